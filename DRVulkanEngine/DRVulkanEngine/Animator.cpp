@@ -1,11 +1,12 @@
 #include "Animator.h"
 #include "ModelLoader.h"
 
-Animator::Animator(Animation* animation) {
+Animator::Animator(Animation* animation, const glm::mat4& globalInverseTransform) {
     currentTime_ = 0.0;
     lastTime_ = -1.0f; // ʱⰪ -1 Ͽ ù ° Ʈ 
     forceUpdate_ = true; // ʱȭ   Ʈ
     currentAnimation_ = animation;
+    globalInverseTransform_ = globalInverseTransform;
 
     finalBoneMatrices_.resize(100, glm::mat4(1.0f));
 }
@@ -44,7 +45,7 @@ bool Animator::updateAnimation(float dt) {
     forceUpdate_ = false;
     
     // 2.   ȯ   
-    calculateBoneTransform(&currentAnimation_->GetRootNode(), ModelLoader::globalInverseTransform_);
+    calculateBoneTransform(&currentAnimation_->GetRootNode(), globalInverseTransform_);
     
     return true; // ִϸ̼ Ʈ
 }
@@ -6,8 +6,8 @@
 
 class Animator {
 public:
-    // :  ִϸ̼ ޽ϴ.
-    Animator(Animation* animation);
+    // :  ִϸ̼ǰ   Ʈ ȯ(ModelAsset::globalInverseTransform) ޽ϴ.
+    Animator(Animation* animation, const glm::mat4& globalInverseTransform);
 
     //   ȣǾ ִϸ̼ ð Ʈϰ  ȯ մϴ.
     bool updateAnimation(float dt);
@@ -26,6 +26,7 @@ private:
 
     std::vector<glm::mat4> finalBoneMatrices_; // ̴   ĵ
     Animation* currentAnimation_;              //    ִϸ̼
+    glm::mat4 globalInverseTransform_;         //  Ʈ    (𵨸 ٸ)
     float currentTime_;                        //   ð (in ticks)
     float lastTime_;                          //   ð ( )
     
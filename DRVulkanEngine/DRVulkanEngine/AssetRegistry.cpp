@@ -0,0 +1,146 @@
+#include "AssetRegistry.h"
+#include "VulkanContext.h"
+#include "ModelLoader.h"
+#include "PrimitiveFactory.h"
+#include "Material.h"
+#include "Texture.h"
+#include "TextureCache.h"
+#include <algorithm>
+
+std::mutex AssetRegistry::mutex_;
+std::unordered_map<std::string, std::weak_ptr<ModelAsset>> AssetRegistry::assets_;
+
+void ModelAsset::prepareBindless(MaterialTable& materialTable, TextureArray& textures)
+{
+    if (bindlessPrepared) {
+        return;
+    }
+    for (Mesh& mesh : meshes) {
+        if (mesh.getMaterial()) {
+            mesh.prepareBindless(materialTable, textures);
+        }
+    }
+    bindlessPrepared = true;
+}
+
+std::string AssetRegistry::MakeKey(const ModelConfig& modelConfig)
+{
+    std::string key = std::to_string(static_cast<int>(modelConfig.type));
+    if (modelConfig.type == ModelType::FromFile) {
+        key += "|" + modelConfig.modelDirectory + "/" + modelConfig.modelFilename;
+        for (const auto& animFilename : modelConfig.animationFilenames) {
+            key += "|" + animFilename;
+        }
+    }
+    return key;
+}
+
+std::shared_ptr<ModelAsset> AssetRegistry::Find(const std::string& key)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = assets_.find(key);
+    if (it == assets_.end()) {
+        return nullptr;
+    }
+    std::shared_ptr<ModelAsset> asset = it->second.lock();
+    if (!asset) {
+        assets_.erase(it);
+    }
+    return asset;
+}
+
+void AssetRegistry::Insert(const std::string& key, const std::shared_ptr<ModelAsset>& asset)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    assets_[key] = asset;
+}
+
+std::shared_ptr<ModelAsset> AssetRegistry::Load(const VulkanContext* context, const ModelConfig& modelConfig)
+{
+    const std::string key = MakeKey(modelConfig);
+    if (std::shared_ptr<ModelAsset> cached = Find(key)) {
+        return cached;
+    }
+
+    auto asset = std::make_shared<ModelAsset>();
+    if (modelConfig.type == ModelType::FromFile) {
+        const std::string& filedir = modelConfig.modelDirectory;
+
+        std::lock_guard<std::mutex> importLock(ModelLoader::importMutex_);
+        ModelLoader::LoadSkinnedModel(context, filedir, modelConfig.modelFilename, asset->meshes, asset->globalInverseTransform);
+        for (const auto& animFilename : modelConfig.animationFilenames) {
+            ModelLoader::LoadAnimations(context, filedir, animFilename, asset->animations);
+        }
+    }
+    else if (modelConfig.type == ModelType::Box) {
+        PrimitiveFactory::createBox(context, 50, 50, 50, asset->meshes);
+    }
+
+    Insert(key, asset);
+    return asset;
+}
+
+std::shared_ptr<ModelAsset> AssetRegistry::Create(const VulkanContext* context, ModelImportData&& importData,
+    AssetUploads& outUploads, UploadPriority priority)
+{
+    auto asset = std::make_shared<ModelAsset>();
+    outUploads = AssetUploads{};
+    // 이 에셋이 새로 만든 텍스처 (캐시 등록 전이라 같은 경로를 다시 참조하면 여기서 찾습니다)
+    std::unordered_map<std::string, std::shared_ptr<Texture>> createdTextures;
+
+    // 같은 텍스처를 여러 슬롯/메시/모델이 참조하면 캐시에 등록된 하나를 공유합니다.
+    auto createTexture = [&](const std::string& path) -> std::shared_ptr<Texture> {
+        if (path.empty()) {
+            return nullptr;
+        }
+        if (std::shared_ptr<Texture> cached = TextureCache::Find(path)) {
+            return cached;
+        }
+        auto createdIt = createdTextures.find(path);
+        if (createdIt != createdTextures.end()) {
+            return createdIt->second;
+        }
+        auto pinnedIt = importData.cachedTextures.find(path);
+        if (pinnedIt != importData.cachedTextures.end()) {
+            // 내용 해시로 찾은 경우에만 새 경로를 캐시에 연결합니다.
+            auto hashIt = importData.imageHashes.find(path);
+            if (hashIt != importData.imageHashes.end()) {
+                TextureCache::Insert(path, hashIt->second, pinnedIt->second);
+            }
+            return pinnedIt->second;
+        }
+        auto imageIt = importData.images.find(path);
+        if (imageIt == importData.images.end()) {
+            return nullptr;
+        }
+        auto texture = std::make_shared<Texture>(context, imageIt->second, priority);
+        outUploads.ticket = std::max(outUploads.ticket, texture->getUploadTicket());
+        outUploads.textures.push_back({ path, importData.imageHashes[path], texture });
+        createdTextures.emplace(path, texture);
+        return texture;
+    };
+
+    asset->meshes.reserve(importData.meshes.size());
+    for (const MeshImportData& meshData : importData.meshes) {
+        asset->meshes.emplace_back();
+        asset->meshes.back().initialize(context, meshData.vertices, meshData.indices,
+            createTexture(meshData.texturePaths[TEXTURE_SLOT_DIFFUSE]),
+            createTexture(meshData.texturePaths[TEXTURE_SLOT_SPECULAR]),
+            createTexture(meshData.texturePaths[TEXTURE_SLOT_NORMAL]),
+            createTexture(meshData.texturePaths[TEXTURE_SLOT_AMBIENT]),
+            createTexture(meshData.texturePaths[TEXTURE_SLOT_EMISSIVE]),
+            priority);
+        outUploads.ticket = std::max(outUploads.ticket, asset->meshes.back().getUploadTicket());
+    }
+
+    asset->animations = std::move(importData.animations);
+    asset->globalInverseTransform = importData.globalInverseTransform;
+    return asset;
+}
+
+void AssetRegistry::PublishTextures(const AssetUploads& uploads)
+{
+    for (const AssetUploads::PendingTexture& pending : uploads.textures) {
+        TextureCache::Insert(pending.path, pending.contentHash, pending.texture);
+    }
+}
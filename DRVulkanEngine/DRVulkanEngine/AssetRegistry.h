@@ -0,0 +1,72 @@
+#pragma once
+#include <vulkan/vulkan.h>
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <glm/glm.hpp>
+#include "Mesh.h"
+#include "Animation.h"
+#include "ModelConfig.h"
+
+class VulkanContext;
+class MaterialTable;
+class TextureArray;
+class Texture;
+struct ModelImportData;
+
+// 같은 ModelConfig로 만든 Model 인스턴스들이 공유하는 불변 데이터
+// Mesh(버텍스/인덱스 버퍼)와 Material(재질 테이블 ID, 텍스처)이 여기에 한 번만 존재하고,
+// Model은 월드 행렬, GpuScene 오브젝트 ID, Animator, 본 팔레트 위치 같은 인스턴스별 상태만 가집니다.
+// (트랜스폼은 GpuScene 오브젝트 레코드로 올라가므로 인스턴스마다 따로 가진 유니폼 버퍼는 없습니다)
+struct ModelAsset
+{
+    std::vector<Mesh> meshes;
+    std::vector<Animation> animations;
+    glm::mat4 globalInverseTransform = glm::mat4(1.0f);
+
+    // 재질 바인드리스 등록은 에셋당 한 번만 수행합니다.
+    void prepareBindless(MaterialTable& materialTable, TextureArray& textures);
+    bool bindlessPrepared = false;
+};
+
+// AssetRegistry::Create가 요청한 업로드. 호출자는 ticket이 끝난 뒤에 에셋과 새 텍스처를 공개합니다.
+struct AssetUploads
+{
+    struct PendingTexture {
+        std::string path;
+        uint64_t contentHash = 0;
+        std::shared_ptr<Texture> texture;
+    };
+
+    // 이 에셋이 요청한 업로드 중 가장 늦은 번호. 모두 같은 우선순위라 이것이 끝나면 에셋 전체를 쓸 수 있습니다.
+    UploadTicket ticket = INVALID_UPLOAD_TICKET;
+    // 새로 만든 텍스처. 업로드 중인 텍스처를 다른 에셋이 캐시에서 집어가지 않도록 TextureCache 등록을 미룹니다.
+    std::vector<PendingTexture> textures;
+};
+
+// ModelConfig -> weak_ptr<ModelAsset> 레지스트리
+// TextureCache와 마찬가지로 약한 참조만 보관하므로 마지막 인스턴스가 사라지면 에셋도 해제됩니다.
+class AssetRegistry
+{
+public:
+    static std::string MakeKey(const ModelConfig& modelConfig);
+
+    static std::shared_ptr<ModelAsset> Find(const std::string& key);
+    static void Insert(const std::string& key, const std::shared_ptr<ModelAsset>& asset);
+
+    // 동기 로드: 레지스트리에 있으면 공유하고, 없으면 임포트 후 등록합니다.
+    static std::shared_ptr<ModelAsset> Load(const VulkanContext* context, const ModelConfig& modelConfig);
+
+    // 워커 스레드가 임포트한 데이터로 에셋을 만듭니다. 텍스처와 버텍스/인덱스 복사는 업로드 매니저에 priority로 요청만 합니다.
+    // (업로드가 끝나기 전이므로 레지스트리와 TextureCache 등록은 호출자가 outUploads.ticket을 확인한 뒤에 합니다)
+    static std::shared_ptr<ModelAsset> Create(const VulkanContext* context, ModelImportData&& importData,
+        AssetUploads& outUploads, UploadPriority priority = UploadPriority::Normal);
+    // Create가 미뤄둔 텍스처를 TextureCache에 등록합니다. 업로드가 끝난 뒤에 호출합니다.
+    static void PublishTextures(const AssetUploads& uploads);
+
+private:
+    static std::mutex mutex_;
+    static std::unordered_map<std::string, std::weak_ptr<ModelAsset>> assets_;
+};
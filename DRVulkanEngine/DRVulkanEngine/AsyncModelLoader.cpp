@@ -0,0 +1,249 @@
+#include "AsyncModelLoader.h"
+#include "VulkanContext.h"
+#include "UploadManager.h"
+#include "Model.h"
+#include "Texture.h"
+#include "TextureCache.h"
+#include <iostream>
+#include <stdexcept>
+#include <algorithm>
+
+AsyncModelLoader::~AsyncModelLoader() {
+    cleanup();
+}
+
+void AsyncModelLoader::initialize(const VulkanContext* context, uint32_t workerCount) {
+    context_ = context;
+
+    stopRequested_ = false;
+    workerCount = std::max(workerCount, 1u);
+    for (uint32_t i = 0; i < workerCount; ++i) {
+        workers_.emplace_back(&AsyncModelLoader::workerLoop, this);
+    }
+}
+
+void AsyncModelLoader::cleanup() {
+    if (context_ == nullptr) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(jobMutex_);
+        stopRequested_ = true;
+        jobs_.clear();
+    }
+    jobCondition_.notify_all();
+    for (std::thread& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    workers_.clear();
+
+    std::unique_ptr<LoadResult> discarded;
+    while (completedQueue_.tryPop(discarded)) {
+        discarded.reset();
+    }
+
+    // 종료 시에만 남은 업로드를 기다립니다. (에셋을 놓기 전에 복사가 끝나야 합니다)
+    for (PendingUpload& upload : pendingUploads_) {
+        context_->getUploadManager().wait(upload.uploads.ticket);
+    }
+    pendingUploads_.clear();
+    inFlightAssets_.clear();
+    readyModels_.clear();
+
+    context_ = nullptr;
+}
+
+ModelHandle AsyncModelLoader::requestModel(const ModelConfig& modelConfig) {
+    ModelHandle handle = nextHandle_++;
+    std::string assetKey = AssetRegistry::MakeKey(modelConfig);
+
+    // 이미 살아있는 에셋이면 인스턴스 상태만 만들면 됩니다.
+    if (std::shared_ptr<ModelAsset> asset = AssetRegistry::Find(assetKey)) {
+        readyModels_.emplace_back(handle, std::make_unique<Model>(context_, modelConfig, std::move(asset)));
+        states_[handle] = ModelLoadState::Ready;
+        return handle;
+    }
+
+    states_[handle] = ModelLoadState::Queued;
+    auto& waiters = inFlightAssets_[assetKey];
+    waiters.emplace_back(handle, modelConfig);
+    if (waiters.size() > 1) {
+        return handle;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(jobMutex_);
+        jobs_.push_back(LoadJob{ handle, std::move(assetKey), modelConfig });
+    }
+    jobCondition_.notify_one();
+    return handle;
+}
+
+ModelLoadState AsyncModelLoader::getState(ModelHandle handle) const {
+    auto it = states_.find(handle);
+    return it != states_.end() ? it->second : ModelLoadState::Unknown;
+}
+
+void AsyncModelLoader::update() {
+    retireCompletedUploads();
+
+    for (uint32_t i = 0; i < MAX_UPLOADS_PER_FRAME; ++i) {
+        std::unique_ptr<LoadResult> result;
+        if (!completedQueue_.tryPop(result)) {
+            break;
+        }
+        beginUpload(std::move(result));
+    }
+}
+
+bool AsyncModelLoader::popReadyModel(ModelHandle& outHandle, std::unique_ptr<Model>& outModel) {
+    if (readyModels_.empty()) {
+        return false;
+    }
+    outHandle = readyModels_.front().first;
+    outModel = std::move(readyModels_.front().second);
+    readyModels_.pop_front();
+    return true;
+}
+
+void AsyncModelLoader::workerLoop() {
+    for (;;) {
+        LoadJob job;
+        {
+            std::unique_lock<std::mutex> lock(jobMutex_);
+            jobCondition_.wait(lock, [this] { return stopRequested_ || !jobs_.empty(); });
+            if (stopRequested_) {
+                return;
+            }
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+        }
+
+        auto result = std::make_unique<LoadResult>();
+        result->handle = job.handle;
+        result->assetKey = std::move(job.assetKey);
+        result->config = std::move(job.config);
+        importModel(*result);
+
+        // 렌더 스레드가 큐를 비울 때까지 양보하며 재시도합니다.
+        while (!completedQueue_.tryPush(std::move(result))) {
+            {
+                std::lock_guard<std::mutex> lock(jobMutex_);
+                if (stopRequested_) {
+                    return;
+                }
+            }
+            std::this_thread::yield();
+        }
+    }
+}
+
+void AsyncModelLoader::importModel(LoadResult& result) {
+    if (result.config.type != ModelType::FromFile) {
+        // 기본 도형은 파일 I/O가 없으므로 렌더 스레드에서 바로 생성합니다.
+        result.succeeded = true;
+        return;
+    }
+
+    const std::string& filedir = result.config.modelDirectory;
+    {
+        std::lock_guard<std::mutex> importLock(ModelLoader::importMutex_);
+        if (!ModelLoader::ImportSkinnedModel(filedir, result.config.modelFilename, result.data)) {
+            return;
+        }
+        for (const auto& animFilename : result.config.animationFilenames) {
+            ModelLoader::LoadAnimations(context_, filedir, animFilename, result.data.animations);
+        }
+    }
+
+    // 텍스처 디코딩은 static 상태를 건드리지 않으므로 락 밖에서 병렬로 수행합니다.
+    // 캐시에 이미 살아있는 텍스처(같은 경로 또는 같은 내용)는 디코딩하지 않고 참조만 잡아둡니다.
+    ModelImportData& data = result.data;
+    for (const MeshImportData& meshData : data.meshes) {
+        for (const std::string& path : meshData.texturePaths) {
+            if (path.empty() || data.imageHashes.count(path) > 0 || data.cachedTextures.count(path) > 0) {
+                continue;
+            }
+            if (std::shared_ptr<Texture> cached = TextureCache::Find(path)) {
+                data.cachedTextures.emplace(path, std::move(cached));
+                continue;
+            }
+
+            std::vector<unsigned char> bytes;
+            if (!TextureCache::ReadFileBytes(path, bytes)) {
+                std::cerr << "failed to load texture image: " << path << std::endl;
+                continue;
+            }
+            uint64_t contentHash = TextureCache::HashBytes(bytes.data(), bytes.size());
+            data.imageHashes[path] = contentHash;
+            if (std::shared_ptr<Texture> cached = TextureCache::FindByHash(contentHash)) {
+                data.cachedTextures.emplace(path, std::move(cached));
+                continue;
+            }
+
+            ImageData image;
+            if (Texture::DecodeImageData(bytes, image)) {
+                data.images.emplace(path, std::move(image));
+            }
+            else {
+                std::cerr << "failed to decode texture image: " << path << std::endl;
+            }
+        }
+    }
+    result.succeeded = true;
+}
+
+void AsyncModelLoader::beginUpload(std::unique_ptr<LoadResult> result) {
+    if (!result->succeeded) {
+        std::cerr << "failed to load model: " << result->config.modelDirectory << "/" << result->config.modelFilename << std::endl;
+        for (const auto& [handle, config] : inFlightAssets_[result->assetKey]) {
+            states_[handle] = ModelLoadState::Failed;
+        }
+        inFlightAssets_.erase(result->assetKey);
+        return;
+    }
+
+    if (result->config.type != ModelType::FromFile) {
+        completeAsset(result->assetKey, AssetRegistry::Load(context_, result->config));
+        return;
+    }
+
+    PendingUpload upload{};
+    upload.assetKey = result->assetKey;
+    // 스트리밍 우선순위로 요청하므로 큰 에셋도 프레임 업로드 예산에 맞춰 여러 프레임에 나뉘어 올라갑니다.
+    upload.asset = AssetRegistry::Create(context_, std::move(result->data), upload.uploads, UploadPriority::Normal);
+
+    for (const auto& [handle, config] : inFlightAssets_[upload.assetKey]) {
+        states_[handle] = ModelLoadState::Uploading;
+    }
+    pendingUploads_.push_back(std::move(upload));
+}
+
+void AsyncModelLoader::retireCompletedUploads() {
+    const UploadManager& uploadManager = context_->getUploadManager();
+    for (auto it = pendingUploads_.begin(); it != pendingUploads_.end();) {
+        if (!uploadManager.isComplete(it->uploads.ticket)) {
+            ++it;
+            continue;
+        }
+
+        // 내용이 다 올라간 텍스처만 캐시에 공개합니다.
+        AssetRegistry::PublishTextures(it->uploads);
+        completeAsset(it->assetKey, it->asset);
+        it = pendingUploads_.erase(it);
+    }
+}
+
+void AsyncModelLoader::completeAsset(const std::string& assetKey, const std::shared_ptr<ModelAsset>& asset) {
+    // 업로드가 끝난 뒤에야 레지스트리에 공개하므로, 다른 요청이 업로드 중인 에셋을 보는 일은 없습니다.
+    AssetRegistry::Insert(assetKey, asset);
+
+    for (const auto& [handle, config] : inFlightAssets_[assetKey]) {
+        readyModels_.emplace_back(handle, std::make_unique<Model>(context_, config, asset));
+        states_[handle] = ModelLoadState::Ready;
+    }
+    inFlightAssets_.erase(assetKey);
+}
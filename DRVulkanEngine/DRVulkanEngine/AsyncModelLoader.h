@@ -0,0 +1,107 @@
+#pragma once
+#include <vulkan/vulkan.h>
+#include <vector>
+#include <deque>
+#include <map>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "ModelConfig.h"
+#include "ModelLoader.h"
+#include "UploadManager.h"
+#include "LockFreeQueue.h"
+#include "AssetRegistry.h"
+
+class VulkanContext;
+class Model;
+
+using ModelHandle = uint32_t;
+constexpr ModelHandle INVALID_MODEL_HANDLE = 0;
+
+enum class ModelLoadState
+{
+    Unknown,
+    Queued,     // 워커 스레드에서 임포트/디코딩 중
+    Uploading,  // GPU 업로드 기록됨, 업로드 타임라인 대기 중
+    Ready,      // popReadyModel로 꺼낼 수 있음
+    Failed
+};
+
+// 모델을 프레임 루프를 막지 않고 로드합니다.
+//  1) requestModel은 핸들만 즉시 반환하고
+//  2) 워커 스레드가 Assimp 임포트와 텍스처 디코딩을 수행한 뒤 lock-free 큐로 결과를 넘기면
+//  3) 렌더 스레드의 update()가 업로드 매니저의 배치에 복사를 기록하고, 그 배치의 타임라인 값을 폴링(대기 없음)하여
+//  4) 업로드가 끝난 모델을 popReadyModel로 넘겨줍니다.
+// 같은 에셋이 이미 로드되어 있거나 로드 중이면 임포트 없이 인스턴스만 만듭니다.
+class AsyncModelLoader
+{
+public:
+    AsyncModelLoader() = default;
+    ~AsyncModelLoader();
+
+    AsyncModelLoader(const AsyncModelLoader&) = delete;
+    AsyncModelLoader& operator=(const AsyncModelLoader&) = delete;
+
+    void initialize(const VulkanContext* context, uint32_t workerCount = 2);
+    void cleanup();
+
+    ModelHandle requestModel(const ModelConfig& modelConfig);
+    ModelLoadState getState(ModelHandle handle) const;
+
+    // 렌더 스레드에서 매 프레임 호출합니다.
+    void update();
+    bool popReadyModel(ModelHandle& outHandle, std::unique_ptr<Model>& outModel);
+
+private:
+    struct LoadJob {
+        ModelHandle handle = INVALID_MODEL_HANDLE;
+        std::string assetKey;
+        ModelConfig config;
+    };
+
+    struct LoadResult {
+        ModelHandle handle = INVALID_MODEL_HANDLE;
+        std::string assetKey;
+        ModelConfig config;
+        ModelImportData data;
+        bool succeeded = false;
+    };
+
+    struct PendingUpload {
+        std::string assetKey;
+        std::shared_ptr<ModelAsset> asset;
+        // 이 에셋이 요청한 업로드와, 그것이 끝나면 TextureCache에 등록할 텍스처
+        AssetUploads uploads;
+    };
+
+    void workerLoop();
+    void importModel(LoadResult& result);
+    void beginUpload(std::unique_ptr<LoadResult> result);
+    void retireCompletedUploads();
+    void completeAsset(const std::string& assetKey, const std::shared_ptr<ModelAsset>& asset);
+
+    // 한 프레임에 업로드를 시작하는 모델 수 (업로드 스파이크 분산)
+    static constexpr uint32_t MAX_UPLOADS_PER_FRAME = 1;
+    static constexpr size_t COMPLETED_QUEUE_CAPACITY = 64;
+
+    const VulkanContext* context_ = nullptr;
+
+    // 렌더 스레드 -> 워커 (워커가 잠들 수 있어야 하므로 condition_variable 사용)
+    std::vector<std::thread> workers_;
+    std::mutex jobMutex_;
+    std::condition_variable jobCondition_;
+    std::deque<LoadJob> jobs_;
+    bool stopRequested_ = false;
+
+    // 워커 -> 렌더 스레드
+    LockFreeQueue<std::unique_ptr<LoadResult>, COMPLETED_QUEUE_CAPACITY> completedQueue_;
+
+    // 이하 렌더 스레드 전용
+    ModelHandle nextHandle_ = 1;
+    std::map<ModelHandle, ModelLoadState> states_;
+    // 로드 중인 에셋 키 -> 그 에셋을 기다리는 요청들 (같은 파일을 중복 임포트하지 않기 위함)
+    std::map<std::string, std::vector<std::pair<ModelHandle, ModelConfig>>> inFlightAssets_;
+    std::vector<PendingUpload> pendingUploads_;
+    std::deque<std::pair<ModelHandle, std::unique_ptr<Model>>> readyModels_;
+};
@@ -11,31 +11,16 @@ BDABuffer::BDABuffer(const VulkanContext* ctx, VkDeviceSize size, VkBufferUsageF
     VkBufferCreateInfo bufferInfo{ VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
     bufferInfo.size = size;
     bufferInfo.usage = fullUsage;
-    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    context_->setBufferSharing(bufferInfo);
 
     if (vkCreateBuffer(context_->getDevice(), &bufferInfo, nullptr, &buffer_) != VK_SUCCESS) {
         throw std::runtime_error("failed to create BDA buffer!");
     }
 
-    VkMemoryRequirements memRequirements;
-    vkGetBufferMemoryRequirements(context_->getDevice(), buffer_, &memRequirements);
-
-    // BDA  ؼ ޸ Ҵ  'Ҵ ÷' ؾ մϴ.
-    VkMemoryAllocateFlagsInfo flagsInfo{ VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO };
-    flagsInfo.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT; // ʼ ÷
-
-    VkMemoryAllocateInfo allocInfo{ VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
-    allocInfo.pNext = &flagsInfo;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = context_->findMemoryType(memRequirements.memoryTypeBits,
+    // BDA ʿ Ҵ ÷״ Ҵ  Ͽ ̹ پ ֽϴ.
+    allocation_ = context_->getMemoryAllocator().allocateForBuffer(buffer_,
         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
 
-    if (vkAllocateMemory(context_->getDevice(), &allocInfo, nullptr, &bufferMemory_) != VK_SUCCESS) {
-        throw std::runtime_error("failed to allocate BDA buffer memory!");
-    }
-
-    vkBindBufferMemory(context_->getDevice(), buffer_, bufferMemory_, 0);
-
     VkBufferDeviceAddressInfo addressInfo{ VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO };
     addressInfo.buffer = buffer_;
     deviceAddress_ = vkGetBufferDeviceAddress(context_->getDevice(), &addressInfo);
@@ -43,12 +28,9 @@ BDABuffer::BDABuffer(const VulkanContext* ctx, VkDeviceSize size, VkBufferUsageF
 
 BDABuffer::~BDABuffer() {
     if (buffer_ != VK_NULL_HANDLE) vkDestroyBuffer(context_->getDevice(), buffer_, nullptr);
-    if (bufferMemory_ != VK_NULL_HANDLE) vkFreeMemory(context_->getDevice(), bufferMemory_, nullptr);
+    context_->getMemoryAllocator().free(allocation_);
 }
 
 void BDABuffer::update(const void* data) {
-    void* mappedMemory;
-    vkMapMemory(context_->getDevice(), bufferMemory_, 0, bufferSize_, 0, &mappedMemory);
-    memcpy(mappedMemory, data, static_cast<size_t>(bufferSize_));
-    vkUnmapMemory(context_->getDevice(), bufferMemory_);
+    memcpy(allocation_.mapped, data, static_cast<size_t>(bufferSize_));
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 #include <vulkan/vulkan.h>
+#include "MemoryAllocator.h"
 
 class VulkanContext;
 
@@ -15,7 +16,7 @@ public:
 
 private:
     VkBuffer buffer_ = VK_NULL_HANDLE;
-    VkDeviceMemory bufferMemory_ = VK_NULL_HANDLE;
+    MemoryAllocation allocation_;
     VkDeviceSize bufferSize_ = 0;
     VkDeviceAddress deviceAddress_ = 0;
 
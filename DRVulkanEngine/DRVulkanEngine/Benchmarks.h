@@ -0,0 +1,13 @@
+#pragma once
+
+// 커맨드라인으로 실행하는 CPU 벤치마크/검사 (Vulkan 초기화 없이 실행)
+// --bench-culling : 프러스텀 컬링 스칼라/AVX2/BVH 비교 (10k, 100k, 1M 박스)
+int RunFrustumCullingBenchmark();
+// --bench-render-queue : 렌더 큐 64비트 키 기수 정렬 vs std::stable_sort (10k, 100k, 1M 드로우)
+int RunRenderQueueBenchmark();
+// --test-occlusion : 소프트웨어 가림 버퍼를 알려진 가리개/박스 배치로 검증 (실패가 있으면 1 반환)
+int RunOcclusionBufferTest();
+
+// 창을 열고 현재 GPU에서 실행하는 벤치마크
+// --bench-bones : 본 팔레트 백엔드(UBO 배열/SSBO/BDA/텍셀 버퍼)별 깊이 프리패스 GPU 시간 (버텍스 단계 비용)
+int RunBoneBackendBenchmark();
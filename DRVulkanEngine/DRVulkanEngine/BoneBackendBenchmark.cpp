@@ -0,0 +1,98 @@
+#include "BoneBackendBenchmark.h"
+#include "Benchmarks.h"
+#include "VulkanApp.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <cstdlib>
+
+BoneBackendBenchmark::BoneBackendBenchmark(const Settings& settings)
+    : settings_(settings)
+{
+    for (uint32_t i = 0; i < static_cast<uint32_t>(BoneBackend::Count); ++i) {
+        Result result;
+        result.backend = static_cast<BoneBackend>(i);
+        result.samples.reserve(settings_.measureFrames);
+        results_.push_back(std::move(result));
+    }
+}
+
+void BoneBackendBenchmark::skipCurrentBackend(const std::string& reason)
+{
+    results_[current_].skipReason = reason;
+    current_++;
+    frameInBackend_ = 0;
+}
+
+bool BoneBackendBenchmark::addFrame(double milliseconds)
+{
+    if (isFinished()) {
+        return false;
+    }
+    if (frameInBackend_++ < settings_.warmupFrames) {
+        return false;
+    }
+    std::vector<double>& samples = results_[current_].samples;
+    samples.push_back(milliseconds);
+    if (samples.size() < settings_.measureFrames) {
+        return false;
+    }
+    current_++;
+    frameInBackend_ = 0;
+    return true;
+}
+
+void BoneBackendBenchmark::printResults(const char* deviceName, uint32_t instanceCount) const
+{
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Bone backend benchmark (" << deviceName << ", " << instanceCount << " skinned instances, "
+              << settings_.measureFrames << " frames, depth prepass GPU time)" << std::endl;
+
+    double bestMedian = -1.0;
+    for (const Result& result : results_) {
+        if (result.samples.empty()) {
+            continue;
+        }
+        std::vector<double> sorted = result.samples;
+        std::sort(sorted.begin(), sorted.end());
+        const double median = sorted[sorted.size() / 2];
+        if (bestMedian < 0.0 || median < bestMedian) {
+            bestMedian = median;
+        }
+    }
+
+    for (const Result& result : results_) {
+        std::cout << std::setw(13) << GetBoneBackendName(result.backend);
+        if (result.samples.empty()) {
+            std::cout << " | skipped (" << (result.skipReason.empty() ? "no timestamps" : result.skipReason) << ")" << std::endl;
+            continue;
+        }
+        // 다른 작업에 밀린 프레임이 평균을 흔들므로 중앙값으로 비교합니다.
+        std::vector<double> sorted = result.samples;
+        std::sort(sorted.begin(), sorted.end());
+        const double median = sorted[sorted.size() / 2];
+        const double mean = std::accumulate(sorted.begin(), sorted.end(), 0.0) / sorted.size();
+        std::cout << " | median " << std::setw(8) << median << " ms"
+                  << " | mean " << std::setw(8) << mean << " ms"
+                  << " | min " << std::setw(8) << sorted.front() << " ms"
+                  << " | x" << std::setprecision(2) << median / bestMedian << std::setprecision(3)
+                  << (median == bestMedian ? "  <- fastest" : "")
+                  << std::endl;
+    }
+}
+
+int RunBoneBackendBenchmark()
+{
+    VulkanApp app;
+    app.enableBoneBackendBenchmark(BoneBackendBenchmark::Settings{});
+
+    try {
+        app.run();
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
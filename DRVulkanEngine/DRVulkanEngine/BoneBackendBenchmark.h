@@ -0,0 +1,42 @@
+#pragma once
+#include "BonePalettePool.h"
+#include <vector>
+#include <string>
+#include <cstdint>
+
+// --bench-bones: 같은 스키닝 씬을 본 백엔드(BoneBackend)마다 그려 깊이 프리패스의 GPU 시간을 비교합니다.
+// 깊이 프리패스는 프래그먼트 셰이더가 없으므로 그 시간을 버텍스 단계 비용으로 봅니다.
+// VulkanApp이 프레임마다 측정값을 넣고 다음에 쓸 백엔드를 물어봅니다.
+class BoneBackendBenchmark
+{
+public:
+    struct Settings {
+        uint32_t gridSize = 12;         // gridSize x gridSize개의 스키닝 인스턴스
+        uint32_t warmupFrames = 60;     // 백엔드를 바꾼 뒤 버리는 프레임 (이전 백엔드로 그린 프레임, 클럭 안정)
+        uint32_t measureFrames = 300;
+    };
+
+    explicit BoneBackendBenchmark(const Settings& settings);
+
+    const Settings& getSettings() const { return settings_; }
+    bool isFinished() const { return current_ >= results_.size(); }
+    BoneBackend getCurrentBackend() const { return results_[current_].backend; }
+
+    // 현재 백엔드를 이 장치에서 쓸 수 없으면 결과 없이 다음으로 넘어갑니다.
+    void skipCurrentBackend(const std::string& reason);
+    // 한 프레임의 측정값 (ms). 현재 백엔드 측정이 끝나 다음으로 넘어갔으면 true
+    bool addFrame(double milliseconds);
+    void printResults(const char* deviceName, uint32_t instanceCount) const;
+
+private:
+    struct Result {
+        BoneBackend backend = BoneBackend::Storage;
+        std::vector<double> samples;
+        std::string skipReason;
+    };
+
+    Settings settings_;
+    std::vector<Result> results_;
+    size_t current_ = 0;
+    uint32_t frameInBackend_ = 0;
+};
@@ -0,0 +1,284 @@
+#include "BonePalettePool.h"
+#include "VulkanContext.h"
+#include <stdexcept>
+#include <algorithm>
+#include <cstring>
+
+const char* GetBoneBackendName(BoneBackend backend)
+{
+    switch (backend) {
+    case BoneBackend::UniformArray: return "UBO array";
+    case BoneBackend::Storage: return "SSBO";
+    case BoneBackend::DeviceAddress: return "BDA";
+    case BoneBackend::TexelBuffer: return "Texel buffer";
+    default: return "Unknown";
+    }
+}
+
+void BonePaletteWindowView::populateWriteDescriptor(VkWriteDescriptorSet& writeInfo) const
+{
+    // 레이아웃은 MAX_UNIFORM_WINDOWS개이고 PARTIALLY_BOUND이므로 버퍼가 덮는 창까지만 씁니다.
+    writeInfo.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    writeInfo.descriptorCount = static_cast<uint32_t>(windowInfos_.size());
+    writeInfo.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    writeInfo.pBufferInfo = windowInfos_.data();
+    writeInfo.pImageInfo = nullptr;
+    writeInfo.pTexelBufferView = nullptr;
+}
+
+void BonePaletteWindowView::rebuild(VkBuffer buffer, uint32_t windowCount)
+{
+    const VkDeviceSize windowSize = sizeof(glm::mat4) * BonePalettePool::WINDOW_MATRICES;
+    windowInfos_.resize(windowCount);
+    for (uint32_t i = 0; i < windowCount; ++i) {
+        windowInfos_[i].buffer = buffer;
+        windowInfos_[i].offset = windowSize * i;
+        windowInfos_[i].range = windowSize;
+    }
+    bBufferInfosDirty_ = true;
+}
+
+void BonePaletteTexelView::populateWriteDescriptor(VkWriteDescriptorSet& writeInfo) const
+{
+    writeInfo.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    writeInfo.descriptorCount = 1;
+    writeInfo.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER;
+    writeInfo.pTexelBufferView = &bufferView_;
+    writeInfo.pBufferInfo = nullptr;
+    writeInfo.pImageInfo = nullptr;
+}
+
+void BonePaletteTexelView::rebuild(VkBufferView bufferView)
+{
+    bufferView_ = bufferView;
+    bBufferInfosDirty_ = true;
+}
+
+BonePalettePool::~BonePalettePool()
+{
+    cleanup();
+}
+
+void BonePalettePool::initialize(const VulkanContext* ctx, uint32_t framesInFlight, uint32_t initialCapacity)
+{
+    context = ctx; // Resource::createBuffer가 사용
+    framesInFlight_ = framesInFlight;
+
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(context->getPhysicalDevice(), &properties);
+    maxTexelBufferElements_ = properties.limits.maxTexelBufferElements;
+
+    const uint32_t capacity = std::max(initialCapacity, CAPACITY_GRANULARITY);
+    matrices_.resize((capacity + CAPACITY_GRANULARITY - 1) / CAPACITY_GRANULARITY * CAPACITY_GRANULARITY, glm::mat4(1.0f));
+    dirtyRanges_.assign(framesInFlight_, DirtyRange{});
+    // 팔레트가 하나도 없을 때도 주소가 유효하도록 바로 만듭니다.
+    growDeviceBuffer();
+}
+
+void BonePalettePool::cleanup()
+{
+    if (!context) {
+        return;
+    }
+    destroyDeviceBuffer(buffer_);
+    for (RetiredBuffer& retired : retiredBuffers_) {
+        destroyDeviceBuffer(retired.buffer);
+    }
+    retiredBuffers_.clear();
+
+    matrices_.clear();
+    dirtyRanges_.clear();
+    matrixCount_ = 0;
+    capacity_ = 0;
+    deviceAddress_ = 0;
+    context = nullptr;
+}
+
+uint32_t BonePalettePool::allocate(uint32_t boneCount)
+{
+    if (boneCount == 0) {
+        return INVALID_PALETTE;
+    }
+    if (boneCount > WINDOW_MATRICES) {
+        throw std::runtime_error("bone palette does not fit in a uniform window!");
+    }
+    // UBO 창 백엔드가 창 하나로 읽을 수 있도록, 현재 창에 자리가 모자라면 다음 창에서 시작합니다.
+    uint32_t paletteIndex = matrixCount_;
+    if (paletteIndex % WINDOW_MATRICES + boneCount > WINDOW_MATRICES) {
+        paletteIndex = (paletteIndex / WINDOW_MATRICES + 1) * WINDOW_MATRICES;
+    }
+
+    // CPU 사본만 먼저 키우고, GPU 버퍼는 다음 flush()에서 다시 만듭니다.
+    if (paletteIndex + boneCount > matrices_.size()) {
+        size_t newSize = matrices_.size() * 2;
+        while (newSize < paletteIndex + boneCount) {
+            newSize *= 2;
+        }
+        matrices_.resize(newSize, glm::mat4(1.0f));
+    }
+
+    matrixCount_ = paletteIndex + boneCount;
+    // 첫 write() 전에 그려도 항등 행렬을 읽도록 새 구간도 올립니다.
+    markDirty(paletteIndex, matrixCount_);
+
+    stats_.paletteCount++;
+    stats_.matrixCount = matrixCount_;
+    return paletteIndex;
+}
+
+void BonePalettePool::write(uint32_t paletteIndex, const glm::mat4* matrices, uint32_t boneCount)
+{
+    if (paletteIndex == INVALID_PALETTE || boneCount == 0) {
+        return;
+    }
+    if (paletteIndex + boneCount > matrixCount_) {
+        throw std::runtime_error("bone palette write out of range!");
+    }
+    memcpy(matrices_.data() + paletteIndex, matrices, sizeof(glm::mat4) * boneCount);
+    markDirty(paletteIndex, paletteIndex + boneCount);
+}
+
+void BonePalettePool::markDirty(uint32_t begin, uint32_t end)
+{
+    for (DirtyRange& range : dirtyRanges_) {
+        if (range.begin == range.end) {
+            range.begin = begin;
+            range.end = end;
+        }
+        else {
+            range.begin = std::min(range.begin, begin);
+            range.end = std::max(range.end, end);
+        }
+    }
+}
+
+void BonePalettePool::flush(uint32_t frameIndex)
+{
+    frameIndex_ = frameIndex % framesInFlight_;
+    releaseRetiredBuffers();
+
+    if (capacity_ < matrices_.size()) {
+        growDeviceBuffer();
+    }
+
+    // 이 슬롯은 펜스 대기로 GPU 사용이 끝났으므로, 지난번 이 슬롯을 채운 뒤로 바뀐 구간만 한 번에 복사합니다.
+    DirtyRange& range = dirtyRanges_[frameIndex_];
+    const VkDeviceSize uploadBytes = sizeof(glm::mat4) * (range.end - range.begin);
+    if (uploadBytes > 0) {
+        char* slot = static_cast<char*>(buffer_.allocation.mapped) + getFrameOffset();
+        memcpy(slot + sizeof(glm::mat4) * range.begin, matrices_.data() + range.begin, static_cast<size_t>(uploadBytes));
+    }
+    range = DirtyRange{};
+
+    stats_.lastUploadBytes = uploadBytes;
+    stats_.peakUploadBytes = std::max(stats_.peakUploadBytes, uploadBytes);
+}
+
+void BonePalettePool::populateWriteDescriptor(VkWriteDescriptorSet& writeInfo) const
+{
+    writeInfo.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    writeInfo.descriptorCount = 1;
+    writeInfo.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    writeInfo.pBufferInfo = &bufferInfo_;
+    writeInfo.pImageInfo = nullptr;
+    writeInfo.pTexelBufferView = nullptr;
+}
+
+bool BonePalettePool::isBackendSupported(BoneBackend backend) const
+{
+    const uint64_t totalMatrices = static_cast<uint64_t>(capacity_) * framesInFlight_;
+    switch (backend) {
+    case BoneBackend::UniformArray:
+        return context->supportsUniformBufferArrayNonUniformIndexing()
+            && totalMatrices <= static_cast<uint64_t>(WINDOW_MATRICES) * MAX_UNIFORM_WINDOWS;
+    case BoneBackend::TexelBuffer:
+        return totalMatrices * TEXELS_PER_MATRIX <= maxTexelBufferElements_;
+    case BoneBackend::Storage:
+    case BoneBackend::DeviceAddress:
+        return true;
+    default:
+        return false;
+    }
+}
+
+void BonePalettePool::growDeviceBuffer()
+{
+    // 다른 슬롯의 프레임이 아직 읽고 있을 수 있으므로 바로 해제하지 않습니다.
+    if (buffer_.buffer != VK_NULL_HANDLE) {
+        const uint32_t allFramesMask = (1u << framesInFlight_) - 1;
+        retiredBuffers_.push_back({ buffer_, allFramesMask & ~(1u << frameIndex_) });
+        buffer_ = DeviceBuffer{};
+        stats_.growCount++;
+    }
+
+    capacity_ = static_cast<uint32_t>(matrices_.size());
+    const VkDeviceSize bufferSize = static_cast<VkDeviceSize>(capacity_) * sizeof(glm::mat4) * framesInFlight_;
+    createBuffer(bufferSize,
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT
+            | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_UNIFORM_TEXEL_BUFFER_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+        buffer_.buffer,
+        buffer_.allocation);
+
+    VkBufferDeviceAddressInfo addressInfo{ VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO };
+    addressInfo.buffer = buffer_.buffer;
+    deviceAddress_ = vkGetBufferDeviceAddress(context->getDevice(), &addressInfo);
+
+    bufferInfo_.buffer = buffer_.buffer;
+    bufferInfo_.offset = 0;
+    bufferInfo_.range = bufferSize;
+    bBufferInfosDirty_ = true;
+    stats_.capacity = capacity_;
+
+    // 같은 버퍼의 다른 뷰들도 새 버퍼를 가리키게 합니다.
+    // 제한을 넘는 부분은 뷰에 넣지 않고, 그동안 그 백엔드는 isBackendSupported()가 false입니다.
+    const uint64_t totalMatrices = static_cast<uint64_t>(capacity_) * framesInFlight_;
+    windowView_.rebuild(buffer_.buffer, static_cast<uint32_t>(std::min<uint64_t>(totalMatrices / WINDOW_MATRICES, MAX_UNIFORM_WINDOWS)));
+
+    VkBufferViewCreateInfo viewInfo{};
+    viewInfo.sType = VK_STRUCTURE_TYPE_BUFFER_VIEW_CREATE_INFO;
+    viewInfo.buffer = buffer_.buffer;
+    viewInfo.format = VK_FORMAT_R32G32B32A32_SFLOAT;
+    viewInfo.offset = 0;
+    viewInfo.range = sizeof(glm::vec4) * std::min<uint64_t>(totalMatrices * TEXELS_PER_MATRIX, maxTexelBufferElements_);
+    if (vkCreateBufferView(context->getDevice(), &viewInfo, nullptr, &buffer_.texelView) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create bone palette texel view!");
+    }
+    texelView_.rebuild(buffer_.texelView);
+
+    // 새 버퍼는 비어 있으므로 모든 슬롯을 처음부터 다시 채웁니다.
+    if (matrixCount_ > 0) {
+        for (DirtyRange& range : dirtyRanges_) {
+            range.begin = 0;
+            range.end = matrixCount_;
+        }
+    }
+}
+
+void BonePalettePool::destroyDeviceBuffer(DeviceBuffer& buffer)
+{
+    if (buffer.buffer == VK_NULL_HANDLE) {
+        return;
+    }
+    if (buffer.texelView != VK_NULL_HANDLE) {
+        vkDestroyBufferView(context->getDevice(), buffer.texelView, nullptr);
+    }
+    vkDestroyBuffer(context->getDevice(), buffer.buffer, nullptr);
+    context->getMemoryAllocator().free(buffer.allocation);
+    buffer = DeviceBuffer{};
+}
+
+void BonePalettePool::releaseRetiredBuffers()
+{
+    // 이번 슬롯의 펜스를 기다렸으니 이 슬롯의 이전 프레임은 끝났고, 이번 프레임의 셋은 곧 새 버퍼로 바뀝니다.
+    // 모든 슬롯이 그렇게 지나갔으면 그 버퍼를 읽는 GPU 작업은 없습니다.
+    auto it = std::remove_if(retiredBuffers_.begin(), retiredBuffers_.end(), [this](RetiredBuffer& retired) {
+        retired.pendingFrameMask &= ~(1u << frameIndex_);
+        if (retired.pendingFrameMask != 0) {
+            return false;
+        }
+        destroyDeviceBuffer(retired.buffer);
+        return true;
+    });
+    retiredBuffers_.erase(it, retiredBuffers_.end());
+}
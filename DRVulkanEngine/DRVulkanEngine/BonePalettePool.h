@@ -0,0 +1,148 @@
+#pragma once
+#include "Resource.h"
+#include <vulkan/vulkan.h>
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+
+// 버텍스 셰이더가 본 행렬을 읽는 경로 (shader.vert/depth_prepass.vert의 BONE_BACKEND 특수화 상수 값)
+// 모두 같은 풀 버퍼를 가리키므로 파이프라인만 다시 특수화하면 바로 바꿀 수 있습니다.
+enum class BoneBackend : uint32_t {
+    UniformArray = 0,   // 16KB UBO 창 배열 (인스턴스마다 창이 달라 non-uniform 인덱싱 필요)
+    Storage,            // 스토리지 버퍼
+    DeviceAddress,      // 버퍼 디바이스 주소 (디스크립터 없음)
+    TexelBuffer,        // RGBA32F 텍셀 버퍼, 행렬 하나가 열 4개 텍셀
+    Count
+};
+
+const char* GetBoneBackendName(BoneBackend backend);
+
+// 풀 버퍼를 UBO 창 배열로 보는 디스크립터 (버텍스 셰이더의 bonePaletteWindows)
+class BonePaletteWindowView : public Resource
+{
+public:
+    virtual void populateWriteDescriptor(VkWriteDescriptorSet& writeInfo) const override;
+
+private:
+    friend class BonePalettePool;
+    void rebuild(VkBuffer buffer, uint32_t windowCount);
+
+    std::vector<VkDescriptorBufferInfo> windowInfos_;
+};
+
+// 풀 버퍼를 RGBA32F 텍셀 버퍼로 보는 디스크립터 (버텍스 셰이더의 bonePaletteTexels)
+class BonePaletteTexelView : public Resource
+{
+public:
+    virtual void populateWriteDescriptor(VkWriteDescriptorSet& writeInfo) const override;
+
+private:
+    friend class BonePalettePool;
+    void rebuild(VkBufferView bufferView);
+
+    VkBufferView bufferView_ = VK_NULL_HANDLE;
+};
+
+// 모든 스키닝 인스턴스의 본 팔레트를 담는 공유 버퍼 (영구 매핑, 프레임 인 플라이트 수만큼 슬롯)
+//  - 인스턴스는 allocate()로 자기 본 수만큼 딱 맞는 구간을 받고, 그 위치는 모든 슬롯에서 같고 바뀌지 않습니다.
+//    그래서 GPU 씬 레코드의 팔레트 위치도 고정이고, 컬링이 이번 슬롯의 시작 주소만 더해 본 주소를 만듭니다.
+//  - write()는 CPU 사본에만 쓰고 슬롯마다 더러운 구간을 넓힙니다.
+//    flush()가 이번 슬롯의 더러운 구간을 memcpy 한 번으로 올리므로 인스턴스 수와 관계없이 프레임마다 한 번입니다.
+//  - 슬롯의 펜스를 기다린 뒤 flush()하므로 이전 프레임이 읽는 슬롯은 건드리지 않습니다.
+//  - 용량이 차면 CPU 사본을 두 배로 키우고, 다음 flush()에서 새 버퍼를 만들어 모든 슬롯을 다시 채웁니다.
+//    풀과 뷰를 가리키는 디스크립터 셋은 프레임 슬롯마다 사본이 있어 각 슬롯의 펜스를 기다린 뒤에 새 버퍼로 바뀝니다.
+//    이전 버퍼는 다른 슬롯들이 모두 한 번씩 flush()를 거친 뒤 해제합니다. (flush() 횟수가 아니라 슬롯으로 셉니다)
+//  - 팔레트는 UBO 창(WINDOW_MATRICES개) 경계에 걸치지 않게 잡으므로 BoneBackend 어느 경로로도 읽을 수 있습니다.
+//    풀 자체는 스토리지 버퍼 디스크립터이고, UBO 창 배열과 텍셀 버퍼는 별도 뷰 리소스로 바인딩합니다.
+// 렌더 스레드에서만 사용합니다.
+class BonePalettePool : public Resource
+{
+public:
+    static constexpr uint32_t INITIAL_CAPACITY = 4096;     // 행렬 수 (슬롯당)
+    static constexpr uint32_t WINDOW_MATRICES = 256;       // UBO 창 하나 (16KB, maxUniformBufferRange 최소 보장값)
+    static constexpr uint32_t MAX_UNIFORM_WINDOWS = 128;   // 셰이더의 MAX_BONE_WINDOWS와 같아야 함
+    static constexpr uint32_t CAPACITY_GRANULARITY = WINDOW_MATRICES; // 슬롯 시작이 창 경계(와 오프셋 정렬 제한)에 맞도록
+    static constexpr uint32_t TEXELS_PER_MATRIX = 4;
+    static constexpr uint32_t INVALID_PALETTE = ~0u;
+
+    struct Stats {
+        uint32_t paletteCount = 0;
+        uint32_t matrixCount = 0;
+        uint32_t capacity = 0;
+        VkDeviceSize lastUploadBytes = 0;
+        VkDeviceSize peakUploadBytes = 0;
+        uint32_t growCount = 0;
+    };
+
+    BonePalettePool() = default;
+    ~BonePalettePool();
+
+    BonePalettePool(const BonePalettePool&) = delete;
+    BonePalettePool& operator=(const BonePalettePool&) = delete;
+
+    void initialize(const VulkanContext* context, uint32_t framesInFlight, uint32_t initialCapacity = INITIAL_CAPACITY);
+    void cleanup();
+
+    // 팔레트 첫 행렬의 인덱스 (모든 슬롯 공통)
+    uint32_t allocate(uint32_t boneCount);
+    void write(uint32_t paletteIndex, const glm::mat4* matrices, uint32_t boneCount);
+
+    // 프레임 슬롯의 펜스를 기다린 뒤, 컬링 입력을 만들기 전에 부릅니다.
+    void flush(uint32_t frameIndex);
+
+    // 이번 슬롯의 시작 주소, 팔레트 인덱스 * sizeof(mat4)를 더하면 그 팔레트의 BDA 주소입니다.
+    VkDeviceAddress getFrameAddress() const { return deviceAddress_ + getFrameOffset(); }
+    VkDeviceSize getFrameOffset() const { return static_cast<VkDeviceSize>(capacity_) * sizeof(glm::mat4) * frameIndex_; }
+    // 이번 슬롯 시작의 풀 전체 기준 행렬 인덱스, 팔레트 인덱스를 더하면 디스크립터 백엔드가 읽는 위치입니다.
+    uint32_t getFrameBaseIndex() const { return capacity_ * frameIndex_; }
+    virtual void populateWriteDescriptor(VkWriteDescriptorSet& writeInfo) const override;
+    Resource* getWindowView() { return &windowView_; }
+    Resource* getTexelView() { return &texelView_; }
+
+    // 디바이스 기능과 현재 버퍼 크기로 그 백엔드가 풀 전체를 가리킬 수 있는지 (버퍼가 커지면 바뀔 수 있음)
+    bool isBackendSupported(BoneBackend backend) const;
+    const Stats& getStats() const { return stats_; }
+
+private:
+    struct DeviceBuffer {
+        VkBuffer buffer = VK_NULL_HANDLE;
+        VkBufferView texelView = VK_NULL_HANDLE;
+        MemoryAllocation allocation;
+    };
+
+    struct RetiredBuffer {
+        DeviceBuffer buffer;
+        // 아직 이 버퍼(와 뷰)를 가리키는 디스크립터 사본이 남아 있을 수 있는 프레임 슬롯 (비트마스크)
+        uint32_t pendingFrameMask = 0;
+    };
+
+    // 슬롯마다 아직 올리지 않은 행렬 구간 [begin, end)
+    struct DirtyRange {
+        uint32_t begin = 0;
+        uint32_t end = 0;
+    };
+
+    void growDeviceBuffer();
+    void destroyDeviceBuffer(DeviceBuffer& buffer);
+    void releaseRetiredBuffers();
+    void markDirty(uint32_t begin, uint32_t end);
+
+    uint32_t framesInFlight_ = 0;
+    uint32_t frameIndex_ = 0;
+
+    // CPU 사본 (슬롯 하나 분량), 끝까지 잘라 준 위치가 matrixCount_
+    std::vector<glm::mat4> matrices_;
+    uint32_t matrixCount_ = 0;
+    std::vector<DirtyRange> dirtyRanges_;
+
+    DeviceBuffer buffer_;
+    VkDeviceAddress deviceAddress_ = 0;
+    uint32_t capacity_ = 0;         // 디바이스 버퍼의 슬롯당 행렬 수
+    VkDescriptorBufferInfo bufferInfo_{};
+    BonePaletteWindowView windowView_;
+    BonePaletteTexelView texelView_;
+    uint32_t maxTexelBufferElements_ = 0;
+    std::vector<RetiredBuffer> retiredBuffers_;
+
+    Stats stats_;
+};
@@ -0,0 +1,85 @@
+#include "CommandBufferCache.h"
+#include "VulkanContext.h"
+#include <stdexcept>
+
+CommandBufferCache::~CommandBufferCache()
+{
+    cleanup();
+}
+
+void CommandBufferCache::initialize(const VulkanContext* context, uint32_t framesInFlight, uint32_t queueFamilyIndex)
+{
+    context_ = context;
+
+    // 다시 기록할 때 버퍼 하나만 리셋하므로 RESET_COMMAND_BUFFER가 필요합니다. (오래 재사용하므로 TRANSIENT는 아님)
+    VkCommandPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    poolInfo.queueFamilyIndex = queueFamilyIndex;
+
+    if (vkCreateCommandPool(context_->getDevice(), &poolInfo, nullptr, &commandPool_) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create command buffer cache pool!");
+    }
+
+    entries_.clear();
+    entries_.resize(framesInFlight);
+}
+
+void CommandBufferCache::cleanup()
+{
+    // 풀을 지우면 거기서 할당한 커맨드 버퍼도 함께 해제됩니다.
+    if (context_ && commandPool_ != VK_NULL_HANDLE) {
+        vkDestroyCommandPool(context_->getDevice(), commandPool_, nullptr);
+        commandPool_ = VK_NULL_HANDLE;
+    }
+    entries_.clear();
+}
+
+VkCommandBuffer CommandBufferCache::acquire(uint32_t frameIndex, uint32_t imageIndex, uint32_t segment, uint64_t version, bool& outNeedsRecording)
+{
+    std::vector<std::vector<Entry>>& frameEntries = entries_[frameIndex];
+    if (imageIndex >= frameEntries.size()) {
+        frameEntries.resize(imageIndex + 1);
+    }
+    std::vector<Entry>& imageEntries = frameEntries[imageIndex];
+    if (segment >= imageEntries.size()) {
+        imageEntries.resize(segment + 1);
+    }
+
+    Entry& entry = imageEntries[segment];
+    if (entry.commandBuffer == VK_NULL_HANDLE) {
+        VkCommandBufferAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.commandPool = commandPool_;
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocInfo.commandBufferCount = 1;
+
+        if (vkAllocateCommandBuffers(context_->getDevice(), &allocInfo, &entry.commandBuffer) != VK_SUCCESS) {
+            throw std::runtime_error("failed to allocate cached command buffer!");
+        }
+    }
+
+    if (entry.recorded && entry.version == version) {
+        hitCount_++;
+        outNeedsRecording = false;
+        return entry.commandBuffer;
+    }
+
+    vkResetCommandBuffer(entry.commandBuffer, 0);
+    entry.version = version;
+    entry.recorded = true;
+    missCount_++;
+    outNeedsRecording = true;
+    return entry.commandBuffer;
+}
+
+void CommandBufferCache::invalidate()
+{
+    for (std::vector<std::vector<Entry>>& frameEntries : entries_) {
+        for (std::vector<Entry>& imageEntries : frameEntries) {
+            for (Entry& entry : imageEntries) {
+                entry.recorded = false;
+            }
+        }
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <vulkan/vulkan.h>
+#include <vector>
+#include <cstdint>
+
+class VulkanContext;
+
+// 한 번 기록한 primary 커맨드 버퍼를 (프레임 인 플라이트 슬롯, 스왑체인 이미지, 렌더 그래프 세그먼트)마다 보관했다가
+// 씬 버전이 같으면 다시 기록하지 않고 그대로 제출합니다.
+//  - 슬롯마다 따로 두므로 펜스 대기 뒤에는 GPU가 그 버퍼를 쓰고 있지 않습니다. (SIMULTANEOUS_USE 불필요)
+//  - 버전은 호출자가 관리하며, 기록된 커맨드가 달라지는 모든 변경(모델/파이프라인/디스크립터 셋/푸시 상수 값)에 올려야 합니다.
+//  - 기록 내용은 프레임마다 바뀌는 값을 버퍼(UBO/SSBO)로만 참조해야 합니다.
+//  - ONE_TIME_SUBMIT secondary나 프레임마다 리셋되는 풀의 secondary를 실행하면 재제출할 수 없으므로 primary에 직접 기록합니다.
+//  - 커맨드 풀은 큐 패밀리마다 따로 있어야 하므로 제출할 큐마다 캐시를 하나씩 둡니다.
+class CommandBufferCache
+{
+public:
+    CommandBufferCache() = default;
+    ~CommandBufferCache();
+
+    CommandBufferCache(const CommandBufferCache&) = delete;
+    CommandBufferCache& operator=(const CommandBufferCache&) = delete;
+
+    void initialize(const VulkanContext* context, uint32_t framesInFlight, uint32_t queueFamilyIndex);
+    void cleanup();
+
+    // 슬롯의 커맨드 버퍼를 반환합니다. 버전이 다르면 리셋한 상태로 돌려주고 outNeedsRecording을 true로 설정합니다.
+    // (호출자가 vkBeginCommandBuffer부터 기록) 스왑체인 이미지 수나 세그먼트 수가 늘면 자동으로 슬롯을 늘립니다.
+    // segment는 이 큐에 제출하는 세그먼트 중 몇 번째인지입니다.
+    VkCommandBuffer acquire(uint32_t frameIndex, uint32_t imageIndex, uint32_t segment, uint64_t version, bool& outNeedsRecording);
+    // 모든 슬롯을 다음 acquire에서 다시 기록하게 합니다.
+    void invalidate();
+
+    uint64_t getHitCount() const { return hitCount_; }
+    uint64_t getMissCount() const { return missCount_; }
+
+private:
+    struct Entry {
+        VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+        uint64_t version = 0;
+        bool recorded = false;
+    };
+
+    const VulkanContext* context_ = nullptr;
+    VkCommandPool commandPool_ = VK_NULL_HANDLE;
+    // [frame][image][segment]
+    std::vector<std::vector<std::vector<Entry>>> entries_;
+
+    uint64_t hitCount_ = 0;
+    uint64_t missCount_ = 0;
+};
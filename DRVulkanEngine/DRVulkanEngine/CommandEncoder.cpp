@@ -0,0 +1,222 @@
+#include "CommandEncoder.h"
+#include <cstring>
+#include <algorithm>
+
+uint32_t CommandEncoder::Stats::getIssuedCount() const
+{
+    return pipelineBinds + descriptorSetBinds + vertexBufferBinds + indexBufferBinds + pushConstants + draws + dispatches;
+}
+
+uint32_t CommandEncoder::Stats::getSkippedCount() const
+{
+    return pipelineBindsSkipped + descriptorSetBindsSkipped + vertexBufferBindsSkipped + indexBufferBindsSkipped + pushConstantsSkipped;
+}
+
+CommandEncoder::Stats& CommandEncoder::Stats::operator+=(const Stats& other)
+{
+    pipelineBinds += other.pipelineBinds;
+    pipelineBindsSkipped += other.pipelineBindsSkipped;
+    descriptorSetBinds += other.descriptorSetBinds;
+    descriptorSetBindsSkipped += other.descriptorSetBindsSkipped;
+    vertexBufferBinds += other.vertexBufferBinds;
+    vertexBufferBindsSkipped += other.vertexBufferBindsSkipped;
+    indexBufferBinds += other.indexBufferBinds;
+    indexBufferBindsSkipped += other.indexBufferBindsSkipped;
+    pushConstants += other.pushConstants;
+    pushConstantsSkipped += other.pushConstantsSkipped;
+    draws += other.draws;
+    dispatches += other.dispatches;
+    return *this;
+}
+
+void CommandEncoder::begin(VkCommandBuffer commandBuffer)
+{
+    commandBuffer_ = commandBuffer;
+    invalidate();
+}
+
+void CommandEncoder::invalidate()
+{
+    bindPoints_ = {};
+    vertexBindings_ = {};
+    indexBuffer_ = VK_NULL_HANDLE;
+    indexOffset_ = 0;
+    indexType_ = VK_INDEX_TYPE_UINT32;
+    pushConstantLayout_ = VK_NULL_HANDLE;
+    pushConstantEntryCount_ = 0;
+}
+
+uint32_t CommandEncoder::toBindPointIndex(VkPipelineBindPoint bindPoint)
+{
+    return bindPoint == VK_PIPELINE_BIND_POINT_COMPUTE ? 1 : 0;
+}
+
+void CommandEncoder::bindPipeline(VkPipelineBindPoint bindPoint, VkPipeline pipeline)
+{
+    BindPointState& state = bindPoints_[toBindPointIndex(bindPoint)];
+    if (state.pipeline == pipeline) {
+        stats_.pipelineBindsSkipped++;
+        return;
+    }
+
+    // 파이프라인을 바꿔도 바인딩된 디스크립터 셋은 레이아웃이 호환되는 한 유지됩니다.
+    vkCmdBindPipeline(commandBuffer_, bindPoint, pipeline);
+    state.pipeline = pipeline;
+    stats_.pipelineBinds++;
+}
+
+void CommandEncoder::bindDescriptorSets(VkPipelineBindPoint bindPoint, VkPipelineLayout layout,
+    uint32_t firstSet, uint32_t setCount, const VkDescriptorSet* descriptorSets,
+    uint32_t dynamicOffsetCount, const uint32_t* dynamicOffsets)
+{
+    if (setCount == 0) {
+        return;
+    }
+
+    BindPointState& state = bindPoints_[toBindPointIndex(bindPoint)];
+    bool tracked = firstSet + setCount <= MAX_DESCRIPTOR_SETS && dynamicOffsetCount <= MAX_DYNAMIC_OFFSETS;
+    if (tracked && (state.dynamicOffsetCount > 0 || dynamicOffsetCount > 0)) {
+        // 동적 오프셋은 셋 범위에 걸려 있으므로 같은 범위를 같은 오프셋으로 다시 바인딩할 때만 건너뜁니다.
+        tracked = state.dynamicFirstSet == firstSet && state.dynamicSetCount == setCount &&
+            state.dynamicOffsetCount == dynamicOffsetCount &&
+            std::equal(dynamicOffsets, dynamicOffsets + dynamicOffsetCount, state.dynamicOffsets.begin());
+    }
+    if (tracked) {
+        bool redundant = true;
+        for (uint32_t i = 0; i < setCount; ++i) {
+            const BoundSet& bound = state.sets[firstSet + i];
+            if (bound.layout != layout || bound.set != descriptorSets[i]) {
+                redundant = false;
+                break;
+            }
+        }
+        if (redundant) {
+            stats_.descriptorSetBindsSkipped++;
+            return;
+        }
+    }
+
+    vkCmdBindDescriptorSets(commandBuffer_, bindPoint, layout, firstSet, setCount, descriptorSets, dynamicOffsetCount, dynamicOffsets);
+    stats_.descriptorSetBinds++;
+
+    state.dynamicFirstSet = firstSet;
+    state.dynamicSetCount = setCount;
+    state.dynamicOffsetCount = std::min(dynamicOffsetCount, MAX_DYNAMIC_OFFSETS);
+    std::copy(dynamicOffsets, dynamicOffsets + state.dynamicOffsetCount, state.dynamicOffsets.begin());
+
+    // 다른 레이아웃으로 바인딩하면 범위 밖의 셋도 흐트러질 수 있으므로 레이아웃이 다른 기록은 지웁니다.
+    for (uint32_t i = 0; i < MAX_DESCRIPTOR_SETS; ++i) {
+        bool inRange = i >= firstSet && i < firstSet + setCount;
+        if (inRange) {
+            state.sets[i] = { layout, descriptorSets[i - firstSet] };
+        }
+        else if (state.sets[i].layout != layout) {
+            state.sets[i] = {};
+        }
+    }
+}
+
+void CommandEncoder::bindVertexBuffer(uint32_t binding, VkBuffer buffer, VkDeviceSize offset)
+{
+    if (binding < MAX_VERTEX_BINDINGS) {
+        VertexBinding& bound = vertexBindings_[binding];
+        if (bound.buffer == buffer && bound.offset == offset) {
+            stats_.vertexBufferBindsSkipped++;
+            return;
+        }
+        bound = { buffer, offset };
+    }
+
+    vkCmdBindVertexBuffers(commandBuffer_, binding, 1, &buffer, &offset);
+    stats_.vertexBufferBinds++;
+}
+
+void CommandEncoder::bindIndexBuffer(VkBuffer buffer, VkDeviceSize offset, VkIndexType indexType)
+{
+    if (indexBuffer_ == buffer && indexOffset_ == offset && indexType_ == indexType) {
+        stats_.indexBufferBindsSkipped++;
+        return;
+    }
+
+    vkCmdBindIndexBuffer(commandBuffer_, buffer, offset, indexType);
+    indexBuffer_ = buffer;
+    indexOffset_ = offset;
+    indexType_ = indexType;
+    stats_.indexBufferBinds++;
+}
+
+void CommandEncoder::pushConstants(VkPipelineLayout layout, VkShaderStageFlags stageFlags, uint32_t offset, uint32_t size, const void* data)
+{
+    if (layout != pushConstantLayout_) {
+        pushConstantLayout_ = layout;
+        pushConstantEntryCount_ = 0;
+    }
+
+    bool trackable = offset + size <= MAX_PUSH_CONSTANT_BYTES;
+    PushConstantEntry* entry = nullptr;
+    if (trackable) {
+        for (uint32_t i = 0; i < pushConstantEntryCount_; ++i) {
+            PushConstantEntry& candidate = pushConstantEntries_[i];
+            if (candidate.stageFlags == stageFlags && candidate.offset == offset && candidate.size == size) {
+                if (std::memcmp(candidate.bytes.data(), data, size) == 0) {
+                    stats_.pushConstantsSkipped++;
+                    return;
+                }
+                entry = &candidate;
+                break;
+            }
+        }
+    }
+
+    vkCmdPushConstants(commandBuffer_, layout, stageFlags, offset, size, data);
+    stats_.pushConstants++;
+
+    if (!trackable) {
+        return;
+    }
+    if (!entry) {
+        // 범위가 겹치는 기록은 값이 바뀌었을 수 있으므로 지웁니다.
+        uint32_t kept = 0;
+        for (uint32_t i = 0; i < pushConstantEntryCount_; ++i) {
+            const PushConstantEntry& candidate = pushConstantEntries_[i];
+            bool overlaps = candidate.offset < offset + size && offset < candidate.offset + candidate.size;
+            if (!overlaps) {
+                pushConstantEntries_[kept++] = candidate;
+            }
+        }
+        pushConstantEntryCount_ = kept;
+        if (pushConstantEntryCount_ == MAX_PUSH_CONSTANT_ENTRIES) {
+            return;
+        }
+        entry = &pushConstantEntries_[pushConstantEntryCount_++];
+        entry->stageFlags = stageFlags;
+        entry->offset = offset;
+        entry->size = size;
+    }
+    std::memcpy(entry->bytes.data(), data, size);
+}
+
+void CommandEncoder::draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance)
+{
+    vkCmdDraw(commandBuffer_, vertexCount, instanceCount, firstVertex, firstInstance);
+    stats_.draws++;
+}
+
+void CommandEncoder::drawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance)
+{
+    vkCmdDrawIndexed(commandBuffer_, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+    stats_.draws++;
+}
+
+void CommandEncoder::drawIndexedIndirectCount(VkBuffer buffer, VkDeviceSize offset, VkBuffer countBuffer, VkDeviceSize countBufferOffset,
+    uint32_t maxDrawCount, uint32_t stride)
+{
+    vkCmdDrawIndexedIndirectCount(commandBuffer_, buffer, offset, countBuffer, countBufferOffset, maxDrawCount, stride);
+    stats_.draws++;
+}
+
+void CommandEncoder::dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ)
+{
+    vkCmdDispatch(commandBuffer_, groupCountX, groupCountY, groupCountZ);
+    stats_.dispatches++;
+}
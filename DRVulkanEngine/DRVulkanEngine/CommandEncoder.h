@@ -0,0 +1,112 @@
+#pragma once
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <array>
+
+// 커맨드 버퍼 위의 얇은 래퍼, 마지막으로 바인딩한 상태를 기억해 같은 값을 다시 보내는 vkCmd* 호출을 건너뜁니다.
+//  - 파이프라인 (바인드 포인트별)
+//  - 디스크립터 셋 (같은 파이프라인 레이아웃으로 바인딩된 셋만 호환으로 봅니다, 동적 오프셋이 있으면 오프셋까지 같아야 함)
+//  - 정점/인덱스 버퍼
+//  - 푸시 상수 (레이아웃/스테이지/범위/바이트가 모두 같을 때)
+// 새 커맨드 버퍼는 아무 상태도 없으므로 begin()마다 기록을 지웁니다.
+// 인코더를 거치지 않고 vkCmd*를 직접 기록했다면 invalidate()를 불러야 합니다.
+class CommandEncoder
+{
+public:
+    static constexpr uint32_t MAX_DESCRIPTOR_SETS = 8;
+    static constexpr uint32_t MAX_DYNAMIC_OFFSETS = 8;
+    static constexpr uint32_t MAX_VERTEX_BINDINGS = 4;
+    static constexpr uint32_t MAX_PUSH_CONSTANT_BYTES = 128; // 스펙이 보장하는 최소값
+    static constexpr uint32_t MAX_PUSH_CONSTANT_ENTRIES = 4;
+
+    // 실제로 기록한 호출 수와 중복이라 건너뛴 호출 수
+    struct Stats {
+        uint32_t pipelineBinds = 0;
+        uint32_t pipelineBindsSkipped = 0;
+        uint32_t descriptorSetBinds = 0;
+        uint32_t descriptorSetBindsSkipped = 0;
+        uint32_t vertexBufferBinds = 0;
+        uint32_t vertexBufferBindsSkipped = 0;
+        uint32_t indexBufferBinds = 0;
+        uint32_t indexBufferBindsSkipped = 0;
+        uint32_t pushConstants = 0;
+        uint32_t pushConstantsSkipped = 0;
+        uint32_t draws = 0;
+        uint32_t dispatches = 0;
+
+        uint32_t getIssuedCount() const;
+        uint32_t getSkippedCount() const;
+        Stats& operator+=(const Stats& other);
+    };
+
+    CommandEncoder() = default;
+    explicit CommandEncoder(VkCommandBuffer commandBuffer) { begin(commandBuffer); }
+
+    void begin(VkCommandBuffer commandBuffer);
+    void invalidate();
+
+    VkCommandBuffer getCommandBuffer() const { return commandBuffer_; }
+    const Stats& getStats() const { return stats_; }
+    void resetStats() { stats_ = Stats{}; }
+
+    void bindPipeline(VkPipelineBindPoint bindPoint, VkPipeline pipeline);
+    void bindDescriptorSets(VkPipelineBindPoint bindPoint, VkPipelineLayout layout,
+        uint32_t firstSet, uint32_t setCount, const VkDescriptorSet* descriptorSets,
+        uint32_t dynamicOffsetCount = 0, const uint32_t* dynamicOffsets = nullptr);
+    void bindVertexBuffer(uint32_t binding, VkBuffer buffer, VkDeviceSize offset = 0);
+    void bindIndexBuffer(VkBuffer buffer, VkDeviceSize offset, VkIndexType indexType);
+    void pushConstants(VkPipelineLayout layout, VkShaderStageFlags stageFlags, uint32_t offset, uint32_t size, const void* data);
+
+    void draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance);
+    void drawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance);
+    void drawIndexedIndirectCount(VkBuffer buffer, VkDeviceSize offset, VkBuffer countBuffer, VkDeviceSize countBufferOffset,
+        uint32_t maxDrawCount, uint32_t stride);
+    void dispatch(uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ);
+
+private:
+    // 그래픽스 / 컴퓨트
+    static constexpr uint32_t BIND_POINT_COUNT = 2;
+
+    struct BoundSet {
+        VkPipelineLayout layout = VK_NULL_HANDLE;
+        VkDescriptorSet set = VK_NULL_HANDLE;
+    };
+
+    struct BindPointState {
+        VkPipeline pipeline = VK_NULL_HANDLE;
+        std::array<BoundSet, MAX_DESCRIPTOR_SETS> sets{};
+        // 마지막 바인딩 호출의 동적 오프셋 (같은 셋 범위를 다시 바인딩할 때만 비교합니다)
+        uint32_t dynamicFirstSet = 0;
+        uint32_t dynamicSetCount = 0;
+        uint32_t dynamicOffsetCount = 0;
+        std::array<uint32_t, MAX_DYNAMIC_OFFSETS> dynamicOffsets{};
+    };
+
+    struct VertexBinding {
+        VkBuffer buffer = VK_NULL_HANDLE;
+        VkDeviceSize offset = 0;
+    };
+
+    struct PushConstantEntry {
+        VkShaderStageFlags stageFlags = 0;
+        uint32_t offset = 0;
+        uint32_t size = 0;
+        std::array<uint8_t, MAX_PUSH_CONSTANT_BYTES> bytes{};
+    };
+
+    static uint32_t toBindPointIndex(VkPipelineBindPoint bindPoint);
+
+    VkCommandBuffer commandBuffer_ = VK_NULL_HANDLE;
+    std::array<BindPointState, BIND_POINT_COUNT> bindPoints_{};
+    std::array<VertexBinding, MAX_VERTEX_BINDINGS> vertexBindings_{};
+    VkBuffer indexBuffer_ = VK_NULL_HANDLE;
+    VkDeviceSize indexOffset_ = 0;
+    VkIndexType indexType_ = VK_INDEX_TYPE_UINT32;
+
+    // 푸시 상수 값은 레이아웃이 바뀌면 보장되지 않으므로 레이아웃 하나에 대해서만 기억합니다.
+    VkPipelineLayout pushConstantLayout_ = VK_NULL_HANDLE;
+    std::array<PushConstantEntry, MAX_PUSH_CONSTANT_ENTRIES> pushConstantEntries_{};
+    uint32_t pushConstantEntryCount_ = 0;
+
+    Stats stats_;
+};
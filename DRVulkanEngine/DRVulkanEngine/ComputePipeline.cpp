@@ -0,0 +1,132 @@
+#include "ComputePipeline.h"
+#include "VulkanContext.h"
+#include "Shader.h"
+#include "ShaderManager.h"
+#include "DescriptorPool.h"
+#include "DescriptorSet.h"
+#include "CommandEncoder.h"
+#include <stdexcept>
+
+ComputePipeline::~ComputePipeline() {
+    cleanup();
+}
+
+void ComputePipeline::initialize(const VulkanContext* vulkanContext,
+    DescriptorPool* descriptorPool,
+    ShaderManager* shaderMgr,
+    const std::string& computeShaderPath)
+{
+    context_ = vulkanContext;
+    descriptorPool_ = descriptorPool;
+    shaderMgr_ = shaderMgr;
+
+    Shader* computeShader = shaderMgr_->getShader(computeShaderPath);
+    createPipelineLayout(computeShader);
+    createComputePipeline(computeShader);
+}
+
+void ComputePipeline::createPipelineLayout(const Shader* shader) {
+    for (const auto& [setNumber, bindings] : shader->descriptorSetLayouts_) {
+        for (const auto& binding : bindings) {
+            descriptorSetLayoutBindingMap_[setNumber][binding.bindingInfo.binding] = binding;
+        }
+    }
+
+    std::vector<VkDescriptorSetLayout> descriptorSetLayouts(descriptorSetLayoutBindingMap_.size());
+    for (const auto& [setNumber, bindingsMap] : descriptorSetLayoutBindingMap_) {
+        std::vector<VkDescriptorSetLayoutBinding> bindings;
+        for (const auto& [bindingNumber, bindingInfo] : bindingsMap) {
+            bindings.push_back(bindingInfo.bindingInfo);
+        }
+        descriptorSetLayouts[setNumber] = descriptorPool_->layoutCache_.getLayout(bindings);
+    }
+
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+    pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipelineLayoutInfo.setLayoutCount = static_cast<uint32_t>(descriptorSetLayouts.size());
+    pipelineLayoutInfo.pSetLayouts = descriptorSetLayouts.empty() ? nullptr : descriptorSetLayouts.data();
+    pipelineLayoutInfo.pushConstantRangeCount = static_cast<uint32_t>(shader->pushConstantRanges_.size());
+    pipelineLayoutInfo.pPushConstantRanges = shader->pushConstantRanges_.empty() ? nullptr : shader->pushConstantRanges_.data();
+
+    if (vkCreatePipelineLayout(context_->getDevice(), &pipelineLayoutInfo, nullptr, &pipelineLayout_) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create compute pipeline layout!");
+    }
+}
+
+void ComputePipeline::createComputePipeline(const Shader* shader) {
+    VkComputePipelineCreateInfo pipelineInfo{};
+    pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipelineInfo.stage = shader->stageInfo_;
+    pipelineInfo.layout = pipelineLayout_;
+
+    if (vkCreateComputePipelines(context_->getDevice(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &computePipeline_) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create compute pipeline!");
+    }
+}
+
+void ComputePipeline::cleanup() {
+    if (!context_ || !context_->getDevice()) {
+        return;
+    }
+
+    if (computePipeline_ != VK_NULL_HANDLE) {
+        vkDestroyPipeline(context_->getDevice(), computePipeline_, nullptr);
+        computePipeline_ = VK_NULL_HANDLE;
+    }
+
+    if (pipelineLayout_ != VK_NULL_HANDLE) {
+        vkDestroyPipelineLayout(context_->getDevice(), pipelineLayout_, nullptr);
+        pipelineLayout_ = VK_NULL_HANDLE;
+    }
+}
+
+void ComputePipeline::setDescriptorSets(const std::vector<DescriptorSet>& inDescriptorSet)
+{
+    descriptorSets_ = inDescriptorSet;
+
+    frameDescriptorSetHandles_.clear();
+    if (descriptorSets_.empty()) {
+        return;
+    }
+    frameDescriptorSetHandles_.resize(descriptorSets_.front().getFrameCount());
+    for (uint32_t frameIndex = 0; frameIndex < frameDescriptorSetHandles_.size(); ++frameIndex)
+    {
+        for (const DescriptorSet& ds : descriptorSets_)
+        {
+            frameDescriptorSetHandles_[frameIndex].push_back(ds.getHandle(frameIndex));
+        }
+    }
+}
+
+void ComputePipeline::bindPipeline(VkCommandBuffer commandBuffer, uint32_t frameIndex)
+{
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computePipeline_);
+
+    // BDA만 쓰는 컴퓨트 셰이더는 디스크립터 셋이 없습니다.
+    if (frameDescriptorSetHandles_.empty()) {
+        return;
+    }
+    const std::vector<VkDescriptorSet>& descriptorSetHandles = frameDescriptorSetHandles_[frameIndex];
+
+    vkCmdBindDescriptorSets(
+        commandBuffer,
+        VK_PIPELINE_BIND_POINT_COMPUTE,
+        pipelineLayout_,
+        0,
+        static_cast<uint32_t>(descriptorSetHandles.size()),
+        descriptorSetHandles.data(),
+        0,
+        nullptr
+    );
+}
+
+void ComputePipeline::bindPipeline(CommandEncoder& encoder, uint32_t frameIndex)
+{
+    encoder.bindPipeline(VK_PIPELINE_BIND_POINT_COMPUTE, computePipeline_);
+    if (frameDescriptorSetHandles_.empty()) {
+        return;
+    }
+    const std::vector<VkDescriptorSet>& descriptorSetHandles = frameDescriptorSetHandles_[frameIndex];
+    encoder.bindDescriptorSets(VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout_, 0,
+        static_cast<uint32_t>(descriptorSetHandles.size()), descriptorSetHandles.data());
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <vector>
+#include <string>
+#include <map>
+#include "Shader.h"
+
+class VulkanContext;
+class ShaderManager;
+class DescriptorPool;
+class DescriptorSet;
+class CommandEncoder;
+
+// 컴퓨트 셰이더 하나로 만드는 파이프라인
+// VulkanPipeline과 같이 리플렉션 결과로 디스크립터 셋 레이아웃과 푸시 상수 범위를 만듭니다.
+class ComputePipeline {
+public:
+    ComputePipeline() = default;
+    ~ComputePipeline();
+
+    ComputePipeline(const ComputePipeline&) = delete;
+    ComputePipeline& operator=(const ComputePipeline&) = delete;
+
+    void initialize(const VulkanContext* vulkanContext,
+        DescriptorPool* descriptorPool,
+        ShaderManager* shaderMgr,
+        const std::string& computeShaderPath);
+
+    void cleanup();
+    // frameIndex의 디스크립터 셋 사본을 바인딩합니다. (셋이 없는 파이프라인은 무시)
+    void bindPipeline(VkCommandBuffer commandBuffer, uint32_t frameIndex = 0);
+    void bindPipeline(CommandEncoder& encoder, uint32_t frameIndex = 0);
+
+    VkPipeline getComputePipeline() const { return computePipeline_; }
+    VkPipelineLayout getPipelineLayout() const { return pipelineLayout_; }
+    const std::map<uint32_t, std::map<uint32_t, LayoutBindingInfo>>& GetDescriptorSetLayoutBindingMap() { return descriptorSetLayoutBindingMap_; };
+
+    bool isValid() const { return computePipeline_ != VK_NULL_HANDLE; }
+    void setDescriptorSets(const std::vector<DescriptorSet>& inDescriptorSet);
+private:
+    void createPipelineLayout(const Shader* shader);
+    void createComputePipeline(const Shader* shader);
+private:
+    VkPipelineLayout pipelineLayout_ = VK_NULL_HANDLE;
+    VkPipeline computePipeline_ = VK_NULL_HANDLE;
+
+    const VulkanContext* context_ = nullptr;
+    ShaderManager* shaderMgr_ = nullptr;
+    DescriptorPool* descriptorPool_ = nullptr;
+
+    // Set Index -> Binding Indexes
+    std::map<uint32_t, std::map<uint32_t, LayoutBindingInfo>> descriptorSetLayoutBindingMap_;
+
+    std::vector<DescriptorSet> descriptorSets_;
+    // 프레임 -> 셋 순서의 핸들
+    std::vector<std::vector<VkDescriptorSet>> frameDescriptorSetHandles_;
+};
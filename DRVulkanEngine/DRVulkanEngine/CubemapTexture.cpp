@@ -1,5 +1,6 @@
 #include "CubemapTexture.h"
 #include "VulkanContext.h"
+#include "UploadManager.h"
 #include <stdexcept>
 #include <cmath>
 #include <algorithm>
@@ -34,7 +35,7 @@ CubemapTexture::~CubemapTexture() {
     if (context && context->getDevice()) {
         vkDestroyImageView(context->getDevice(), cubemapView_, nullptr);
         vkDestroyImage(context->getDevice(), cubemapImage_, nullptr);
-        vkFreeMemory(context->getDevice(), cubemapMemory_, nullptr);
+        context->getMemoryAllocator().free(cubemapAllocation_);
         vkDestroySampler(context->getDevice(), cubemapSampler_, nullptr);
     }
 }
@@ -95,42 +96,21 @@ void CubemapTexture::createFromSixImages(const std::array<std::string, 6>& cubeF
     VkDeviceSize imageSize = cubemapSize_ * cubemapSize_ * 4; // RGBA
     VkDeviceSize totalSize = imageSize * CUBE_FACES;
 
-    VkBuffer stagingBuffer;
-    VkDeviceMemory stagingBufferMemory;
-    
-    createBuffer(totalSize,
-                VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                stagingBuffer,
-                stagingBufferMemory);
-
-    // �� ť�� ���̽� �ε� �� ������¡ ���ۿ� ����
-    void* data;
-    vkMapMemory(context->getDevice(), stagingBufferMemory, 0, totalSize, 0, &data);
+    std::vector<unsigned char> cubemapData(totalSize);
 
     for (int face = 0; face < CUBE_FACES; ++face) {
         int imgWidth, imgHeight, imgChannels;
         unsigned char* faceData = stbi_load(cubeFaces[face].c_str(), &imgWidth, &imgHeight, &imgChannels, 4);
         if (!faceData) {
-            vkUnmapMemory(context->getDevice(), stagingBufferMemory);
             throw std::runtime_error("Failed to load cube face: " + cubeFaces[face]);
         }
 
-        memcpy(static_cast<char*>(data) + face * imageSize, faceData, imageSize);
+        memcpy(cubemapData.data() + face * imageSize, faceData, imageSize);
         stbi_image_free(faceData);
     }
 
-    vkUnmapMemory(context->getDevice(), stagingBufferMemory);
-
-    // �̹��� ���̾ƿ� ��ȯ �� ������ ����
-    transitionImageLayout(VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-    copyBufferToCubemap(stagingBuffer, cubemapSize_, cubemapSize_, false); // LDR �̹���
-    // VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL -> VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL_KHR
-    transitionImageLayout(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL_KHR);
-
-    // ������¡ ���� ����
-    vkDestroyBuffer(context->getDevice(), stagingBuffer, nullptr);
-    vkFreeMemory(context->getDevice(), stagingBufferMemory, nullptr);
+    // 복사와 레이아웃 전환은 업로드 매니저가 스테이징 링을 거쳐 배치에 기록합니다.
+    uploadCubemap(cubemapData.data(), cubemapSize_, cubemapSize_, false); // LDR
 
     // �̹��� ��� ���÷� ����
     createCubemapImageView(VK_FORMAT_R8G8B8A8_SRGB);
@@ -201,30 +181,8 @@ void CubemapTexture::convertEquirectangularToCubemap(float* hdrData, int hdrWidt
         }
     }
     
-    // ������¡ ���� ���� �� ������ ����
-    VkBuffer stagingBuffer;
-    VkDeviceMemory stagingBufferMemory;
-    
-    createBuffer(totalSize,
-                VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                stagingBuffer,
-                stagingBufferMemory);
-
-    void* data;
-    vkMapMemory(context->getDevice(), stagingBufferMemory, 0, totalSize, 0, &data);
-    memcpy(data, cubemapData.data(), totalSize);
-    vkUnmapMemory(context->getDevice(), stagingBufferMemory);
-
-    // �̹��� ���̾ƿ� ��ȯ �� ������ ����
-    transitionImageLayout(VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-    copyBufferToCubemap(stagingBuffer, cubemapSize, cubemapSize, true); // HDR �̹���
-    // VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL -> VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL_KHR
-    transitionImageLayout(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL_KHR);
-
-    // ������¡ ���� ����
-    vkDestroyBuffer(context->getDevice(), stagingBuffer, nullptr);
-    vkFreeMemory(context->getDevice(), stagingBufferMemory, nullptr);
+    // 복사와 레이아웃 전환은 업로드 매니저가 스테이징 링을 거쳐 배치에 기록합니다.
+    uploadCubemap(cubemapData.data(), cubemapSize, cubemapSize, true); // HDR
 }
 
 void CubemapTexture::getCubeFaceDirection(int face, float u, float v, float& x, float& y, float& z) const {
@@ -290,19 +248,7 @@ void CubemapTexture::createCubemapImage(uint32_t width, uint32_t height, VkForma
         throw std::runtime_error("failed to create cubemap image!");
     }
 
-    VkMemoryRequirements memRequirements;
-    vkGetImageMemoryRequirements(context->getDevice(), cubemapImage_, &memRequirements);
-
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = context->findMemoryType(memRequirements.memoryTypeBits, properties);
-
-    if (vkAllocateMemory(context->getDevice(), &allocInfo, nullptr, &cubemapMemory_) != VK_SUCCESS) {
-        throw std::runtime_error("failed to allocate cubemap memory!");
-    }
-
-    vkBindImageMemory(context->getDevice(), cubemapImage_, cubemapMemory_, 0);
+    cubemapAllocation_ = context->getMemoryAllocator().allocateForImage(cubemapImage_, properties);
 }
 
 void CubemapTexture::createCubemapImageView(VkFormat format) {
@@ -354,81 +300,8 @@ void CubemapTexture::createCubemapSampler() {
     }
 }
 
-void CubemapTexture::transitionImageLayout(VkImageLayout oldLayout, VkImageLayout newLayout) {
-    VkCommandBuffer commandBuffer = beginSingleTimeCommands();
-
-    VkImageMemoryBarrier barrier{};
-    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-    barrier.oldLayout = oldLayout;
-    barrier.newLayout = newLayout;
-    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    barrier.image = cubemapImage_;
-    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    barrier.subresourceRange.baseMipLevel = 0;
-    barrier.subresourceRange.levelCount = 1;
-    barrier.subresourceRange.baseArrayLayer = 0;
-    barrier.subresourceRange.layerCount = 6; // 6�� ���̾� ���
-
-    VkPipelineStageFlags sourceStage;
-    VkPipelineStageFlags destinationStage;
-
-    if (oldLayout == VK_IMAGE_LAYOUT_UNDEFINED && newLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL) {
-        barrier.srcAccessMask = 0;
-        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-        sourceStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-        destinationStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-    }
-    else if (oldLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL && newLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL) {
-        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-        sourceStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-        destinationStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-    }
-    // 1. �ʱ�ȭ -> ���� ����ġ��Ʈ (Dynamic Rendering��)
-    else if (oldLayout == VK_IMAGE_LAYOUT_UNDEFINED && newLayout == VK_IMAGE_LAYOUT_ATTACHMENT_OPTIMAL_KHR) {
-        barrier.srcAccessMask = 0;
-        // �÷��� ����/���ٽ� ��ο� ������ �� �ֵ��� ��Ʈ ����
-        barrier.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-        sourceStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-        destinationStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
-    }
-    // 2. ���� �Ϸ� -> ���� �б� ���� (���ø�, �Է� ÷�ι� ��)
-    else if (oldLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL && newLayout == VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL_KHR) {
-        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-        sourceStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-        destinationStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-    }
-    // 3. ������ �Ϸ�(Attachment) -> ���� �н����� �б�(Read Only)
-    else if (oldLayout == VK_IMAGE_LAYOUT_ATTACHMENT_OPTIMAL_KHR && newLayout == VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL_KHR) {
-        barrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-        sourceStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
-        destinationStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-    }
-    else if (oldLayout == VK_IMAGE_LAYOUT_UNDEFINED && newLayout == VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL) {
-        barrier.srcAccessMask = 0;
-        barrier.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-        sourceStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-        destinationStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-    }
-    else if (oldLayout == VK_IMAGE_LAYOUT_UNDEFINED && newLayout == VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL) {
-        barrier.srcAccessMask = 0;
-        barrier.dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-        sourceStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-        destinationStage = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
-    }
-    else {
-        throw std::invalid_argument("unsupported layout transition!");
-    }
-
-    vkCmdPipelineBarrier(commandBuffer, sourceStage, destinationStage, 0, 0, nullptr, 0, nullptr, 1, &barrier);
-    endSingleTimeCommands(commandBuffer);
-}
-
-void CubemapTexture::copyBufferToCubemap(VkBuffer buffer, uint32_t width, uint32_t height, bool isHDR) {
-    VkCommandBuffer commandBuffer = beginSingleTimeCommands();
+void CubemapTexture::uploadCubemap(const void* data, uint32_t width, uint32_t height, bool isHDR) {
+    VkImageSubresourceRange range{ VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, CUBE_FACES };
 
     std::vector<VkBufferImageCopy> regions(CUBE_FACES);
     VkDeviceSize faceSize = width * height * 4 * (isHDR ? sizeof(float) : sizeof(unsigned char));
@@ -445,11 +318,8 @@ void CubemapTexture::copyBufferToCubemap(VkBuffer buffer, uint32_t width, uint32
         regions[face].imageExtent = {width, height, 1};
     }
 
-    vkCmdCopyBufferToImage(commandBuffer, buffer, cubemapImage_, 
-                          VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 
-                          CUBE_FACES, regions.data());
-
-    endSingleTimeCommands(commandBuffer);
+    context->getUploadManager().uploadImage(cubemapImage_, range, regions, VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL_KHR,
+        data, faceSize * CUBE_FACES);
 }
 
 void CubemapTexture::populateWriteDescriptor(VkWriteDescriptorSet& writeInfo) const {
@@ -40,11 +40,8 @@ private:
     // ť ÷ 
     void createCubemapSampler();
     
-    // ̹ ̾ƿ ȯ
-    void transitionImageLayout(VkImageLayout oldLayout, VkImageLayout newLayout);
-    
-    // ۿ ť  
-    void copyBufferToCubemap(VkBuffer buffer, uint32_t width, uint32_t height, bool isHDR = false);
+    // 6 ̽ ̾  ȼ ͸ ť ε (ε Ŵ ¡   ġ )
+    void uploadCubemap(const void* data, uint32_t width, uint32_t height, bool isHDR = false);
     
     //  ǥ ť ǥ ȯϴ ƿƼ Լ
     struct CubeCoord {
@@ -58,7 +55,7 @@ private:
 
 private:
     VkImage cubemapImage_;
-    VkDeviceMemory cubemapMemory_;
+    MemoryAllocation cubemapAllocation_;
     VkImageView cubemapView_;
     VkSampler cubemapSampler_;
     
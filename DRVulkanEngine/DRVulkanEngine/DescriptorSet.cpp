@@ -5,57 +5,63 @@
 #include <stdexcept>
 #include <vector>
 
-void DescriptorSet::initialize(VulkanContext* inContext, DescriptorPool* inDescriptorPool, VkDescriptorSetLayout inDescriptorSetLayout, const std::vector<Resource*>& inResources)
+void DescriptorSet::initialize(VulkanContext* inContext, DescriptorPool* inDescriptorPool, VkDescriptorSetLayout inDescriptorSetLayout, const std::vector<Resource*>& inResources, uint32_t frameCount)
 {
     context_ = inContext;
 	resources_ = inResources;
     // 1. Ǵ Ǯ(Pool)κ ũ  Ҵ޽ϴ.
     //    VulkanContext DescriptorPoolManager  ִٰ մϴ.
-    bool allocated = inDescriptorPool->allocateDescriptorSet(inDescriptorSetLayout, descriptorSet_);
-    if (!allocated) {
-        throw std::runtime_error("Failed to allocate descriptor set from pool!");
-    }
+    descriptorSets_.assign(frameCount, VK_NULL_HANDLE);
+    for (uint32_t frameIndex = 0; frameIndex < frameCount; ++frameIndex) {
+        bool allocated = inDescriptorPool->allocateDescriptorSet(inDescriptorSetLayout, descriptorSets_[frameIndex]);
+        if (!allocated) {
+            throw std::runtime_error("Failed to allocate descriptor set from pool!");
+        }
 
-    // 2. Ҵ ũ ¿  ҽ (Ʈ)մϴ.
-    updateSet(inResources);
+        // 2. Ҵ ũ ¿  ҽ (Ʈ)մϴ.
+        updateSet(frameIndex);
+    }
+    staleFrameMask_ = 0;
 }
 
-void DescriptorSet::updateIfDirty()
+bool DescriptorSet::updateIfDirty(uint32_t frameIndex)
 {
-    bool bNeedsUpdate = false;
     for (const auto& resource : resources_)
     {
         if (resource->IsBufferInfosDirty())
         {
-            bNeedsUpdate = true;
+            staleFrameMask_ = (1u << descriptorSets_.size()) - 1;
             break;
         }
     }
-    if (bNeedsUpdate)
+
+    const uint32_t frameBit = 1u << frameIndex;
+    if ((staleFrameMask_ & frameBit) == 0)
     {
-        updateSet(resources_);
+        return false;
     }
+    updateSet(frameIndex);
+    staleFrameMask_ &= ~frameBit;
+    return true;
 }
 
 
 // User createDescriptorSets() û  Լ 
-void DescriptorSet::updateSet(const std::vector<Resource*>& resources)
+void DescriptorSet::updateSet(uint32_t frameIndex)
 {
     // VkWriteDescriptorSet: " ũ    ε  ҽ "  
     std::vector<VkWriteDescriptorSet> descriptorWrites;
-    descriptorWrites.reserve(resources.size());
+    descriptorWrites.reserve(resources_.size());
 
     int index = 0;
-    for (const auto& resource : resources) {
+    for (const auto& resource : resources_) {
         VkWriteDescriptorSet writeInfo{};
 		resource->populateWriteDescriptor(writeInfo);
         writeInfo.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-        writeInfo.dstSet = descriptorSet_;
+        writeInfo.dstSet = descriptorSets_[frameIndex];
         writeInfo.dstBinding = index++;
         writeInfo.dstArrayElement = 0;
         descriptorWrites.push_back(writeInfo);
-
-        resource->ClearBufferInfosDirty();
     }
 
     // غ   ũ  Ʈ ѹ 
@@ -7,23 +7,34 @@ class VulkanContext;
 class Resource;
 class DescriptorPool;
 
+//  ̾ƿ/ҽ ũ     ŭ ϴ.
+// ҽ ٲ(  )   纻   潺 ٸ ڿ ٽ ϹǷ,
+//  GPU а ִ ٸ    ʽϴ.
 class DescriptorSet
 {
 public:
-    // ũ  ʱȭմϴ. (Ǯ Ҵ & ҽ Ʈ)
-    void initialize(VulkanContext* inContext, DescriptorPool* inDescriptorPool, VkDescriptorSetLayout inDescriptorSetLayout, const std::vector<Resource*>& inResources);
+    // ũ  ʱȭմϴ. (Ǯ  ŭ Ҵ & ҽ Ʈ)
+    void initialize(VulkanContext* inContext, DescriptorPool* inDescriptorPool, VkDescriptorSetLayout inDescriptorSetLayout, const std::vector<Resource*>& inResources, uint32_t frameCount);
 
     // Vulkan ڵ  Getter
-    VkDescriptorSet getHandle() const { return descriptorSet_; }
+    VkDescriptorSet getHandle(uint32_t frameIndex) const { return descriptorSets_[frameIndex]; }
+    uint32_t getFrameCount() const { return static_cast<uint32_t>(descriptorSets_.size()); }
+    // ε    ҽ (    )
+    const std::vector<Resource*>& getResources() const { return resources_; }
 
-    void updateIfDirty();
+    // frameIndex 纻  true,   ε ä ϵ Ŀǵ ۴ ٽ ؾ մϴ.
+    // Ƽ ҽ  ӿ  纻   ǥϰ,  纻 ڱ  ʿ մϴ.
+    //  ҽ   ϹǷ Ƽ ÷״   Ȯ  ȣ ʿ ϴ.
+    bool updateIfDirty(uint32_t frameIndex);
 private:
     // Ҵ ũ ¿  ҽ  (Ʈ)մϴ.
-    void updateSet(const std::vector<Resource*>& resources);
+    void updateSet(uint32_t frameIndex);
 
 private:
     VulkanContext* context_ = nullptr;
-    VkDescriptorSet descriptorSet_ = VK_NULL_HANDLE;
+    std::vector<VkDescriptorSet> descriptorSets_;
+    //  ֽ ҽ    纻 (Ʈũ)
+    uint32_t staleFrameMask_ = 0;
 
     std::vector<Resource*> resources_;
 };
\ No newline at end of file
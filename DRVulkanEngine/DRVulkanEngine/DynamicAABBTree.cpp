@@ -0,0 +1,340 @@
+#include "DynamicAABBTree.h"
+#include "FrustumCuller.h"
+#include <algorithm>
+
+namespace
+{
+    float surfaceArea(const glm::vec3& boundsMin, const glm::vec3& boundsMax)
+    {
+        glm::vec3 d = boundsMax - boundsMin;
+        return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+    }
+
+    float unionArea(const glm::vec3& minA, const glm::vec3& maxA, const glm::vec3& minB, const glm::vec3& maxB)
+    {
+        return surfaceArea(glm::min(minA, minB), glm::max(maxA, maxB));
+    }
+
+    bool contains(const glm::vec3& outerMin, const glm::vec3& outerMax, const glm::vec3& innerMin, const glm::vec3& innerMax)
+    {
+        return outerMin.x <= innerMin.x && outerMin.y <= innerMin.y && outerMin.z <= innerMin.z &&
+               innerMax.x <= outerMax.x && innerMax.y <= outerMax.y && innerMax.z <= outerMax.z;
+    }
+}
+
+int32_t DynamicAABBTree::allocateNode()
+{
+    if (freeList_ == NULL_NODE) {
+        nodes_.emplace_back();
+        return static_cast<int32_t>(nodes_.size() - 1);
+    }
+
+    int32_t nodeId = freeList_;
+    freeList_ = nodes_[nodeId].parent;
+    nodes_[nodeId] = Node{};
+    return nodeId;
+}
+
+void DynamicAABBTree::freeNode(int32_t nodeId)
+{
+    nodes_[nodeId].parent = freeList_;
+    nodes_[nodeId].height = -1;
+    freeList_ = nodeId;
+}
+
+void DynamicAABBTree::clear()
+{
+    nodes_.clear();
+    root_ = NULL_NODE;
+    freeList_ = NULL_NODE;
+    proxyCount_ = 0;
+}
+
+int32_t DynamicAABBTree::createProxy(const glm::vec3& boundsMin, const glm::vec3& boundsMax, uint32_t userData)
+{
+    int32_t proxyId = allocateNode();
+    Node& node = nodes_[proxyId];
+    node.boundsMin = boundsMin - glm::vec3(FAT_MARGIN);
+    node.boundsMax = boundsMax + glm::vec3(FAT_MARGIN);
+    node.userData = userData;
+    node.height = 0;
+
+    insertLeaf(proxyId);
+    proxyCount_++;
+    return proxyId;
+}
+
+void DynamicAABBTree::destroyProxy(int32_t proxyId)
+{
+    removeLeaf(proxyId);
+    freeNode(proxyId);
+    proxyCount_--;
+}
+
+bool DynamicAABBTree::moveProxy(int32_t proxyId, const glm::vec3& boundsMin, const glm::vec3& boundsMax)
+{
+    if (contains(nodes_[proxyId].boundsMin, nodes_[proxyId].boundsMax, boundsMin, boundsMax)) {
+        return false;
+    }
+
+    removeLeaf(proxyId);
+    nodes_[proxyId].boundsMin = boundsMin - glm::vec3(FAT_MARGIN);
+    nodes_[proxyId].boundsMax = boundsMax + glm::vec3(FAT_MARGIN);
+    insertLeaf(proxyId);
+    return true;
+}
+
+void DynamicAABBTree::insertLeaf(int32_t leaf)
+{
+    if (root_ == NULL_NODE) {
+        root_ = leaf;
+        nodes_[root_].parent = NULL_NODE;
+        return;
+    }
+
+    // 1) 표면적 휴리스틱으로 형제 노드 찾기
+    glm::vec3 leafMin = nodes_[leaf].boundsMin;
+    glm::vec3 leafMax = nodes_[leaf].boundsMax;
+    int32_t index = root_;
+    while (!nodes_[index].isLeaf()) {
+        const Node& node = nodes_[index];
+        float area = surfaceArea(node.boundsMin, node.boundsMax);
+        float combinedArea = unionArea(node.boundsMin, node.boundsMax, leafMin, leafMax);
+
+        // 여기서 새 부모를 만드는 비용과, 자식으로 내려갈 때 조상들이 커지는 비용
+        float cost = 2.0f * combinedArea;
+        float inheritanceCost = 2.0f * (combinedArea - area);
+
+        auto descendCost = [&](int32_t child) {
+            const Node& c = nodes_[child];
+            float newArea = unionArea(c.boundsMin, c.boundsMax, leafMin, leafMax);
+            if (c.isLeaf()) {
+                return newArea + inheritanceCost;
+            }
+            return (newArea - surfaceArea(c.boundsMin, c.boundsMax)) + inheritanceCost;
+        };
+        float cost1 = descendCost(node.child1);
+        float cost2 = descendCost(node.child2);
+
+        if (cost < cost1 && cost < cost2) {
+            break;
+        }
+        index = (cost1 < cost2) ? node.child1 : node.child2;
+    }
+    int32_t sibling = index;
+
+    // 2) 형제와 새 리프를 묶는 부모 노드 생성
+    int32_t oldParent = nodes_[sibling].parent;
+    int32_t newParent = allocateNode();
+    nodes_[newParent].parent = oldParent;
+    nodes_[newParent].boundsMin = glm::min(leafMin, nodes_[sibling].boundsMin);
+    nodes_[newParent].boundsMax = glm::max(leafMax, nodes_[sibling].boundsMax);
+    nodes_[newParent].height = nodes_[sibling].height + 1;
+    nodes_[newParent].child1 = sibling;
+    nodes_[newParent].child2 = leaf;
+    nodes_[sibling].parent = newParent;
+    nodes_[leaf].parent = newParent;
+
+    if (oldParent != NULL_NODE) {
+        if (nodes_[oldParent].child1 == sibling) {
+            nodes_[oldParent].child1 = newParent;
+        }
+        else {
+            nodes_[oldParent].child2 = newParent;
+        }
+    }
+    else {
+        root_ = newParent;
+    }
+
+    // 3) 올라가면서 균형을 맞추고 AABB/높이 갱신
+    index = nodes_[leaf].parent;
+    while (index != NULL_NODE) {
+        index = balance(index);
+        refit(index);
+        index = nodes_[index].parent;
+    }
+}
+
+void DynamicAABBTree::removeLeaf(int32_t leaf)
+{
+    if (leaf == root_) {
+        root_ = NULL_NODE;
+        return;
+    }
+
+    int32_t parent = nodes_[leaf].parent;
+    int32_t grandParent = nodes_[parent].parent;
+    int32_t sibling = (nodes_[parent].child1 == leaf) ? nodes_[parent].child2 : nodes_[parent].child1;
+
+    if (grandParent != NULL_NODE) {
+        // 부모를 지우고 형제를 조부모에 바로 연결
+        if (nodes_[grandParent].child1 == parent) {
+            nodes_[grandParent].child1 = sibling;
+        }
+        else {
+            nodes_[grandParent].child2 = sibling;
+        }
+        nodes_[sibling].parent = grandParent;
+        freeNode(parent);
+
+        int32_t index = grandParent;
+        while (index != NULL_NODE) {
+            index = balance(index);
+            refit(index);
+            index = nodes_[index].parent;
+        }
+    }
+    else {
+        root_ = sibling;
+        nodes_[sibling].parent = NULL_NODE;
+        freeNode(parent);
+    }
+}
+
+void DynamicAABBTree::refit(int32_t nodeId)
+{
+    Node& node = nodes_[nodeId];
+    const Node& child1 = nodes_[node.child1];
+    const Node& child2 = nodes_[node.child2];
+    node.boundsMin = glm::min(child1.boundsMin, child2.boundsMin);
+    node.boundsMax = glm::max(child1.boundsMax, child2.boundsMax);
+    node.height = 1 + std::max(child1.height, child2.height);
+}
+
+// 높이 차가 1보다 크면 더 높은 자식을 위로 올립니다. 새 서브트리 루트를 반환합니다.
+int32_t DynamicAABBTree::balance(int32_t iA)
+{
+    Node& A = nodes_[iA];
+    if (A.isLeaf() || A.height < 2) {
+        return iA;
+    }
+
+    int32_t iB = A.child1;
+    int32_t iC = A.child2;
+    int32_t heightDiff = nodes_[iC].height - nodes_[iB].height;
+
+    // 오른쪽(C)을 올림
+    if (heightDiff > 1) {
+        Node& C = nodes_[iC];
+        int32_t iF = C.child1;
+        int32_t iG = C.child2;
+
+        C.child1 = iA;
+        C.parent = A.parent;
+        A.parent = iC;
+
+        if (C.parent != NULL_NODE) {
+            if (nodes_[C.parent].child1 == iA) {
+                nodes_[C.parent].child1 = iC;
+            }
+            else {
+                nodes_[C.parent].child2 = iC;
+            }
+        }
+        else {
+            root_ = iC;
+        }
+
+        // 더 높은 손자는 C에 남기고 낮은 쪽을 A로 넘깁니다.
+        if (nodes_[iF].height > nodes_[iG].height) {
+            C.child2 = iF;
+            A.child2 = iG;
+            nodes_[iG].parent = iA;
+        }
+        else {
+            C.child2 = iG;
+            A.child2 = iF;
+            nodes_[iF].parent = iA;
+        }
+        refit(iA);
+        refit(iC);
+        return iC;
+    }
+
+    // 왼쪽(B)을 올림
+    if (heightDiff < -1) {
+        Node& B = nodes_[iB];
+        int32_t iD = B.child1;
+        int32_t iE = B.child2;
+
+        B.child1 = iA;
+        B.parent = A.parent;
+        A.parent = iB;
+
+        if (B.parent != NULL_NODE) {
+            if (nodes_[B.parent].child1 == iA) {
+                nodes_[B.parent].child1 = iB;
+            }
+            else {
+                nodes_[B.parent].child2 = iB;
+            }
+        }
+        else {
+            root_ = iB;
+        }
+
+        if (nodes_[iD].height > nodes_[iE].height) {
+            B.child2 = iD;
+            A.child1 = iE;
+            nodes_[iE].parent = iA;
+        }
+        else {
+            B.child2 = iE;
+            A.child1 = iD;
+            nodes_[iD].parent = iA;
+        }
+        refit(iA);
+        refit(iB);
+        return iB;
+    }
+
+    return iA;
+}
+
+void DynamicAABBTree::collectLeaves(int32_t nodeId, std::vector<uint32_t>& outUserData, std::vector<int32_t>& stack) const
+{
+    stack.clear();
+    stack.push_back(nodeId);
+    while (!stack.empty()) {
+        const Node& node = nodes_[stack.back()];
+        stack.pop_back();
+        if (node.isLeaf()) {
+            outUserData.push_back(node.userData);
+        }
+        else {
+            stack.push_back(node.child1);
+            stack.push_back(node.child2);
+        }
+    }
+}
+
+void DynamicAABBTree::queryFrustum(const Frustum& frustum, std::vector<uint32_t>& outInside, std::vector<uint32_t>& outIntersecting) const
+{
+    if (root_ == NULL_NODE) {
+        return;
+    }
+
+    queryStack_.clear();
+    queryStack_.push_back(root_);
+    while (!queryStack_.empty()) {
+        int32_t nodeId = queryStack_.back();
+        queryStack_.pop_back();
+        const Node& node = nodes_[nodeId];
+
+        FrustumTestResult result = frustum.testAABB(node.boundsMin, node.boundsMax);
+        if (result == FrustumTestResult::Outside) {
+            continue;
+        }
+        if (result == FrustumTestResult::Inside) {
+            collectLeaves(nodeId, outInside, collectStack_);
+            continue;
+        }
+        if (node.isLeaf()) {
+            outIntersecting.push_back(node.userData);
+            continue;
+        }
+        queryStack_.push_back(node.child1);
+        queryStack_.push_back(node.child2);
+    }
+}
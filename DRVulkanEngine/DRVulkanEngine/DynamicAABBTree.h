@@ -0,0 +1,60 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+struct Frustum;
+
+// 동적 AABB 트리 (BVH), 큰 씬에서 프러스텀 밖의 서브트리를 통째로 버리기 위해 씁니다.
+// 리프는 여유(FAT_MARGIN)를 둔 AABB를 저장하므로 조금씩 움직이는 오브젝트는 트리를 고치지 않습니다.
+// 삽입은 표면적 비용이 가장 작은 형제를 찾고, 올라가며 회전으로 높이 균형을 맞춥니다. (AVL)
+class DynamicAABBTree
+{
+public:
+    static constexpr int32_t NULL_NODE = -1;
+    static constexpr float FAT_MARGIN = 0.1f;
+
+    int32_t createProxy(const glm::vec3& boundsMin, const glm::vec3& boundsMax, uint32_t userData);
+    void destroyProxy(int32_t proxyId);
+    // 여유 AABB를 벗어났을 때만 다시 삽입하고 true를 반환합니다.
+    bool moveProxy(int32_t proxyId, const glm::vec3& boundsMin, const glm::vec3& boundsMax);
+    void clear();
+
+    uint32_t getUserData(int32_t proxyId) const { return nodes_[proxyId].userData; }
+    int32_t getHeight() const { return root_ == NULL_NODE ? 0 : nodes_[root_].height; }
+    size_t getProxyCount() const { return proxyCount_; }
+
+    // 프러스텀과 겹치는 리프의 userData를 추가합니다.
+    // 노드가 프러스텀 안에 완전히 들어가면 자식은 검사 없이 모두 outInside로 보내고,
+    // 경계에 걸친 리프만 outIntersecting으로 보내 호출자가 리프 안의 내용을 다시 검사하게 합니다.
+    void queryFrustum(const Frustum& frustum, std::vector<uint32_t>& outInside, std::vector<uint32_t>& outIntersecting) const;
+
+private:
+    struct Node {
+        glm::vec3 boundsMin = glm::vec3(0.0f);
+        glm::vec3 boundsMax = glm::vec3(0.0f);
+        int32_t parent = NULL_NODE;   // 빈 노드일 때는 다음 빈 노드
+        int32_t child1 = NULL_NODE;
+        int32_t child2 = NULL_NODE;
+        int32_t height = -1;          // 리프 0, 빈 노드 -1
+        uint32_t userData = 0;
+
+        bool isLeaf() const { return child1 == NULL_NODE; }
+    };
+
+    int32_t allocateNode();
+    void freeNode(int32_t nodeId);
+    void insertLeaf(int32_t leaf);
+    void removeLeaf(int32_t leaf);
+    int32_t balance(int32_t nodeId);
+    void refit(int32_t nodeId);
+    void collectLeaves(int32_t nodeId, std::vector<uint32_t>& outUserData, std::vector<int32_t>& stack) const;
+
+    std::vector<Node> nodes_;
+    int32_t root_ = NULL_NODE;
+    int32_t freeList_ = NULL_NODE;
+    size_t proxyCount_ = 0;
+
+    mutable std::vector<int32_t> queryStack_;
+    mutable std::vector<int32_t> collectStack_;
+};
@@ -0,0 +1,94 @@
+#include "FrameUniformAllocator.h"
+#include "VulkanContext.h"
+#include <stdexcept>
+#include <algorithm>
+#include <cstring>
+
+FrameUniformAllocator::~FrameUniformAllocator()
+{
+    cleanup();
+}
+
+void FrameUniformAllocator::initialize(const VulkanContext* ctx, uint32_t framesInFlight, VkDeviceSize dynamicRange, VkDeviceSize frameSize)
+{
+    context = ctx; // Resource::createBuffer가 사용
+
+    // 동적 오프셋과 BDA 양쪽으로 읽으므로 두 정렬 제한 중 큰 쪽에 맞춥니다.
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(context->getPhysicalDevice(), &properties);
+    alignment_ = std::max<VkDeviceSize>({ 16, properties.limits.minUniformBufferOffsetAlignment,
+        properties.limits.minStorageBufferOffsetAlignment });
+
+    framesInFlight_ = framesInFlight;
+    frameSize_ = (frameSize + alignment_ - 1) & ~(alignment_ - 1);
+    createBuffer(frameSize_ * framesInFlight_,
+        VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+        buffer_,
+        allocation_);
+
+    VkBufferDeviceAddressInfo addressInfo{ VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO };
+    addressInfo.buffer = buffer_;
+    deviceAddress_ = vkGetBufferDeviceAddress(context->getDevice(), &addressInfo);
+
+    // 동적 UBO 디스크립터의 오프셋은 0으로 두고, 바인딩할 때 넘기는 동적 오프셋이 실제 위치가 됩니다.
+    bufferInfo_.buffer = buffer_;
+    bufferInfo_.offset = 0;
+    bufferInfo_.range = dynamicRange;
+
+    frameBegin_ = 0;
+    head_ = 0;
+}
+
+void FrameUniformAllocator::cleanup()
+{
+    if (buffer_ == VK_NULL_HANDLE) {
+        return;
+    }
+    vkDestroyBuffer(context->getDevice(), buffer_, nullptr);
+    context->getMemoryAllocator().free(allocation_);
+    buffer_ = VK_NULL_HANDLE;
+}
+
+void FrameUniformAllocator::beginFrame(uint32_t frameIndex)
+{
+    lastFrameBytes_ = head_ - frameBegin_;
+    peakFrameBytes_ = std::max(peakFrameBytes_, lastFrameBytes_);
+
+    frameBegin_ = frameSize_ * (frameIndex % framesInFlight_);
+    head_ = frameBegin_;
+}
+
+FrameUniformAllocation FrameUniformAllocator::allocate(VkDeviceSize size)
+{
+    // 프레임 구간을 넘으면 다른 슬롯의 데이터를 덮어쓰게 되므로 크기를 늘려야 합니다.
+    const VkDeviceSize alignedSize = (size + alignment_ - 1) & ~(alignment_ - 1);
+    if (head_ + alignedSize > frameBegin_ + frameSize_) {
+        throw std::runtime_error("frame uniform allocator overflow!");
+    }
+
+    FrameUniformAllocation allocation;
+    allocation.offset = head_;
+    allocation.frameOffset = head_ - frameBegin_;
+    allocation.mapped = static_cast<char*>(allocation_.mapped) + head_;
+    allocation.address = deviceAddress_ + head_;
+    head_ += alignedSize;
+    return allocation;
+}
+
+FrameUniformAllocation FrameUniformAllocator::write(const void* data, VkDeviceSize size)
+{
+    FrameUniformAllocation allocation = allocate(size);
+    memcpy(allocation.mapped, data, static_cast<size_t>(size));
+    return allocation;
+}
+
+void FrameUniformAllocator::populateWriteDescriptor(VkWriteDescriptorSet& writeInfo) const
+{
+    writeInfo.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    writeInfo.descriptorCount = 1;
+    writeInfo.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+    writeInfo.pBufferInfo = &bufferInfo_;
+    writeInfo.pImageInfo = nullptr;
+    writeInfo.pTexelBufferView = nullptr;
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include "Resource.h"
+#include <vulkan/vulkan.h>
+#include <cstdint>
+
+// 프레임 링에서 잘라 받은 구간. mapped에 쓰면 그대로 GPU가 읽습니다. (HOST_COHERENT)
+struct FrameUniformAllocation {
+    void* mapped = nullptr;
+    VkDeviceSize offset = 0;        // 버퍼 시작 기준 (동적 오프셋)
+    VkDeviceSize frameOffset = 0;   // 이번 프레임 구간 시작 기준 (매 프레임 같은 순서로 쓰면 슬롯이 바뀌어도 같음)
+    VkDeviceAddress address = 0;    // BDA로 읽을 때
+};
+
+// 프레임마다 새로 쓰는 유니폼 데이터(카메라, 본 팔레트 등)를 영구 매핑된 버퍼 하나에서 선형으로 잘라 씁니다.
+//  - 버퍼는 프레임 인 플라이트 수만큼 구간으로 나뉘고, beginFrame()이 그 슬롯 구간의 머리를 처음으로 돌립니다.
+//    슬롯의 펜스를 기다린 뒤에 부르므로 이전 프레임이 아직 읽는 데이터를 덮어쓰지 않습니다.
+//  - 잘라 준 구간은 디스크립터의 동적 오프셋(UNIFORM_BUFFER_DYNAMIC)이나 BDA 주소로 읽습니다.
+//  - 디스크립터로 바인딩할 때는 이 버퍼 자체가 리소스입니다. 범위는 dynamicRange, 오프셋은 setDynamicOffset()으로 정한 값이고
+//    파이프라인이 바인딩할 때 getDynamicOffset()으로 가져갑니다.
+// 렌더 스레드에서만 사용합니다.
+class FrameUniformAllocator : public Resource
+{
+public:
+    static constexpr VkDeviceSize DEFAULT_FRAME_SIZE = 1024 * 1024;
+
+    FrameUniformAllocator() = default;
+    ~FrameUniformAllocator();
+
+    FrameUniformAllocator(const FrameUniformAllocator&) = delete;
+    FrameUniformAllocator& operator=(const FrameUniformAllocator&) = delete;
+
+    void initialize(const VulkanContext* context, uint32_t framesInFlight, VkDeviceSize dynamicRange, VkDeviceSize frameSize = DEFAULT_FRAME_SIZE);
+    void cleanup();
+
+    // 프레임 슬롯의 펜스를 기다린 직후, 이번 프레임의 첫 할당 전에 부릅니다.
+    void beginFrame(uint32_t frameIndex);
+    FrameUniformAllocation allocate(VkDeviceSize size);
+    FrameUniformAllocation write(const void* data, VkDeviceSize size);
+
+    void setDynamicOffset(VkDeviceSize offset) { dynamicOffset_ = static_cast<uint32_t>(offset); }
+    virtual bool hasDynamicOffset() const override { return true; }
+    virtual uint32_t getDynamicOffset() const override { return dynamicOffset_; }
+    virtual void populateWriteDescriptor(VkWriteDescriptorSet& writeInfo) const override;
+
+    // 이번 프레임 구간의 시작 주소, frameOffset과 더하면 BDA 주소가 됩니다.
+    VkDeviceAddress getFrameAddress() const { return deviceAddress_ + frameBegin_; }
+    VkDeviceSize getFrameSize() const { return frameSize_; }
+    VkDeviceSize getLastFrameBytes() const { return lastFrameBytes_; }
+    VkDeviceSize getPeakFrameBytes() const { return peakFrameBytes_; }
+
+private:
+    VkBuffer buffer_ = VK_NULL_HANDLE;
+    MemoryAllocation allocation_;
+    VkDeviceAddress deviceAddress_ = 0;
+    VkDescriptorBufferInfo bufferInfo_{};
+
+    uint32_t framesInFlight_ = 0;
+    VkDeviceSize frameSize_ = 0;
+    VkDeviceSize alignment_ = 16;
+    VkDeviceSize frameBegin_ = 0;   // 이번 프레임 구간의 시작
+    VkDeviceSize head_ = 0;         // 다음에 잘라 줄 위치
+    uint32_t dynamicOffset_ = 0;
+
+    VkDeviceSize lastFrameBytes_ = 0;
+    VkDeviceSize peakFrameBytes_ = 0;
+};
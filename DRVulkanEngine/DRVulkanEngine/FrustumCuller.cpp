@@ -0,0 +1,351 @@
+#include "FrustumCuller.h"
+#include <algorithm>
+#include <limits>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define FRUSTUM_CULLER_X64 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define FRUSTUM_CULLER_AVX2_FUNCTION
+#else
+#define FRUSTUM_CULLER_AVX2_FUNCTION __attribute__((target("avx2")))
+#endif
+#else
+#define FRUSTUM_CULLER_X64 0
+#endif
+
+Frustum Frustum::FromViewProj(const glm::mat4& viewProj)
+{
+    glm::vec4 row0(viewProj[0][0], viewProj[1][0], viewProj[2][0], viewProj[3][0]);
+    glm::vec4 row1(viewProj[0][1], viewProj[1][1], viewProj[2][1], viewProj[3][1]);
+    glm::vec4 row2(viewProj[0][2], viewProj[1][2], viewProj[2][2], viewProj[3][2]);
+    glm::vec4 row3(viewProj[0][3], viewProj[1][3], viewProj[2][3], viewProj[3][3]);
+
+    Frustum frustum;
+    frustum.planes[0] = row3 + row0; // left
+    frustum.planes[1] = row3 - row0; // right
+    frustum.planes[2] = row3 + row1; // bottom
+    frustum.planes[3] = row3 - row1; // top
+    frustum.planes[4] = row2;        // near
+    frustum.planes[5] = row3 - row2; // far
+
+    for (glm::vec4& plane : frustum.planes) {
+        plane /= glm::length(glm::vec3(plane));
+    }
+    return frustum;
+}
+
+FrustumTestResult Frustum::testAABB(const glm::vec3& boundsMin, const glm::vec3& boundsMax) const
+{
+    FrustumTestResult result = FrustumTestResult::Inside;
+    for (const glm::vec4& plane : planes) {
+        // 평면 법선 방향으로 가장 먼 꼭짓점(p)과 가장 가까운 꼭짓점(n)
+        glm::vec3 positive(plane.x >= 0.0f ? boundsMax.x : boundsMin.x,
+                           plane.y >= 0.0f ? boundsMax.y : boundsMin.y,
+                           plane.z >= 0.0f ? boundsMax.z : boundsMin.z);
+        if (glm::dot(glm::vec3(plane), positive) + plane.w < 0.0f) {
+            return FrustumTestResult::Outside;
+        }
+        glm::vec3 negative(plane.x >= 0.0f ? boundsMin.x : boundsMax.x,
+                           plane.y >= 0.0f ? boundsMin.y : boundsMax.y,
+                           plane.z >= 0.0f ? boundsMin.z : boundsMax.z);
+        if (glm::dot(glm::vec3(plane), negative) + plane.w < 0.0f) {
+            result = FrustumTestResult::Intersect;
+        }
+    }
+    return result;
+}
+
+bool FrustumCuller::IsAVX2Supported()
+{
+#if FRUSTUM_CULLER_X64
+    static const bool supported = [] {
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7) {
+            return false;
+        }
+        __cpuid(info, 1);
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        bool avx = (info[2] & (1 << 28)) != 0;
+        if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+            return false;
+        }
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        return __builtin_cpu_supports("avx2") != 0;
+#endif
+    }();
+    return supported;
+#else
+    return false;
+#endif
+}
+
+void FrustumCuller::reserve(size_t count)
+{
+    minX_.reserve(count); minY_.reserve(count); minZ_.reserve(count);
+    maxX_.reserve(count); maxY_.reserve(count); maxZ_.reserve(count);
+    boxIds_.reserve(count);
+    slots_.reserve(count);
+}
+
+void FrustumCuller::clear()
+{
+    minX_.clear(); minY_.clear(); minZ_.clear();
+    maxX_.clear(); maxY_.clear(); maxZ_.clear();
+    boxIds_.clear();
+    slots_.clear();
+    clusterProxies_.clear();
+    clusterDirtyFlags_.clear();
+    dirtyClusters_.clear();
+    clustersDirty_ = true;
+    tree_.clear();
+}
+
+uint32_t FrustumCuller::addBox(const glm::vec3& boundsMin, const glm::vec3& boundsMax)
+{
+    uint32_t index = static_cast<uint32_t>(minX_.size());
+    minX_.push_back(boundsMin.x); minY_.push_back(boundsMin.y); minZ_.push_back(boundsMin.z);
+    maxX_.push_back(boundsMax.x); maxY_.push_back(boundsMax.y); maxZ_.push_back(boundsMax.z);
+    boxIds_.push_back(index);
+    slots_.push_back(index);
+    clustersDirty_ = true;
+    return index;
+}
+
+void FrustumCuller::setBox(uint32_t index, const glm::vec3& boundsMin, const glm::vec3& boundsMax)
+{
+    uint32_t slot = slots_[index];
+    minX_[slot] = boundsMin.x; minY_[slot] = boundsMin.y; minZ_[slot] = boundsMin.z;
+    maxX_[slot] = boundsMax.x; maxY_[slot] = boundsMax.y; maxZ_[slot] = boundsMax.z;
+    if (!clustersDirty_) {
+        uint32_t cluster = slot / CLUSTER_SIZE;
+        if (!clusterDirtyFlags_[cluster]) {
+            clusterDirtyFlags_[cluster] = 1;
+            dirtyClusters_.push_back(cluster);
+        }
+    }
+}
+
+namespace
+{
+    // 10비트 정수의 비트 사이에 0을 두 개씩 끼웁니다. (3축 모턴 코드)
+    uint32_t expandBits(uint32_t value)
+    {
+        value = (value * 0x00010001u) & 0xFF0000FFu;
+        value = (value * 0x00000101u) & 0x0F00F00Fu;
+        value = (value * 0x00000011u) & 0xC30C30C3u;
+        value = (value * 0x00000005u) & 0x49249249u;
+        return value;
+    }
+
+    template <typename T>
+    void reorder(std::vector<T>& values, const std::vector<uint64_t>& sortKeys, std::vector<T>& scratch)
+    {
+        scratch.resize(values.size());
+        for (size_t i = 0; i < sortKeys.size(); ++i) {
+            scratch[i] = values[static_cast<uint32_t>(sortKeys[i])];
+        }
+        values.swap(scratch);
+    }
+}
+
+void FrustumCuller::updateHierarchy()
+{
+    if (clustersDirty_) {
+        rebuildClusters();
+        clustersDirty_ = false;
+        return;
+    }
+    for (uint32_t cluster : dirtyClusters_) {
+        refitCluster(cluster);
+        clusterDirtyFlags_[cluster] = 0;
+    }
+    dirtyClusters_.clear();
+}
+
+void FrustumCuller::rebuildClusters()
+{
+    const size_t count = size();
+
+    // 박스 중심을 씬 바운드 안의 10비트 격자로 양자화해 모턴 순서로 정렬하면 공간적으로 가까운 박스가 같은 클러스터에 모입니다.
+    glm::vec3 sceneMin(std::numeric_limits<float>::max());
+    glm::vec3 sceneMax(std::numeric_limits<float>::lowest());
+    for (size_t i = 0; i < count; ++i) {
+        glm::vec3 center((minX_[i] + maxX_[i]) * 0.5f, (minY_[i] + maxY_[i]) * 0.5f, (minZ_[i] + maxZ_[i]) * 0.5f);
+        sceneMin = glm::min(sceneMin, center);
+        sceneMax = glm::max(sceneMax, center);
+    }
+    const glm::vec3 extent = sceneMax - sceneMin;
+    const glm::vec3 scale(extent.x > 0.0f ? 1023.0f / extent.x : 0.0f,
+                          extent.y > 0.0f ? 1023.0f / extent.y : 0.0f,
+                          extent.z > 0.0f ? 1023.0f / extent.z : 0.0f);
+
+    // 상위 32비트 모턴 코드, 하위 32비트 현재 슬롯
+    sortKeys_.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t x = static_cast<uint32_t>(((minX_[i] + maxX_[i]) * 0.5f - sceneMin.x) * scale.x);
+        uint32_t y = static_cast<uint32_t>(((minY_[i] + maxY_[i]) * 0.5f - sceneMin.y) * scale.y);
+        uint32_t z = static_cast<uint32_t>(((minZ_[i] + maxZ_[i]) * 0.5f - sceneMin.z) * scale.z);
+        uint64_t code = (expandBits(x) << 2) | (expandBits(y) << 1) | expandBits(z);
+        sortKeys_[i] = (code << 32) | i;
+    }
+    std::sort(sortKeys_.begin(), sortKeys_.end());
+
+    reorder(minX_, sortKeys_, reorderScratch_); reorder(minY_, sortKeys_, reorderScratch_); reorder(minZ_, sortKeys_, reorderScratch_);
+    reorder(maxX_, sortKeys_, reorderScratch_); reorder(maxY_, sortKeys_, reorderScratch_); reorder(maxZ_, sortKeys_, reorderScratch_);
+    reorder(boxIds_, sortKeys_, reorderIds_);
+    for (size_t slot = 0; slot < count; ++slot) {
+        slots_[boxIds_[slot]] = static_cast<uint32_t>(slot);
+    }
+
+    const uint32_t clusterCount = static_cast<uint32_t>((count + CLUSTER_SIZE - 1) / CLUSTER_SIZE);
+    tree_.clear();
+    clusterProxies_.assign(clusterCount, DynamicAABBTree::NULL_NODE);
+    clusterDirtyFlags_.assign(clusterCount, 0);
+    dirtyClusters_.clear();
+    for (uint32_t cluster = 0; cluster < clusterCount; ++cluster) {
+        refitCluster(cluster);
+    }
+}
+
+void FrustumCuller::refitCluster(uint32_t cluster)
+{
+    const size_t begin = static_cast<size_t>(cluster) * CLUSTER_SIZE;
+    const size_t end = std::min(begin + CLUSTER_SIZE, size());
+    glm::vec3 boundsMin(std::numeric_limits<float>::max());
+    glm::vec3 boundsMax(std::numeric_limits<float>::lowest());
+    for (size_t i = begin; i < end; ++i) {
+        boundsMin = glm::min(boundsMin, glm::vec3(minX_[i], minY_[i], minZ_[i]));
+        boundsMax = glm::max(boundsMax, glm::vec3(maxX_[i], maxY_[i], maxZ_[i]));
+    }
+
+    int32_t& proxy = clusterProxies_[cluster];
+    if (proxy == DynamicAABBTree::NULL_NODE) {
+        proxy = tree_.createProxy(boundsMin, boundsMax, cluster);
+    }
+    else {
+        tree_.moveProxy(proxy, boundsMin, boundsMax);
+    }
+}
+
+void FrustumCuller::cull(const Frustum& frustum, std::vector<uint32_t>& outVisible)
+{
+    if (size() >= HIERARCHICAL_CULL_THRESHOLD) {
+        cullHierarchical(frustum, outVisible);
+    }
+    else {
+        cullAVX2(frustum, outVisible);
+    }
+}
+
+void FrustumCuller::cullScalar(const Frustum& frustum, std::vector<uint32_t>& outVisible) const
+{
+    outVisible.clear();
+    cullRangeScalar(frustum, 0, size(), outVisible);
+}
+
+void FrustumCuller::cullRangeScalar(const Frustum& frustum, size_t begin, size_t end, std::vector<uint32_t>& outVisible) const
+{
+    for (size_t i = begin; i < end; ++i) {
+        bool outside = false;
+        for (const glm::vec4& plane : frustum.planes) {
+            float px = plane.x >= 0.0f ? maxX_[i] : minX_[i];
+            float py = plane.y >= 0.0f ? maxY_[i] : minY_[i];
+            float pz = plane.z >= 0.0f ? maxZ_[i] : minZ_[i];
+            if (plane.x * px + plane.y * py + plane.z * pz + plane.w < 0.0f) {
+                outside = true;
+                break;
+            }
+        }
+        if (!outside) {
+            outVisible.push_back(boxIds_[i]);
+        }
+    }
+}
+
+#if FRUSTUM_CULLER_X64
+namespace
+{
+    // 박스 8개를 평면 6개와 검사해 보이는 박스의 비트 마스크를 반환합니다.
+    // 평면마다 p-꼭짓점 축(min/max 배열)을 스칼라로 미리 골라두므로 레인별 blend가 없습니다.
+    FRUSTUM_CULLER_AVX2_FUNCTION
+    int testEightBoxes(const Frustum& frustum, const float* const minAxes[3], const float* const maxAxes[3], size_t offset)
+    {
+        __m256 outside = _mm256_setzero_ps();
+        for (const glm::vec4& plane : frustum.planes) {
+            const float* px = (plane.x >= 0.0f ? maxAxes[0] : minAxes[0]) + offset;
+            const float* py = (plane.y >= 0.0f ? maxAxes[1] : minAxes[1]) + offset;
+            const float* pz = (plane.z >= 0.0f ? maxAxes[2] : minAxes[2]) + offset;
+
+            __m256 distance = _mm256_add_ps(
+                _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.x), _mm256_loadu_ps(px)),
+                              _mm256_mul_ps(_mm256_set1_ps(plane.y), _mm256_loadu_ps(py))),
+                _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.z), _mm256_loadu_ps(pz)),
+                              _mm256_set1_ps(plane.w)));
+            outside = _mm256_or_ps(outside, _mm256_cmp_ps(distance, _mm256_setzero_ps(), _CMP_LT_OQ));
+        }
+        return ~_mm256_movemask_ps(outside) & 0xFF;
+    }
+}
+#endif
+
+void FrustumCuller::cullAVX2(const Frustum& frustum, std::vector<uint32_t>& outVisible) const
+{
+    outVisible.clear();
+    cullRange(frustum, 0, size(), outVisible);
+}
+
+void FrustumCuller::cullRange(const Frustum& frustum, size_t begin, size_t end, std::vector<uint32_t>& outVisible) const
+{
+    size_t simdEnd = begin;
+
+#if FRUSTUM_CULLER_X64
+    if (IsAVX2Supported()) {
+        const float* const minAxes[3] = { minX_.data(), minY_.data(), minZ_.data() };
+        const float* const maxAxes[3] = { maxX_.data(), maxY_.data(), maxZ_.data() };
+        simdEnd = begin + ((end - begin) & ~static_cast<size_t>(7));
+        for (size_t i = begin; i < simdEnd; i += 8) {
+            int visibleMask = testEightBoxes(frustum, minAxes, maxAxes, i);
+            while (visibleMask != 0) {
+                unsigned long lane = 0;
+#if defined(_MSC_VER)
+                _BitScanForward(&lane, static_cast<unsigned long>(visibleMask));
+#else
+                lane = static_cast<unsigned long>(__builtin_ctz(static_cast<unsigned int>(visibleMask)));
+#endif
+                outVisible.push_back(boxIds_[i + lane]);
+                visibleMask &= visibleMask - 1;
+            }
+        }
+    }
+#endif
+
+    // 8개로 나누어떨어지지 않는 나머지 (AVX2가 없으면 전부)
+    cullRangeScalar(frustum, simdEnd, end, outVisible);
+}
+
+void FrustumCuller::cullHierarchical(const Frustum& frustum, std::vector<uint32_t>& outVisible)
+{
+    outVisible.clear();
+    updateHierarchy();
+
+    insideClusters_.clear();
+    intersectingClusters_.clear();
+    tree_.queryFrustum(frustum, insideClusters_, intersectingClusters_);
+
+    // 완전히 안쪽인 클러스터는 검사 없이 구간째로, 경계의 클러스터는 연속된 SoA 구간을 AVX2로 검사합니다.
+    for (uint32_t cluster : insideClusters_) {
+        const size_t begin = static_cast<size_t>(cluster) * CLUSTER_SIZE;
+        const size_t end = std::min(begin + CLUSTER_SIZE, size());
+        outVisible.insert(outVisible.end(), boxIds_.begin() + begin, boxIds_.begin() + end);
+    }
+    for (uint32_t cluster : intersectingClusters_) {
+        const size_t begin = static_cast<size_t>(cluster) * CLUSTER_SIZE;
+        cullRange(frustum, begin, std::min(begin + CLUSTER_SIZE, size()), outVisible);
+    }
+}
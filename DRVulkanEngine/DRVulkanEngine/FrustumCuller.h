@@ -0,0 +1,84 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include "DynamicAABBTree.h"
+
+enum class FrustumTestResult
+{
+    Outside,
+    Intersect,
+    Inside
+};
+
+// 월드 공간 프러스텀 평면 6개, dot(n, p) + w >= 0 이면 평면 안쪽
+struct Frustum {
+    glm::vec4 planes[6];
+
+    // Gribb-Hartmann 추출, Camera의 0 <= z <= w 깊이 범위 기준 (GLM_FORCE_DEPTH_ZERO_TO_ONE)
+    static Frustum FromViewProj(const glm::mat4& viewProj);
+
+    FrustumTestResult testAABB(const glm::vec3& boundsMin, const glm::vec3& boundsMax) const;
+};
+
+// CPU 프러스텀 컬링
+// AABB를 SoA(축별 min/max 배열)로 저장해 AVX2로 8개씩 검사합니다. (지원하지 않는 CPU는 스칼라)
+// 박스가 HIERARCHICAL_CULL_THRESHOLD개 이상이면 계층 경로를 씁니다.
+//  - 박스를 중심의 모턴 순서로 SoA 안에서 재배치해 CLUSTER_SIZE개씩 클러스터로 묶고, 동적 BVH의 리프는 클러스터입니다.
+//  - 프러스텀 안에 완전히 들어간 서브트리는 검사 없이 클러스터 구간을 통째로 받아들이고,
+//    경계에 걸친 클러스터만 연속된 SoA 구간을 AVX2로 검사합니다.
+// 박스 인덱스는 addBox 순서이며 setBox로 위치만 갱신합니다.
+// addBox 뒤에는 다음 계층 컬링에서 클러스터를 다시 만들고, setBox는 그 클러스터의 바운드만 다시 맞춥니다. (BVH는 여유 AABB 안에서는 고치지 않음)
+class FrustumCuller
+{
+public:
+    // FrustumCullingBenchmark 기준 약 2천 개부터 계층 경로가 평면 AVX2보다 빨라서 여유를 두고 잡았습니다.
+    static constexpr size_t HIERARCHICAL_CULL_THRESHOLD = 4096;
+    static constexpr uint32_t CLUSTER_SIZE = 64; // 8의 배수 (AVX2 검사 단위)
+
+    void reserve(size_t count);
+    void clear();
+
+    uint32_t addBox(const glm::vec3& boundsMin, const glm::vec3& boundsMax);
+    void setBox(uint32_t index, const glm::vec3& boundsMin, const glm::vec3& boundsMax);
+    size_t size() const { return minX_.size(); }
+
+    // 프러스텀과 겹치는 박스 인덱스를 outVisible에 씁니다. (순서는 정해져 있지 않음)
+    // 계층 경로는 클러스터를 먼저 맞추므로 const가 아닙니다.
+    void cull(const Frustum& frustum, std::vector<uint32_t>& outVisible);
+
+    // 벤치마크/비교용으로 경로를 직접 고를 수 있게 열어둡니다.
+    void cullScalar(const Frustum& frustum, std::vector<uint32_t>& outVisible) const;
+    void cullAVX2(const Frustum& frustum, std::vector<uint32_t>& outVisible) const;
+    void cullHierarchical(const Frustum& frustum, std::vector<uint32_t>& outVisible);
+    // 클러스터 재구성/바운드 갱신, cullHierarchical()이 먼저 부르며 미리 불러 비용을 옮길 수 있습니다.
+    void updateHierarchy();
+
+    static bool IsAVX2Supported();
+
+private:
+    // [begin, end)는 SoA 슬롯 구간이고, 출력은 박스 인덱스입니다.
+    void cullRangeScalar(const Frustum& frustum, size_t begin, size_t end, std::vector<uint32_t>& outVisible) const;
+    void cullRange(const Frustum& frustum, size_t begin, size_t end, std::vector<uint32_t>& outVisible) const;
+    void rebuildClusters();
+    void refitCluster(uint32_t cluster);
+
+    // 슬롯 순서 (계층 경로가 클러스터 순서로 재배치), boxIds_[슬롯] = 박스 인덱스, slots_[박스 인덱스] = 슬롯
+    std::vector<float> minX_, minY_, minZ_;
+    std::vector<float> maxX_, maxY_, maxZ_;
+    std::vector<uint32_t> boxIds_;
+    std::vector<uint32_t> slots_;
+
+    DynamicAABBTree tree_;
+    std::vector<int32_t> clusterProxies_;
+    bool clustersDirty_ = true;
+    std::vector<uint8_t> clusterDirtyFlags_;
+    std::vector<uint32_t> dirtyClusters_;
+
+    // 재사용 버퍼
+    std::vector<uint64_t> sortKeys_;
+    std::vector<float> reorderScratch_;
+    std::vector<uint32_t> reorderIds_;
+    std::vector<uint32_t> insideClusters_;
+    std::vector<uint32_t> intersectingClusters_;
+};
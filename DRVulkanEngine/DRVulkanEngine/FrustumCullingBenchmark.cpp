@@ -0,0 +1,94 @@
+#include "Benchmarks.h"
+#include "Camera.h"
+#include "FrustumCuller.h"
+#include <chrono>
+#include <random>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <limits>
+#include <algorithm>
+
+namespace
+{
+    using Clock = std::chrono::high_resolution_clock;
+
+    constexpr int CULL_ITERATIONS = 20;
+    constexpr float WORLD_EXTENT = 500.0f;
+
+    // 여러 번 돌려 가장 빠른 시간을 씁니다. (ms)
+    template <typename Func>
+    double measureBest(Func&& func, int iterations)
+    {
+        double best = std::numeric_limits<double>::max();
+        for (int i = 0; i < iterations; ++i) {
+            auto start = Clock::now();
+            func();
+            auto end = Clock::now();
+            best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+        }
+        return best;
+    }
+
+    void runCase(size_t boxCount, const Frustum& frustum)
+    {
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> position(-WORLD_EXTENT, WORLD_EXTENT);
+        std::uniform_real_distribution<float> halfSize(0.25f, 2.0f);
+
+        std::vector<glm::vec3> mins(boxCount);
+        std::vector<glm::vec3> maxs(boxCount);
+        for (size_t i = 0; i < boxCount; ++i) {
+            glm::vec3 center(position(rng), position(rng), position(rng));
+            glm::vec3 extent(halfSize(rng));
+            mins[i] = center - extent;
+            maxs[i] = center + extent;
+        }
+
+        // 클러스터 정렬과 BVH 생성 시간 포함 (addBox 뒤 updateHierarchy가 한 번에 만듦)
+        FrustumCuller culler;
+        culler.reserve(boxCount);
+        auto buildStart = Clock::now();
+        for (size_t i = 0; i < boxCount; ++i) {
+            culler.addBox(mins[i], maxs[i]);
+        }
+        culler.updateHierarchy();
+        double buildMs = std::chrono::duration<double, std::milli>(Clock::now() - buildStart).count();
+
+        std::vector<uint32_t> visible;
+        visible.reserve(boxCount);
+
+        double scalarMs = measureBest([&] { culler.cullScalar(frustum, visible); }, CULL_ITERATIONS);
+        size_t scalarVisible = visible.size();
+
+        double simdMs = measureBest([&] { culler.cullAVX2(frustum, visible); }, CULL_ITERATIONS);
+        size_t simdVisible = visible.size();
+
+        double bvhMs = measureBest([&] { culler.cullHierarchical(frustum, visible); }, CULL_ITERATIONS);
+        size_t bvhVisible = visible.size();
+
+        std::cout << std::setw(9) << boxCount
+            << " | build " << std::setw(9) << buildMs << " ms"
+            << " | scalar " << std::setw(8) << scalarMs << " ms (" << scalarVisible << ")"
+            << " | avx2 " << std::setw(8) << simdMs << " ms (" << simdVisible << ")"
+            << " | bvh " << std::setw(8) << bvhMs << " ms (" << bvhVisible << ")"
+            << std::endl;
+    }
+}
+
+int RunFrustumCullingBenchmark()
+{
+    // 월드 중앙에서 +Z 쪽을 보는 카메라 (앱과 같은 투영)
+    Camera camera(glm::vec3(0.0f, 0.0f, -WORLD_EXTENT), glm::vec3(0.0f, 1.0f, 0.0f), 90.0f, 0.0f);
+    glm::mat4 viewProj = camera.getProjectionMatrix(16.0f / 9.0f, 0.1f, WORLD_EXTENT) * camera.getViewMatrix();
+    Frustum frustum = Frustum::FromViewProj(viewProj);
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Frustum culling benchmark (AVX2 " << (FrustumCuller::IsAVX2Supported() ? "supported" : "not supported")
+        << ", best of " << CULL_ITERATIONS << ")" << std::endl;
+
+    for (size_t boxCount : { size_t(10000), size_t(100000), size_t(1000000) }) {
+        runCase(boxCount, frustum);
+    }
+    return 0;
+}
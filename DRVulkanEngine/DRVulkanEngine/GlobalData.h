@@ -1,11 +1,38 @@
 #pragma once
-#define USE_BDA_BUFFER 1
+#include <vulkan/vulkan.h>
+#include <glm/glm.hpp>
 #define USE_GENERAL_LAYOUT 1
+// 카메라 행렬은 SceneUBO에서 읽으므로 여기에는 프레임마다 같은 값만 둡니다. (캐시된 커맨드 버퍼 재사용)
 struct PushConstantData {
+    // 이번 프레임 인스턴스 버퍼 주소, 셰이더에서 gl_InstanceIndex로 인덱싱합니다.
+    VkDeviceAddress instanceAddress = 0;
+    int padding[2] = { 0, 0 };
+};
+
+// 인스턴스 하나(모델 x 메시)의 GPU 데이터 (std430, shader.vert의 InstanceData와 일치해야 함)
+struct alignas(16) InstanceData {
+    glm::mat4 world;
     VkDeviceAddress boneAddress = 0;
-    int modelUBIndex = -1;
+    // 팔레트 풀 전체 기준 첫 행렬 인덱스 (이번 슬롯 포함), 디스크립터로 읽는 본 백엔드가 씁니다. 없으면 -1
+    int paletteIndex = -1;
+    int materialIndex = -1;
+};
+
+// GPU 씬 데이터베이스(GpuScene)의 오브젝트 하나(모델 x 메시), 안정된 오브젝트 ID로 인덱싱합니다.
+// (std430, scene_scatter.comp/cull.comp의 ObjectRecord와 일치해야 함)
+struct alignas(16) ObjectRecord {
+    static constexpr uint32_t NO_PALETTE = ~0u;
+
+    glm::mat4 world = glm::mat4(1.0f);
+    glm::vec4 boundingSphere = glm::vec4(0.0f); // 로컬 공간 (xyz = 중심, w = 반지름)
     int materialIndex = -1;
+    // 본 팔레트 풀의 슬롯 시작 기준 팔레트 위치 (바이트, 모든 슬롯 공통), 컬링이 주소로 바꿔 InstanceData에 넣습니다.
+    uint32_t paletteOffset = NO_PALETTE;
+    uint32_t padding[2] = { 0, 0 };
+};
 
-    int boneUbIndex = -1;
-    int padding = 0;
+// GPU 컬링 입력, 이번 프레임에 그릴 후보 오브젝트 (cull.comp의 CullEntry와 일치해야 함)
+struct CullEntryData {
+    uint32_t objectId = 0;
+    uint32_t batchIndex = 0;
 };
\ No newline at end of file
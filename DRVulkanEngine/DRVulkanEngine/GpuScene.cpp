@@ -0,0 +1,261 @@
+#include "GpuScene.h"
+#include "VulkanContext.h"
+#include "StorageBuffer.h"
+#include "ComputePipeline.h"
+#include <stdexcept>
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    // scene_scatter.comp의 UploadPtr 머리와 일치해야 합니다. (앞 12바이트가 vkCmdDispatchIndirect 인자)
+    struct UploadHeader {
+        VkDispatchIndirectCommand dispatch;
+        uint32_t updateCount;
+    };
+    static_assert(sizeof(UploadHeader) == 16, "upload header must match scene_scatter.comp");
+
+    // scene_scatter.comp의 ObjectUpdate와 일치해야 합니다. (std430)
+    struct alignas(16) ObjectUpdate {
+        ObjectRecord record;
+        uint32_t objectId;
+        uint32_t flags;
+        uint32_t padding[2];
+    };
+
+    // scene_scatter.comp의 UPDATE_RESET_VISIBILITY
+    constexpr uint32_t SCATTER_RESET_VISIBILITY = 1;
+
+    // scene_scatter.comp의 PushConstants와 일치해야 합니다.
+    struct ScatterPushConstants {
+        VkDeviceAddress uploadAddress;
+        VkDeviceAddress objectRecordAddress;
+        VkDeviceAddress visibilityAddress;
+    };
+}
+
+GpuScene::~GpuScene()
+{
+    cleanup();
+}
+
+void GpuScene::initialize(const VulkanContext* context, uint32_t framesInFlight, uint32_t initialCapacity)
+{
+    context_ = context;
+    framesInFlight_ = framesInFlight;
+
+    records_.assign(std::max(initialCapacity, 1u), ObjectRecord{});
+    updateFlags_.assign(records_.size(), 0);
+    pendingUpdates_.reserve(records_.size());
+    uploadBuffers_.resize(framesInFlight_);
+    uploadCapacities_.assign(framesInFlight_, 0);
+    stats_.capacity = static_cast<uint32_t>(records_.size());
+}
+
+void GpuScene::cleanup()
+{
+    if (!context_) {
+        return;
+    }
+    destroyDeviceBuffer(recordBuffer_);
+    destroyDeviceBuffer(visibilityBuffer_);
+    for (RetiredBuffer& retired : retiredBuffers_) {
+        destroyDeviceBuffer(retired.buffer);
+    }
+    retiredBuffers_.clear();
+    uploadBuffers_.clear();
+    uploadCapacities_.clear();
+
+    records_.clear();
+    updateFlags_.clear();
+    pendingUpdates_.clear();
+    freeObjects_.clear();
+    objectCount_ = 0;
+    deviceCapacity_ = 0;
+    recordAddress_ = 0;
+    visibilityAddress_ = 0;
+    context_ = nullptr;
+}
+
+uint32_t GpuScene::addObject()
+{
+    uint32_t objectId;
+    if (!freeObjects_.empty()) {
+        objectId = freeObjects_.back();
+        freeObjects_.pop_back();
+    }
+    else {
+        // CPU 사본만 먼저 키우고, GPU 버퍼는 다음 flush()에서 다시 만듭니다.
+        if (objectCount_ == records_.size()) {
+            records_.resize(records_.size() * 2);
+            updateFlags_.resize(records_.size(), 0);
+            stats_.capacity = static_cast<uint32_t>(records_.size());
+        }
+        objectId = objectCount_++;
+    }
+
+    // 이전에 이 ID를 쓰던 오브젝트의 가시성을 물려받지 않도록 지웁니다.
+    records_[objectId] = ObjectRecord{};
+    queueUpdate(objectId, UPDATE_RESET_VISIBILITY);
+    stats_.objectCount++;
+    return objectId;
+}
+
+void GpuScene::removeObject(uint32_t objectId)
+{
+    if (objectId >= objectCount_) {
+        return;
+    }
+    // 컬링 입력에 더 이상 오르지 않으므로 GPU 레코드는 그대로 둡니다.
+    records_[objectId] = ObjectRecord{};
+    freeObjects_.push_back(objectId);
+    stats_.objectCount--;
+}
+
+void GpuScene::setObject(uint32_t objectId, const ObjectRecord& record)
+{
+    ObjectRecord& current = records_[objectId];
+    if (memcmp(&current, &record, sizeof(ObjectRecord)) == 0) {
+        return;
+    }
+    current = record;
+    queueUpdate(objectId, 0);
+}
+
+void GpuScene::queueUpdate(uint32_t objectId, uint8_t flags)
+{
+    if ((updateFlags_[objectId] & UPDATE_QUEUED) == 0) {
+        pendingUpdates_.push_back(objectId);
+    }
+    updateFlags_[objectId] |= UPDATE_QUEUED | flags;
+}
+
+void GpuScene::flush(uint32_t frameIndex)
+{
+    frameIndex_ = frameIndex;
+    frameCounter_++;
+    releaseRetiredBuffers();
+
+    if (deviceCapacity_ < records_.size()) {
+        growDeviceBuffers();
+    }
+
+    // 이 슬롯의 업로드 버퍼는 펜스 대기로 GPU 사용이 끝났으므로 바로 다시 만들어도 됩니다.
+    const uint32_t updateCount = static_cast<uint32_t>(pendingUpdates_.size());
+    uint32_t& uploadCapacity = uploadCapacities_[frameIndex_];
+    if (!uploadBuffers_[frameIndex_] || updateCount > uploadCapacity) {
+        uploadCapacity = std::max({ uploadCapacity * 2, updateCount, SCATTER_GROUP_SIZE });
+        uploadBuffers_[frameIndex_] = std::make_unique<StorageBuffer>(context_,
+            sizeof(UploadHeader) + sizeof(ObjectUpdate) * uploadCapacity,
+            VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT);
+        recordVersion_++;
+    }
+    StorageBuffer& uploadBuffer = *uploadBuffers_[frameIndex_];
+
+    VkDeviceSize offset = sizeof(UploadHeader);
+    for (uint32_t objectId : pendingUpdates_) {
+        ObjectUpdate update{};
+        update.record = records_[objectId];
+        update.objectId = objectId;
+        update.flags = (updateFlags_[objectId] & UPDATE_RESET_VISIBILITY) ? SCATTER_RESET_VISIBILITY : 0;
+        uploadBuffer.update(&update, sizeof(ObjectUpdate), offset);
+        offset += sizeof(ObjectUpdate);
+        updateFlags_[objectId] = 0;
+    }
+    pendingUpdates_.clear();
+
+    // 바뀐 레코드가 없으면 그룹 수 0으로 디스패치가 아무 일도 하지 않습니다.
+    UploadHeader header{};
+    header.dispatch.x = (updateCount + SCATTER_GROUP_SIZE - 1) / SCATTER_GROUP_SIZE;
+    header.dispatch.y = 1;
+    header.dispatch.z = 1;
+    header.updateCount = updateCount;
+    uploadBuffer.update(&header, sizeof(UploadHeader), 0);
+
+    stats_.lastUploadCount = updateCount;
+    stats_.peakUploadCount = std::max(stats_.peakUploadCount, updateCount);
+    stats_.totalUploadCount += updateCount;
+}
+
+void GpuScene::recordScatter(VkCommandBuffer commandBuffer, ComputePipeline& scatterPipeline) const
+{
+    if (uploadBuffers_.empty() || !uploadBuffers_[frameIndex_]) {
+        return;
+    }
+    const StorageBuffer& uploadBuffer = *uploadBuffers_[frameIndex_];
+
+    ScatterPushConstants pushData{};
+    pushData.uploadAddress = uploadBuffer.getDeviceAddress();
+    pushData.objectRecordAddress = recordAddress_;
+    pushData.visibilityAddress = visibilityAddress_;
+
+    scatterPipeline.bindPipeline(commandBuffer);
+    vkCmdPushConstants(commandBuffer, scatterPipeline.getPipelineLayout(), VK_SHADER_STAGE_COMPUTE_BIT,
+        0, sizeof(ScatterPushConstants), &pushData);
+    vkCmdDispatchIndirect(commandBuffer, uploadBuffer.getBuffer(), 0);
+}
+
+void GpuScene::growDeviceBuffers()
+{
+    // 이전 프레임이 아직 읽고 있을 수 있으므로 바로 해제하지 않습니다.
+    if (recordBuffer_.buffer != VK_NULL_HANDLE) {
+        retiredBuffers_.push_back({ recordBuffer_, frameCounter_ });
+        retiredBuffers_.push_back({ visibilityBuffer_, frameCounter_ });
+        recordBuffer_ = DeviceBuffer{};
+        visibilityBuffer_ = DeviceBuffer{};
+        stats_.growCount++;
+    }
+
+    deviceCapacity_ = static_cast<uint32_t>(records_.size());
+    recordAddress_ = createDeviceBuffer(sizeof(ObjectRecord) * deviceCapacity_, recordBuffer_);
+    visibilityAddress_ = createDeviceBuffer(sizeof(uint32_t) * deviceCapacity_, visibilityBuffer_);
+    recordVersion_++;
+
+    // 새 버퍼는 비어 있으므로 지금까지의 레코드를 모두 다시 올리고 가시성도 지웁니다.
+    for (uint32_t objectId = 0; objectId < objectCount_; ++objectId) {
+        queueUpdate(objectId, UPDATE_RESET_VISIBILITY);
+    }
+}
+
+VkDeviceAddress GpuScene::createDeviceBuffer(VkDeviceSize size, DeviceBuffer& outBuffer)
+{
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = size;
+    bufferInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+    // 컬링이 컴퓨트 전용 큐에서 돌 수 있으므로 CONCURRENT로 만듭니다.
+    context_->setBufferSharing(bufferInfo);
+
+    if (vkCreateBuffer(context_->getDevice(), &bufferInfo, nullptr, &outBuffer.buffer) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create gpu scene buffer!");
+    }
+    outBuffer.allocation = context_->getMemoryAllocator().allocateForBuffer(outBuffer.buffer, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+    VkBufferDeviceAddressInfo addressInfo{};
+    addressInfo.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO;
+    addressInfo.buffer = outBuffer.buffer;
+    return vkGetBufferDeviceAddress(context_->getDevice(), &addressInfo);
+}
+
+void GpuScene::destroyDeviceBuffer(DeviceBuffer& buffer)
+{
+    if (buffer.buffer == VK_NULL_HANDLE) {
+        return;
+    }
+    vkDestroyBuffer(context_->getDevice(), buffer.buffer, nullptr);
+    context_->getMemoryAllocator().free(buffer.allocation);
+    buffer = DeviceBuffer{};
+}
+
+void GpuScene::releaseRetiredBuffers()
+{
+    // 버린 프레임 이후로 프레임 인 플라이트 수만큼 펜스를 기다렸으면 그 버퍼를 읽는 GPU 작업은 없습니다.
+    auto it = std::remove_if(retiredBuffers_.begin(), retiredBuffers_.end(), [this](RetiredBuffer& retired) {
+        if (retired.retireFrame + framesInFlight_ > frameCounter_) {
+            return false;
+        }
+        destroyDeviceBuffer(retired.buffer);
+        return true;
+    });
+    retiredBuffers_.erase(it, retiredBuffers_.end());
+}
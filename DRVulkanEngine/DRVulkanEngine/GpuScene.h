@@ -0,0 +1,110 @@
+#pragma once
+#include <vulkan/vulkan.h>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include "GlobalData.h"
+#include "MemoryAllocator.h"
+
+class VulkanContext;
+class StorageBuffer;
+class ComputePipeline;
+
+// GPU에 상주하는 오브젝트 레코드 테이블 (변환, 바운드, 재질, 본 팔레트 위치)
+//  - 오브젝트는 addObject()가 준 ID로 계속 같은 자리에 있고, 컬링은 ID로 레코드와 가시성을 읽습니다.
+//  - setObject()는 CPU 사본과 비교해 바뀐 레코드만 업로드 목록에 올리고,
+//    flush()가 그 (ID, 레코드) 쌍을 프레임 슬롯의 업로드 버퍼에 모으면 recordScatter()가 컴퓨트로 흩뿌립니다.
+//    업로드량은 씬 크기가 아니라 바뀐 오브젝트 수에 비례합니다.
+//  - 디스패치 크기는 업로드 버퍼 머리의 간접 인자로 넘기므로 캐시된 커맨드 버퍼를 그대로 다시 제출해도 됩니다.
+//  - 용량이 차면 두 배로 키운 새 버퍼를 만들고 모든 레코드를 다시 올립니다. 이전 버퍼는 프레임 인 플라이트가 끝난 뒤 해제합니다.
+// 렌더 스레드에서만 사용합니다.
+class GpuScene
+{
+public:
+    static constexpr uint32_t INITIAL_CAPACITY = 1024;
+    static constexpr uint32_t SCATTER_GROUP_SIZE = 64; // scene_scatter.comp의 local_size_x
+    static constexpr uint32_t INVALID_OBJECT = ~0u;
+
+    struct Stats {
+        uint32_t objectCount = 0;
+        uint32_t capacity = 0;
+        uint32_t lastUploadCount = 0;
+        uint32_t peakUploadCount = 0;
+        uint64_t totalUploadCount = 0;
+        uint32_t growCount = 0;
+    };
+
+    GpuScene() = default;
+    ~GpuScene();
+
+    GpuScene(const GpuScene&) = delete;
+    GpuScene& operator=(const GpuScene&) = delete;
+
+    void initialize(const VulkanContext* context, uint32_t framesInFlight, uint32_t initialCapacity = INITIAL_CAPACITY);
+    void cleanup();
+
+    uint32_t addObject();
+    void removeObject(uint32_t objectId);
+    void setObject(uint32_t objectId, const ObjectRecord& record);
+    const ObjectRecord& getObject(uint32_t objectId) const { return records_[objectId]; }
+
+    // 프레임 슬롯의 펜스를 기다린 뒤, 커맨드 버퍼를 기록(또는 캐시 재제출)하기 전에 부릅니다.
+    void flush(uint32_t frameIndex);
+    // 컬링보다 먼저 기록합니다. 컬링과의 배리어는 렌더 그래프(sceneObjects 리소스)가 넣습니다.
+    void recordScatter(VkCommandBuffer commandBuffer, ComputePipeline& scatterPipeline) const;
+
+    VkDeviceAddress getRecordAddress() const { return recordAddress_; }
+    // 오브젝트별 지난 프레임 가시성 (2단계 Hi-Z 컬링), 새 오브젝트와 버퍼를 키울 때 0으로 초기화됩니다.
+    VkDeviceAddress getVisibilityAddress() const { return visibilityAddress_; }
+    // recordScatter()가 기록하는 버퍼 주소가 바뀔 때만 증가합니다. (레코드 버퍼나 업로드 버퍼를 다시 만들 때)
+    uint64_t getRecordVersion() const { return recordVersion_; }
+    const Stats& getStats() const { return stats_; }
+
+private:
+    struct DeviceBuffer {
+        VkBuffer buffer = VK_NULL_HANDLE;
+        MemoryAllocation allocation;
+    };
+
+    struct RetiredBuffer {
+        DeviceBuffer buffer;
+        uint64_t retireFrame = 0;
+    };
+
+    enum UpdateFlags : uint8_t {
+        UPDATE_QUEUED = 1 << 0,
+        UPDATE_RESET_VISIBILITY = 1 << 1,
+    };
+
+    void queueUpdate(uint32_t objectId, uint8_t flags);
+    void growDeviceBuffers();
+    VkDeviceAddress createDeviceBuffer(VkDeviceSize size, DeviceBuffer& outBuffer);
+    void destroyDeviceBuffer(DeviceBuffer& buffer);
+    void releaseRetiredBuffers();
+
+    const VulkanContext* context_ = nullptr;
+    uint32_t framesInFlight_ = 0;
+    uint32_t frameIndex_ = 0;
+    uint64_t frameCounter_ = 0;
+    uint64_t recordVersion_ = 0;
+
+    // CPU 사본 (용량만큼, ID로 인덱싱)
+    std::vector<ObjectRecord> records_;
+    std::vector<uint8_t> updateFlags_;
+    std::vector<uint32_t> pendingUpdates_;
+    std::vector<uint32_t> freeObjects_;
+    uint32_t objectCount_ = 0;      // 한 번이라도 쓴 ID의 끝
+
+    DeviceBuffer recordBuffer_;
+    DeviceBuffer visibilityBuffer_;
+    VkDeviceAddress recordAddress_ = 0;
+    VkDeviceAddress visibilityAddress_ = 0;
+    uint32_t deviceCapacity_ = 0;
+    std::vector<RetiredBuffer> retiredBuffers_;
+
+    // 프레임 슬롯마다 [간접 디스패치 인자 + 업로드 수][ObjectUpdate x 용량]
+    std::vector<std::unique_ptr<StorageBuffer>> uploadBuffers_;
+    std::vector<uint32_t> uploadCapacities_;
+
+    Stats stats_;
+};
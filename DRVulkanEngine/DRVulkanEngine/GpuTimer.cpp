@@ -0,0 +1,99 @@
+#include "GpuTimer.h"
+#include "VulkanContext.h"
+#include <stdexcept>
+#include <iostream>
+
+GpuTimer::~GpuTimer()
+{
+    cleanup();
+}
+
+void GpuTimer::initialize(const VulkanContext* context, uint32_t framesInFlight, uint32_t scopeCount)
+{
+    context_ = context;
+    framesInFlight_ = framesInFlight;
+    scopeCount_ = scopeCount;
+
+    uint32_t queueFamilyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(context_->getPhysicalDevice(), &queueFamilyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(context_->getPhysicalDevice(), &queueFamilyCount, queueFamilies.data());
+    const uint32_t validBits = queueFamilies[context_->getGraphicsQueueFamily()].timestampValidBits;
+    if (validBits == 0 || !context_->supportsHostQueryReset()) {
+        std::cout << "GPU timer: timestamps are not supported on this device" << std::endl;
+        return;
+    }
+    timestampMask_ = validBits >= 64 ? ~0ull : ((1ull << validBits) - 1);
+
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(context_->getPhysicalDevice(), &properties);
+    timestampPeriod_ = properties.limits.timestampPeriod;
+
+    VkQueryPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    poolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    poolInfo.queryCount = framesInFlight_ * scopeCount_ * 2;
+    if (vkCreateQueryPool(context_->getDevice(), &poolInfo, nullptr, &queryPool_) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create timestamp query pool!");
+    }
+    // 처음 쓰기 전에 리셋되어 있어야 합니다.
+    vkResetQueryPool(context_->getDevice(), queryPool_, 0, poolInfo.queryCount);
+}
+
+void GpuTimer::cleanup()
+{
+    if (queryPool_ != VK_NULL_HANDLE) {
+        vkDestroyQueryPool(context_->getDevice(), queryPool_, nullptr);
+        queryPool_ = VK_NULL_HANDLE;
+    }
+}
+
+void GpuTimer::beginScope(VkCommandBuffer commandBuffer, uint32_t frameIndex, uint32_t scope)
+{
+    if (queryPool_ == VK_NULL_HANDLE) {
+        return;
+    }
+    vkCmdWriteTimestamp2(commandBuffer, VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT, queryPool_, getQueryIndex(frameIndex, scope));
+}
+
+void GpuTimer::endScope(VkCommandBuffer commandBuffer, uint32_t frameIndex, uint32_t scope)
+{
+    if (queryPool_ == VK_NULL_HANDLE) {
+        return;
+    }
+    // 앞선 커맨드가 모두 끝난 시점
+    vkCmdWriteTimestamp2(commandBuffer, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, queryPool_, getQueryIndex(frameIndex, scope) + 1);
+}
+
+bool GpuTimer::resolve(uint32_t frameIndex, std::vector<double>& outMilliseconds)
+{
+    outMilliseconds.assign(scopeCount_, -1.0);
+    if (queryPool_ == VK_NULL_HANDLE) {
+        return false;
+    }
+
+    // [시작, 시작 가용, 끝, 끝 가용] x 구간 수
+    std::vector<uint64_t> results(scopeCount_ * 4);
+    const uint32_t firstQuery = getQueryIndex(frameIndex, 0);
+    const uint32_t queryCount = scopeCount_ * 2;
+    // 기다리지 않으므로 기록되지 않은 쿼리가 있으면 VK_NOT_READY지만 가용 값은 채워집니다.
+    vkGetQueryPoolResults(context_->getDevice(), queryPool_, firstQuery, queryCount,
+        sizeof(uint64_t) * results.size(), results.data(), sizeof(uint64_t) * 2,
+        VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+
+    bool hasResult = false;
+    for (uint32_t scope = 0; scope < scopeCount_; ++scope) {
+        const uint64_t* begin = &results[scope * 4];
+        const uint64_t* end = &results[scope * 4 + 2];
+        if (begin[1] == 0 || end[1] == 0) {
+            continue;
+        }
+        const uint64_t ticks = (end[0] - begin[0]) & timestampMask_;
+        outMilliseconds[scope] = static_cast<double>(ticks) * timestampPeriod_ / 1000000.0;
+        hasResult = true;
+    }
+
+    // 다음 제출이 기록하지 않으면 결과가 없도록 되돌립니다.
+    vkResetQueryPool(context_->getDevice(), queryPool_, firstQuery, queryCount);
+    return hasResult;
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <vulkan/vulkan.h>
+#include <vector>
+#include <cstdint>
+
+class VulkanContext;
+
+// 프레임 슬롯마다 구간 몇 개의 GPU 시간을 재는 타임스탬프 쿼리
+//  - 쿼리는 호스트에서 리셋합니다. 커맨드 버퍼에는 리셋을 넣지 않으므로 캐시된 커맨드 버퍼를 다시 제출해도 그대로 잽니다.
+//  - 슬롯의 펜스를 기다린 뒤 resolve()로 지난번 그 슬롯 제출의 결과를 읽고 다시 리셋합니다.
+//    그 제출에서 기록되지 않은 구간(꺼진 패스)은 쿼리가 사용 불가 상태로 남으므로 결과가 없습니다.
+// 호스트 쿼리 리셋이나 그래픽스 큐 타임스탬프를 지원하지 않으면 아무것도 하지 않습니다.
+class GpuTimer
+{
+public:
+    GpuTimer() = default;
+    ~GpuTimer();
+
+    GpuTimer(const GpuTimer&) = delete;
+    GpuTimer& operator=(const GpuTimer&) = delete;
+
+    void initialize(const VulkanContext* context, uint32_t framesInFlight, uint32_t scopeCount);
+    void cleanup();
+    bool isSupported() const { return queryPool_ != VK_NULL_HANDLE; }
+
+    // 렌더링 패스 밖에서 그래픽스 큐 커맨드 버퍼에 기록합니다.
+    void beginScope(VkCommandBuffer commandBuffer, uint32_t frameIndex, uint32_t scope);
+    void endScope(VkCommandBuffer commandBuffer, uint32_t frameIndex, uint32_t scope);
+
+    // 구간마다 밀리초, 결과가 없는 구간은 음수입니다. 결과가 하나라도 있으면 true
+    bool resolve(uint32_t frameIndex, std::vector<double>& outMilliseconds);
+
+private:
+    uint32_t getQueryIndex(uint32_t frameIndex, uint32_t scope) const { return (frameIndex * scopeCount_ + scope) * 2; }
+
+    const VulkanContext* context_ = nullptr;
+    VkQueryPool queryPool_ = VK_NULL_HANDLE;
+    uint32_t framesInFlight_ = 0;
+    uint32_t scopeCount_ = 0;
+    double timestampPeriod_ = 0.0;  // 나노초 / 틱
+    uint64_t timestampMask_ = 0;    // timestampValidBits만큼
+};
@@ -0,0 +1,242 @@
+#include "HiZPyramid.h"
+#include "VulkanContext.h"
+#include "DescriptorPool.h"
+#include "ComputePipeline.h"
+#include "RenderTarget.h"
+#include "Texture.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+    // hiz_downsample.comp의 PushConstants와 일치해야 합니다.
+    struct DownsamplePushConstants {
+        int32_t srcSize[2];
+        int32_t dstSize[2];
+        int32_t srcLevel;
+    };
+}
+
+HiZPyramid::HiZPyramid(const VulkanContext* context, DescriptorPool* descriptorPool,
+    ComputePipeline& downsamplePipeline, const RenderTarget& sceneRenderTarget)
+{
+    this->context = context;
+
+    depthView_ = sceneRenderTarget.getDepthView();
+    depthExtent_ = sceneRenderTarget.getExtent();
+
+    // 0번 밉이 이미 깊이의 절반 크기 (원본 해상도 단계는 컬링에 필요 없습니다)
+    extent_.width = std::max(1u, depthExtent_.width / 2);
+    extent_.height = std::max(1u, depthExtent_.height / 2);
+    mipCount_ = 1;
+    for (uint32_t size = std::max(extent_.width, extent_.height); size > 1; size /= 2) {
+        mipCount_++;
+    }
+
+    createImage();
+    createViews();
+    createSampler();
+    createDescriptorSets(descriptorPool, downsamplePipeline);
+
+    imageInfo_.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+    imageInfo_.imageView = fullView_;
+    imageInfo_.sampler = sampler_;
+}
+
+HiZPyramid::~HiZPyramid()
+{
+    VkDevice device = context->getDevice();
+    // 디스크립터 셋은 풀이 정리될 때 함께 해제됩니다.
+    for (VkImageView view : mipViews_) {
+        vkDestroyImageView(device, view, nullptr);
+    }
+    vkDestroyImageView(device, fullView_, nullptr);
+    vkDestroySampler(device, sampler_, nullptr);
+    vkDestroyImage(device, image_, nullptr);
+    context->getMemoryAllocator().free(imageAllocation_);
+}
+
+void HiZPyramid::createImage()
+{
+    VkImageCreateInfo imageInfo{};
+    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    imageInfo.imageType = VK_IMAGE_TYPE_2D;
+    imageInfo.extent = { extent_.width, extent_.height, 1 };
+    imageInfo.mipLevels = mipCount_;
+    imageInfo.arrayLayers = 1;
+    imageInfo.format = VK_FORMAT_R32_SFLOAT;
+    imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    imageInfo.usage = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+
+    if (vkCreateImage(context->getDevice(), &imageInfo, nullptr, &image_) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create hi-z image!");
+    }
+
+    imageAllocation_ = context->getMemoryAllocator().allocateForImage(image_, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+    // 한 번만 GENERAL로 옮겨두고 이후로는 레이아웃을 바꾸지 않습니다.
+    VkCommandBuffer commandBuffer = beginSingleTimeCommands();
+
+    VkImageMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    barrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = image_;
+    barrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, mipCount_, 0, 1 };
+    barrier.srcAccessMask = 0;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+
+    vkCmdPipelineBarrier(commandBuffer,
+        VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+    endSingleTimeCommands(commandBuffer);
+}
+
+void HiZPyramid::createViews()
+{
+    VkImageViewCreateInfo viewInfo{};
+    viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    viewInfo.image = image_;
+    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    viewInfo.format = VK_FORMAT_R32_SFLOAT;
+    viewInfo.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, mipCount_, 0, 1 };
+
+    if (vkCreateImageView(context->getDevice(), &viewInfo, nullptr, &fullView_) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create hi-z image view!");
+    }
+
+    mipViews_.resize(mipCount_);
+    for (uint32_t level = 0; level < mipCount_; ++level) {
+        viewInfo.subresourceRange.baseMipLevel = level;
+        viewInfo.subresourceRange.levelCount = 1;
+        if (vkCreateImageView(context->getDevice(), &viewInfo, nullptr, &mipViews_[level]) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create hi-z mip view!");
+        }
+    }
+}
+
+void HiZPyramid::createSampler()
+{
+    VkSamplerCreateInfo samplerInfo{};
+    samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    samplerInfo.magFilter = VK_FILTER_NEAREST;
+    samplerInfo.minFilter = VK_FILTER_NEAREST;
+    samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+    samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.anisotropyEnable = VK_FALSE;
+    samplerInfo.compareEnable = VK_FALSE;
+    samplerInfo.minLod = 0.0f;
+    samplerInfo.maxLod = static_cast<float>(mipCount_);
+    samplerInfo.borderColor = VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE;
+
+    if (vkCreateSampler(context->getDevice(), &samplerInfo, nullptr, &sampler_) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create hi-z sampler!");
+    }
+}
+
+void HiZPyramid::createDescriptorSets(DescriptorPool* descriptorPool, ComputePipeline& downsamplePipeline)
+{
+    // 밉마다 입력/출력이 달라서 DescriptorSet(리소스 목록 기반) 대신 직접 기록합니다.
+    const auto& bindingMap = downsamplePipeline.GetDescriptorSetLayoutBindingMap();
+    auto setIt = bindingMap.find(0);
+    if (setIt == bindingMap.end()) {
+        throw std::runtime_error("hi-z downsample shader has no descriptor set 0!");
+    }
+
+    std::vector<VkDescriptorSetLayoutBinding> layoutBindings;
+    for (const auto& [bindingIndex, layoutBinding] : setIt->second) {
+        layoutBindings.push_back(layoutBinding.bindingInfo);
+    }
+    VkDescriptorSetLayout layout = descriptorPool->layoutCache_.getLayout(layoutBindings);
+
+    mipDescriptorSets_.resize(mipCount_);
+    for (uint32_t level = 0; level < mipCount_; ++level) {
+        descriptorPool->allocateDescriptorSet(layout, mipDescriptorSets_[level]);
+
+        // 0번 밉은 씬 깊이, 나머지는 바로 위 밉을 읽습니다. (읽기/쓰기 밉이 겹치지 않음)
+        VkDescriptorImageInfo srcInfo{};
+        srcInfo.sampler = sampler_;
+        srcInfo.imageView = (level == 0) ? depthView_ : fullView_;
+        srcInfo.imageLayout = (level == 0) ? VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_GENERAL;
+
+        VkDescriptorImageInfo dstInfo{};
+        dstInfo.imageView = mipViews_[level];
+        dstInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+
+        VkWriteDescriptorSet writes[2]{};
+        writes[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[0].dstSet = mipDescriptorSets_[level];
+        writes[0].dstBinding = 0;
+        writes[0].descriptorCount = 1;
+        writes[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        writes[0].pImageInfo = &srcInfo;
+
+        writes[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[1].dstSet = mipDescriptorSets_[level];
+        writes[1].dstBinding = 1;
+        writes[1].descriptorCount = 1;
+        writes[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        writes[1].pImageInfo = &dstInfo;
+
+        vkUpdateDescriptorSets(context->getDevice(), 2, writes, 0, nullptr);
+    }
+}
+
+void HiZPyramid::build(VkCommandBuffer commandBuffer, ComputePipeline& downsamplePipeline) const
+{
+    downsamplePipeline.bindPipeline(commandBuffer);
+
+    VkMemoryBarrier2 mipBarrier{};
+    mipBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+    mipBarrier.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    mipBarrier.srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+    mipBarrier.dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    mipBarrier.dstAccessMask = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT;
+
+    VkDependencyInfo dependencyInfo{};
+    dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependencyInfo.memoryBarrierCount = 1;
+    dependencyInfo.pMemoryBarriers = &mipBarrier;
+
+    VkExtent2D srcExtent = depthExtent_;
+    for (uint32_t level = 0; level < mipCount_; ++level) {
+        VkExtent2D dstExtent = { std::max(1u, extent_.width >> level), std::max(1u, extent_.height >> level) };
+
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE,
+            downsamplePipeline.getPipelineLayout(), 0, 1, &mipDescriptorSets_[level], 0, nullptr);
+
+        DownsamplePushConstants pushData{};
+        pushData.srcSize[0] = static_cast<int32_t>(srcExtent.width);
+        pushData.srcSize[1] = static_cast<int32_t>(srcExtent.height);
+        pushData.dstSize[0] = static_cast<int32_t>(dstExtent.width);
+        pushData.dstSize[1] = static_cast<int32_t>(dstExtent.height);
+        pushData.srcLevel = (level == 0) ? 0 : static_cast<int32_t>(level - 1);
+        vkCmdPushConstants(commandBuffer, downsamplePipeline.getPipelineLayout(), VK_SHADER_STAGE_COMPUTE_BIT,
+            0, sizeof(DownsamplePushConstants), &pushData);
+
+        vkCmdDispatch(commandBuffer,
+            (dstExtent.width + DOWNSAMPLE_GROUP_SIZE - 1) / DOWNSAMPLE_GROUP_SIZE,
+            (dstExtent.height + DOWNSAMPLE_GROUP_SIZE - 1) / DOWNSAMPLE_GROUP_SIZE,
+            1);
+
+        // 다음 밉(또는 레이트 컬링)이 방금 쓴 밉을 읽습니다.
+        vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+        srcExtent = dstExtent;
+    }
+}
+
+void HiZPyramid::populateWriteDescriptor(VkWriteDescriptorSet& writeInfo) const
+{
+    writeInfo.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    writeInfo.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    writeInfo.descriptorCount = 1;
+    writeInfo.pImageInfo = &imageInfo_;
+}
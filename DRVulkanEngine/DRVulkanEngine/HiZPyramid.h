@@ -0,0 +1,57 @@
+#pragma once
+#include "Resource.h"
+#include <vector>
+
+class VulkanContext;
+class DescriptorPool;
+class ComputePipeline;
+class RenderTarget;
+
+// 씬 깊이로 만드는 계층형 깊이 버퍼 (Hi-Z)
+// 각 텍셀은 아래 단계 2x2(홀수 크기면 3x3) 영역의 최대 깊이를 가지므로,
+// 바운딩 박스가 덮는 텍셀의 최대 깊이보다 박스의 최소 깊이가 더 멀면 확실히 가려진 것입니다.
+// 이미지는 항상 GENERAL 레이아웃에 두고 컴퓨트에서만 읽고 씁니다.
+class HiZPyramid : public Resource
+{
+public:
+    static constexpr uint32_t DOWNSAMPLE_GROUP_SIZE = 8; // hiz_downsample.comp의 local_size_x/y
+
+    HiZPyramid(const VulkanContext* context, DescriptorPool* descriptorPool,
+        ComputePipeline& downsamplePipeline, const RenderTarget& sceneRenderTarget);
+    ~HiZPyramid();
+
+    HiZPyramid(const HiZPyramid&) = delete;
+    HiZPyramid& operator=(const HiZPyramid&) = delete;
+
+    // 렌더링 패스 밖에서 기록해야 합니다.
+    // 깊이는 READ_ONLY_OPTIMAL, 피라미드는 GENERAL이어야 하며 전후의 레이아웃 전환은 렌더 그래프가 맡습니다.
+    void build(VkCommandBuffer commandBuffer, ComputePipeline& downsamplePipeline) const;
+
+    VkImage getImage() const { return image_; }
+    VkExtent2D getExtent() const { return extent_; }
+    uint32_t getMipCount() const { return mipCount_; }
+
+    virtual void populateWriteDescriptor(VkWriteDescriptorSet& writeInfo) const override;
+
+private:
+    void createImage();
+    void createViews();
+    void createSampler();
+    void createDescriptorSets(DescriptorPool* descriptorPool, ComputePipeline& downsamplePipeline);
+
+private:
+    VkImage image_ = VK_NULL_HANDLE;
+    MemoryAllocation imageAllocation_;
+    VkImageView fullView_ = VK_NULL_HANDLE;     // 컬링 셰이더가 textureLod로 읽는 전체 밉 뷰
+    std::vector<VkImageView> mipViews_;         // 다운샘플 출력용 (storage image)
+    VkSampler sampler_ = VK_NULL_HANDLE;        // NEAREST + CLAMP (보간하면 보수적이지 않음)
+    std::vector<VkDescriptorSet> mipDescriptorSets_;
+
+    VkImageView depthView_ = VK_NULL_HANDLE;
+    VkExtent2D depthExtent_{};
+
+    VkExtent2D extent_{};
+    uint32_t mipCount_ = 0;
+
+    mutable VkDescriptorImageInfo imageInfo_{};
+};
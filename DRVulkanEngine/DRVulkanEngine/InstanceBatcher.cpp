@@ -0,0 +1,468 @@
+#include "InstanceBatcher.h"
+#include "VulkanContext.h"
+#include "GpuScene.h"
+#include "StorageBuffer.h"
+#include "ComputePipeline.h"
+#include "Model.h"
+#include "Mesh.h"
+#include "FrustumCuller.h"
+#include "CommandEncoder.h"
+#include <iostream>
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+namespace
+{
+    // cull.comp의 CullParamsPtr와 일치해야 합니다. (std430)
+    struct CullParams {
+        glm::mat4 viewProj;
+        glm::vec4 frustumPlanes[6];
+        glm::vec4 cameraPosition;
+        VkDeviceAddress cullEntryAddress;
+        VkDeviceAddress objectRecordAddress;
+        VkDeviceAddress visibilityAddress;
+        VkDeviceAddress paletteAddress;
+        glm::vec2 hizSize;
+        glm::vec2 screenSize;
+        uint32_t hizMipCount;
+        uint32_t objectCount;
+        uint32_t maxBatches;
+        uint32_t paletteBaseIndex;
+    };
+
+    // cull.comp의 PushConstants와 일치해야 합니다.
+    struct CullPushConstants {
+        VkDeviceAddress paramsAddress;
+        VkDeviceAddress visibleInstanceAddress;
+        VkDeviceAddress drawArgsAddress;
+        uint32_t phase;
+        uint32_t padding;
+    };
+
+    // cluster_cull.comp의 PushConstants와 일치해야 합니다.
+    struct ClusterCullPushConstants {
+        VkDeviceAddress paramsAddress;
+        VkDeviceAddress visibleInstanceAddress;
+        VkDeviceAddress instanceDrawArgsAddress;
+        VkDeviceAddress clusterBatchAddress;
+        VkDeviceAddress clusterDrawArgsAddress;
+        uint32_t maxClusterDraws;
+        uint32_t padding;
+    };
+}
+
+void InstanceBatcher::initialize(const VulkanContext* context, GpuScene* scene, uint32_t framesInFlight, uint32_t maxInstances, uint32_t maxBatches, uint32_t maxClusterDraws)
+{
+    context_ = context;
+    scene_ = scene;
+    maxInstances_ = maxInstances;
+    maxBatches_ = maxBatches;
+    maxClusterDraws_ = maxClusterDraws;
+
+    frameBuffers_.clear();
+    frameBuffers_.resize(framesInFlight);
+    for (FrameBuffers& frame : frameBuffers_) {
+        frame.cullParams = std::make_unique<StorageBuffer>(context_, sizeof(CullParams));
+        frame.cullEntries = std::make_unique<StorageBuffer>(context_, sizeof(CullEntryData) * maxInstances_);
+        for (uint32_t phase = 0; phase < CULL_PHASE_COUNT; ++phase) {
+            frame.visibleInstances[phase] = std::make_unique<StorageBuffer>(context_, sizeof(InstanceData) * maxInstances_);
+            frame.drawArgs[phase] = std::make_unique<StorageBuffer>(context_,
+                getDrawCountOffset() + sizeof(uint32_t) * maxBatches_,
+                VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT);
+            frame.clusterDrawArgs[phase] = std::make_unique<StorageBuffer>(context_,
+                getClusterDrawCountOffset() + sizeof(uint32_t) * maxBatches_,
+                VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT);
+        }
+        frame.clusterBatches = std::make_unique<StorageBuffer>(context_, sizeof(ClusterBatchData) * maxBatches_);
+    }
+
+    pending_.reserve(maxInstances_);
+    cullEntries_.reserve(maxInstances_);
+    drawCommands_.reserve(maxBatches_);
+    clusterBatches_.reserve(maxBatches_);
+    batchDistances_.reserve(maxBatches_);
+    renderQueue_.reserve(maxBatches_);
+}
+
+void InstanceBatcher::cleanup()
+{
+    frameBuffers_.clear();
+    batchIndices_.clear();
+    pending_.clear();
+    batches_.clear();
+    cullEntries_.clear();
+    drawCommands_.clear();
+    clusterBatches_.clear();
+    renderQueue_.clear();
+}
+
+void InstanceBatcher::begin()
+{
+    batchIndices_.clear();
+    pending_.clear();
+    batches_.clear();
+    cullEntries_.clear();
+    drawCommands_.clear();
+    renderQueue_.clear();
+    droppedInstances_ = 0;
+    droppedBatchInstances_ = 0;
+    layoutDirty_ = true;
+}
+
+void InstanceBatcher::addModel(const Model& model)
+{
+    const ModelAsset* asset = model.getAsset();
+    if (!asset) {
+        return;
+    }
+
+    for (size_t meshIndex = 0; meshIndex < asset->meshes.size(); ++meshIndex) {
+        const Mesh& mesh = asset->meshes[meshIndex];
+        const uint32_t objectId = model.getObjectId(meshIndex);
+        if (objectId == GpuScene::INVALID_OBJECT) {
+            continue; // 아직 GPU 씬에 등록되지 않은 모델
+        }
+        if (pending_.size() >= maxInstances_) {
+            droppedInstances_++;
+            continue;
+        }
+
+        auto it = batchIndices_.find(&mesh);
+        if (it == batchIndices_.end()) {
+            if (batches_.size() >= maxBatches_) {
+                droppedBatchInstances_++;
+                continue;
+            }
+            it = batchIndices_.emplace(&mesh, static_cast<uint32_t>(batches_.size())).first;
+            DrawBatch batch{};
+            batch.mesh = &mesh;
+            batches_.push_back(batch);
+        }
+        batches_[it->second].instanceCount++;
+
+        // 바뀌지 않은 레코드는 GpuScene이 걸러내므로 업로드되지 않습니다.
+        ObjectRecord record;
+        model.getObjectRecord(meshIndex, record);
+        scene_->setObject(objectId, record);
+
+        CullEntryData entry{};
+        entry.objectId = objectId;
+        entry.batchIndex = it->second;
+        pending_.push_back(entry);
+    }
+}
+
+void InstanceBatcher::build(uint32_t frameIndex, const glm::mat4& viewProj, const glm::vec3& cameraPosition, VkExtent2D screenExtent,
+    VkExtent2D hizExtent, uint32_t hizMipCount, VkDeviceAddress paletteAddress, uint32_t paletteBaseIndex)
+{
+    frameIndex_ = frameIndex;
+
+    // 인스턴스 목록이 그대로인 프레임은 배치 수에 비례하는 일(정렬, 드로우 인자 초기화)만 합니다.
+    if (layoutDirty_) {
+        buildLayout();
+        layoutDirty_ = false;
+    }
+
+    sortBatches(cameraPosition);
+
+    // 오브젝트 데이터는 GpuScene에 있고 여기는 ID 목록뿐이라, 목록을 다시 만든 뒤 슬롯마다 한 번만 올립니다.
+    FrameBuffers& frame = frameBuffers_[frameIndex_];
+    if (frame.uploadedLayoutVersion != layoutVersion_) {
+        frame.cullEntries->update(cullEntries_.data(), sizeof(CullEntryData) * cullEntries_.size());
+        frame.uploadedLayoutVersion = layoutVersion_;
+    }
+
+    // 드로우 개수는 모두 0에서 시작 (첫 인스턴스가 살아남으면 cull.comp가 1로 설정)
+    batchCursors_.assign(batches_.size(), 0);
+    for (uint32_t phase = 0; phase < CULL_PHASE_COUNT; ++phase) {
+        frame.drawArgs[phase]->update(drawCommands_.data(), sizeof(VkDrawIndexedIndirectCommand) * drawCommands_.size());
+        frame.drawArgs[phase]->update(batchCursors_.data(), sizeof(uint32_t) * batchCursors_.size(), getDrawCountOffset());
+        frame.clusterDrawArgs[phase]->update(batchCursors_.data(), sizeof(uint32_t) * batchCursors_.size(), getClusterDrawCountOffset());
+    }
+    frame.clusterBatches->update(clusterBatches_.data(), sizeof(ClusterBatchData) * clusterBatches_.size());
+
+    CullParams params{};
+    params.viewProj = viewProj;
+    Frustum frustum = Frustum::FromViewProj(viewProj);
+    std::copy(std::begin(frustum.planes), std::end(frustum.planes), params.frustumPlanes);
+    params.cameraPosition = glm::vec4(cameraPosition, 1.0f);
+    params.cullEntryAddress = frame.cullEntries->getDeviceAddress();
+    params.objectRecordAddress = scene_->getRecordAddress();
+    params.visibilityAddress = scene_->getVisibilityAddress();
+    params.paletteAddress = paletteAddress;
+    params.hizSize = glm::vec2(static_cast<float>(hizExtent.width), static_cast<float>(hizExtent.height));
+    params.screenSize = glm::vec2(static_cast<float>(screenExtent.width), static_cast<float>(screenExtent.height));
+    params.hizMipCount = hizMipCount;
+    params.objectCount = static_cast<uint32_t>(cullEntries_.size());
+    params.maxBatches = maxBatches_;
+    params.paletteBaseIndex = paletteBaseIndex;
+    frame.cullParams->update(&params, sizeof(CullParams));
+}
+
+void InstanceBatcher::buildLayout()
+{
+    if (!overflowReported_ && (droppedInstances_ > 0 || droppedBatchInstances_ > 0)) {
+        std::cerr << "instance batcher is full, skipping " << droppedInstances_ << " instances (max " << maxInstances_ << ")"
+                  << " and " << droppedBatchInstances_ << " instances of new meshes (max " << maxBatches_ << " batches)" << std::endl;
+        overflowReported_ = true;
+    }
+
+    // 배치별 개수로 영역 시작 위치를 정한 뒤 한 번에 흩뿌립니다. (정렬 없이 O(N))
+    // 컬링 결과는 각 배치 영역 안에서 앞쪽부터 압축됩니다.
+    // 클러스터 드로우 영역은 모든 인스턴스의 모든 메시렛이 살아남는 경우만큼 잡습니다.
+    // 넘치는 배치는 클러스터 컬링 없이 인스턴스 드로우로 그립니다.
+    uint32_t offset = 0;
+    uint32_t clusterOffset = 0;
+    drawCommands_.resize(batches_.size());
+    batchCursors_.resize(batches_.size());
+    clusterBatches_.resize(batches_.size());
+    for (size_t i = 0; i < batches_.size(); ++i) {
+        DrawBatch& batch = batches_[i];
+        batch.firstInstance = offset;
+        batchCursors_[i] = offset;
+        offset += batch.instanceCount;
+
+        uint64_t clusterCapacity = static_cast<uint64_t>(batch.instanceCount) * batch.mesh->getMeshletCount();
+        ClusterBatchData& clusterBatch = clusterBatches_[i];
+        clusterBatch = ClusterBatchData{};
+        batch.clusterDrawOffset = 0;
+        batch.clusterDrawCapacity = 0;
+        if (clusterCapacity > 0 && clusterOffset + clusterCapacity <= maxClusterDraws_) {
+            batch.clusterDrawOffset = clusterOffset;
+            batch.clusterDrawCapacity = static_cast<uint32_t>(clusterCapacity);
+            clusterBatch.meshletAddress = batch.mesh->getMeshletAddress();
+            clusterBatch.meshletCount = batch.mesh->getMeshletCount();
+            clusterBatch.clusterDrawOffset = clusterOffset;
+            clusterOffset += batch.clusterDrawCapacity;
+        }
+
+        VkDrawIndexedIndirectCommand& command = drawCommands_[i];
+        command.indexCount = batch.mesh->getIndexCount();
+        command.instanceCount = 0; // cull.comp가 살아남은 인스턴스 수만큼 증가
+        command.firstIndex = 0;
+        command.vertexOffset = 0;
+        // 간접 인자의 firstInstance는 drawIndirectFirstInstance 기능이 켜져 있어야 쓰입니다. (VulkanContext가 필수로 요구)
+        command.firstInstance = batch.firstInstance;
+    }
+
+    cullEntries_.resize(pending_.size());
+    for (const CullEntryData& entry : pending_) {
+        cullEntries_[batchCursors_[entry.batchIndex]++] = entry;
+    }
+
+    computeBatchBounds();
+
+    uint64_t recordHash = hashRecordLayout();
+    if (recordHash != recordHash_) {
+        recordHash_ = recordHash;
+        recordVersion_++;
+    }
+    layoutVersion_++;
+}
+
+void InstanceBatcher::computeBatchBounds()
+{
+    // 인스턴스 바운딩 스피어를 월드로 옮겨 배치마다 AABB로 모은 뒤, 그 중심에서 모든 스피어를 감싸는 반지름을 구합니다.
+    auto worldSphere = [this](const CullEntryData& entry) {
+        const ObjectRecord& object = scene_->getObject(entry.objectId);
+        const glm::mat4& world = object.world;
+        glm::vec3 center = glm::vec3(world * glm::vec4(glm::vec3(object.boundingSphere), 1.0f));
+        float scale = std::max({ glm::length(glm::vec3(world[0])), glm::length(glm::vec3(world[1])), glm::length(glm::vec3(world[2])) });
+        return glm::vec4(center, object.boundingSphere.w * scale);
+    };
+
+    batchBoundsMin_.assign(batches_.size(), glm::vec3(std::numeric_limits<float>::max()));
+    batchBoundsMax_.assign(batches_.size(), glm::vec3(std::numeric_limits<float>::lowest()));
+    for (const CullEntryData& entry : cullEntries_) {
+        glm::vec4 sphere = worldSphere(entry);
+        batchBoundsMin_[entry.batchIndex] = glm::min(batchBoundsMin_[entry.batchIndex], glm::vec3(sphere) - sphere.w);
+        batchBoundsMax_[entry.batchIndex] = glm::max(batchBoundsMax_[entry.batchIndex], glm::vec3(sphere) + sphere.w);
+    }
+    for (size_t i = 0; i < batches_.size(); ++i) {
+        batches_[i].boundingSphere = glm::vec4((batchBoundsMin_[i] + batchBoundsMax_[i]) * 0.5f, 0.0f);
+    }
+    for (const CullEntryData& entry : cullEntries_) {
+        glm::vec4 sphere = worldSphere(entry);
+        glm::vec4& batchSphere = batches_[entry.batchIndex].boundingSphere;
+        batchSphere.w = std::max(batchSphere.w, glm::length(glm::vec3(sphere) - glm::vec3(batchSphere)) + sphere.w);
+    }
+}
+
+uint64_t InstanceBatcher::hashRecordLayout() const
+{
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](uint64_t value) {
+        for (int i = 0; i < 8; ++i) {
+            hash ^= (value >> (i * 8)) & 0xFF;
+            hash *= 1099511628211ull;
+        }
+    };
+
+    mix(cullEntries_.size());
+    mix(batches_.size());
+    for (const DrawBatch& batch : batches_) {
+        mix(reinterpret_cast<uintptr_t>(batch.mesh));
+        mix(batch.clusterDrawOffset);
+        mix(batch.clusterDrawCapacity);
+    }
+    return hash;
+}
+
+void InstanceBatcher::sortBatches(const glm::vec3& cameraPosition)
+{
+    // 배치마다 카메라에서 배치 바운딩 스피어까지의 거리 (인스턴스가 아니라 배치 수에 비례)
+    batchDistances_.resize(batches_.size());
+    float maxDistance = 0.0f;
+    for (size_t i = 0; i < batches_.size(); ++i) {
+        const glm::vec4& sphere = batches_[i].boundingSphere;
+        batchDistances_[i] = std::max(glm::length(glm::vec3(sphere) - cameraPosition) - sphere.w, 0.0f);
+        maxDistance = std::max(maxDistance, batchDistances_[i]);
+    }
+
+    // 배치 하나가 메시 하나이고 파이프라인은 호출자가 정하므로 pipeline은 0, mesh는 배치 인덱스입니다.
+    renderQueue_.clear();
+    for (uint32_t i = 0; i < static_cast<uint32_t>(batches_.size()); ++i) {
+        const Material* material = batches_[i].mesh->getMaterial();
+        uint32_t materialId = material ? static_cast<uint32_t>(material->getMaterialIndex() + 1) : 0;
+        uint32_t depthBucket = RenderQueue::QuantizeDepth(batchDistances_[i], maxDistance);
+        renderQueue_.push(RenderQueue::MakeKey(RenderQueue::PASS_OPAQUE, 0, depthBucket, materialId, i), i);
+    }
+    renderQueue_.sort();
+}
+
+void InstanceBatcher::cull(VkCommandBuffer commandBuffer, ComputePipeline& cullPipeline, CullPhase phase) const
+{
+    if (cullEntries_.empty()) {
+        return;
+    }
+
+    const FrameBuffers& frame = frameBuffers_[frameIndex_];
+
+    if (phase == CULL_PHASE_EARLY) {
+        // 이전 프레임 LATE가 쓴 가시성과 Hi-Z 읽기가 끝난 뒤에 시작합니다.
+        VkMemoryBarrier2 visibilityBarrier{};
+        visibilityBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+        visibilityBarrier.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+        visibilityBarrier.srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+        visibilityBarrier.dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+        visibilityBarrier.dstAccessMask = VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+
+        VkDependencyInfo visibilityDependency{};
+        visibilityDependency.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+        visibilityDependency.memoryBarrierCount = 1;
+        visibilityDependency.pMemoryBarriers = &visibilityBarrier;
+        vkCmdPipelineBarrier2(commandBuffer, &visibilityDependency);
+    }
+
+    CullPushConstants pushData{};
+    pushData.paramsAddress = frame.cullParams->getDeviceAddress();
+    pushData.visibleInstanceAddress = frame.visibleInstances[phase]->getDeviceAddress();
+    pushData.drawArgsAddress = frame.drawArgs[phase]->getDeviceAddress();
+    pushData.phase = phase;
+
+    cullPipeline.bindPipeline(commandBuffer, frameIndex_);
+    vkCmdPushConstants(commandBuffer, cullPipeline.getPipelineLayout(), VK_SHADER_STAGE_COMPUTE_BIT,
+        0, sizeof(CullPushConstants), &pushData);
+
+    uint32_t objectCount = static_cast<uint32_t>(cullEntries_.size());
+    uint32_t groupCount = (objectCount + CULL_GROUP_SIZE - 1) / CULL_GROUP_SIZE;
+    vkCmdDispatch(commandBuffer, groupCount, 1, 1);
+
+    // 컴퓨트 쓰기 -> 클러스터 컬링의 읽기
+    // 간접 인자/인스턴스를 읽는 드로우 쪽 배리어(또는 큐 사이 세마포어)는 렌더 그래프가 넣습니다.
+    // 컴퓨트 전용 큐에 기록될 수 있으므로 그래픽스 단계를 여기 넣으면 안 됩니다.
+    VkMemoryBarrier2 barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+    barrier.srcStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    barrier.srcAccessMask = VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+    barrier.dstStageMask = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+    barrier.dstAccessMask = VK_ACCESS_2_SHADER_STORAGE_READ_BIT;
+
+    VkDependencyInfo dependencyInfo{};
+    dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependencyInfo.memoryBarrierCount = 1;
+    dependencyInfo.pMemoryBarriers = &barrier;
+    vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+}
+
+void InstanceBatcher::cullClusters(VkCommandBuffer commandBuffer, ComputePipeline& clusterCullPipeline, CullPhase phase) const
+{
+    if (cullEntries_.empty()) {
+        return;
+    }
+
+    const FrameBuffers& frame = frameBuffers_[frameIndex_];
+
+    ClusterCullPushConstants pushData{};
+    pushData.paramsAddress = frame.cullParams->getDeviceAddress();
+    pushData.visibleInstanceAddress = frame.visibleInstances[phase]->getDeviceAddress();
+    pushData.instanceDrawArgsAddress = frame.drawArgs[phase]->getDeviceAddress();
+    pushData.clusterBatchAddress = frame.clusterBatches->getDeviceAddress();
+    pushData.clusterDrawArgsAddress = frame.clusterDrawArgs[phase]->getDeviceAddress();
+    pushData.maxClusterDraws = maxClusterDraws_;
+
+    clusterCullPipeline.bindPipeline(commandBuffer);
+    vkCmdPushConstants(commandBuffer, clusterCullPipeline.getPipelineLayout(), VK_SHADER_STAGE_COMPUTE_BIT,
+        0, sizeof(ClusterCullPushConstants), &pushData);
+
+    // 인스턴스 슬롯마다 워크그룹 하나 (컬링된 슬롯은 바로 끝납니다)
+    // 클러스터 드로우 인자 -> 간접 드로우 배리어는 렌더 그래프가 패스 사이에 넣습니다.
+    vkCmdDispatch(commandBuffer, static_cast<uint32_t>(cullEntries_.size()), 1, 1);
+}
+
+void InstanceBatcher::draw(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, CullPhase phase) const
+{
+    CommandEncoder encoder(commandBuffer);
+    drawRange(encoder, pipelineLayout, phase, 0, getDrawCount());
+}
+
+void InstanceBatcher::drawRange(CommandEncoder& encoder, VkPipelineLayout pipelineLayout, CullPhase phase,
+    uint32_t batchBegin, uint32_t batchEnd) const
+{
+    batchEnd = std::min(batchEnd, getDrawCount());
+    if (batchBegin >= batchEnd) {
+        return;
+    }
+
+    const FrameBuffers& frame = frameBuffers_[frameIndex_];
+
+    PushConstantData pushData{};
+    pushData.instanceAddress = frame.visibleInstances[phase]->getDeviceAddress();
+    encoder.pushConstants(
+        pipelineLayout,
+        VK_SHADER_STAGE_VERTEX_BIT,
+        0,
+        sizeof(PushConstantData),
+        &pushData
+    );
+
+    // 메시마다 정점/인덱스 버퍼가 따로 있으므로 배치당 한 번씩 기록하고,
+    // 전부 컬링된 배치는 GPU가 드로우 개수 0으로 건너뜁니다.
+    VkBuffer drawArgsBuffer = frame.drawArgs[phase]->getBuffer();
+    VkBuffer clusterDrawArgsBuffer = frame.clusterDrawArgs[phase]->getBuffer();
+    for (size_t order = batchBegin; order < batchEnd; ++order) {
+        uint32_t i = renderQueue_.getItem(order);
+        const DrawBatch& batch = batches_[i];
+        batch.mesh->bind(encoder);
+        if (batch.clusterDrawCapacity > 0) {
+            // 메시렛 드로우마다 firstInstance에 인스턴스 슬롯이 들어 있습니다. (drawIndirectFirstInstance 필요)
+            encoder.drawIndexedIndirectCount(
+                clusterDrawArgsBuffer,
+                sizeof(VkDrawIndexedIndirectCommand) * batch.clusterDrawOffset,
+                clusterDrawArgsBuffer,
+                getClusterDrawCountOffset() + sizeof(uint32_t) * i,
+                batch.clusterDrawCapacity,
+                sizeof(VkDrawIndexedIndirectCommand));
+            continue;
+        }
+        encoder.drawIndexedIndirectCount(
+            drawArgsBuffer,
+            sizeof(VkDrawIndexedIndirectCommand) * i,
+            drawArgsBuffer,
+            getDrawCountOffset() + sizeof(uint32_t) * i,
+            1,
+            sizeof(VkDrawIndexedIndirectCommand));
+    }
+}
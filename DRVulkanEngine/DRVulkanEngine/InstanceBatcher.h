@@ -0,0 +1,156 @@
+#pragma once
+#include <vulkan/vulkan.h>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <glm/glm.hpp>
+#include "GlobalData.h"
+#include "RenderQueue.h"
+
+class VulkanContext;
+class GpuScene;
+class StorageBuffer;
+class ComputePipeline;
+class Model;
+class Mesh;
+class CommandEncoder;
+
+// 같은 메시를 쓰는 모델들을 하나의 인스턴스 드로우로 묶고, 컬링과 드로우 인자 생성은 GPU가 합니다.
+//  1) begin() 후 모델을 addModel()로 모으고 (모델의 오브젝트 레코드는 GpuScene에 갱신, 바뀐 것만 업로드됨)
+//  2) build()가 메시별로 묶은 컬링 입력(오브젝트 ID + 배치)과 드로우 템플릿을 이번 프레임 버퍼에 기록하면
+//     1)은 인스턴스 목록이나 변환이 바뀔 때만 합니다. 나머지 프레임은 build()만 불러 지난 목록을 그대로 컬링하므로
+//     CPU 비용이 오브젝트 수가 아니라 배치 수에 비례합니다.
+//  3) cull()이 컴퓨트로 프러스텀 컬링 후 살아남은 인스턴스를 배치 영역에 압축하고 instanceCount/드로우 개수를 채우며
+//  4) draw()는 메시마다 vkCmdDrawIndexedIndirectCount 한 번만 기록합니다. (오브젝트 수와 무관)
+// 메시는 재질을 하나만 가지므로 메시 단위로 묶으면 메시+재질 단위 배치가 됩니다.
+// 배치는 build()에서 RenderQueue 키로 정렬되어, 배치 바운딩 스피어 기준 앞에서 뒤로 그려집니다. (early-Z)
+//
+// cull()/draw()는 CullPhase별로 두 번 호출합니다. (2단계 Hi-Z 가림 컬링)
+//  EARLY: 지난 프레임에 보였던 인스턴스를 그리고, 그 깊이로 Hi-Z를 만든 뒤
+//  LATE : 모든 인스턴스를 Hi-Z로 검사해 가시성을 갱신하고 새로 보이게 된 것만 그립니다.
+// 단계마다 출력 버퍼가 따로 있어서 EARLY 드로우 인자를 LATE 컬링이 덮어쓰지 않습니다.
+//
+// 메시렛이 있는 메시는 cullClusters()가 살아남은 인스턴스의 메시렛을 한 번 더 컬링하고 (cluster_cull.comp)
+// draw()는 그 배치를 클러스터마다 드로우 커맨드 하나로 그립니다. (인덱스 버퍼의 메시렛 구간 x 인스턴스 1개)
+class InstanceBatcher
+{
+public:
+    // 수만 개 인스턴스(모델 x 메시)를 한 프레임에 컬링하도록 잡습니다. (InstanceData 80B x 단계 2개 x 프레임 수)
+    static constexpr uint32_t MAX_INSTANCES = 65536;
+    static constexpr uint32_t MAX_BATCHES = 1024;
+    static constexpr uint32_t MAX_CLUSTER_DRAWS = 262144;
+    static constexpr uint32_t CULL_GROUP_SIZE = 64; // cull.comp의 local_size_x
+
+    enum CullPhase : uint32_t {
+        CULL_PHASE_EARLY = 0,
+        CULL_PHASE_LATE = 1,
+        CULL_PHASE_COUNT
+    };
+
+    void initialize(const VulkanContext* context, GpuScene* scene, uint32_t framesInFlight,
+        uint32_t maxInstances = MAX_INSTANCES, uint32_t maxBatches = MAX_BATCHES, uint32_t maxClusterDraws = MAX_CLUSTER_DRAWS);
+    void cleanup();
+
+    // 인스턴스 목록을 처음부터 다시 모읍니다. 다음 build()가 배치 영역과 컬링 입력을 다시 만듭니다.
+    void begin();
+    void addModel(const Model& model);
+    // cameraPosition/screenExtent: 클러스터 백페이스/작은 클러스터 검사용
+    // hizExtent/hizMipCount: LATE 단계가 읽는 Hi-Z 피라미드의 0번 밉 크기와 밉 개수
+    // paletteAddress/paletteBaseIndex: 본 팔레트 풀의 이번 프레임 슬롯 시작 주소와 행렬 인덱스 (ObjectRecord::paletteOffset의 기준)
+    // GpuScene::flush() 뒤에 불러야 레코드 버퍼 주소가 맞습니다. begin() 없이 부르면 지난 인스턴스 목록을 씁니다.
+    void build(uint32_t frameIndex, const glm::mat4& viewProj, const glm::vec3& cameraPosition, VkExtent2D screenExtent,
+        VkExtent2D hizExtent, uint32_t hizMipCount, VkDeviceAddress paletteAddress, uint32_t paletteBaseIndex);
+
+    // 렌더링 패스 밖에서 기록해야 합니다. (컴퓨트 -> 간접 드로우 배리어 포함)
+    // LATE는 Hi-Z 피라미드가 cullPipeline의 디스크립터 셋에 바인딩되어 있어야 합니다.
+    void cull(VkCommandBuffer commandBuffer, ComputePipeline& cullPipeline, CullPhase phase) const;
+    // 같은 단계의 cull() 바로 뒤에 기록합니다. 드로우 전의 컴퓨트 -> 간접 드로우 배리어는 호출자(렌더 그래프)가 넣습니다.
+    void cullClusters(VkCommandBuffer commandBuffer, ComputePipeline& clusterCullPipeline, CullPhase phase) const;
+    // 푸시 상수는 배치마다가 아니라 패스당 한 번만 기록합니다.
+    void draw(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, CullPhase phase) const;
+    // 정렬된 순서의 [batchBegin, batchEnd) 배치만 기록합니다. 워커 스레드마다 secondary 커맨드 버퍼에 나눠 기록할 때 씁니다.
+    // 인코더가 같은 메시의 버퍼나 같은 푸시 상수가 이어지면 다시 기록하지 않습니다.
+    void drawRange(CommandEncoder& encoder, VkPipelineLayout pipelineLayout, CullPhase phase,
+        uint32_t batchBegin, uint32_t batchEnd) const;
+
+    uint32_t getDrawCount() const { return static_cast<uint32_t>(batches_.size()); }
+    uint32_t getInstanceCount() const { return static_cast<uint32_t>(cullEntries_.size()); }
+    // 인스턴스/배치 버퍼가 가득 차 지금 목록에서 빠진 인스턴스 수 (begin()에서 0으로)
+    uint32_t getDroppedInstanceCount() const { return droppedInstances_; }
+    uint32_t getDroppedBatchInstanceCount() const { return droppedBatchInstances_; }
+    // cull()/cullClusters()/draw()가 기록하는 커맨드가 달라질 때만 증가합니다. (배치 구성, 메시, 클러스터 영역, 디스패치 크기)
+    // 인스턴스 변환이나 카메라는 버퍼로만 전달되므로 바뀌어도 증가하지 않습니다. 그리는 순서도 포함하지 않습니다.
+    uint64_t getRecordVersion() const { return recordVersion_; }
+
+private:
+    struct DrawBatch {
+        const Mesh* mesh = nullptr;
+        uint32_t firstInstance = 0;
+        uint32_t instanceCount = 0;
+        // 클러스터 드로우 영역 (인스턴스 수 x 메시렛 수), 0이면 인스턴스 드로우로 그립니다.
+        uint32_t clusterDrawOffset = 0;
+        uint32_t clusterDrawCapacity = 0;
+        // 모든 인스턴스를 감싸는 월드 스피어 (목록을 만들 때 한 번 계산, 그리는 순서 정렬용)
+        glm::vec4 boundingSphere = glm::vec4(0.0f);
+    };
+
+    // cluster_cull.comp의 ClusterBatch와 일치해야 합니다.
+    struct ClusterBatchData {
+        VkDeviceAddress meshletAddress = 0;
+        uint32_t meshletCount = 0;
+        uint32_t clusterDrawOffset = 0;
+    };
+
+    struct FrameBuffers {
+        std::unique_ptr<StorageBuffer> cullParams;       // 두 단계가 같이 쓰는 행렬/평면/주소
+        std::unique_ptr<StorageBuffer> cullEntries;      // CPU -> 컬링 입력 (오브젝트 ID + 배치)
+        uint64_t uploadedLayoutVersion = 0;              // 이 슬롯에 마지막으로 올린 컬링 입력의 layoutVersion_
+        std::unique_ptr<StorageBuffer> visibleInstances[CULL_PHASE_COUNT]; // 컬링 출력, 버텍스 셰이더 입력
+        std::unique_ptr<StorageBuffer> drawArgs[CULL_PHASE_COUNT];         // [드로우 커맨드 x maxBatches][드로우 개수 x maxBatches]
+        std::unique_ptr<StorageBuffer> clusterBatches;   // 배치별 메시렛 주소/개수
+        std::unique_ptr<StorageBuffer> clusterDrawArgs[CULL_PHASE_COUNT];  // [드로우 커맨드 x maxClusterDraws][드로우 개수 x maxBatches]
+    };
+
+    // begin() 뒤 첫 build()에서만: 배치 영역, 컬링 입력 흩뿌리기, 드로우 템플릿, 배치 바운드
+    void buildLayout();
+    void computeBatchBounds();
+    void sortBatches(const glm::vec3& cameraPosition);
+    uint64_t hashRecordLayout() const;
+
+    VkDeviceSize getDrawCountOffset() const { return sizeof(VkDrawIndexedIndirectCommand) * maxBatches_; }
+    VkDeviceSize getClusterDrawCountOffset() const { return sizeof(VkDrawIndexedIndirectCommand) * maxClusterDraws_; }
+
+    const VulkanContext* context_ = nullptr;
+    GpuScene* scene_ = nullptr;
+    uint32_t maxInstances_ = 0;
+    uint32_t maxBatches_ = 0;
+    uint32_t maxClusterDraws_ = 0;
+    uint32_t frameIndex_ = 0;
+    uint64_t recordHash_ = 0;
+    uint64_t recordVersion_ = 0;
+    bool layoutDirty_ = false;
+    uint64_t layoutVersion_ = 0;
+    uint32_t droppedInstances_ = 0;
+    uint32_t droppedBatchInstances_ = 0;
+    // 넘침은 매 프레임 반복되므로 처음 한 번만 출력하고, 이후는 getDropped*Count()로 확인합니다.
+    bool overflowReported_ = false;
+
+    // 프레임 인 플라이트마다 하나씩 (GPU가 읽는 중인 버퍼를 덮어쓰지 않도록)
+    std::vector<FrameBuffers> frameBuffers_;
+    // 가시성은 GpuScene이 오브젝트 ID별로 들고 있어 다음 프레임 EARLY가 그대로 읽습니다.
+    // (EARLY/LATE 컬링 패스는 같은 큐에서 순서대로 실행되고 cull()이 시작할 때 컴퓨트 배리어를 겁니다)
+
+    // begin()에서 clear만 하고 용량은 재사용합니다.
+    std::unordered_map<const Mesh*, uint32_t> batchIndices_;
+    std::vector<CullEntryData> pending_;
+    std::vector<DrawBatch> batches_;
+    std::vector<CullEntryData> cullEntries_;
+    std::vector<VkDrawIndexedIndirectCommand> drawCommands_;
+    std::vector<uint32_t> batchCursors_;
+    std::vector<ClusterBatchData> clusterBatches_;
+    std::vector<float> batchDistances_;
+    std::vector<glm::vec3> batchBoundsMin_;
+    std::vector<glm::vec3> batchBoundsMax_;
+    // 배치 인덱스를 그리는 순서로 정렬한 큐, 드로우 인자 버퍼는 배치 인덱스 기준 그대로입니다.
+    RenderQueue renderQueue_;
+};
@@ -0,0 +1,322 @@
+#include "JsonValue.h"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <cstdlib>
+
+class JsonValue::Parser
+{
+public:
+    explicit Parser(const std::string& text) : text_(text) {}
+
+    JsonValue parseDocument()
+    {
+        JsonValue value = parseValue();
+        skipWhitespace();
+        if (position_ != text_.size()) {
+            fail("unexpected trailing characters");
+        }
+        return value;
+    }
+
+private:
+    [[noreturn]] void fail(const std::string& message) const
+    {
+        // 줄 번호를 같이 알려주면 손으로 쓴 파일을 고치기 쉽습니다.
+        size_t line = 1;
+        for (size_t i = 0; i < position_ && i < text_.size(); ++i) {
+            if (text_[i] == '\n') {
+                ++line;
+            }
+        }
+        throw std::runtime_error("failed to parse json (line " + std::to_string(line) + "): " + message);
+    }
+
+    void skipWhitespace()
+    {
+        while (position_ < text_.size()) {
+            char c = text_[position_];
+            if (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+                ++position_;
+            }
+            else {
+                break;
+            }
+        }
+    }
+
+    char peek()
+    {
+        skipWhitespace();
+        if (position_ >= text_.size()) {
+            fail("unexpected end of input");
+        }
+        return text_[position_];
+    }
+
+    void expect(char c)
+    {
+        if (peek() != c) {
+            fail(std::string("expected '") + c + "'");
+        }
+        ++position_;
+    }
+
+    bool consumeLiteral(const char* literal)
+    {
+        size_t length = std::char_traits<char>::length(literal);
+        if (text_.compare(position_, length, literal) == 0) {
+            position_ += length;
+            return true;
+        }
+        return false;
+    }
+
+    JsonValue parseValue()
+    {
+        char c = peek();
+        JsonValue value;
+        if (c == '{') {
+            value.type_ = Type::Object;
+            ++position_;
+            if (peek() == '}') {
+                ++position_;
+                return value;
+            }
+            while (true) {
+                if (peek() != '"') {
+                    fail("expected object key");
+                }
+                std::string key = parseString();
+                expect(':');
+                value.object_[key] = parseValue();
+                char next = peek();
+                ++position_;
+                if (next == '}') {
+                    break;
+                }
+                if (next != ',') {
+                    fail("expected ',' or '}'");
+                }
+            }
+        }
+        else if (c == '[') {
+            value.type_ = Type::Array;
+            ++position_;
+            if (peek() == ']') {
+                ++position_;
+                return value;
+            }
+            while (true) {
+                value.array_.push_back(parseValue());
+                char next = peek();
+                ++position_;
+                if (next == ']') {
+                    break;
+                }
+                if (next != ',') {
+                    fail("expected ',' or ']'");
+                }
+            }
+        }
+        else if (c == '"') {
+            value.type_ = Type::String;
+            value.string_ = parseString();
+        }
+        else if (consumeLiteral("true")) {
+            value.type_ = Type::Bool;
+            value.bool_ = true;
+        }
+        else if (consumeLiteral("false")) {
+            value.type_ = Type::Bool;
+            value.bool_ = false;
+        }
+        else if (consumeLiteral("null")) {
+            value.type_ = Type::Null;
+        }
+        else if (c == '-' || (c >= '0' && c <= '9')) {
+            const char* begin = text_.c_str() + position_;
+            char* end = nullptr;
+            value.type_ = Type::Number;
+            value.number_ = std::strtod(begin, &end);
+            if (end == begin) {
+                fail("invalid number");
+            }
+            position_ += static_cast<size_t>(end - begin);
+        }
+        else {
+            fail(std::string("unexpected character '") + c + "'");
+        }
+        return value;
+    }
+
+    static void appendUtf8(std::string& out, uint32_t codePoint)
+    {
+        if (codePoint < 0x80) {
+            out += static_cast<char>(codePoint);
+        }
+        else if (codePoint < 0x800) {
+            out += static_cast<char>(0xC0 | (codePoint >> 6));
+            out += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+        else if (codePoint < 0x10000) {
+            out += static_cast<char>(0xE0 | (codePoint >> 12));
+            out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+        else {
+            out += static_cast<char>(0xF0 | (codePoint >> 18));
+            out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+    }
+
+    uint32_t parseHex4()
+    {
+        if (position_ + 4 > text_.size()) {
+            fail("invalid unicode escape");
+        }
+        uint32_t value = 0;
+        for (int i = 0; i < 4; ++i) {
+            char h = text_[position_++];
+            value <<= 4;
+            if (h >= '0' && h <= '9') value |= static_cast<uint32_t>(h - '0');
+            else if (h >= 'a' && h <= 'f') value |= static_cast<uint32_t>(h - 'a' + 10);
+            else if (h >= 'A' && h <= 'F') value |= static_cast<uint32_t>(h - 'A' + 10);
+            else fail("invalid unicode escape");
+        }
+        return value;
+    }
+
+    std::string parseString()
+    {
+        expect('"');
+        std::string out;
+        while (true) {
+            if (position_ >= text_.size()) {
+                fail("unterminated string");
+            }
+            char c = text_[position_++];
+            if (c == '"') {
+                break;
+            }
+            if (c != '\\') {
+                out += c;
+                continue;
+            }
+            if (position_ >= text_.size()) {
+                fail("unterminated string");
+            }
+            char escape = text_[position_++];
+            switch (escape) {
+            case '"': out += '"'; break;
+            case '\\': out += '\\'; break;
+            case '/': out += '/'; break;
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'n': out += '\n'; break;
+            case 'r': out += '\r'; break;
+            case 't': out += '\t'; break;
+            case 'u': {
+                uint32_t codePoint = parseHex4();
+                // 서로게이트 쌍
+                if (codePoint >= 0xD800 && codePoint <= 0xDBFF && consumeLiteral("\\u")) {
+                    uint32_t low = parseHex4();
+                    codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                }
+                appendUtf8(out, codePoint);
+                break;
+            }
+            default:
+                fail("invalid escape");
+            }
+        }
+        return out;
+    }
+
+private:
+    const std::string& text_;
+    size_t position_ = 0;
+};
+
+JsonValue JsonValue::Parse(const std::string& text)
+{
+    Parser parser(text);
+    return parser.parseDocument();
+}
+
+JsonValue JsonValue::ParseFile(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("failed to open file: " + path);
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    std::string text = buffer.str();
+    // UTF-8 BOM
+    if (text.size() >= 3 && text.compare(0, 3, "\xEF\xBB\xBF") == 0) {
+        text.erase(0, 3);
+    }
+    return Parse(text);
+}
+
+bool JsonValue::asBool() const
+{
+    if (type_ != Type::Bool) {
+        throw std::runtime_error("json value is not a bool!");
+    }
+    return bool_;
+}
+
+double JsonValue::asNumber() const
+{
+    if (type_ != Type::Number) {
+        throw std::runtime_error("json value is not a number!");
+    }
+    return number_;
+}
+
+const std::string& JsonValue::asString() const
+{
+    if (type_ != Type::String) {
+        throw std::runtime_error("json value is not a string!");
+    }
+    return string_;
+}
+
+const std::vector<JsonValue>& JsonValue::asArray() const
+{
+    if (type_ != Type::Array) {
+        throw std::runtime_error("json value is not an array!");
+    }
+    return array_;
+}
+
+bool JsonValue::contains(const std::string& key) const
+{
+    return type_ == Type::Object && object_.find(key) != object_.end();
+}
+
+const JsonValue& JsonValue::operator[](const std::string& key) const
+{
+    if (type_ != Type::Object) {
+        throw std::runtime_error("json value is not an object!");
+    }
+    auto it = object_.find(key);
+    if (it == object_.end()) {
+        throw std::runtime_error("json object has no key: " + key);
+    }
+    return it->second;
+}
+
+bool JsonValue::getBool(const std::string& key, bool defaultValue) const
+{
+    return contains(key) ? (*this)[key].asBool() : defaultValue;
+}
+
+std::string JsonValue::getString(const std::string& key, const std::string& defaultValue) const
+{
+    return contains(key) ? (*this)[key].asString() : defaultValue;
+}
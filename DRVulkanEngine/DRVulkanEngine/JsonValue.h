@@ -0,0 +1,52 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <map>
+
+// 설정 파일(렌더 그래프 등)을 읽기 위한 최소한의 JSON 값
+// 숫자는 double 하나로 보관하고, 이스케이프는 \uXXXX를 포함해 표준 문법만 지원합니다.
+// 잘못된 문법이나 없는 키/타입 불일치는 std::runtime_error를 던집니다.
+class JsonValue
+{
+public:
+    enum class Type {
+        Null,
+        Bool,
+        Number,
+        String,
+        Array,
+        Object,
+    };
+
+    JsonValue() = default;
+
+    static JsonValue Parse(const std::string& text);
+    static JsonValue ParseFile(const std::string& path);
+
+    Type getType() const { return type_; }
+    bool isNull() const { return type_ == Type::Null; }
+    bool isArray() const { return type_ == Type::Array; }
+    bool isObject() const { return type_ == Type::Object; }
+
+    bool asBool() const;
+    double asNumber() const;
+    const std::string& asString() const;
+    const std::vector<JsonValue>& asArray() const;
+
+    // 오브젝트 멤버
+    bool contains(const std::string& key) const;
+    const JsonValue& operator[](const std::string& key) const;
+    // 키가 없으면 기본값을 돌려줍니다.
+    bool getBool(const std::string& key, bool defaultValue) const;
+    std::string getString(const std::string& key, const std::string& defaultValue) const;
+
+private:
+    class Parser;
+
+    Type type_ = Type::Null;
+    bool bool_ = false;
+    double number_ = 0.0;
+    std::string string_;
+    std::vector<JsonValue> array_;
+    std::map<std::string, JsonValue> object_;
+};
@@ -0,0 +1,251 @@
+#include "MaskedOcclusionBuffer.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // w가 이보다 작으면 near 평면에 걸친 것으로 보고 클리핑 대신 건너뜁니다.
+    // (가리개를 빼는 것과 피가림체를 보이게 두는 것 모두 보수적인 방향)
+    constexpr float NEAR_W_EPSILON = 1e-5f;
+    constexpr uint32_t FULL_COVERAGE = 0xFFFFFFFFu;
+
+    struct ScreenVertex {
+        float x;
+        float y;
+        float z;
+    };
+
+    ScreenVertex toScreen(const glm::vec4& clip, float width, float height)
+    {
+        float invW = 1.0f / clip.w;
+        ScreenVertex v;
+        v.x = (clip.x * invW * 0.5f + 0.5f) * width;
+        v.y = (clip.y * invW * 0.5f + 0.5f) * height;
+        v.z = clip.z * invW;
+        return v;
+    }
+}
+
+void MaskedOcclusionBuffer::initialize(uint32_t width, uint32_t height)
+{
+    tilesX_ = std::max(1u, (width + TILE_WIDTH - 1) / TILE_WIDTH);
+    tilesY_ = std::max(1u, (height + TILE_HEIGHT - 1) / TILE_HEIGHT);
+    width_ = tilesX_ * TILE_WIDTH;
+    height_ = tilesY_ * TILE_HEIGHT;
+
+    size_t tileCount = static_cast<size_t>(tilesX_) * tilesY_;
+    zMax0_.resize(tileCount);
+    zMax1_.resize(tileCount);
+    coverage_.resize(tileCount);
+    clear();
+}
+
+void MaskedOcclusionBuffer::clear()
+{
+    clearRows(0, tilesY_);
+}
+
+void MaskedOcclusionBuffer::clearRows(uint32_t tileRowBegin, uint32_t tileRowEnd)
+{
+    size_t begin = static_cast<size_t>(tileRowBegin) * tilesX_;
+    size_t end = static_cast<size_t>(std::min(tileRowEnd, tilesY_)) * tilesX_;
+    std::fill(zMax0_.begin() + begin, zMax0_.begin() + end, 1.0f);
+    std::fill(zMax1_.begin() + begin, zMax1_.begin() + end, 0.0f);
+    std::fill(coverage_.begin() + begin, coverage_.begin() + end, 0u);
+}
+
+void MaskedOcclusionBuffer::renderOccluder(const float* positions, uint32_t stride, size_t vertexCount,
+    const uint32_t* indices, size_t indexCount, const glm::mat4& worldViewProj)
+{
+    std::vector<glm::vec4> clipScratch;
+    renderOccluderRows(positions, stride, vertexCount, indices, indexCount, worldViewProj, 0, tilesY_, clipScratch);
+}
+
+void MaskedOcclusionBuffer::renderOccluderRows(const float* positions, uint32_t stride, size_t vertexCount,
+    const uint32_t* indices, size_t indexCount, const glm::mat4& worldViewProj,
+    uint32_t tileRowBegin, uint32_t tileRowEnd, std::vector<glm::vec4>& clipScratch)
+{
+    clipScratch.resize(vertexCount);
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(positions);
+    for (size_t i = 0; i < vertexCount; ++i) {
+        const float* p = reinterpret_cast<const float*>(bytes + i * stride);
+        clipScratch[i] = worldViewProj * glm::vec4(p[0], p[1], p[2], 1.0f);
+    }
+
+    tileRowEnd = std::min(tileRowEnd, tilesY_);
+    for (size_t i = 0; i + 2 < indexCount; i += 3) {
+        const glm::vec4& c0 = clipScratch[indices[i]];
+        const glm::vec4& c1 = clipScratch[indices[i + 1]];
+        const glm::vec4& c2 = clipScratch[indices[i + 2]];
+        if (c0.w < NEAR_W_EPSILON || c1.w < NEAR_W_EPSILON || c2.w < NEAR_W_EPSILON) {
+            continue;
+        }
+        rasterizeTriangle(c0, c1, c2, tileRowBegin, tileRowEnd);
+    }
+}
+
+void MaskedOcclusionBuffer::rasterizeTriangle(const glm::vec4& clip0, const glm::vec4& clip1, const glm::vec4& clip2,
+    uint32_t tileRowBegin, uint32_t tileRowEnd)
+{
+    float width = static_cast<float>(width_);
+    float height = static_cast<float>(height_);
+    ScreenVertex v0 = toScreen(clip0, width, height);
+    ScreenVertex v1 = toScreen(clip1, width, height);
+    ScreenVertex v2 = toScreen(clip2, width, height);
+
+    // near보다 앞은 클리핑하지 않으므로 버립니다.
+    if (v0.z < 0.0f || v1.z < 0.0f || v2.z < 0.0f) {
+        return;
+    }
+
+    float area = (v1.x - v0.x) * (v2.y - v0.y) - (v1.y - v0.y) * (v2.x - v0.x);
+    if (std::abs(area) < 1e-6f) {
+        return;
+    }
+    // 가리개는 양면으로 그립니다. (와인딩을 맞춰 엣지 함수가 안쪽에서 양수가 되도록)
+    if (area < 0.0f) {
+        std::swap(v1, v2);
+        area = -area;
+    }
+
+    float minX = std::min({ v0.x, v1.x, v2.x });
+    float maxX = std::max({ v0.x, v1.x, v2.x });
+    float minY = std::min({ v0.y, v1.y, v2.y });
+    float maxY = std::max({ v0.y, v1.y, v2.y });
+    if (maxX < 0.0f || maxY < 0.0f || minX >= width || minY >= height) {
+        return;
+    }
+
+    int tileX0 = std::max(0, static_cast<int>(minX) / static_cast<int>(TILE_WIDTH));
+    int tileX1 = std::min(static_cast<int>(tilesX_) - 1, static_cast<int>(maxX) / static_cast<int>(TILE_WIDTH));
+    int tileY0 = std::max(static_cast<int>(tileRowBegin), static_cast<int>(minY) / static_cast<int>(TILE_HEIGHT));
+    int tileY1 = std::min(static_cast<int>(tileRowEnd) - 1, static_cast<int>(maxY) / static_cast<int>(TILE_HEIGHT));
+    if (tileX0 > tileX1 || tileY0 > tileY1) {
+        return;
+    }
+
+    // 깊이 평면 z = a*x + b*y + c (타일 모서리에서 평가해 타일 안 최대/최소를 구함)
+    float invArea = 1.0f / area;
+    float depthA = ((v1.z - v0.z) * (v2.y - v0.y) - (v2.z - v0.z) * (v1.y - v0.y)) * invArea;
+    float depthB = ((v2.z - v0.z) * (v1.x - v0.x) - (v1.z - v0.z) * (v2.x - v0.x)) * invArea;
+    float depthC = v0.z - depthA * v0.x - depthB * v0.y;
+    float triMinZ = std::min({ v0.z, v1.z, v2.z });
+    float triMaxZ = std::max({ v0.z, v1.z, v2.z });
+
+    // 엣지 함수 E(x, y) = A*x + B*y + C, 삼각형 안쪽에서 세 값 모두 >= 0
+    const ScreenVertex* verts[3] = { &v0, &v1, &v2 };
+    float edgeA[3], edgeB[3], edgeC[3];
+    for (int e = 0; e < 3; ++e) {
+        const ScreenVertex& a = *verts[e];
+        const ScreenVertex& b = *verts[(e + 1) % 3];
+        edgeA[e] = a.y - b.y;
+        edgeB[e] = b.x - a.x;
+        edgeC[e] = a.x * b.y - a.y * b.x;
+    }
+
+    for (int tileY = tileY0; tileY <= tileY1; ++tileY) {
+        float tileTop = static_cast<float>(tileY * TILE_HEIGHT);
+        for (int tileX = tileX0; tileX <= tileX1; ++tileX) {
+            float tileLeft = static_cast<float>(tileX * TILE_WIDTH);
+
+            // 픽셀 중심에서 샘플링, 한 행(8픽셀)씩 같은 연산이라 컴파일러가 벡터화할 수 있습니다.
+            uint32_t coverage = 0;
+            for (uint32_t row = 0; row < TILE_HEIGHT; ++row) {
+                float y = tileTop + static_cast<float>(row) + 0.5f;
+                float rowBase[3];
+                for (int e = 0; e < 3; ++e) {
+                    rowBase[e] = edgeB[e] * y + edgeC[e];
+                }
+
+                uint32_t rowMask = 0;
+                for (uint32_t lane = 0; lane < TILE_WIDTH; ++lane) {
+                    float x = tileLeft + static_cast<float>(lane) + 0.5f;
+                    bool inside = (edgeA[0] * x + rowBase[0] >= 0.0f) &
+                                  (edgeA[1] * x + rowBase[1] >= 0.0f) &
+                                  (edgeA[2] * x + rowBase[2] >= 0.0f);
+                    rowMask |= static_cast<uint32_t>(inside) << lane;
+                }
+                coverage |= rowMask << (row * TILE_WIDTH);
+            }
+            if (coverage == 0) {
+                continue;
+            }
+
+            float tileRight = tileLeft + static_cast<float>(TILE_WIDTH);
+            float tileBottom = tileTop + static_cast<float>(TILE_HEIGHT);
+            float z00 = depthA * tileLeft + depthB * tileTop + depthC;
+            float z10 = depthA * tileRight + depthB * tileTop + depthC;
+            float z01 = depthA * tileLeft + depthB * tileBottom + depthC;
+            float z11 = depthA * tileRight + depthB * tileBottom + depthC;
+            float tileMinZ = std::max(std::min({ z00, z10, z01, z11 }), triMinZ);
+            float tileMaxZ = std::min(std::max({ z00, z10, z01, z11 }), triMaxZ);
+
+            updateTile(static_cast<uint32_t>(tileY) * tilesX_ + static_cast<uint32_t>(tileX), coverage, tileMinZ, tileMaxZ);
+        }
+    }
+}
+
+void MaskedOcclusionBuffer::updateTile(uint32_t tileIndex, uint32_t coverage, float tileMinDepth, float tileMaxDepth)
+{
+    // 이미 타일 전체를 덮은 가리개보다 뒤에 있으면 정보가 없습니다.
+    if (tileMinDepth >= zMax0_[tileIndex]) {
+        return;
+    }
+
+    zMax1_[tileIndex] = std::max(zMax1_[tileIndex], tileMaxDepth);
+    coverage_[tileIndex] |= coverage;
+
+    // 작업 레이어가 타일을 다 덮으면 확정 깊이로 합치고 비웁니다.
+    if (coverage_[tileIndex] == FULL_COVERAGE) {
+        zMax0_[tileIndex] = std::min(zMax0_[tileIndex], zMax1_[tileIndex]);
+        zMax1_[tileIndex] = 0.0f;
+        coverage_[tileIndex] = 0;
+    }
+}
+
+bool MaskedOcclusionBuffer::testAABB(const glm::vec3& boundsMin, const glm::vec3& boundsMax, const glm::mat4& viewProj) const
+{
+    float width = static_cast<float>(width_);
+    float height = static_cast<float>(height_);
+
+    float minX = width, maxX = 0.0f;
+    float minY = height, maxY = 0.0f;
+    float minZ = 1.0f;
+    for (int i = 0; i < 8; ++i) {
+        glm::vec3 corner((i & 1) ? boundsMax.x : boundsMin.x,
+                         (i & 2) ? boundsMax.y : boundsMin.y,
+                         (i & 4) ? boundsMax.z : boundsMin.z);
+        glm::vec4 clip = viewProj * glm::vec4(corner, 1.0f);
+        if (clip.w < NEAR_W_EPSILON) {
+            return true; // 카메라에 걸친 박스는 투영할 수 없으니 보이는 것으로 둡니다.
+        }
+        ScreenVertex v = toScreen(clip, width, height);
+        minX = std::min(minX, v.x);
+        maxX = std::max(maxX, v.x);
+        minY = std::min(minY, v.y);
+        maxY = std::max(maxY, v.y);
+        minZ = std::min(minZ, v.z);
+    }
+
+    if (minZ < 0.0f) {
+        return true;
+    }
+    if (maxX < 0.0f || maxY < 0.0f || minX >= width || minY >= height) {
+        return false;
+    }
+
+    int tileX0 = std::max(0, static_cast<int>(minX) / static_cast<int>(TILE_WIDTH));
+    int tileX1 = std::min(static_cast<int>(tilesX_) - 1, static_cast<int>(maxX) / static_cast<int>(TILE_WIDTH));
+    int tileY0 = std::max(0, static_cast<int>(minY) / static_cast<int>(TILE_HEIGHT));
+    int tileY1 = std::min(static_cast<int>(tilesY_) - 1, static_cast<int>(maxY) / static_cast<int>(TILE_HEIGHT));
+
+    for (int tileY = tileY0; tileY <= tileY1; ++tileY) {
+        const float* rowDepth = &zMax0_[static_cast<size_t>(tileY) * tilesX_];
+        for (int tileX = tileX0; tileX <= tileX1; ++tileX) {
+            if (minZ <= rowDepth[tileX]) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+// CPU 소프트웨어 가림 컬링용 저해상도 깊이 버퍼 (Masked Occlusion Culling 방식)
+// 화면을 8x4 픽셀 타일로 나누고 타일마다 픽셀 깊이 대신
+//  - zMax0: 타일 전체를 덮는 확정된 최대 깊이 (이보다 먼 것은 가려짐)
+//  - zMax1 + coverageMask: 아직 타일을 다 덮지 못한 작업 레이어
+// 만 저장하므로 타일 하나가 32비트 마스크 + float 2개입니다. (SoA 배열, 행 단위로 8픽셀씩 처리)
+// Vulkan 객체를 쓰지 않으므로 CPU만으로 테스트할 수 있습니다. (--test-occlusion)
+// 깊이는 GLM_FORCE_DEPTH_ZERO_TO_ONE 기준 (0 = near, 1 = far)
+class MaskedOcclusionBuffer
+{
+public:
+    static constexpr uint32_t TILE_WIDTH = 8;
+    static constexpr uint32_t TILE_HEIGHT = 4;
+
+    // 크기는 타일 크기의 배수로 올림합니다.
+    void initialize(uint32_t width, uint32_t height);
+
+    void clear();
+    void clearRows(uint32_t tileRowBegin, uint32_t tileRowEnd);
+
+    // positions: stride 간격의 vec3 위치 배열, indices: 삼각형 리스트
+    void renderOccluder(const float* positions, uint32_t stride, size_t vertexCount,
+        const uint32_t* indices, size_t indexCount, const glm::mat4& worldViewProj);
+    // 워커 스레드 분할용: 지정한 타일 행 범위에만 씁니다. (행 범위가 겹치지 않으면 동시에 호출 가능)
+    void renderOccluderRows(const float* positions, uint32_t stride, size_t vertexCount,
+        const uint32_t* indices, size_t indexCount, const glm::mat4& worldViewProj,
+        uint32_t tileRowBegin, uint32_t tileRowEnd, std::vector<glm::vec4>& clipScratch);
+
+    // 월드 공간 AABB가 화면에 보일 수 있으면 true (가려졌거나 화면 밖이면 false)
+    bool testAABB(const glm::vec3& boundsMin, const glm::vec3& boundsMax, const glm::mat4& viewProj) const;
+
+    uint32_t getWidth() const { return width_; }
+    uint32_t getHeight() const { return height_; }
+    uint32_t getTileRows() const { return tilesY_; }
+
+    // 디버그/테스트용: 타일의 확정 깊이
+    float getTileDepth(uint32_t tileX, uint32_t tileY) const { return zMax0_[tileY * tilesX_ + tileX]; }
+
+private:
+    void rasterizeTriangle(const glm::vec4& clip0, const glm::vec4& clip1, const glm::vec4& clip2,
+        uint32_t tileRowBegin, uint32_t tileRowEnd);
+    void updateTile(uint32_t tileIndex, uint32_t coverage, float tileMinDepth, float tileMaxDepth);
+
+private:
+    uint32_t width_ = 0;
+    uint32_t height_ = 0;
+    uint32_t tilesX_ = 0;
+    uint32_t tilesY_ = 0;
+
+    std::vector<float> zMax0_;
+    std::vector<float> zMax1_;
+    std::vector<uint32_t> coverage_;
+};
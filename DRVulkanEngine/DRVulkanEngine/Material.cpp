@@ -3,9 +3,9 @@
 #include "Texture.h"
 #include <array>
 #include <stdexcept>
-#include "UniformBuffer.h"
 #include "TextureArray.h"
-#include "UniformBufferArray.h"
+#include "MaterialTable.h"
+#include "TextureCache.h"
 
 Material::Material(const VulkanContext* context,
     std::shared_ptr<Texture> diffuse,
@@ -22,39 +22,25 @@ Material::Material(const VulkanContext* context,
     normalTexture_ = normal;
     ambientTexture_ = ambient;
     emissiveTexture_ = emissive;
-
-    createUniformBuffer();
 }
 
 Material::~Material() {
 }
 
-void Material::createUniformBuffer()
-{
-    static_assert(sizeof(MaterialUBO) % 16 == 0, "MaterialUBO size must be a multiple of 16 for std140 array compatibility!");
-    materialUB_ = std::make_unique<UniformBuffer>(context_, sizeof(MaterialUBO));
-}
-
-
-void Material::prepareBindless(UniformBufferArray& uniformBufferArray, TextureArray& textures)
+void Material::prepareBindless(MaterialTable& materialTable, TextureArray& textures)
 {
     static std::shared_ptr<Texture> defaultTexture = nullptr;
     if (defaultTexture == nullptr)
     {
         // ӽù: δ Renderer   Ŭ ̸ εؾ մϴ.
-        defaultTexture = std::make_shared<Texture>(context_, "../assets/images/minion.jpg");
-    }
-    if (diffuseTexture_)
-    {
-        materialUBO_.diffuseTexIndex = textures.AddTexture(diffuseTexture_.get());
+        defaultTexture = TextureCache::Load(context_, "../assets/images/minion.jpg");
     }
-    
-    materialUBO_.diffuseTexIndex = diffuseTexture_ ? textures.AddTexture(diffuseTexture_.get()):-1;
-    materialUBO_.specularTexIndex = specularTexture_ ? textures.AddTexture( specularTexture_.get()): -1;
-    materialUBO_.normalTexIndex = normalTexture_ ? textures.AddTexture(normalTexture_.get()): -1;
-    materialUBO_.ambientTexIndex = ambientTexture_ ? textures.AddTexture(ambientTexture_.get()): -1;
-    materialUBO_.emissiveTexIndex = emissiveTexture_ ? textures.AddTexture(emissiveTexture_.get()): -1;
-
-    materialUB_->update(&materialUBO_);
-    materialIndex_ = uniformBufferArray.addUniformBuffer(materialUB_.get());
+    materialData_.diffuseTexIndex = diffuseTexture_ ? textures.AddTexture(diffuseTexture_.get()):-1;
+    materialData_.specularTexIndex = specularTexture_ ? textures.AddTexture( specularTexture_.get()): -1;
+    materialData_.normalTexIndex = normalTexture_ ? textures.AddTexture(normalTexture_.get()): -1;
+    materialData_.ambientTexIndex = ambientTexture_ ? textures.AddTexture(ambientTexture_.get()): -1;
+    materialData_.emissiveTexIndex = emissiveTexture_ ? textures.AddTexture(emissiveTexture_.get()): -1;
+
+    //  ؽó    ̺ ID ϳ մϴ.
+    materialIndex_ = materialTable.registerMaterial(materialData_);
 }
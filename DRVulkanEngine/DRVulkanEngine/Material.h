@@ -7,16 +7,18 @@
 #include <string>
 class Texture;
 class VulkanContext;
-class UniformBuffer;
 class TextureArray;
-class UniformBufferArray;
+class MaterialTable;
 
-struct MaterialUBO {
-    alignas(16) int diffuseTexIndex = -1;
+// MaterialTable  ĭ (shader.frag MaterialData, std430)
+// ̺ Ʈ ߺ ãǷ е ׻ 0̾ մϴ.
+struct MaterialData {
+    int diffuseTexIndex = -1;
     int normalTexIndex = -1;
     int specularTexIndex = -1;
     int ambientTexIndex = -1;
     int emissiveTexIndex = -1;
+    int padding[3] = { 0, 0, 0 };
 };
 
 class Material {
@@ -30,12 +32,10 @@ public:
         std::shared_ptr<Texture> emissive);
     ~Material();
 
-    void prepareBindless(UniformBufferArray& uniformBufferArray, TextureArray& textures);
+    void prepareBindless(MaterialTable& materialTable, TextureArray& textures);
 
 	int getMaterialIndex() const { return materialIndex_; }
 private:
-    void createUniformBuffer();
-
     const VulkanContext* context_;
     std::shared_ptr<Texture> diffuseTexture_;
     std::shared_ptr<Texture> specularTexture_;
@@ -44,8 +44,7 @@ private:
     std::shared_ptr<Texture> emissiveTexture_;
     std::shared_ptr<Texture> defaultTexture_;
 
-    MaterialUBO           materialUBO_;
-    std::unique_ptr<UniformBuffer>       materialUB_;
+    MaterialData          materialData_;
 
     int materialIndex_ = 0;
 };
\ No newline at end of file
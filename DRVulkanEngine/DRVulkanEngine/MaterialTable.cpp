@@ -0,0 +1,158 @@
+#include "MaterialTable.h"
+#include "VulkanContext.h"
+#include "UploadManager.h"
+#include <stdexcept>
+#include <algorithm>
+#include <cstring>
+
+static_assert(sizeof(MaterialData) % 16 == 0, "MaterialData must keep a 16-byte std430 array stride!");
+
+MaterialTable::~MaterialTable()
+{
+    cleanup();
+}
+
+void MaterialTable::initialize(const VulkanContext* context, uint32_t framesInFlight, uint32_t initialCapacity)
+{
+    context_ = context;
+    framesInFlight_ = framesInFlight;
+
+    materials_.reserve(std::max(initialCapacity, 1u));
+    // 디스크립터는 재질이 하나도 없을 때도 유효한 버퍼를 가리켜야 하므로 바로 만듭니다.
+    createDeviceBuffer(std::max(initialCapacity, 1u));
+}
+
+void MaterialTable::cleanup()
+{
+    if (!context_) {
+        return;
+    }
+    destroyDeviceBuffer(buffer_);
+    for (RetiredBuffer& retired : retiredBuffers_) {
+        destroyDeviceBuffer(retired.buffer);
+    }
+    retiredBuffers_.clear();
+
+    materials_.clear();
+    materialIds_.clear();
+    uploadedCount_ = 0;
+    capacity_ = 0;
+    context_ = nullptr;
+}
+
+int MaterialTable::registerMaterial(const MaterialData& material)
+{
+    stats_.registerCount++;
+
+    const uint64_t hash = hashMaterial(material);
+    auto range = materialIds_.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (memcmp(&materials_[it->second], &material, sizeof(MaterialData)) == 0) {
+            stats_.dedupHits++;
+            return static_cast<int>(it->second);
+        }
+    }
+
+    const uint32_t materialId = static_cast<uint32_t>(materials_.size());
+    materials_.push_back(material);
+    materialIds_.emplace(hash, materialId);
+    stats_.materialCount = static_cast<uint32_t>(materials_.size());
+    return static_cast<int>(materialId);
+}
+
+void MaterialTable::flush(uint32_t frameIndex)
+{
+    frameIndex %= framesInFlight_;
+    releaseRetiredBuffers(frameIndex);
+
+    const uint32_t materialCount = static_cast<uint32_t>(materials_.size());
+    if (materialCount > capacity_) {
+        // 다른 슬롯의 프레임이 아직 읽고 있을 수 있으므로 바로 해제하지 않습니다.
+        const uint32_t allFramesMask = (1u << framesInFlight_) - 1;
+        retiredBuffers_.push_back({ buffer_, allFramesMask & ~(1u << frameIndex) });
+        buffer_ = DeviceBuffer{};
+        createDeviceBuffer(std::max(capacity_ * 2, materialCount));
+        uploadedCount_ = 0;
+        bBufferInfosDirty_ = true;
+        stats_.growCount++;
+    }
+
+    if (uploadedCount_ == materialCount) {
+        return;
+    }
+    // 새로 붙은 레코드는 연속이므로 한 번에 올립니다.
+    context_->getUploadManager().uploadBuffer(buffer_.buffer,
+        sizeof(MaterialData) * uploadedCount_,
+        materials_.data() + uploadedCount_,
+        sizeof(MaterialData) * (materialCount - uploadedCount_),
+        UploadPriority::Immediate);
+    uploadedCount_ = materialCount;
+}
+
+void MaterialTable::populateWriteDescriptor(VkWriteDescriptorSet& writeInfo) const
+{
+    writeInfo.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    writeInfo.descriptorCount = 1;
+    writeInfo.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    writeInfo.pBufferInfo = &bufferInfo_;
+    writeInfo.pImageInfo = nullptr;
+    writeInfo.pTexelBufferView = nullptr;
+}
+
+uint64_t MaterialTable::hashMaterial(const MaterialData& material)
+{
+    // FNV-1a, 레코드가 작아서 바이트 단위로 충분합니다.
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&material);
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < sizeof(MaterialData); ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+void MaterialTable::createDeviceBuffer(uint32_t capacity)
+{
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = sizeof(MaterialData) * capacity;
+    bufferInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    // 전송 큐에서 올리므로 CONCURRENT로 만듭니다.
+    context_->setBufferSharing(bufferInfo);
+
+    if (vkCreateBuffer(context_->getDevice(), &bufferInfo, nullptr, &buffer_.buffer) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create material table buffer!");
+    }
+    buffer_.allocation = context_->getMemoryAllocator().allocateForBuffer(buffer_.buffer, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+    capacity_ = capacity;
+    stats_.capacity = capacity;
+    bufferInfo_.buffer = buffer_.buffer;
+    bufferInfo_.offset = 0;
+    bufferInfo_.range = bufferInfo.size;
+}
+
+void MaterialTable::destroyDeviceBuffer(DeviceBuffer& buffer)
+{
+    if (buffer.buffer == VK_NULL_HANDLE) {
+        return;
+    }
+    vkDestroyBuffer(context_->getDevice(), buffer.buffer, nullptr);
+    context_->getMemoryAllocator().free(buffer.allocation);
+    buffer = DeviceBuffer{};
+}
+
+void MaterialTable::releaseRetiredBuffers(uint32_t frameIndex)
+{
+    // 이 슬롯의 펜스를 기다렸으니 이 슬롯의 이전 프레임은 끝났고, 이번 프레임의 셋은 곧 새 버퍼로 바뀝니다.
+    // 모든 슬롯이 그렇게 지나갔으면 그 버퍼를 읽는 GPU 작업은 없습니다.
+    auto it = std::remove_if(retiredBuffers_.begin(), retiredBuffers_.end(), [this, frameIndex](RetiredBuffer& retired) {
+        retired.pendingFrameMask &= ~(1u << frameIndex);
+        if (retired.pendingFrameMask != 0) {
+            return false;
+        }
+        destroyDeviceBuffer(retired.buffer);
+        return true;
+    });
+    retiredBuffers_.erase(it, retiredBuffers_.end());
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include "Resource.h"
+#include "Material.h"
+#include <vulkan/vulkan.h>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+// 모든 재질 레코드를 담는 스토리지 버퍼 하나 (shader.frag의 materialData, 재질 ID로 인덱싱)
+//  - registerMaterial()은 레코드 바이트의 해시로 같은 재질이 이미 있는지 찾아 그 ID를 돌려주고, 없을 때만 뒤에 붙입니다.
+//    텍스처는 TextureArray에서 이미 중복 제거되므로 같은 텍스처 조합을 쓰는 재질은 ID 하나를 공유합니다.
+//  - 새 레코드는 flush()에서 한 번의 Immediate 업로드로 이번 프레임 제출에 들어갑니다.
+//    이미 올라간 레코드는 바뀌지 않으므로 이전 프레임이 읽는 구간을 덮어쓰지 않습니다.
+//  - 용량이 차면 두 배로 키운 버퍼에 전체를 다시 올리고 디스크립터를 더티로 표시합니다.
+//    디스크립터 셋은 프레임 슬롯마다 사본이 있고 각 사본은 자기 슬롯의 펜스를 기다린 뒤에 새 버퍼로 바뀝니다.
+//    그래서 이전 버퍼는 다른 슬롯들이 모두 한 번씩 flush()를 거친 뒤(그 슬롯의 마지막 사용이 끝나고 셋도 바뀐 뒤) 해제합니다.
+//    flush() 횟수가 아니라 슬롯으로 세므로 프레임을 제출하지 못하고 건너뛰어도 일찍 해제되지 않습니다.
+// 렌더 스레드에서만 사용합니다.
+class MaterialTable : public Resource
+{
+public:
+    static constexpr uint32_t INITIAL_CAPACITY = 256;
+
+    struct Stats {
+        uint32_t materialCount = 0;
+        uint32_t capacity = 0;
+        uint32_t registerCount = 0;
+        uint32_t dedupHits = 0;
+        uint32_t growCount = 0;
+    };
+
+    MaterialTable() = default;
+    ~MaterialTable();
+
+    MaterialTable(const MaterialTable&) = delete;
+    MaterialTable& operator=(const MaterialTable&) = delete;
+
+    void initialize(const VulkanContext* context, uint32_t framesInFlight, uint32_t initialCapacity = INITIAL_CAPACITY);
+    void cleanup();
+
+    int registerMaterial(const MaterialData& material);
+    const MaterialData& getMaterial(int materialId) const { return materials_[materialId]; }
+
+    // 프레임마다 한 번, frameIndex 슬롯의 펜스를 기다린 뒤 디스크립터 셋을 갱신하기 전에 부릅니다. (필요하면 버퍼를 키움)
+    void flush(uint32_t frameIndex);
+
+    virtual void populateWriteDescriptor(VkWriteDescriptorSet& writeInfo) const override;
+    const Stats& getStats() const { return stats_; }
+
+private:
+    struct DeviceBuffer {
+        VkBuffer buffer = VK_NULL_HANDLE;
+        MemoryAllocation allocation;
+    };
+
+    struct RetiredBuffer {
+        DeviceBuffer buffer;
+        // 아직 이 버퍼를 가리키는 디스크립터 사본이 남아 있을 수 있는 프레임 슬롯 (비트마스크)
+        uint32_t pendingFrameMask = 0;
+    };
+
+    static uint64_t hashMaterial(const MaterialData& material);
+
+    void createDeviceBuffer(uint32_t capacity);
+    void destroyDeviceBuffer(DeviceBuffer& buffer);
+    void releaseRetiredBuffers(uint32_t frameIndex);
+
+    const VulkanContext* context_ = nullptr;
+    uint32_t framesInFlight_ = 0;
+
+    std::vector<MaterialData> materials_;
+    // 레코드 해시 -> 재질 ID (해시가 같아도 바이트를 비교해 확인합니다)
+    std::unordered_multimap<uint64_t, uint32_t> materialIds_;
+    uint32_t uploadedCount_ = 0;
+
+    DeviceBuffer buffer_;
+    uint32_t capacity_ = 0;
+    VkDescriptorBufferInfo bufferInfo_{};
+    std::vector<RetiredBuffer> retiredBuffers_;
+
+    Stats stats_;
+};
@@ -0,0 +1,584 @@
+#include "MemoryAllocator.h"
+#include "VulkanContext.h"
+#include <stdexcept>
+#include <algorithm>
+#include <bit>
+
+namespace {
+    VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    uint32_t highestBit(VkDeviceSize value)
+    {
+        return 63u - static_cast<uint32_t>(std::countl_zero(static_cast<uint64_t>(value)));
+    }
+}
+
+// 블록 하나(VkDeviceMemory 하나)를 TLSF로 나눠 씁니다.
+// 빈 구간은 크기로 (1단계 = 최상위 비트, 2단계 = 그 아래 SL_LOG2 비트) 칸에 나눠 연결 리스트로 두고,
+// 비트맵 두 개로 요청 크기 이상인 칸을 바로 찾습니다. 구간은 주소 순서로도 연결되어 있어 해제할 때 이웃과 합칩니다.
+class MemoryAllocator::TlsfBlock
+{
+public:
+    static constexpr uint32_t INVALID_NODE = ~0u;
+
+    TlsfBlock(VkDeviceMemory memory, VkDeviceSize size, void* mapped)
+        : memory_(memory), size_(size), mapped_(mapped)
+    {
+        std::fill(&freeHeads_[0][0], &freeHeads_[0][0] + FL_COUNT * SL_COUNT, INVALID_NODE);
+        const uint32_t node = createNode();
+        nodes_[node].offset = 0;
+        nodes_[node].size = size;
+        insertFree(node);
+    }
+
+    VkDeviceMemory getMemory() const { return memory_; }
+    VkDeviceSize getSize() const { return size_; }
+    void* getMapped() const { return mapped_; }
+    bool isEmpty() const { return usedBytes_ == 0; }
+
+    bool allocate(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& outOffset, uint32_t& outNode)
+    {
+        // 정렬 여유까지 더한 크기로 찾으면 어느 빈 구간을 받아도 정렬 후에 들어갑니다.
+        const VkDeviceSize searchSize = size + alignment - 1;
+        uint32_t fl = 0;
+        uint32_t sl = 0;
+        mappingSearch(searchSize, fl, sl);
+        uint32_t node = findFree(fl, sl);
+        if (node == INVALID_NODE) {
+            return false;
+        }
+        removeFree(node);
+
+        // 앞쪽 정렬 여백은 빈 구간으로 떼어 둡니다.
+        const VkDeviceSize alignedOffset = alignUp(nodes_[node].offset, alignment);
+        const VkDeviceSize padding = alignedOffset - nodes_[node].offset;
+        if (padding > 0) {
+            const uint32_t front = node;
+            node = splitAfter(front, padding);
+            insertFree(front);
+        }
+
+        // 뒤쪽이 충분히 남으면 잘라서 돌려놓습니다.
+        if (nodes_[node].size - size >= MIN_SPLIT_SIZE) {
+            const uint32_t back = splitAfter(node, size);
+            insertFree(back);
+        }
+
+        nodes_[node].free = false;
+        usedBytes_ += nodes_[node].size;
+        outOffset = nodes_[node].offset;
+        outNode = node;
+        return true;
+    }
+
+    void free(uint32_t node)
+    {
+        usedBytes_ -= nodes_[node].size;
+        nodes_[node].free = true;
+
+        // 주소상 앞뒤 구간이 비어 있으면 합칩니다.
+        const uint32_t prev = nodes_[node].prevPhysical;
+        if (prev != INVALID_NODE && nodes_[prev].free) {
+            removeFree(prev);
+            mergeIntoPrevious(prev, node);
+            node = prev;
+        }
+        const uint32_t next = nodes_[node].nextPhysical;
+        if (next != INVALID_NODE && nodes_[next].free) {
+            removeFree(next);
+            mergeIntoPrevious(node, next);
+        }
+        insertFree(node);
+    }
+
+private:
+    static constexpr uint32_t SL_LOG2 = 4;
+    static constexpr uint32_t SL_COUNT = 1u << SL_LOG2;
+    static constexpr uint32_t SMALL_SHIFT = 8;                          // 256바이트 미만은 1단계 0번 칸에 선형으로
+    static constexpr VkDeviceSize SMALL_SIZE = 1ull << SMALL_SHIFT;
+    static constexpr uint32_t FL_COUNT = 40;
+    static constexpr VkDeviceSize MIN_SPLIT_SIZE = 256;
+
+    struct Node {
+        VkDeviceSize offset = 0;
+        VkDeviceSize size = 0;
+        uint32_t prevPhysical = INVALID_NODE;
+        uint32_t nextPhysical = INVALID_NODE;
+        uint32_t prevFree = INVALID_NODE;
+        uint32_t nextFree = INVALID_NODE;
+        bool free = true;
+    };
+
+    static void mapping(VkDeviceSize size, uint32_t& fl, uint32_t& sl)
+    {
+        if (size < SMALL_SIZE) {
+            fl = 0;
+            sl = static_cast<uint32_t>(size / (SMALL_SIZE / SL_COUNT));
+            return;
+        }
+        const uint32_t bit = highestBit(size);
+        sl = static_cast<uint32_t>((size >> (bit - SL_LOG2)) ^ SL_COUNT);
+        fl = bit - SMALL_SHIFT + 1;
+    }
+
+    // 칸의 하한으로 올림해서, 찾은 칸의 어떤 구간이든 size 이상이 되게 합니다.
+    static void mappingSearch(VkDeviceSize size, uint32_t& fl, uint32_t& sl)
+    {
+        if (size >= SMALL_SIZE) {
+            size += (1ull << (highestBit(size) - SL_LOG2)) - 1;
+        }
+        mapping(size, fl, sl);
+    }
+
+    uint32_t findFree(uint32_t fl, uint32_t sl) const
+    {
+        if (fl >= FL_COUNT) {
+            return INVALID_NODE;
+        }
+        uint32_t slMap = sl < SL_COUNT ? (slBitmap_[fl] & (~0u << sl)) : 0;
+        if (slMap == 0) {
+            const uint64_t flMap = fl + 1 < 64 ? (flBitmap_ & (~0ull << (fl + 1))) : 0;
+            if (flMap == 0) {
+                return INVALID_NODE;
+            }
+            fl = static_cast<uint32_t>(std::countr_zero(flMap));
+            slMap = slBitmap_[fl];
+        }
+        sl = static_cast<uint32_t>(std::countr_zero(slMap));
+        return freeHeads_[fl][sl];
+    }
+
+    void insertFree(uint32_t node)
+    {
+        uint32_t fl = 0;
+        uint32_t sl = 0;
+        mapping(nodes_[node].size, fl, sl);
+        nodes_[node].free = true;
+        nodes_[node].prevFree = INVALID_NODE;
+        nodes_[node].nextFree = freeHeads_[fl][sl];
+        if (freeHeads_[fl][sl] != INVALID_NODE) {
+            nodes_[freeHeads_[fl][sl]].prevFree = node;
+        }
+        freeHeads_[fl][sl] = node;
+        flBitmap_ |= 1ull << fl;
+        slBitmap_[fl] |= 1u << sl;
+    }
+
+    void removeFree(uint32_t node)
+    {
+        uint32_t fl = 0;
+        uint32_t sl = 0;
+        mapping(nodes_[node].size, fl, sl);
+        const uint32_t prev = nodes_[node].prevFree;
+        const uint32_t next = nodes_[node].nextFree;
+        if (prev != INVALID_NODE) {
+            nodes_[prev].nextFree = next;
+        }
+        else {
+            freeHeads_[fl][sl] = next;
+        }
+        if (next != INVALID_NODE) {
+            nodes_[next].prevFree = prev;
+        }
+        if (freeHeads_[fl][sl] == INVALID_NODE) {
+            slBitmap_[fl] &= ~(1u << sl);
+            if (slBitmap_[fl] == 0) {
+                flBitmap_ &= ~(1ull << fl);
+            }
+        }
+        nodes_[node].prevFree = INVALID_NODE;
+        nodes_[node].nextFree = INVALID_NODE;
+    }
+
+    // node를 [offset, offset + size)와 나머지로 나누고 나머지 노드를 돌려줍니다.
+    uint32_t splitAfter(uint32_t node, VkDeviceSize size)
+    {
+        const uint32_t rest = createNode();
+        nodes_[rest].offset = nodes_[node].offset + size;
+        nodes_[rest].size = nodes_[node].size - size;
+        nodes_[rest].prevPhysical = node;
+        nodes_[rest].nextPhysical = nodes_[node].nextPhysical;
+        if (nodes_[node].nextPhysical != INVALID_NODE) {
+            nodes_[nodes_[node].nextPhysical].prevPhysical = rest;
+        }
+        nodes_[node].nextPhysical = rest;
+        nodes_[node].size = size;
+        return rest;
+    }
+
+    void mergeIntoPrevious(uint32_t prev, uint32_t node)
+    {
+        nodes_[prev].size += nodes_[node].size;
+        nodes_[prev].nextPhysical = nodes_[node].nextPhysical;
+        if (nodes_[node].nextPhysical != INVALID_NODE) {
+            nodes_[nodes_[node].nextPhysical].prevPhysical = prev;
+        }
+        unusedNodes_.push_back(node);
+    }
+
+    uint32_t createNode()
+    {
+        if (!unusedNodes_.empty()) {
+            const uint32_t node = unusedNodes_.back();
+            unusedNodes_.pop_back();
+            nodes_[node] = Node{};
+            return node;
+        }
+        nodes_.emplace_back();
+        return static_cast<uint32_t>(nodes_.size() - 1);
+    }
+
+private:
+    VkDeviceMemory memory_ = VK_NULL_HANDLE;
+    VkDeviceSize size_ = 0;
+    void* mapped_ = nullptr;
+    VkDeviceSize usedBytes_ = 0;
+
+    std::vector<Node> nodes_;
+    std::vector<uint32_t> unusedNodes_;
+    uint64_t flBitmap_ = 0;
+    uint32_t slBitmap_[FL_COUNT] = {};
+    uint32_t freeHeads_[FL_COUNT][SL_COUNT];
+};
+
+MemoryAllocator::MemoryAllocator() = default;
+
+MemoryAllocator::~MemoryAllocator()
+{
+    cleanup();
+}
+
+void MemoryAllocator::initialize(const VulkanContext* context)
+{
+    context_ = context;
+    vkGetPhysicalDeviceMemoryProperties(context_->getPhysicalDevice(), &memoryProperties_);
+
+    VkPhysicalDeviceProperties deviceProperties;
+    vkGetPhysicalDeviceProperties(context_->getPhysicalDevice(), &deviceProperties);
+    maxDeviceMemoryCount_ = deviceProperties.limits.maxMemoryAllocationCount;
+
+    pools_.clear();
+    pools_.resize(memoryProperties_.memoryTypeCount * 2);
+    for (uint32_t typeIndex = 0; typeIndex < memoryProperties_.memoryTypeCount; ++typeIndex) {
+        const VkMemoryType& memoryType = memoryProperties_.memoryTypes[typeIndex];
+        const VkDeviceSize heapSize = memoryProperties_.memoryHeaps[memoryType.heapIndex].size;
+        // 작은 힙(BAR 등)에서는 블록 하나가 힙을 다 차지하지 않게 줄입니다.
+        const VkDeviceSize blockSize = std::max<VkDeviceSize>(SLAB_PAGE_SIZE, std::min(DEFAULT_BLOCK_SIZE, heapSize / 8));
+        for (uint32_t optimal = 0; optimal < 2; ++optimal) {
+            Pool& pool = pools_[typeIndex * 2 + optimal];
+            pool.memoryTypeIndex = typeIndex;
+            pool.optimal = optimal != 0;
+            pool.hostVisible = (memoryType.propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0;
+            pool.blockSize = blockSize;
+        }
+    }
+}
+
+void MemoryAllocator::cleanup()
+{
+    if (context_ == nullptr) {
+        return;
+    }
+
+    // 남은 할당은 리소스가 해제를 빠뜨린 것이지만, 디바이스를 없애기 전에 블록은 모두 돌려줍니다.
+    VkDevice device = context_->getDevice();
+    for (Pool& pool : pools_) {
+        for (std::unique_ptr<TlsfBlock>& block : pool.blocks) {
+            if (block) {
+                vkFreeMemory(device, block->getMemory(), nullptr);
+            }
+        }
+    }
+    pools_.clear();
+    context_ = nullptr;
+}
+
+MemoryAllocation MemoryAllocator::allocateForBuffer(VkBuffer buffer, VkMemoryPropertyFlags properties)
+{
+    VkMemoryRequirements memRequirements;
+    vkGetBufferMemoryRequirements(context_->getDevice(), buffer, &memRequirements);
+
+    MemoryAllocation allocation = allocate(memRequirements, properties, false);
+    if (vkBindBufferMemory(context_->getDevice(), buffer, allocation.memory, allocation.offset) != VK_SUCCESS) {
+        free(allocation);
+        throw std::runtime_error("failed to bind buffer memory!");
+    }
+    return allocation;
+}
+
+MemoryAllocation MemoryAllocator::allocateForImage(VkImage image, VkMemoryPropertyFlags properties)
+{
+    VkMemoryRequirements memRequirements;
+    vkGetImageMemoryRequirements(context_->getDevice(), image, &memRequirements);
+
+    // 이 할당기로 만드는 이미지는 모두 OPTIMAL 타일링입니다.
+    MemoryAllocation allocation = allocate(memRequirements, properties, true);
+    if (vkBindImageMemory(context_->getDevice(), image, allocation.memory, allocation.offset) != VK_SUCCESS) {
+        free(allocation);
+        throw std::runtime_error("failed to bind image memory!");
+    }
+    return allocation;
+}
+
+MemoryAllocation MemoryAllocator::allocate(const VkMemoryRequirements& memRequirements, VkMemoryPropertyFlags properties, bool optimal)
+{
+    const uint32_t typeIndex = context_->findMemoryType(memRequirements.memoryTypeBits, properties);
+    uint32_t poolIndex = 0;
+    Pool& pool = getPool(typeIndex, optimal, poolIndex);
+
+    MemoryAllocation allocation;
+    const VkDeviceSize size = memRequirements.size;
+    const VkDeviceSize alignment = std::max<VkDeviceSize>(memRequirements.alignment, 1);
+    if (size > pool.blockSize / 2) {
+        allocation = allocateDedicated(pool, poolIndex, size);
+    }
+    else if (std::max(size, alignment) <= MAX_SLAB_SIZE) {
+        if (!allocateFromSlab(pool, poolIndex, size, alignment, allocation)) {
+            throw std::runtime_error("failed to allocate slab memory!");
+        }
+    }
+    else if (!allocateFromBlocks(pool, poolIndex, size, alignment, allocation)) {
+        throw std::runtime_error("failed to allocate block memory!");
+    }
+
+    allocation.size = size;
+    ++allocationCount_;
+    ++totalAllocationCount_;
+    usedBytes_ += size;
+    return allocation;
+}
+
+void MemoryAllocator::free(MemoryAllocation& allocation)
+{
+    if (!allocation.isValid() || context_ == nullptr) {
+        return;
+    }
+
+    Pool& pool = pools_[allocation.pool];
+    switch (allocation.kind) {
+    case Dedicated:
+        vkFreeMemory(context_->getDevice(), allocation.memory, nullptr);
+        --dedicatedCount_;
+        dedicatedBytes_ -= allocation.size;
+        break;
+    case Block:
+        freeFromBlocks(pool, allocation.block, allocation.node);
+        break;
+    case Slab:
+        freeFromSlab(pool, allocation);
+        break;
+    }
+
+    --allocationCount_;
+    usedBytes_ -= allocation.size;
+    allocation = MemoryAllocation{};
+}
+
+bool MemoryAllocator::allocateFromBlocks(Pool& pool, uint32_t poolIndex, VkDeviceSize size, VkDeviceSize alignment, MemoryAllocation& outAllocation)
+{
+    VkDeviceSize offset = 0;
+    uint32_t node = 0;
+    uint32_t blockIndex = static_cast<uint32_t>(pool.blocks.size());
+    for (uint32_t i = 0; i < pool.blocks.size(); ++i) {
+        if (pool.blocks[i] && pool.blocks[i]->allocate(size, alignment, offset, node)) {
+            blockIndex = i;
+            break;
+        }
+    }
+
+    if (blockIndex == pool.blocks.size()) {
+        // 들어갈 블록이 없으면 새로 잡습니다. 해제된 칸이 있으면 그 번호를 다시 씁니다.
+        void* mapped = nullptr;
+        VkDeviceMemory memory = allocateDeviceMemory(pool, pool.blockSize, &mapped);
+        auto block = std::make_unique<TlsfBlock>(memory, pool.blockSize, mapped);
+        if (!block->allocate(size, alignment, offset, node)) {
+            vkFreeMemory(context_->getDevice(), memory, nullptr);
+            return false;
+        }
+        auto emptySlot = std::find(pool.blocks.begin(), pool.blocks.end(), nullptr);
+        blockIndex = static_cast<uint32_t>(emptySlot - pool.blocks.begin());
+        if (emptySlot == pool.blocks.end()) {
+            pool.blocks.push_back(std::move(block));
+        }
+        else {
+            *emptySlot = std::move(block);
+        }
+    }
+
+    const TlsfBlock& block = *pool.blocks[blockIndex];
+    outAllocation.memory = block.getMemory();
+    outAllocation.offset = offset;
+    outAllocation.mapped = block.getMapped() ? static_cast<char*>(block.getMapped()) + offset : nullptr;
+    outAllocation.pool = poolIndex;
+    outAllocation.kind = Block;
+    outAllocation.block = blockIndex;
+    outAllocation.node = node;
+    return true;
+}
+
+bool MemoryAllocator::allocateFromSlab(Pool& pool, uint32_t poolIndex, VkDeviceSize size, VkDeviceSize alignment, MemoryAllocation& outAllocation)
+{
+    // 크기와 정렬 중 큰 쪽을 담는 가장 작은 2의 거듭제곱 슬롯
+    const VkDeviceSize slotSize = std::bit_ceil(std::max({ size, alignment, MIN_SLAB_SIZE }));
+    const uint32_t sizeClass = highestBit(slotSize) - highestBit(MIN_SLAB_SIZE);
+
+    std::vector<uint32_t>& partialPages = pool.partialPages[sizeClass];
+    if (partialPages.empty()) {
+        // 페이지를 블록에서 잘라 옵니다. 페이지 시작을 슬롯 크기로 정렬해 두면 모든 슬롯이 정렬됩니다.
+        MemoryAllocation pageAllocation;
+        if (!allocateFromBlocks(pool, poolIndex, SLAB_PAGE_SIZE, slotSize, pageAllocation)) {
+            return false;
+        }
+
+        auto page = std::make_unique<SlabPage>();
+        page->sizeClass = sizeClass;
+        page->block = pageAllocation.block;
+        page->node = pageAllocation.node;
+        page->offset = pageAllocation.offset;
+        page->slotCount = static_cast<uint32_t>(SLAB_PAGE_SIZE / slotSize);
+        page->freeSlots.reserve(page->slotCount);
+        for (uint32_t slot = page->slotCount; slot > 0; --slot) {
+            page->freeSlots.push_back(slot - 1);
+        }
+
+        auto emptySlot = std::find(pool.pages.begin(), pool.pages.end(), nullptr);
+        const uint32_t pageIndex = static_cast<uint32_t>(emptySlot - pool.pages.begin());
+        if (emptySlot == pool.pages.end()) {
+            pool.pages.push_back(std::move(page));
+        }
+        else {
+            *emptySlot = std::move(page);
+        }
+        partialPages.push_back(pageIndex);
+    }
+
+    const uint32_t pageIndex = partialPages.back();
+    SlabPage& page = *pool.pages[pageIndex];
+    const uint32_t slot = page.freeSlots.back();
+    page.freeSlots.pop_back();
+    if (page.freeSlots.empty()) {
+        partialPages.pop_back();
+    }
+
+    const TlsfBlock& block = *pool.blocks[page.block];
+    const VkDeviceSize offset = page.offset + slot * slotSize;
+    outAllocation.memory = block.getMemory();
+    outAllocation.offset = offset;
+    outAllocation.mapped = block.getMapped() ? static_cast<char*>(block.getMapped()) + offset : nullptr;
+    outAllocation.pool = poolIndex;
+    outAllocation.kind = Slab;
+    outAllocation.block = pageIndex;
+    outAllocation.node = slot;
+    return true;
+}
+
+MemoryAllocation MemoryAllocator::allocateDedicated(Pool& pool, uint32_t poolIndex, VkDeviceSize size)
+{
+    MemoryAllocation allocation;
+    allocation.memory = allocateDeviceMemory(pool, size, &allocation.mapped);
+    allocation.offset = 0;
+    allocation.pool = poolIndex;
+    allocation.kind = Dedicated;
+    ++dedicatedCount_;
+    dedicatedBytes_ += size;
+    return allocation;
+}
+
+void MemoryAllocator::freeFromBlocks(Pool& pool, uint32_t blockIndex, uint32_t node)
+{
+    TlsfBlock& block = *pool.blocks[blockIndex];
+    block.free(node);
+
+    // 빈 블록은 풀에 다른 블록이 남아 있을 때만 돌려줍니다. (하나는 남겨서 할당/해제가 반복될 때 드라이버 호출을 막음)
+    if (block.isEmpty()) {
+        const bool hasOtherBlock = std::any_of(pool.blocks.begin(), pool.blocks.end(),
+            [&block](const std::unique_ptr<TlsfBlock>& other) { return other && other.get() != &block; });
+        if (hasOtherBlock) {
+            vkFreeMemory(context_->getDevice(), block.getMemory(), nullptr);
+            pool.blocks[blockIndex].reset();
+        }
+    }
+}
+
+void MemoryAllocator::freeFromSlab(Pool& pool, MemoryAllocation& allocation)
+{
+    SlabPage& page = *pool.pages[allocation.block];
+    std::vector<uint32_t>& partialPages = pool.partialPages[page.sizeClass];
+    if (page.freeSlots.empty()) {
+        partialPages.push_back(allocation.block);
+    }
+    page.freeSlots.push_back(allocation.node);
+
+    // 다 비면 페이지를 블록에 돌려줍니다.
+    if (page.freeSlots.size() == page.slotCount) {
+        partialPages.erase(std::find(partialPages.begin(), partialPages.end(), allocation.block));
+        const uint32_t blockIndex = page.block;
+        const uint32_t node = page.node;
+        pool.pages[allocation.block].reset();
+        freeFromBlocks(pool, blockIndex, node);
+    }
+}
+
+VkDeviceMemory MemoryAllocator::allocateDeviceMemory(const Pool& pool, VkDeviceSize size, void** outMapped)
+{
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = size;
+    allocInfo.memoryTypeIndex = pool.memoryTypeIndex;
+
+    // 버퍼 풀에는 BDA 버퍼가 섞이므로 항상 주소 플래그를 붙입니다.
+    VkMemoryAllocateFlagsInfo flagsInfo{ VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO };
+    if (!pool.optimal) {
+        flagsInfo.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT;
+        allocInfo.pNext = &flagsInfo;
+    }
+
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    if (vkAllocateMemory(context_->getDevice(), &allocInfo, nullptr, &memory) != VK_SUCCESS) {
+        throw std::runtime_error("failed to allocate device memory!");
+    }
+
+    *outMapped = nullptr;
+    if (pool.hostVisible) {
+        if (vkMapMemory(context_->getDevice(), memory, 0, VK_WHOLE_SIZE, 0, outMapped) != VK_SUCCESS) {
+            vkFreeMemory(context_->getDevice(), memory, nullptr);
+            throw std::runtime_error("failed to map device memory!");
+        }
+    }
+    return memory;
+}
+
+MemoryAllocator::Pool& MemoryAllocator::getPool(uint32_t memoryTypeIndex, bool optimal, uint32_t& outPoolIndex)
+{
+    outPoolIndex = memoryTypeIndex * 2 + (optimal ? 1 : 0);
+    return pools_[outPoolIndex];
+}
+
+MemoryAllocator::Stats MemoryAllocator::getStats() const
+{
+    Stats stats;
+    stats.maxDeviceMemoryCount = maxDeviceMemoryCount_;
+    stats.dedicatedCount = dedicatedCount_;
+    stats.allocationCount = allocationCount_;
+    stats.totalAllocationCount = totalAllocationCount_;
+    stats.usedBytes = usedBytes_;
+    stats.reservedBytes = dedicatedBytes_;
+    for (const Pool& pool : pools_) {
+        for (const std::unique_ptr<TlsfBlock>& block : pool.blocks) {
+            if (block) {
+                ++stats.blockCount;
+                stats.reservedBytes += block->getSize();
+            }
+        }
+        for (const std::unique_ptr<SlabPage>& page : pool.pages) {
+            if (page) {
+                ++stats.slabPageCount;
+            }
+        }
+    }
+    stats.deviceMemoryCount = stats.blockCount + stats.dedicatedCount;
+    return stats;
+}
@@ -0,0 +1,125 @@
+#pragma once
+#include <vulkan/vulkan.h>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+class VulkanContext;
+
+// 메모리 할당기에서 잘라 받은 구간. 리소스는 memory + offset에 바인딩되고, 해제할 때 free()로 돌려줍니다.
+struct MemoryAllocation {
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    VkDeviceSize offset = 0;
+    VkDeviceSize size = 0;
+    // HOST_VISIBLE 메모리는 블록 전체를 한 번 매핑해 두고 이 구간의 시작 주소를 넘겨줍니다.
+    // 여러 리소스가 같은 VkDeviceMemory를 쓰므로 리소스가 직접 vkMapMemory하면 안 됩니다.
+    void* mapped = nullptr;
+
+    bool isValid() const { return memory != VK_NULL_HANDLE; }
+
+private:
+    friend class MemoryAllocator;
+    uint32_t pool = 0;      // 메모리 타입 * 2 + (최적 타일링 이미지면 1)
+    uint32_t kind = 0;      // MemoryAllocator::AllocationKind
+    uint32_t block = 0;     // 풀 안의 블록 번호 (슬랩이면 페이지 번호)
+    uint32_t node = 0;      // 블록 안의 TLSF 노드 번호 (슬랩이면 슬롯 번호)
+};
+
+// 모든 리소스가 vkAllocateMemory를 따로 부르지 않도록 큰 블록을 잡아 나눠 주는 할당기
+//  - 풀은 (메모리 타입, 선형/최적 타일링)마다 하나입니다. 버퍼와 OPTIMAL 이미지가 같은 블록에 섞이지 않으므로
+//    bufferImageGranularity를 따로 맞출 필요가 없습니다.
+//  - 작은 할당(MAX_SLAB_SIZE 이하)은 2의 거듭제곱 크기 클래스별 슬랩 페이지에서 슬롯 하나를 꺼내 줍니다.
+//    슬롯 크기가 정렬 요구보다 크거나 같고 페이지가 슬롯 크기로 정렬되어 있으므로 정렬이 자동으로 맞습니다.
+//  - 그보다 큰 할당은 블록마다 TLSF(two-level segregated fit)로 O(1)에 찾고, 해제 시 이웃 빈 구간과 합칩니다.
+//  - 블록 크기의 절반을 넘는 할당은 블록을 낭비하므로 전용 메모리를 잡습니다.
+//  - 버퍼 블록은 BDA를 쓰는 버퍼가 섞이므로 항상 DEVICE_ADDRESS 플래그로 잡습니다.
+// 렌더 스레드에서만 사용합니다.
+class MemoryAllocator
+{
+public:
+    static constexpr VkDeviceSize DEFAULT_BLOCK_SIZE = 64ull * 1024 * 1024;
+    static constexpr VkDeviceSize SLAB_PAGE_SIZE = 256ull * 1024;
+    static constexpr VkDeviceSize MIN_SLAB_SIZE = 256;
+    static constexpr VkDeviceSize MAX_SLAB_SIZE = 16ull * 1024;
+
+    enum AllocationKind : uint32_t {
+        Dedicated,
+        Block,
+        Slab
+    };
+
+    struct Stats {
+        uint32_t deviceMemoryCount = 0;     // 지금 잡고 있는 VkDeviceMemory 수 (블록 + 전용)
+        uint32_t maxDeviceMemoryCount = 0;  // maxMemoryAllocationCount
+        uint32_t blockCount = 0;
+        uint32_t dedicatedCount = 0;
+        uint32_t slabPageCount = 0;
+        uint64_t allocationCount = 0;       // 살아 있는 할당 수
+        uint64_t totalAllocationCount = 0;  // 누적 할당 수
+        VkDeviceSize reservedBytes = 0;     // 드라이버에서 받은 크기
+        VkDeviceSize usedBytes = 0;         // 리소스에 나눠 준 크기
+    };
+
+    MemoryAllocator();
+    ~MemoryAllocator();
+
+    MemoryAllocator(const MemoryAllocator&) = delete;
+    MemoryAllocator& operator=(const MemoryAllocator&) = delete;
+
+    void initialize(const VulkanContext* context);
+    void cleanup();
+
+    // 메모리를 잡아 바인딩까지 합니다.
+    MemoryAllocation allocateForBuffer(VkBuffer buffer, VkMemoryPropertyFlags properties);
+    MemoryAllocation allocateForImage(VkImage image, VkMemoryPropertyFlags properties);
+    void free(MemoryAllocation& allocation);
+
+    Stats getStats() const;
+
+private:
+    class TlsfBlock;
+
+    struct SlabPage {
+        uint32_t sizeClass = 0;
+        uint32_t block = 0;             // 페이지를 잘라 온 TLSF 블록과 노드
+        uint32_t node = 0;
+        VkDeviceSize offset = 0;
+        std::vector<uint32_t> freeSlots;
+        uint32_t slotCount = 0;
+    };
+
+    static constexpr uint32_t SLAB_CLASS_COUNT = 7;    // 256 ~ 16K
+
+    struct Pool {
+        uint32_t memoryTypeIndex = 0;
+        bool optimal = false;
+        bool hostVisible = false;
+        VkDeviceSize blockSize = 0;
+        std::vector<std::unique_ptr<TlsfBlock>> blocks;     // 빈 칸은 해제된 블록 (번호를 유지하기 위해 지우지 않음)
+        std::vector<std::unique_ptr<SlabPage>> pages;
+        std::vector<uint32_t> partialPages[SLAB_CLASS_COUNT];  // 빈 슬롯이 남은 페이지
+    };
+
+    MemoryAllocation allocate(const VkMemoryRequirements& memRequirements, VkMemoryPropertyFlags properties, bool optimal);
+    bool allocateFromBlocks(Pool& pool, uint32_t poolIndex, VkDeviceSize size, VkDeviceSize alignment, MemoryAllocation& outAllocation);
+    bool allocateFromSlab(Pool& pool, uint32_t poolIndex, VkDeviceSize size, VkDeviceSize alignment, MemoryAllocation& outAllocation);
+    MemoryAllocation allocateDedicated(Pool& pool, uint32_t poolIndex, VkDeviceSize size);
+    void freeFromBlocks(Pool& pool, uint32_t blockIndex, uint32_t node);
+    void freeFromSlab(Pool& pool, MemoryAllocation& allocation);
+
+    VkDeviceMemory allocateDeviceMemory(const Pool& pool, VkDeviceSize size, void** outMapped);
+    Pool& getPool(uint32_t memoryTypeIndex, bool optimal, uint32_t& outPoolIndex);
+
+private:
+    const VulkanContext* context_ = nullptr;
+    VkPhysicalDeviceMemoryProperties memoryProperties_{};
+    uint32_t maxDeviceMemoryCount_ = 0;
+
+    std::vector<Pool> pools_;
+
+    uint32_t dedicatedCount_ = 0;
+    uint64_t allocationCount_ = 0;
+    uint64_t totalAllocationCount_ = 0;
+    VkDeviceSize dedicatedBytes_ = 0;
+    VkDeviceSize usedBytes_ = 0;
+};
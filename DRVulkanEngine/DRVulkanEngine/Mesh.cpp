@@ -1,32 +1,42 @@
 #include "Mesh.h"
 #include "VulkanContext.h"
 #include "TextureArray.h"
+#include "StorageBuffer.h"
+#include "CommandEncoder.h"
 #include <stdexcept>
+#include <algorithm>
+#include <cmath>
 
 Mesh::Mesh() {
 }
 
 Mesh::~Mesh() {
     vkDestroyBuffer(context_->getDevice(), indexBuffer_, nullptr);
-    vkFreeMemory(context_->getDevice(), indexBufferMemory_, nullptr);
+    context_->getMemoryAllocator().free(indexAllocation_);
     vkDestroyBuffer(context_->getDevice(), vertexBuffer_, nullptr);
-    vkFreeMemory(context_->getDevice(), vertexBufferMemory_, nullptr);
+    context_->getMemoryAllocator().free(vertexAllocation_);
 }
 
 Mesh::Mesh(Mesh&& other) noexcept
     : vertexBuffer_(other.vertexBuffer_),
-    vertexBufferMemory_(other.vertexBufferMemory_),
+    vertexAllocation_(other.vertexAllocation_),
     indexBuffer_(other.indexBuffer_),
-    indexBufferMemory_(other.indexBufferMemory_),
+    indexAllocation_(other.indexAllocation_),
     vertices_(std::move(other.vertices_)),
     indices_(std::move(other.indices_)),
+    boundingSphere_(other.boundingSphere_),
+    boundsMin_(other.boundsMin_),
+    boundsMax_(other.boundsMax_),
+    meshlets_(std::move(other.meshlets_)),
+    meshletBuffer_(std::move(other.meshletBuffer_)),
+    uploadTicket_(other.uploadTicket_),
     context_(other.context_),
     material_(std::move(other.material_))
 {
     other.vertexBuffer_ = VK_NULL_HANDLE;
-    other.vertexBufferMemory_ = VK_NULL_HANDLE;
+    other.vertexAllocation_ = MemoryAllocation{};
     other.indexBuffer_ = VK_NULL_HANDLE;
-    other.indexBufferMemory_ = VK_NULL_HANDLE;
+    other.indexAllocation_ = MemoryAllocation{};
 }
 
 void Mesh::update(float dt)
@@ -34,13 +44,24 @@ void Mesh::update(float dt)
 
 }
 
-void Mesh::draw(VkCommandBuffer commandBuffer)
+void Mesh::bind(VkCommandBuffer commandBuffer) const
 {
     VkBuffer vertexBuffers[] = { vertexBuffer_ };
     VkDeviceSize offsets[] = { 0 };
     vkCmdBindVertexBuffers(commandBuffer, 0, 1, vertexBuffers, offsets);
     vkCmdBindIndexBuffer(commandBuffer, indexBuffer_, 0, VK_INDEX_TYPE_UINT32);
-    vkCmdDrawIndexed(commandBuffer, static_cast<uint32_t>(indices_.size()), 1, 0, 0, 0);
+}
+
+void Mesh::bind(CommandEncoder& encoder) const
+{
+    encoder.bindVertexBuffer(0, vertexBuffer_);
+    encoder.bindIndexBuffer(indexBuffer_, 0, VK_INDEX_TYPE_UINT32);
+}
+
+void Mesh::draw(VkCommandBuffer commandBuffer, uint32_t instanceCount, uint32_t firstInstance) const
+{
+    bind(commandBuffer);
+    vkCmdDrawIndexed(commandBuffer, static_cast<uint32_t>(indices_.size()), instanceCount, 0, 0, firstInstance);
 }
 
 void Mesh::initialize(const VulkanContext* context,
@@ -50,15 +71,20 @@ void Mesh::initialize(const VulkanContext* context,
     std::shared_ptr<Texture> inSpecular,
     std::shared_ptr<Texture> inNormal,
     std::shared_ptr<Texture> inAmbient,
-    std::shared_ptr<Texture> inEmissive)
+    std::shared_ptr<Texture> inEmissive,
+    UploadPriority uploadPriority)
 {
     // 1. ⺻    
     context_ = context;
     vertices_ = inVertices;
     indices_ = inIndices;
 
-    createVertexBuffer();
-    createIndexBuffer();
+    createDeviceBuffer(vertices_.data(), sizeof(vertices_[0]) * vertices_.size(), VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+        uploadPriority, vertexBuffer_, vertexAllocation_);
+    uploadTicket_ = createDeviceBuffer(indices_.data(), sizeof(indices_[0]) * indices_.size(), VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+        uploadPriority, indexBuffer_, indexAllocation_);
+    computeBoundingSphere();
+    createMeshletBuffer();
 
     if(inDiffuse.get() != nullptr)
     {
@@ -71,79 +97,75 @@ void Mesh::initialize(const VulkanContext* context,
 	}
 }
 
-void Mesh::intializeMaterial()
+void Mesh::computeBoundingSphere()
 {
-
-}
-
-void Mesh::createVertexBuffer() {
-    VkBufferCreateInfo bufferInfo{};
-    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-    bufferInfo.size = sizeof(vertices_[0]) * vertices_.size();
-    bufferInfo.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
-    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-
-    if (vkCreateBuffer(context_->getDevice(), &bufferInfo, nullptr, &vertexBuffer_) != VK_SUCCESS) {
-        throw std::runtime_error("failed to create vertex buffer!");
+    if (vertices_.empty()) {
+        boundingSphere_ = glm::vec4(0.0f);
+        boundsMin_ = glm::vec3(0.0f);
+        boundsMax_ = glm::vec3(0.0f);
+        return;
     }
 
-    VkMemoryRequirements memRequirements;
-    vkGetBufferMemoryRequirements(context_->getDevice(), vertexBuffer_, &memRequirements);
-
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = context_->findMemoryType(memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    // AABB ߽  ߽ ,     մϴ.
+    glm::vec3 minPos = vertices_[0].pos;
+    glm::vec3 maxPos = vertices_[0].pos;
+    for (const Vertex& vertex : vertices_) {
+        minPos = glm::min(minPos, vertex.pos);
+        maxPos = glm::max(maxPos, vertex.pos);
+    }
+    boundsMin_ = minPos;
+    boundsMax_ = maxPos;
+    glm::vec3 center = (minPos + maxPos) * 0.5f;
+
+    float radiusSq = 0.0f;
+    for (const Vertex& vertex : vertices_) {
+        glm::vec3 offset = vertex.pos - center;
+        radiusSq = std::max(radiusSq, glm::dot(offset, offset));
+    }
+    boundingSphere_ = glm::vec4(center, std::sqrt(radiusSq));
+}
 
-    if (vkAllocateMemory(context_->getDevice(), &allocInfo, nullptr, &vertexBufferMemory_) != VK_SUCCESS) {
-        throw std::runtime_error("failed to allocate vertex buffer memory!");
+void Mesh::createMeshletBuffer()
+{
+    meshlets_ = BuildMeshlets(vertices_, indices_);
+    if (meshlets_.empty()) {
+        return;
     }
 
-    vkBindBufferMemory(context_->getDevice(), vertexBuffer_, vertexBufferMemory_, 0);
+    VkDeviceSize bufferSize = sizeof(Meshlet) * meshlets_.size();
+    meshletBuffer_ = std::make_unique<StorageBuffer>(context_, bufferSize);
+    meshletBuffer_->update(meshlets_.data(), bufferSize);
+}
 
-    void* data;
-    vkMapMemory(context_->getDevice(), vertexBufferMemory_, 0, bufferInfo.size, 0, &data);
-    memcpy(data, vertices_.data(), (size_t)bufferInfo.size);
-    vkUnmapMemory(context_->getDevice(), vertexBufferMemory_);
+VkDeviceAddress Mesh::getMeshletAddress() const
+{
+    return meshletBuffer_ ? meshletBuffer_->getDeviceAddress() : 0;
 }
 
+void Mesh::intializeMaterial()
+{
 
-void Mesh::createIndexBuffer() {
-    VkDeviceSize bufferSize = sizeof(indices_[0]) * indices_.size();
+}
 
+UploadTicket Mesh::createDeviceBuffer(const void* data, VkDeviceSize size, VkBufferUsageFlags usage, UploadPriority uploadPriority,
+    VkBuffer& buffer, MemoryAllocation& allocation) {
     VkBufferCreateInfo bufferInfo{};
     bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-    bufferInfo.size = bufferSize;
-    bufferInfo.usage = VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
-    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-
-    if (vkCreateBuffer(context_->getDevice(), &bufferInfo, nullptr, &indexBuffer_) != VK_SUCCESS) {
-        throw std::runtime_error("failed to create index buffer!");
-    }
-
-    VkMemoryRequirements memRequirements;
-    vkGetBufferMemoryRequirements(context_->getDevice(), indexBuffer_, &memRequirements);
-
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = context_->findMemoryType(memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    bufferInfo.size = size;
+    bufferInfo.usage = usage | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    //  ť ϰ ׷Ƚ ť Ƿ йи ٸ CONCURRENT ϴ.
+    context_->setBufferSharing(bufferInfo);
 
-    if (vkAllocateMemory(context_->getDevice(), &allocInfo, nullptr, &indexBufferMemory_) != VK_SUCCESS) {
-        throw std::runtime_error("failed to allocate index buffer memory!");
+    if (vkCreateBuffer(context_->getDevice(), &bufferInfo, nullptr, &buffer) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create mesh buffer!");
     }
 
-    vkBindBufferMemory(context_->getDevice(), indexBuffer_, indexBufferMemory_, 0);
+    allocation = context_->getMemoryAllocator().allocateForBuffer(buffer, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
 
-    //  ͸ ۿ մϴ.
-    void* data;
-    vkMapMemory(context_->getDevice(), indexBufferMemory_, 0, bufferSize, 0, &data);
-    // 3.  ͸ 'vertices'  'indices' Ϳ ɴϴ.
-    memcpy(data, indices_.data(), (size_t)bufferSize);
-    vkUnmapMemory(context_->getDevice(), indexBufferMemory_);
+    return context_->getUploadManager().uploadBuffer(buffer, 0, data, size, uploadPriority);
 }
 
-void Mesh::prepareBindless(UniformBufferArray& uniformBufferArray, TextureArray& textures)
+void Mesh::prepareBindless(MaterialTable& materialTable, TextureArray& textures)
 {
-	material_->prepareBindless(uniformBufferArray, textures);
+	material_->prepareBindless(materialTable, textures);
 }
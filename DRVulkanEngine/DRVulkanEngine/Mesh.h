@@ -2,13 +2,18 @@
 #include <vulkan/vulkan.h>
 #include "Vertex.h"
 #include "Material.h"
+#include "MeshletBuilder.h"
+#include "UploadManager.h"
 #include <vector>
 #include <memory>
 #include <map>
+#include <glm/glm.hpp>
 class VulkanContext;
 class Texture;
 class TextureArray;
-class UniformBufferArray;
+class MaterialTable;
+class StorageBuffer;
+class CommandEncoder;
 
 class Mesh
 {
@@ -25,27 +30,57 @@ public:
         std::shared_ptr<Texture> inSpecular = nullptr,
         std::shared_ptr<Texture> inNormal = nullptr,
         std::shared_ptr<Texture> inAmbient = nullptr,
-        std::shared_ptr<Texture> inEmissive = nullptr);
+        std::shared_ptr<Texture> inEmissive = nullptr,
+        UploadPriority uploadPriority = UploadPriority::Immediate);
 
     void update(float dt);
-    void draw(VkCommandBuffer commandBuffer);
+    // firstInstance는 셰이더의 gl_InstanceIndex에 더해지므로 인스턴스 버퍼 오프셋으로 사용합니다.
+    void draw(VkCommandBuffer commandBuffer, uint32_t instanceCount = 1, uint32_t firstInstance = 0) const;
+    // 간접 드로우용: 버퍼만 바인딩하고 드로우 파라미터는 GPU가 채웁니다.
+    void bind(VkCommandBuffer commandBuffer) const;
+    void bind(CommandEncoder& encoder) const;
+
+    uint32_t getIndexCount() const { return static_cast<uint32_t>(indices_.size()); }
+    // 로컬 공간 바운딩 스피어 (xyz = 중심, w = 반지름), 바인드 포즈 기준
+    const glm::vec4& getBoundingSphere() const { return boundingSphere_; }
+    // 로컬 공간 AABB, 바인드 포즈 기준
+    const glm::vec3& getBoundsMin() const { return boundsMin_; }
+    const glm::vec3& getBoundsMax() const { return boundsMax_; }
+    // CPU 소프트웨어 가림 컬링의 가리개로 쓸 때 (업로드 후에도 CPU 사본을 유지합니다)
+    const std::vector<Vertex>& getVertices() const { return vertices_; }
+    const std::vector<uint32_t>& getIndices() const { return indices_; }
+    // 클러스터 컬링용 메시렛, 인덱스 버퍼의 연속 구간이라 firstIndex만으로 그릴 수 있습니다.
+    const std::vector<Meshlet>& getMeshlets() const { return meshlets_; }
+    uint32_t getMeshletCount() const { return static_cast<uint32_t>(meshlets_.size()); }
+    VkDeviceAddress getMeshletAddress() const;
+    // 버텍스/인덱스 복사 중 나중에 요청한 업로드 번호
+    UploadTicket getUploadTicket() const { return uploadTicket_; }
 
 	Material* getMaterial() const { return material_.get(); }
-    void prepareBindless(UniformBufferArray& uniformBufferArray, TextureArray& textures);
+    void prepareBindless(MaterialTable& materialTable, TextureArray& textures);
 private:
 
 
     void intializeMaterial();
-    void createVertexBuffer();
-    void createIndexBuffer();
+    // DEVICE_LOCAL 버퍼를 만들고 내용은 업로드 매니저의 스테이징 링을 거쳐 복사합니다. 복사 요청 번호를 반환합니다.
+    UploadTicket createDeviceBuffer(const void* data, VkDeviceSize size, VkBufferUsageFlags usage, UploadPriority uploadPriority,
+        VkBuffer& buffer, MemoryAllocation& allocation);
+    void computeBoundingSphere();
+    void createMeshletBuffer();
 private:
     VkBuffer vertexBuffer_;
-    VkDeviceMemory vertexBufferMemory_;
+    MemoryAllocation vertexAllocation_;
     VkBuffer indexBuffer_;
-    VkDeviceMemory indexBufferMemory_;
+    MemoryAllocation indexAllocation_;
 
     std::vector<Vertex> vertices_;
     std::vector<uint32_t> indices_;
+    glm::vec4 boundingSphere_ = glm::vec4(0.0f);
+    glm::vec3 boundsMin_ = glm::vec3(0.0f);
+    glm::vec3 boundsMax_ = glm::vec3(0.0f);
+    std::vector<Meshlet> meshlets_;
+    std::unique_ptr<StorageBuffer> meshletBuffer_;
+    UploadTicket uploadTicket_ = INVALID_UPLOAD_TICKET;
 
     const VulkanContext* context_;
 public:
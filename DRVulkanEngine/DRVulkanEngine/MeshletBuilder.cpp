@@ -0,0 +1,152 @@
+#include "MeshletBuilder.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    constexpr float RIGID_WEIGHT_THRESHOLD = 0.999f;
+    constexpr uint32_t INVALID_LOCAL_INDEX = ~0u;
+
+    // 정점이 한 본에만 붙어 있으면 그 본, 스키닝이 없으면 MESHLET_STATIC, 섞여 있으면 MESHLET_BLENDED
+    int32_t classifyVertexBone(const Vertex& vertex)
+    {
+        // shader.vert와 같은 기준 (첫 가중치가 0이면 스키닝 안 함)
+        if (vertex.weights[0] <= 0.0f) {
+            return MESHLET_STATIC;
+        }
+
+        int32_t bone = MESHLET_STATIC;
+        for (int i = 0; i < MAX_BONE_INFLUENCE; ++i) {
+            if (vertex.boneIDs[i] < 0 || vertex.weights[i] == 0.0f) {
+                continue;
+            }
+            if (bone != MESHLET_STATIC && bone != vertex.boneIDs[i]) {
+                return MESHLET_BLENDED;
+            }
+            if (vertex.weights[i] < RIGID_WEIGHT_THRESHOLD) {
+                return MESHLET_BLENDED;
+            }
+            bone = vertex.boneIDs[i];
+        }
+        return bone;
+    }
+
+    void finalizeMeshlet(Meshlet& meshlet, const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
+        const std::vector<uint32_t>& meshletVertices)
+    {
+        meshlet.vertexCount = static_cast<uint32_t>(meshletVertices.size());
+
+        // 바운딩 스피어: Mesh::computeBoundingSphere와 같이 AABB 중심 + 가장 먼 정점
+        glm::vec3 minPos = vertices[meshletVertices[0]].pos;
+        glm::vec3 maxPos = minPos;
+        int32_t bone = classifyVertexBone(vertices[meshletVertices[0]]);
+        for (uint32_t vertexIndex : meshletVertices) {
+            const Vertex& vertex = vertices[vertexIndex];
+            minPos = glm::min(minPos, vertex.pos);
+            maxPos = glm::max(maxPos, vertex.pos);
+            if (bone != MESHLET_BLENDED && classifyVertexBone(vertex) != bone) {
+                bone = MESHLET_BLENDED;
+            }
+        }
+        glm::vec3 center = (minPos + maxPos) * 0.5f;
+        float radiusSq = 0.0f;
+        for (uint32_t vertexIndex : meshletVertices) {
+            glm::vec3 offset = vertices[vertexIndex].pos - center;
+            radiusSq = std::max(radiusSq, glm::dot(offset, offset));
+        }
+        meshlet.boundingSphere = glm::vec4(center, std::sqrt(radiusSq));
+        meshlet.boneIndex = bone;
+
+        // 노멀 콘: 삼각형 법선(CCW가 앞면)의 평균을 축으로, 축과 가장 벌어진 법선으로 cutoff를 정합니다.
+        std::vector<glm::vec3> normals;
+        normals.reserve(meshlet.triangleCount);
+        glm::vec3 axis(0.0f);
+        for (uint32_t t = 0; t < meshlet.triangleCount; ++t) {
+            size_t base = (static_cast<size_t>(meshlet.triangleOffset) + t) * 3;
+            const glm::vec3& p0 = vertices[indices[base + 0]].pos;
+            const glm::vec3& p1 = vertices[indices[base + 1]].pos;
+            const glm::vec3& p2 = vertices[indices[base + 2]].pos;
+            glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+            float length = glm::length(normal);
+            if (length <= 0.0f) {
+                continue; // 면적 0인 삼각형은 보이지 않으므로 콘에서 뺍니다.
+            }
+            normal /= length;
+            normals.push_back(normal);
+            axis += normal;
+        }
+
+        float axisLength = glm::length(axis);
+        if (normals.empty() || axisLength <= 0.0f) {
+            meshlet.cone = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+            return;
+        }
+        axis /= axisLength;
+
+        float minDot = 1.0f;
+        for (const glm::vec3& normal : normals) {
+            minDot = std::min(minDot, glm::dot(axis, normal));
+        }
+        // 콘이 반구 이상 벌어지면 어느 방향에서든 앞면이 보일 수 있습니다.
+        float cutoff = (minDot <= 0.0f) ? 1.0f : std::sqrt(1.0f - minDot * minDot);
+        meshlet.cone = glm::vec4(axis, cutoff);
+    }
+}
+
+std::vector<Meshlet> BuildMeshlets(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices)
+{
+    std::vector<Meshlet> meshlets;
+    if (vertices.empty() || indices.size() < 3) {
+        return meshlets;
+    }
+
+    // 정점 -> 현재 메시렛 안 로컬 인덱스 (메시렛을 닫을 때 쓴 정점만 되돌립니다)
+    std::vector<uint32_t> localIndices(vertices.size(), INVALID_LOCAL_INDEX);
+    std::vector<uint32_t> meshletVertices;
+    meshletVertices.reserve(MESHLET_MAX_VERTICES);
+
+    Meshlet current{};
+    auto flush = [&]() {
+        if (current.triangleCount == 0) {
+            return;
+        }
+        finalizeMeshlet(current, vertices, indices, meshletVertices);
+        meshlets.push_back(current);
+        for (uint32_t vertexIndex : meshletVertices) {
+            localIndices[vertexIndex] = INVALID_LOCAL_INDEX;
+        }
+        meshletVertices.clear();
+        Meshlet next{};
+        next.triangleOffset = current.triangleOffset + current.triangleCount;
+        current = next;
+    };
+
+    uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+    for (uint32_t t = 0; t < triangleCount; ++t) {
+        const uint32_t* triangle = &indices[static_cast<size_t>(t) * 3];
+
+        uint32_t newVertices = 0;
+        for (int i = 0; i < 3; ++i) {
+            bool seenInTriangle = (i > 0 && triangle[i] == triangle[0]) || (i > 1 && triangle[i] == triangle[1]);
+            if (localIndices[triangle[i]] == INVALID_LOCAL_INDEX && !seenInTriangle) {
+                newVertices++;
+            }
+        }
+
+        if (meshletVertices.size() + newVertices > MESHLET_MAX_VERTICES ||
+            current.triangleCount + 1 > MESHLET_MAX_TRIANGLES) {
+            flush();
+        }
+
+        for (int i = 0; i < 3; ++i) {
+            if (localIndices[triangle[i]] == INVALID_LOCAL_INDEX) {
+                localIndices[triangle[i]] = static_cast<uint32_t>(meshletVertices.size());
+                meshletVertices.push_back(triangle[i]);
+            }
+        }
+        current.triangleCount++;
+    }
+    flush();
+
+    return meshlets;
+}
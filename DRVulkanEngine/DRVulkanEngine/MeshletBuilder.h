@@ -0,0 +1,27 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include "Vertex.h"
+
+// 메시렛 하나의 GPU 데이터 (cluster_cull.comp의 Meshlet과 일치해야 함, std430)
+struct alignas(16) Meshlet {
+    glm::vec4 boundingSphere = glm::vec4(0.0f); // 로컬 공간, 바인드 포즈 (xyz = 중심, w = 반지름)
+    glm::vec4 cone = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f); // xyz = 평균 법선 축, w = cutoff (1이면 콘 컬링 안 함)
+    uint32_t triangleOffset = 0;                 // 메시 인덱스 버퍼 기준 첫 삼각형 (firstIndex = x3)
+    uint32_t triangleCount = 0;
+    uint32_t vertexCount = 0;
+    int32_t boneIndex = -1;                      // MESHLET_STATIC, 단일 본 인덱스, MESHLET_BLENDED
+};
+
+constexpr uint32_t MESHLET_MAX_VERTICES = 64;
+constexpr uint32_t MESHLET_MAX_TRIANGLES = 124;
+// 스키닝 없는 메시렛, 바인드 포즈 바운드를 그대로 씁니다.
+constexpr int32_t MESHLET_STATIC = -1;
+// 여러 본이 섞인 메시렛, 바인드 포즈 바운드를 믿을 수 없어 클러스터 컬링을 하지 않습니다.
+constexpr int32_t MESHLET_BLENDED = -2;
+
+// 인덱스 버퍼를 앞에서부터 순서대로 잘라 메시렛을 만듭니다. (정점 64개 / 삼각형 124개 이하)
+// 삼각형 순서를 바꾸지 않으므로 각 메시렛은 기존 인덱스 버퍼의 연속 구간이고, 그대로 드로우할 수 있습니다.
+// 한 본에만 100% 붙은 메시렛은 boneIndex에 그 본을 기록해 런타임에 본 행렬로 바운드를 옮깁니다.
+std::vector<Meshlet> BuildMeshlets(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices);
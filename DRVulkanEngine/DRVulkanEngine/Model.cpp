@@ -2,49 +2,39 @@
 #include "VulkanContext.h"
 #include "Material.h"
 #include "ModelLoader.h"
-#include "UniformBuffer.h"
 #include "TextureArray.h"
-#include "UniformBufferArray.h"
 #include "GlobalData.h"
 #include "Animator.h"
 #include "Animation.h"
-#include "PrimitiveFactory.h"
-#include "BDABuffer.h"
+#include "BonePalettePool.h"
+#include "GpuScene.h"
+#include "AssetRegistry.h"
+#include <limits>
+#include <algorithm>
 #include <glm/gtc/type_ptr.hpp> // value_ptr   ߰
 
-Model::Model(const VulkanContext* context, const ModelConfig& modelConfig) {
-    context_ = context; // Resource Ŭκ ӹ context_
-    if(modelConfig.type == ModelType::FromFile) {
-        std::string filedir = modelConfig.modelDirectory;
-        std::string filename = modelConfig.modelFilename;
-        
-        bool modelLoaded = ModelLoader::LoadSkinnedModel(context_, filedir, filename, meshes_);
-        for (const auto& animFilename : modelConfig.animationFilenames) {
-            ModelLoader::LoadAnimations(context_, filedir, animFilename, animations_);
-            if (animations_.size() > 0) {
-                animator_ = std::make_unique<class Animator>(&animations_[0]);
-            }
-        }
-    }
-    else if(modelConfig.type == ModelType::Box) {
-        
-        PrimitiveFactory::createBox(context, 50, 50, 50, meshes_);
-	}
+Model::Model(const VulkanContext* context, const ModelConfig& modelConfig)
+    : Model(context, modelConfig, AssetRegistry::Load(context, modelConfig)) {
+}
 
-	modelUB_ = std::make_unique<class UniformBuffer>(context_, sizeof(UniformBufferObject));
-    
-#if USE_BDA_BUFFER
-    boneBDA_ = std::make_unique<BDABuffer>(context_, sizeof(UniformBufferBone));
-#endif
-    boneUB_ = std::make_unique<UniformBuffer>(context_, sizeof(UniformBufferBone));
+Model::Model(const VulkanContext* context, const ModelConfig& modelConfig, std::shared_ptr<ModelAsset> asset) {
+    context_ = context;
+    modelConfig_ = modelConfig;
+    asset_ = std::move(asset);
 
+    // Animator  ð νϽ , ִϸ̼ ʹ   մϴ.
+    if (asset_->animations.size() > 0) {
+        animator_ = std::make_unique<class Animator>(&asset_->animations[0], asset_->globalInverseTransform);
+    }
+
+    initializeInstanceResources();
+}
 
+void Model::initializeInstanceResources() {
     //  ȭ  ʱȭ
     framesSinceLastBoneUpdate_ = 0;
     boneDataDirty_ = true;
     cachedBoneMatrices_.reserve(MAX_BONES); // ޸ Ҵ 
-    
-    memset(&ubBoneBuffer_, 0, sizeof(UniformBufferBone));
 }
 
 Model::~Model() {
@@ -58,41 +48,45 @@ inline bool Model::isMatrixChanged(const glm::mat4& a, const glm::mat4& b) const
     return memcmp(glm::value_ptr(a), glm::value_ptr(b), sizeof(glm::mat4)) != 0;
 }
 
-void Model::prepareBindless(UniformBufferArray& modelUbArray, UniformBufferArray& materialUbArray, UniformBufferArray& boneUbArray, TextureArray& textures)
+void Model::prepareBindless(MaterialTable& materialTable, BonePalettePool& palettePool, TextureArray& textures)
 {
-
-    modelUbIndex_ = modelUbArray.addUniformBuffer(modelUB_.get());
-//#if !USE_BDA_BUFFER
-    boneUbIndex_ = boneUbArray.addUniformBuffer(boneUB_.get());
-//#endif
-    meshes_[0].prepareBindless(materialUbArray, textures);
-}
-
-void Model::addMesh(Mesh&& mesh) {
-    meshes_.push_back(std::move(mesh));
+    // ̷   ŭ ޽ϴ. ( ID BoneInfo   0 Ű)
+    if (animator_ && paletteIndex_ == BonePalettePool::INVALID_PALETTE) {
+        paletteBoneCount_ = static_cast<uint32_t>(std::min<size_t>(MAX_BONES, asset_->animations[0].GetBoneIDMap().size()));
+        paletteIndex_ = palettePool.allocate(paletteBoneCount_);
+    }
+    asset_->prepareBindless(materialTable, textures);
 }
 
-void Model::update(float deltaTime) {
-    if (!animator_) {
+void Model::update(float deltaTime, BonePalettePool& palettePool) {
+    if (!animator_ || paletteIndex_ == BonePalettePool::INVALID_PALETTE) {
         return;
     }
 
+    if (updateBoneMatrices(deltaTime)) {
+        const uint32_t boneCount = std::min(paletteBoneCount_, static_cast<uint32_t>(cachedBoneMatrices_.size()));
+        palettePool.write(paletteIndex_, cachedBoneMatrices_.data(), boneCount);
+    }
+}
+
+bool Model::updateBoneMatrices(float deltaTime) {
+
     ++framesSinceLastBoneUpdate_;
     if (framesSinceLastBoneUpdate_ < BONE_UPDATE_FREQUENCY) {
-        return;
+        return false;
     }
     framesSinceLastBoneUpdate_ = 0;
 
     bool animationChanged = animator_->updateAnimation(deltaTime);
     
     if (!animationChanged && !boneDataDirty_) {
-        return;
+        return false;
     }
 
     const auto& finalBoneMatrices = animator_->getFinalBoneMatrices();
     
     if (finalBoneMatrices.empty()) {
-        return;
+        return false;
     }
 
     const size_t matricesToProcess = std::min((size_t)MAX_BONES, finalBoneMatrices.size());
@@ -107,7 +101,7 @@ void Model::update(float deltaTime) {
         }
         
         if (!hasChanges) {
-            return; //   GPU Ʈ 
+            return false; //   GPU Ʈ 
         }
     }
 
@@ -119,42 +113,60 @@ void Model::update(float deltaTime) {
         memcpy(cachedBoneMatrices_.data(), 
                finalBoneMatrices.data(), 
                sizeof(glm::mat4) * matricesToProcess);
-        
-        memcpy(&ubBoneBuffer_.finalBoneMatrix, 
-               finalBoneMatrices.data(), 
-               sizeof(glm::mat4) * matricesToProcess);
-#if USE_BDA_BUFFER
-        boneBDA_->update(&ubBoneBuffer_);
-#endif
-        boneUB_->update(&ubBoneBuffer_);
-
     }
 
     boneDataDirty_ = false;
+    return true;
 }
 
 void Model::draw(VkCommandBuffer commandBuffer) {
-    for (auto& mesh : meshes_) {
+    for (auto& mesh : asset_->meshes) {
         mesh.draw(commandBuffer);
     }
 }
 
-void Model::getPushConstantData(PushConstantData& outPushData)
+bool Model::getWorldBounds(glm::vec3& outMin, glm::vec3& outMax) const
 {
-	outPushData.modelUBIndex = modelUbIndex_;
-	
-	outPushData.materialIndex = meshes_[0].getMaterial() ? meshes_[0].getMaterial()->getMaterialIndex() : -1;
-#if USE_BDA_BUFFER
-    outPushData.boneAddress = boneBDA_->getDeviceAddress();
-#else
-    outPushData.boneUbIndex = boneUbIndex_;
-#endif
+    if (!asset_ || asset_->meshes.empty()) {
+        return false;
+    }
+
+    outMin = glm::vec3(std::numeric_limits<float>::max());
+    outMax = glm::vec3(std::numeric_limits<float>::lowest());
+    for (const Mesh& mesh : asset_->meshes) {
+        const glm::vec3& localMin = mesh.getBoundsMin();
+        const glm::vec3& localMax = mesh.getBoundsMax();
+        for (int i = 0; i < 8; ++i) {
+            glm::vec3 corner((i & 1) ? localMax.x : localMin.x,
+                             (i & 2) ? localMax.y : localMin.y,
+                             (i & 4) ? localMax.z : localMin.z);
+            glm::vec3 worldCorner = glm::vec3(worldMatrix_ * glm::vec4(corner, 1.0f));
+            outMin = glm::min(outMin, worldCorner);
+            outMax = glm::max(outMax, worldCorner);
+        }
+    }
+    return true;
+}
+
+void Model::registerObjects(GpuScene& scene)
+{
+    objectIds_.resize(asset_->meshes.size());
+    for (uint32_t& objectId : objectIds_) {
+        objectId = scene.addObject();
+    }
 }
 
-void Model::updateUniformBuffer(const glm::mat4& modelMatrix, const glm::mat4& viewMatrix, const glm::mat4& projMatrix){
-    UniformBufferObject ubo{};
-    ubo.world = modelMatrix;
-    ubo.view = viewMatrix;
-    ubo.proj = projMatrix;
-	modelUB_->update(&ubo);
+uint32_t Model::getObjectId(size_t meshIndex) const
+{
+    return meshIndex < objectIds_.size() ? objectIds_[meshIndex] : GpuScene::INVALID_OBJECT;
+}
+
+void Model::getObjectRecord(size_t meshIndex, ObjectRecord& outRecord) const
+{
+    const Mesh& mesh = asset_->meshes[meshIndex];
+    outRecord.world = worldMatrix_;
+    outRecord.boundingSphere = mesh.getBoundingSphere();
+    outRecord.materialIndex = mesh.getMaterial() ? mesh.getMaterial()->getMaterialIndex() : -1;
+    outRecord.paletteOffset = paletteIndex_ == BonePalettePool::INVALID_PALETTE
+        ? ObjectRecord::NO_PALETTE : static_cast<uint32_t>(paletteIndex_ * sizeof(glm::mat4));
 }
\ No newline at end of file
@@ -9,28 +9,23 @@
 #include "Animator.h"
 #include "ModelConfig.h"
 #include "GlobalData.h"
+#include "AssetRegistry.h"
 
 class VulkanContext;
-class UniformBuffer;
 class TextureArray;
-class UniformBufferArray;
+class MaterialTable;
 class Resource; 
-class BDABuffer;
+class BonePalettePool;
+class GpuScene;
 #define MAX_BONES 100 
-struct UniformBufferBone {
-    alignas(16) glm::mat4 finalBoneMatrix[MAX_BONES];
-};
-
-struct UniformBufferObject {
-    alignas(16) glm::mat4 world;
-    alignas(16) glm::mat4 view;
-    alignas(16) glm::mat4 proj;
-};
 
 class Model
 {
 public:
+    // AssetRegistry에서 공유 에셋을 찾고, 없으면 동기로 로드합니다.
     Model(const VulkanContext* context, const ModelConfig& modelConfig);
+    // 이미 로드된 공유 에셋으로 인스턴스만 만듭니다. (인스턴스별 상태는 트랜스폼과 애니메이터뿐)
+    Model(const VulkanContext* context, const ModelConfig& modelConfig, std::shared_ptr<ModelAsset> asset);
     ~Model();
 
     Model(const Model& other) = delete;
@@ -38,33 +33,41 @@ public:
     Model(Model&& other) noexcept;
     Model& operator=(Model&& other) noexcept;
 
-    void prepareBindless(UniformBufferArray& modelUbArray, UniformBufferArray& materialUbArray, UniformBufferArray& boneUbArray, TextureArray& textures);
-	void updateUniformBuffer(const glm::mat4& modelMatrix, const glm::mat4& viewMatrix, const glm::mat4& projMatrix);
-
-    void addMesh(Mesh&& mesh);
-
-    void update(float deltaTime);
+    // 재질을 테이블에 등록하고, 애니메이션이 있으면 팔레트 풀에서 본 수만큼 구간을 받습니다.
+    void prepareBindless(MaterialTable& materialTable, BonePalettePool& palettePool, TextureArray& textures);
+    // 메시마다 GPU 씬 오브젝트 ID를 하나씩 받습니다. 등록 전에는 InstanceBatcher가 이 모델을 건너뜁니다.
+    void registerObjects(GpuScene& scene);
+    void setWorldMatrix(const glm::mat4& worldMatrix) { worldMatrix_ = worldMatrix; }
+    const glm::mat4& getWorldMatrix() const { return worldMatrix_; }
+    bool isOccluder() const { return modelConfig_.isOccluder; }
+    // 모든 메시 로컬 AABB를 월드로 옮긴 AABB (바인드 포즈 기준)
+    bool getWorldBounds(glm::vec3& outMin, glm::vec3& outMax) const;
+
+    // 포즈가 바뀐 프레임에만 본 팔레트를 풀의 CPU 사본에 씁니다. (GPU로는 풀의 flush()가 한 번에 올림)
+    void update(float deltaTime, BonePalettePool& palettePool);
     void draw(VkCommandBuffer commandBuffer);
 
-    void getPushConstantData(PushConstantData& outPushData);
+    // 인스턴싱: 같은 에셋을 쓰는 모델끼리 메시 단위로 묶어 그립니다.
+    const ModelAsset* getAsset() const { return asset_.get(); }
+    uint32_t getObjectId(size_t meshIndex) const;
+    void getObjectRecord(size_t meshIndex, ObjectRecord& outRecord) const;
 private:
-    const VulkanContext* context_;
-    std::vector<Mesh> meshes_;
-
-	std::unique_ptr<class UniformBuffer> modelUB_;
+    void initializeInstanceResources();
+    // 포즈가 바뀌었으면 true
+    bool updateBoneMatrices(float deltaTime);
 
-	int modelUbIndex_ = -1;
-	int boneUbIndex_ = -1;
-    int boneTbIndex = -1;
+    const VulkanContext* context_;
+    std::shared_ptr<ModelAsset> asset_;
 
+    glm::mat4 worldMatrix_ = glm::mat4(1.0f);
 
     std::unique_ptr<Animator> animator_;
-	std::vector<Animation> animations_;
 
-#if USE_BDA_BUFFER
-    std::unique_ptr<BDABuffer> boneBDA_;
-#endif
-    std::unique_ptr<class UniformBuffer> boneUB_;
+    // 팔레트 풀 안의 첫 행렬 인덱스와 본 수 (애니메이션이 없으면 INVALID_PALETTE)
+    // 위치가 바뀌지 않으므로 GPU 씬 레코드를 애니메이션 때문에 다시 올리지 않습니다.
+    uint32_t paletteIndex_ = ~0u;
+    uint32_t paletteBoneCount_ = 0;
+    std::vector<uint32_t> objectIds_;
 
     bool boneDataDirty_ = true;
     std::vector<glm::mat4> cachedBoneMatrices_;
@@ -73,8 +76,6 @@ private:
     static constexpr uint32_t BONE_UPDATE_FREQUENCY = 1;
     static constexpr float MATRIX_COMPARISON_THRESHOLD = 0.00001f;
     
-    mutable UniformBufferBone ubBoneBuffer_;
-    
     inline bool isMatrixChanged(const glm::mat4& a, const glm::mat4& b) const;
 
     ModelConfig modelConfig_;
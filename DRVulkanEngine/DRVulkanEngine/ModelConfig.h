@@ -18,4 +18,7 @@ struct ModelConfig {
 
 	std::vector<std::string> animationFilenames;
 
+	// CPU Ʈ  ø  Ͷ (, ū ǹ  Ҽ ޽ø)
+	bool isOccluder = false;
+
 };
\ No newline at end of file
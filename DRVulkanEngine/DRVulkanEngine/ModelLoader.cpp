@@ -6,14 +6,40 @@
 #include <assimp/postprocess.h>
 #include <iostream>
 #include "Texture.h"
+#include "TextureCache.h"
 #include <glm/gtc/type_ptr.hpp> // glm::make_mat4  ߰
 
 // static   
 std::map<std::string, BoneInfo> ModelLoader::boneInfoMap_;
 int ModelLoader::boneCounter_ = 0;
-glm::mat4 ModelLoader::globalInverseTransform_;
+std::mutex ModelLoader::importMutex_;
 // --- 1. ̷ ޽ ε Լ ---
-bool ModelLoader::LoadSkinnedModel(const VulkanContext* context, const std::string& filedir, const std::string& filename, std::vector<Mesh>& outMesh) {
+bool ModelLoader::LoadSkinnedModel(const VulkanContext* context, const std::string& filedir, const std::string& filename, std::vector<Mesh>& outMesh, glm::mat4& outGlobalInverseTransform) {
+    ModelImportData importData;
+    if (!ImportSkinnedModel(filedir, filename, importData)) {
+        return false;
+    }
+    outGlobalInverseTransform = importData.globalInverseTransform;
+
+    for (const MeshImportData& meshData : importData.meshes) {
+        std::array<std::shared_ptr<Texture>, TEXTURE_SLOT_COUNT> textures;
+        for (int slot = 0; slot < TEXTURE_SLOT_COUNT; ++slot) {
+            if (!meshData.texturePaths[slot].empty()) {
+                textures[slot] = TextureCache::Load(context, meshData.texturePaths[slot]);
+            }
+        }
+
+        outMesh.emplace_back();
+        Mesh& newMeshRef = outMesh.back();
+        newMeshRef.initialize(context, meshData.vertices, meshData.indices,
+            textures[TEXTURE_SLOT_DIFFUSE], textures[TEXTURE_SLOT_SPECULAR], textures[TEXTURE_SLOT_NORMAL],
+            textures[TEXTURE_SLOT_AMBIENT], textures[TEXTURE_SLOT_EMISSIVE]);
+    }
+
+    return true;
+}
+
+bool ModelLoader::ImportSkinnedModel(const std::string& filedir, const std::string& filename, ModelImportData& outData) {
     Assimp::Importer importer;
     std::string filepath = filedir + "/" + filename;
 
@@ -42,12 +68,12 @@ bool ModelLoader::LoadSkinnedModel(const VulkanContext* context, const std::stri
         rootTransformAssimp.a4, rootTransformAssimp.b4, rootTransformAssimp.c4, rootTransformAssimp.d4
     );
 
-    // 3.    Ͽ   մϴ.
+    // 3.    Ͽ  մϴ.
     //    ̰ ' ' ٷ   Դϴ.
-    globalInverseTransform_ = glm::inverse(globalTransform);
+    outData.globalInverseTransform = glm::inverse(globalTransform);
     //  带 ȸϸ ޽ÿ   óմϴ.
     //   static  boneInfoMap_ äϴ.
-    processNode(context, scene->mRootNode, scene, filedir, outMesh);
+    processNode(scene->mRootNode, scene, filedir, outData.meshes);
 
     return true;
 }
@@ -75,22 +101,24 @@ bool ModelLoader::LoadAnimations(const VulkanContext* context, const std::string
 
 // ---  Լ ---
 
-void ModelLoader::processNode(const VulkanContext* context, aiNode* node, const aiScene* scene, const std::string& filedir, std::vector<Mesh>& outMesh) {
+void ModelLoader::processNode(aiNode* node, const aiScene* scene, const std::string& filedir, std::vector<MeshImportData>& outMeshes) {
     // 1.  忡   ޽ óմϴ.
     for (unsigned int i = 0; i < node->mNumMeshes; i++) {
         aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
-        processMesh(context, mesh, scene, filedir, outMesh);
+        processMesh(mesh, scene, filedir, outMeshes);
     }
 
     // 2.    ڽ 忡    Լ ȣմϴ.
     for (unsigned int i = 0; i < node->mNumChildren; i++) {
-        processNode(context, node->mChildren[i], scene, filedir, outMesh);
+        processNode(node->mChildren[i], scene, filedir, outMeshes);
     }
 }
 
-void ModelLoader::processMesh(const VulkanContext* context, aiMesh* mesh, const aiScene* scene, const std::string& filedir, std::vector<Mesh>& outMeshes) {
-    std::vector<Vertex> vertices;
-    std::vector<uint32_t> indices;
+void ModelLoader::processMesh(aiMesh* mesh, const aiScene* scene, const std::string& filedir, std::vector<MeshImportData>& outMeshes) {
+    outMeshes.emplace_back();
+    MeshImportData& meshData = outMeshes.back();
+    std::vector<Vertex>& vertices = meshData.vertices;
+    std::vector<uint32_t>& indices = meshData.indices;
 
     // 1. (Vertex)  
     for (unsigned int i = 0; i < mesh->mNumVertices; i++) {
@@ -130,16 +158,10 @@ void ModelLoader::processMesh(const VulkanContext* context, aiMesh* mesh, const
     // 3.  ġ  
     extractBoneWeightForVertices(vertices, mesh, scene);
 
-    // 4.   ؽó  
-    std::shared_ptr<Texture> diffuseTex;
-    std::shared_ptr<Texture> specularTex;
-    std::shared_ptr<Texture> normalTex;
-    std::shared_ptr<Texture> ambientTex;
-    std::shared_ptr<Texture> emissiveTex;
-
+    // 4.  ؽó   (ڵ/ε ȣڰ )
     if (mesh->mMaterialIndex >= 0) {
         aiMaterial* material = scene->mMaterials[mesh->mMaterialIndex];
-        auto loadMaterialTexture = [&](aiTextureType type) -> std::shared_ptr<Texture> {
+        auto loadMaterialTexture = [&](aiTextureType type) -> std::string {
             if (material->GetTextureCount(type) > 0) {
                 aiString texturePathInModel;
                 material->GetTexture(type, 0, &texturePathInModel);
@@ -150,26 +172,20 @@ void ModelLoader::processMesh(const VulkanContext* context, aiMesh* mesh, const
                     textureFilename = textureFilename.substr(lastSeparator + 1);
                 }
 
-                std::string finalTexturePath = filedir + "/" + textureFilename;
-                return std::make_shared<Texture>(context, finalTexturePath.c_str());
+                return filedir + "/" + textureFilename;
             }
-            return nullptr;
+            return std::string();
             };
 
-        diffuseTex = loadMaterialTexture(aiTextureType_DIFFUSE);
-        specularTex = loadMaterialTexture(aiTextureType_SPECULAR);
-        normalTex = loadMaterialTexture(aiTextureType_NORMALS);
-        if (!normalTex) {
-            normalTex = loadMaterialTexture(aiTextureType_HEIGHT);
+        meshData.texturePaths[TEXTURE_SLOT_DIFFUSE] = loadMaterialTexture(aiTextureType_DIFFUSE);
+        meshData.texturePaths[TEXTURE_SLOT_SPECULAR] = loadMaterialTexture(aiTextureType_SPECULAR);
+        meshData.texturePaths[TEXTURE_SLOT_NORMAL] = loadMaterialTexture(aiTextureType_NORMALS);
+        if (meshData.texturePaths[TEXTURE_SLOT_NORMAL].empty()) {
+            meshData.texturePaths[TEXTURE_SLOT_NORMAL] = loadMaterialTexture(aiTextureType_HEIGHT);
         }
-        ambientTex = loadMaterialTexture(aiTextureType_AMBIENT);
-        emissiveTex = loadMaterialTexture(aiTextureType_EMISSIVE);
+        meshData.texturePaths[TEXTURE_SLOT_AMBIENT] = loadMaterialTexture(aiTextureType_AMBIENT);
+        meshData.texturePaths[TEXTURE_SLOT_EMISSIVE] = loadMaterialTexture(aiTextureType_EMISSIVE);
     }
-
-    outMeshes.emplace_back();
-    Mesh& newMeshRef = outMeshes.back();
-    newMeshRef.initialize(context, vertices, indices,
-        diffuseTex, specularTex, normalTex, ambientTex, emissiveTex);
 }
 
 void ModelLoader::setVertexBoneData(Vertex& vertex, int boneID, float weight) {
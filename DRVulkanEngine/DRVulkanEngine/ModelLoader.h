@@ -3,8 +3,11 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <array>
+#include <mutex>
 #include "Mesh.h"
 #include "Animation.h"
+#include "Texture.h"
 #include "Bone.h" // BoneInfo ü ⿡ ǵǾ ִٰ 
 
 //  
@@ -13,18 +16,51 @@ struct aiNode;
 struct aiScene;
 struct aiMesh;
 
+//  ؽó   (Mesh::initialize   )
+enum MaterialTextureSlot {
+    TEXTURE_SLOT_DIFFUSE = 0,
+    TEXTURE_SLOT_SPECULAR,
+    TEXTURE_SLOT_NORMAL,
+    TEXTURE_SLOT_AMBIENT,
+    TEXTURE_SLOT_EMISSIVE,
+    TEXTURE_SLOT_COUNT
+};
+
+// GPU ҽ  CPU ʿ ä ޽ 
+struct MeshImportData {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    std::array<std::string, TEXTURE_SLOT_COUNT> texturePaths; // ؽó   ڿ
+};
+
+// Ŀ 忡 Ʈ/ڵ   
+struct ModelImportData {
+    std::vector<MeshImportData> meshes;
+    std::vector<Animation> animations;
+    glm::mat4 globalInverseTransform = glm::mat4(1.0f);
+    std::map<std::string, ImageData> images;       // ؽó  -> ڵ ȼ
+    std::map<std::string, uint64_t> imageHashes;   // ؽó  ->   ؽ (TextureCache Ű)
+    std::map<std::string, std::shared_ptr<Texture>> cachedTextures; // ̹ ĳÿ ִ ؽó (ε   ʵ )
+};
+
 class ModelLoader {
 public:
     // 1. ̷ ޽ ͸  Ͽ εմϴ.
-    static bool LoadSkinnedModel(const VulkanContext* context, const std::string& filedir, const std::string& filename, std::vector<Mesh>& outMesh);
+    static bool LoadSkinnedModel(const VulkanContext* context, const std::string& filedir, const std::string& filename, std::vector<Mesh>& outMesh, glm::mat4& outGlobalInverseTransform);
 
     // 2. ִϸ̼ ͸  Ͽ εմϴ.
     static bool LoadAnimations(const VulkanContext* context, const std::string& filedir, const std::string& filename, std::vector<Animation>& outAnimations);
 
+    // 3. Vulkan ȣ  ޽ Ϳ ؽó θ մϴ. (Ŀ 忡 ȣ )
+    static bool ImportSkinnedModel(const std::string& filedir, const std::string& filename, ModelImportData& outData);
+
+    // boneInfoMap_  static ¸ ϹǷ Ʈ  ؽ ȭմϴ.
+    static std::mutex importMutex_;
+
 private:
     //   Լ static 
-    static void processNode(const VulkanContext* context, aiNode* node, const aiScene* scene, const std::string& filedir, std::vector<Mesh>& outMesh);
-    static void processMesh(const VulkanContext* context, aiMesh* mesh, const aiScene* scene, const std::string& filedir, std::vector<Mesh>& outMeshes);
+    static void processNode(aiNode* node, const aiScene* scene, const std::string& filedir, std::vector<MeshImportData>& outMeshes);
+    static void processMesh(aiMesh* mesh, const aiScene* scene, const std::string& filedir, std::vector<MeshImportData>& outMeshes);
     static void setVertexBoneData(Vertex& vertex, int boneID, float weight);
     static void extractBoneWeightForVertices(std::vector<Vertex>& vertices, aiMesh* mesh, const aiScene* scene);
     static void processAnimations(const aiScene* scene, std::vector<Animation>& outAnimations);
@@ -32,6 +68,4 @@ private:
     //  static   Լ ȣ  ͸ ϴ ٸ  մϴ.
     static std::map<std::string, BoneInfo> boneInfoMap_;
     static int boneCounter_;
-public:
-	static glm::mat4 globalInverseTransform_;
 };
\ No newline at end of file
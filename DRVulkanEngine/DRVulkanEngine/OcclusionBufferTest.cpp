@@ -0,0 +1,121 @@
+#include "Benchmarks.h"
+#include "Camera.h"
+#include "MaskedOcclusionBuffer.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <cmath>
+
+namespace
+{
+    // 64x32 픽셀 = 8x8 타일
+    constexpr uint32_t BUFFER_WIDTH = 64;
+    constexpr uint32_t BUFFER_HEIGHT = 32;
+    constexpr float OCCLUDER_DISTANCE = 10.0f;
+    constexpr float DEPTH_TOLERANCE = 1e-4f;
+
+    int failures = 0;
+
+    void check(bool condition, const char* name)
+    {
+        std::cout << (condition ? "  PASS  " : "  FAIL  ") << name << std::endl;
+        if (!condition) {
+            failures++;
+        }
+    }
+
+    // 원점에서 -z를 보는 카메라 (90도, 종횡비 2 -> 거리 10에서 화면은 x +-20, y +-10)
+    glm::mat4 makeViewProj()
+    {
+        glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        glm::mat4 proj = glm::perspective(glm::radians(90.0f), 2.0f, 0.1f, 100.0f);
+        return proj * view;
+    }
+
+    // z 평면 위의 사각형 (삼각형 2개)
+    void renderQuad(MaskedOcclusionBuffer& buffer, float minX, float minY, float maxX, float maxY, float z, const glm::mat4& viewProj)
+    {
+        const float positions[] = {
+            minX, minY, z,
+            maxX, minY, z,
+            maxX, maxY, z,
+            minX, maxY, z,
+        };
+        const uint32_t indices[] = { 0, 1, 2, 0, 2, 3 };
+        buffer.renderOccluder(positions, sizeof(float) * 3, 4, indices, 6, viewProj);
+    }
+
+    bool allTilesCommittedAt(const MaskedOcclusionBuffer& buffer, float depth)
+    {
+        const uint32_t tilesX = buffer.getWidth() / MaskedOcclusionBuffer::TILE_WIDTH;
+        for (uint32_t tileY = 0; tileY < buffer.getTileRows(); ++tileY) {
+            for (uint32_t tileX = 0; tileX < tilesX; ++tileX) {
+                if (std::abs(buffer.getTileDepth(tileX, tileY) - depth) > DEPTH_TOLERANCE) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // 1, 2, 4: 화면 전체를 덮는 사각형 하나를 가리개로 그린 뒤 박스 위치별 결과
+    void testFullScreenOccluder()
+    {
+        const glm::mat4 viewProj = makeViewProj();
+        MaskedOcclusionBuffer buffer;
+        buffer.initialize(BUFFER_WIDTH, BUFFER_HEIGHT);
+        renderQuad(buffer, -40.0f, -40.0f, 40.0f, 40.0f, -OCCLUDER_DISTANCE, viewProj);
+
+        glm::vec4 clip = viewProj * glm::vec4(0.0f, 0.0f, -OCCLUDER_DISTANCE, 1.0f);
+        check(allTilesCommittedAt(buffer, clip.z / clip.w), "full-screen quad commits its depth to every tile");
+
+        check(!buffer.testAABB(glm::vec3(-1.0f, -1.0f, -21.0f), glm::vec3(1.0f, 1.0f, -20.0f), viewProj),
+            "box behind the quad is occluded");
+        check(buffer.testAABB(glm::vec3(-1.0f, -1.0f, -6.0f), glm::vec3(1.0f, 1.0f, -5.0f), viewProj),
+            "box in front of the quad is visible");
+        // 카메라 뒤까지 걸친 박스는 투영할 수 없으니 가리개가 있어도 보이는 것으로 둡니다.
+        check(buffer.testAABB(glm::vec3(-1.0f, -1.0f, -30.0f), glm::vec3(1.0f, 1.0f, 1.0f), viewProj),
+            "box straddling the near plane is visible");
+        check(!buffer.testAABB(glm::vec3(100.0f, -1.0f, -6.0f), glm::vec3(101.0f, 1.0f, -5.0f), viewProj),
+            "box outside the screen is rejected");
+    }
+
+    // 3: 타일의 왼쪽 절반만 덮는 가리개는 몇 번을 그려도 타일 깊이를 확정하지 않습니다.
+    void testPartialCoverage()
+    {
+        // 단위 행렬: 위치가 곧 NDC (w = 1)
+        const glm::mat4 identity(1.0f);
+        MaskedOcclusionBuffer buffer;
+        buffer.initialize(BUFFER_WIDTH, BUFFER_HEIGHT);
+
+        // 픽셀 x [0, 4) = 첫 번째 타일 열의 왼쪽 절반, 모든 행
+        const float halfTileNdc = 2.0f * (MaskedOcclusionBuffer::TILE_WIDTH / 2) / BUFFER_WIDTH;
+        renderQuad(buffer, -1.0f, -1.0f, -1.0f + halfTileNdc, 1.0f, 0.5f, identity);
+        renderQuad(buffer, -1.0f, -1.0f, -1.0f + halfTileNdc, 1.0f, 0.5f, identity);
+
+        bool committed = false;
+        for (uint32_t tileY = 0; tileY < buffer.getTileRows(); ++tileY) {
+            committed |= buffer.getTileDepth(0, tileY) < 1.0f;
+        }
+        check(!committed, "partial-coverage tile never commits");
+        check(buffer.testAABB(glm::vec3(-1.0f, -0.5f, 0.8f), glm::vec3(-1.0f + halfTileNdc * 0.5f, 0.5f, 0.9f), identity),
+            "box behind a partial-coverage tile stays visible");
+
+        // 나머지 절반을 채우면 두 조각 중 먼 깊이로 확정됩니다.
+        renderQuad(buffer, -1.0f + halfTileNdc, -1.0f, -1.0f + halfTileNdc * 2.0f, 1.0f, 0.6f, identity);
+        check(std::abs(buffer.getTileDepth(0, 0) - 0.6f) < DEPTH_TOLERANCE, "completing the tile commits the farther depth");
+        check(!buffer.testAABB(glm::vec3(-1.0f, -0.5f, 0.8f), glm::vec3(-1.0f + halfTileNdc * 0.5f, 0.5f, 0.9f), identity),
+            "box behind the completed tile is occluded");
+    }
+}
+
+int RunOcclusionBufferTest()
+{
+    std::cout << "Masked occlusion buffer test (" << BUFFER_WIDTH << "x" << BUFFER_HEIGHT << ")" << std::endl;
+
+    testFullScreenOccluder();
+    testPartialCoverage();
+
+    std::cout << (failures == 0 ? "all passed" : "FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,223 @@
+#include "ParallelCommandRecorder.h"
+#include "VulkanContext.h"
+#include <algorithm>
+#include <stdexcept>
+
+ParallelCommandRecorder::~ParallelCommandRecorder()
+{
+    cleanup();
+}
+
+void ParallelCommandRecorder::initialize(const VulkanContext* context, uint32_t framesInFlight, uint32_t workerCount)
+{
+    context_ = context;
+
+    if (workerCount == 0) {
+        uint32_t hardwareThreads = std::thread::hardware_concurrency();
+        workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+    workerCount_ = workerCount;
+
+    QueueFamilyIndices queueFamilyIndices = context_->findQueueFamilies(context_->getPhysicalDevice());
+
+    pools_.resize(framesInFlight);
+    for (std::vector<ThreadPool>& framePools : pools_) {
+        framePools.resize(workerCount_);
+        for (ThreadPool& pool : framePools) {
+            // 버퍼별 리셋 대신 풀 전체를 리셋하므로 RESET_COMMAND_BUFFER 플래그가 필요 없습니다.
+            VkCommandPoolCreateInfo poolInfo{};
+            poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+            poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+            poolInfo.queueFamilyIndex = queueFamilyIndices.graphicsFamily.value();
+
+            if (vkCreateCommandPool(context_->getDevice(), &poolInfo, nullptr, &pool.commandPool) != VK_SUCCESS) {
+                throw std::runtime_error("failed to create worker command pool!");
+            }
+        }
+    }
+
+    recordedBuffers_.resize(workerCount_);
+    workerErrors_.resize(workerCount_);
+    workerStats_.resize(workerCount_);
+
+    stopRequested_ = false;
+    for (uint32_t i = 0; i < workerCount_; ++i) {
+        workers_.emplace_back(&ParallelCommandRecorder::workerLoop, this, i);
+    }
+}
+
+void ParallelCommandRecorder::cleanup()
+{
+    if (!workers_.empty()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopRequested_ = true;
+        }
+        jobCondition_.notify_all();
+        for (std::thread& worker : workers_) {
+            if (worker.joinable()) {
+                worker.join();
+            }
+        }
+        workers_.clear();
+    }
+
+    if (context_) {
+        // 풀을 지우면 거기서 할당한 커맨드 버퍼도 함께 해제됩니다.
+        for (std::vector<ThreadPool>& framePools : pools_) {
+            for (ThreadPool& pool : framePools) {
+                if (pool.commandPool != VK_NULL_HANDLE) {
+                    vkDestroyCommandPool(context_->getDevice(), pool.commandPool, nullptr);
+                }
+            }
+        }
+    }
+    pools_.clear();
+}
+
+void ParallelCommandRecorder::beginFrame(uint32_t frameIndex)
+{
+    frameIndex_ = frameIndex;
+    for (ThreadPool& pool : pools_[frameIndex_]) {
+        vkResetCommandPool(context_->getDevice(), pool.commandPool, 0);
+        pool.usedCount = 0;
+    }
+    std::fill(workerStats_.begin(), workerStats_.end(), CommandEncoder::Stats{});
+}
+
+CommandEncoder::Stats ParallelCommandRecorder::getFrameStats() const
+{
+    CommandEncoder::Stats total;
+    for (const CommandEncoder::Stats& stats : workerStats_) {
+        total += stats;
+    }
+    return total;
+}
+
+VkCommandBuffer ParallelCommandRecorder::acquireCommandBuffer(ThreadPool& pool)
+{
+    // 한 프레임에 여러 패스를 기록하므로 모자랄 때만 새로 할당하고 다음 프레임부터 재사용합니다.
+    if (pool.usedCount == pool.commandBuffers.size()) {
+        VkCommandBufferAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.commandPool = pool.commandPool;
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+        allocInfo.commandBufferCount = 1;
+
+        VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+        if (vkAllocateCommandBuffers(context_->getDevice(), &allocInfo, &commandBuffer) != VK_SUCCESS) {
+            throw std::runtime_error("failed to allocate secondary command buffer!");
+        }
+        pool.commandBuffers.push_back(commandBuffer);
+    }
+    return pool.commandBuffers[pool.usedCount++];
+}
+
+void ParallelCommandRecorder::recordAndExecute(VkCommandBuffer primaryCommandBuffer,
+    const VkCommandBufferInheritanceRenderingInfo& renderingInfo,
+    uint32_t itemCount, const RecordFunc& recordFunc)
+{
+    if (itemCount == 0) {
+        return;
+    }
+
+    uint32_t activeWorkers = std::clamp((itemCount + MIN_ITEMS_PER_WORKER - 1) / MIN_ITEMS_PER_WORKER, 1u, workerCount_);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        renderingInfo_ = &renderingInfo;
+        recordFunc_ = &recordFunc;
+        itemCount_ = itemCount;
+        activeWorkers_ = activeWorkers;
+        std::fill(recordedBuffers_.begin(), recordedBuffers_.end(), VK_NULL_HANDLE);
+        std::fill(workerErrors_.begin(), workerErrors_.end(), nullptr);
+        pendingWorkers_ = workerCount_;
+        jobId_++;
+    }
+    jobCondition_.notify_all();
+
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        doneCondition_.wait(lock, [this] { return pendingWorkers_ == 0; });
+    }
+
+    for (const std::exception_ptr& error : workerErrors_) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    // 워커 순서대로 실행하므로 드로우 순서는 단일 스레드로 기록했을 때와 같습니다.
+    std::vector<VkCommandBuffer> secondaryBuffers;
+    secondaryBuffers.reserve(activeWorkers);
+    for (VkCommandBuffer commandBuffer : recordedBuffers_) {
+        if (commandBuffer != VK_NULL_HANDLE) {
+            secondaryBuffers.push_back(commandBuffer);
+        }
+    }
+    vkCmdExecuteCommands(primaryCommandBuffer, static_cast<uint32_t>(secondaryBuffers.size()), secondaryBuffers.data());
+}
+
+void ParallelCommandRecorder::recordRange(uint32_t workerIndex)
+{
+    uint32_t begin = itemCount_ * workerIndex / activeWorkers_;
+    uint32_t end = itemCount_ * (workerIndex + 1) / activeWorkers_;
+    if (begin == end) {
+        return;
+    }
+
+    VkCommandBuffer commandBuffer = acquireCommandBuffer(pools_[frameIndex_][workerIndex]);
+
+    VkCommandBufferInheritanceInfo inheritanceInfo{};
+    inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    inheritanceInfo.pNext = renderingInfo_;
+
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT | VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    beginInfo.pInheritanceInfo = &inheritanceInfo;
+
+    if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS) {
+        throw std::runtime_error("failed to begin recording secondary command buffer!");
+    }
+
+    CommandEncoder encoder(commandBuffer);
+    (*recordFunc_)(encoder, begin, end);
+    workerStats_[workerIndex] += encoder.getStats();
+
+    if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
+        throw std::runtime_error("failed to record secondary command buffer!");
+    }
+    recordedBuffers_[workerIndex] = commandBuffer;
+}
+
+void ParallelCommandRecorder::workerLoop(uint32_t workerIndex)
+{
+    uint64_t lastJobId = 0;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            jobCondition_.wait(lock, [this, lastJobId] { return stopRequested_ || jobId_ != lastJobId; });
+            if (stopRequested_) {
+                return;
+            }
+            lastJobId = jobId_;
+        }
+
+        if (workerIndex < activeWorkers_) {
+            try {
+                recordRange(workerIndex);
+            }
+            catch (...) {
+                workerErrors_[workerIndex] = std::current_exception();
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--pendingWorkers_ == 0) {
+                doneCondition_.notify_all();
+            }
+        }
+    }
+}
@@ -0,0 +1,84 @@
+#pragma once
+#include <vulkan/vulkan.h>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include "CommandEncoder.h"
+
+class VulkanContext;
+
+// 드로우 목록을 워커 스레드에 나눠 secondary 커맨드 버퍼에 기록하고 primary에서 실행합니다.
+//  - 커맨드 풀은 (프레임 인 플라이트 x 워커)마다 하나씩 두어 스레드 간 동기화 없이 기록하고
+//  - beginFrame()이 그 프레임의 풀을 통째로 리셋합니다. (펜스 대기 뒤에 호출해야 함)
+//  - primary는 VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT로 vkCmdBeginRendering한 상태여야 합니다.
+// secondary는 상태를 물려받지 않으므로 기록 함수가 파이프라인/디스크립터/푸시 상수를 직접 바인딩합니다.
+// 기록은 secondary마다 새 CommandEncoder를 거치므로 같은 secondary 안의 중복 바인딩은 생략됩니다.
+class ParallelCommandRecorder
+{
+public:
+    // [begin, end) 구간의 드로우를 encoder에 기록합니다. (여러 워커에서 동시에 호출됨)
+    using RecordFunc = std::function<void(CommandEncoder& encoder, uint32_t begin, uint32_t end)>;
+
+    // 워커 하나가 맡는 최소 항목 수, 이보다 적으면 스레드를 깨우는 비용이 더 큽니다.
+    static constexpr uint32_t MIN_ITEMS_PER_WORKER = 32;
+
+    ParallelCommandRecorder() = default;
+    ~ParallelCommandRecorder();
+
+    ParallelCommandRecorder(const ParallelCommandRecorder&) = delete;
+    ParallelCommandRecorder& operator=(const ParallelCommandRecorder&) = delete;
+
+    // workerCount가 0이면 하드웨어 스레드 수에서 메인 스레드를 뺀 만큼 씁니다.
+    void initialize(const VulkanContext* context, uint32_t framesInFlight, uint32_t workerCount = 0);
+    void cleanup();
+
+    void beginFrame(uint32_t frameIndex);
+
+    // itemCount를 워커에 나눠 기록한 뒤 primary에 vkCmdExecuteCommands로 넣습니다. 모든 워커가 끝나야 반환합니다.
+    void recordAndExecute(VkCommandBuffer primaryCommandBuffer,
+        const VkCommandBufferInheritanceRenderingInfo& renderingInfo,
+        uint32_t itemCount, const RecordFunc& recordFunc);
+
+    uint32_t getWorkerCount() const { return workerCount_; }
+    // 마지막 beginFrame() 이후 모든 워커가 기록/생략한 호출 수 (기록 중에는 부르지 않습니다)
+    CommandEncoder::Stats getFrameStats() const;
+
+private:
+    // 한 (프레임, 워커)의 풀과 이번 프레임에 쓴 secondary 개수
+    struct ThreadPool {
+        VkCommandPool commandPool = VK_NULL_HANDLE;
+        std::vector<VkCommandBuffer> commandBuffers;
+        uint32_t usedCount = 0;
+    };
+
+    VkCommandBuffer acquireCommandBuffer(ThreadPool& pool);
+    void recordRange(uint32_t workerIndex);
+    void workerLoop(uint32_t workerIndex);
+
+    const VulkanContext* context_ = nullptr;
+    uint32_t workerCount_ = 0;
+    uint32_t frameIndex_ = 0;
+
+    // [frame][worker]
+    std::vector<std::vector<ThreadPool>> pools_;
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable jobCondition_;
+    std::condition_variable doneCondition_;
+    uint64_t jobId_ = 0;
+    uint32_t pendingWorkers_ = 0;
+    bool stopRequested_ = false;
+
+    // 작업 중에는 워커만 읽고, 결과는 워커별 칸에만 씁니다.
+    const VkCommandBufferInheritanceRenderingInfo* renderingInfo_ = nullptr;
+    const RecordFunc* recordFunc_ = nullptr;
+    uint32_t itemCount_ = 0;
+    uint32_t activeWorkers_ = 0;
+    std::vector<VkCommandBuffer> recordedBuffers_;
+    std::vector<std::exception_ptr> workerErrors_;
+    std::vector<CommandEncoder::Stats> workerStats_;
+};
@@ -1,6 +1,7 @@
 #pragma once
 #include <vulkan/vulkan.h>
 #include <string>
+#include <vector>
 struct PipelineConfig {
     std::string pipelineName;
     std::string vertexShaderPath;
@@ -21,6 +22,13 @@ struct PipelineConfig {
 
     bool useVertexInput = true;
 
+    // 깊이 프리패스용 변형: 버텍스 스테이지만 쓰고 컬러 어태치먼트가 없습니다.
+    bool depthOnly = false;
+    // 깊이 전용 변형이 쓸 버텍스 셰이더 (비어 있으면 vertexShaderPath를 그대로 씁니다)
+    std::string depthOnlyVertexShaderPath;
+    // 버텍스 셰이더 특수화 상수 (i번째 값이 constant_id = i, 32비트)
+    std::vector<uint32_t> vertexSpecializationConstants;
+
     VkFormat colorAttachmentFormat;
     VkFormat depthAttachmentFormat;
 };
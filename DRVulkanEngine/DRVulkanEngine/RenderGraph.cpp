@@ -0,0 +1,821 @@
+#include "RenderGraph.h"
+#include "JsonValue.h"
+#include <stdexcept>
+#include <array>
+#include <algorithm>
+
+namespace
+{
+    constexpr VkAccessFlags2 WRITE_ACCESS_MASK =
+        VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT |
+        VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
+        VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT |
+        VK_ACCESS_2_SHADER_WRITE_BIT |
+        VK_ACCESS_2_TRANSFER_WRITE_BIT |
+        VK_ACCESS_2_MEMORY_WRITE_BIT;
+
+    struct AccessName {
+        const char* name;
+        RenderGraphAccess access;
+    };
+
+    constexpr AccessName ACCESS_NAMES[] = {
+        { "colorAttachment", RenderGraphAccess::ColorAttachment },
+        { "depthAttachment", RenderGraphAccess::DepthAttachment },
+        { "depthAttachmentRead", RenderGraphAccess::DepthAttachmentRead },
+        { "fragmentSampled", RenderGraphAccess::FragmentSampled },
+        { "computeSampled", RenderGraphAccess::ComputeSampled },
+        { "computeStorageRead", RenderGraphAccess::ComputeStorageRead },
+        { "computeStorageWrite", RenderGraphAccess::ComputeStorageWrite },
+        { "indirectRead", RenderGraphAccess::IndirectRead },
+        { "present", RenderGraphAccess::Present },
+    };
+
+    // 컴퓨트 전용 큐에서 쓸 수 있는 접근 (그래픽스 단계가 없는 것)
+    bool IsComputeAccess(RenderGraphAccess access)
+    {
+        return access == RenderGraphAccess::ComputeSampled ||
+            access == RenderGraphAccess::ComputeStorageRead ||
+            access == RenderGraphAccess::ComputeStorageWrite;
+    }
+}
+
+const RenderGraph::AccessInfo& RenderGraph::GetAccessInfo(RenderGraphAccess access)
+{
+    static const std::array<AccessInfo, static_cast<size_t>(RenderGraphAccess::Count)> infos = { {
+        // ColorAttachment
+        { VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+          VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT,
+          VK_IMAGE_LAYOUT_ATTACHMENT_OPTIMAL, true },
+        // DepthAttachment
+        { VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT,
+          VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+          VK_IMAGE_LAYOUT_ATTACHMENT_OPTIMAL, true },
+        // DepthAttachmentRead
+        { VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT,
+          VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT,
+          VK_IMAGE_LAYOUT_ATTACHMENT_OPTIMAL, false },
+        // FragmentSampled
+        { VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+          VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+          VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL, false },
+        // ComputeSampled
+        { VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+          VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+          VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL, false },
+        // ComputeStorageRead
+        { VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+          VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_SAMPLED_READ_BIT,
+          VK_IMAGE_LAYOUT_GENERAL, false },
+        // ComputeStorageWrite
+        { VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+          VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT,
+          VK_IMAGE_LAYOUT_GENERAL, true },
+        // IndirectRead
+        { VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT,
+          VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_READ_BIT,
+          VK_IMAGE_LAYOUT_UNDEFINED, false },
+        // Present (프레젠트 엔진과의 동기화는 세마포어가 맡습니다)
+        { VK_PIPELINE_STAGE_2_NONE,
+          VK_ACCESS_2_NONE,
+          VK_IMAGE_LAYOUT_PRESENT_SRC_KHR, false },
+    } };
+    return infos[static_cast<size_t>(access)];
+}
+
+RenderGraphAccess RenderGraph::ParseAccess(const std::string& name)
+{
+    for (const AccessName& entry : ACCESS_NAMES) {
+        if (name == entry.name) {
+            return entry.access;
+        }
+    }
+    throw std::runtime_error("unknown render graph access: " + name);
+}
+
+void RenderGraph::clear()
+{
+    resources_.clear();
+    passes_.clear();
+    resourceNames_.clear();
+    executionOrder_.clear();
+    barrierBatches_.clear();
+    segments_.clear();
+    passSegments_.clear();
+    culledPassCount_ = 0;
+    barrierCount_ = 0;
+    barrierBatchCount_ = 0;
+    queueTransferCount_ = 0;
+    compiled_ = false;
+}
+
+RenderGraph::ResourceId RenderGraph::addResource(const ResourceDesc& desc)
+{
+    if (resourceNames_.contains(desc.name)) {
+        throw std::runtime_error("render graph resource already exists: " + desc.name);
+    }
+    ResourceId id = static_cast<ResourceId>(resources_.size());
+    Resource resource{};
+    resource.desc = desc;
+    resources_.push_back(resource);
+    resourceNames_[desc.name] = id;
+    compiled_ = false;
+    return id;
+}
+
+RenderGraph::ResourceId RenderGraph::findResource(const std::string& name) const
+{
+    auto it = resourceNames_.find(name);
+    return it != resourceNames_.end() ? it->second : INVALID_RESOURCE;
+}
+
+RenderGraph::PassId RenderGraph::addPass(const std::string& name, ExecuteFunc execute, RenderGraphQueue queue)
+{
+    PassId id = static_cast<PassId>(passes_.size());
+    Pass pass{};
+    pass.name = name;
+    pass.execute = std::move(execute);
+    pass.queue = queue;
+    passes_.push_back(std::move(pass));
+    compiled_ = false;
+    return id;
+}
+
+void RenderGraph::read(PassId pass, ResourceId resource, RenderGraphAccess access)
+{
+    addUsage(pass, resource, access, false);
+}
+
+void RenderGraph::write(PassId pass, ResourceId resource, RenderGraphAccess access)
+{
+    addUsage(pass, resource, access, true);
+}
+
+void RenderGraph::addUsage(PassId pass, ResourceId resource, RenderGraphAccess access, bool write)
+{
+    if (pass >= passes_.size() || resource >= resources_.size()) {
+        throw std::runtime_error("invalid render graph pass or resource!");
+    }
+    if (passes_[pass].queue == RenderGraphQueue::Compute && !IsComputeAccess(access)) {
+        throw std::runtime_error("render graph compute pass uses a graphics access: " + passes_[pass].name);
+    }
+    // 한 패스가 같은 리소스를 두 번 선언하면 레이아웃이 같아야 하며 하나로 합칩니다.
+    for (ResourceUsage& usage : passes_[pass].usages) {
+        if (usage.resource != resource) {
+            continue;
+        }
+        if (GetAccessInfo(usage.access).layout != GetAccessInfo(access).layout) {
+            throw std::runtime_error("render graph pass uses a resource with two layouts: " + passes_[pass].name);
+        }
+        if (write) {
+            usage.access = access;
+        }
+        usage.write = usage.write || write;
+        return;
+    }
+    passes_[pass].usages.push_back({ resource, access, write });
+    compiled_ = false;
+}
+
+void RenderGraph::loadFromJson(const std::string& path, const std::unordered_map<std::string, ExecuteFunc>& executors)
+{
+    JsonValue root = JsonValue::ParseFile(path);
+    clear();
+
+    for (const JsonValue& resourceJson : root["resources"].asArray()) {
+        ResourceDesc desc{};
+        desc.name = resourceJson["name"].asString();
+        std::string type = resourceJson.getString("type", "image");
+        if (type == "buffer") {
+            desc.type = ResourceType::Buffer;
+        }
+        else if (type != "image") {
+            throw std::runtime_error("unknown render graph resource type: " + type);
+        }
+        desc.preserveContents = resourceJson.getBool("preserve", false);
+        desc.perFrame = resourceJson.getBool("perFrame", false);
+        desc.output = resourceJson.getBool("output", false);
+        if (resourceJson.contains("final")) {
+            desc.hasFinalAccess = true;
+            desc.finalAccess = ParseAccess(resourceJson["final"].asString());
+        }
+        addResource(desc);
+    }
+
+    auto resolve = [this, &path](const JsonValue& usageJson) {
+        const std::string& name = usageJson["resource"].asString();
+        ResourceId resource = findResource(name);
+        if (resource == INVALID_RESOURCE) {
+            throw std::runtime_error("render graph resource is not declared: " + name + " (" + path + ")");
+        }
+        return resource;
+    };
+
+    for (const JsonValue& passJson : root["passes"].asArray()) {
+        const std::string& name = passJson["name"].asString();
+        auto executor = executors.find(name);
+        if (executor == executors.end()) {
+            throw std::runtime_error("render graph pass has no executor: " + name + " (" + path + ")");
+        }
+
+        RenderGraphQueue queue = RenderGraphQueue::Graphics;
+        std::string queueName = passJson.getString("queue", "graphics");
+        if (queueName == "compute") {
+            queue = RenderGraphQueue::Compute;
+        }
+        else if (queueName != "graphics") {
+            throw std::runtime_error("unknown render graph queue: " + queueName + " (" + path + ")");
+        }
+
+        PassId pass = addPass(name, executor->second, queue);
+        if (passJson.contains("reads")) {
+            for (const JsonValue& usageJson : passJson["reads"].asArray()) {
+                read(pass, resolve(usageJson), ParseAccess(usageJson["access"].asString()));
+            }
+        }
+        if (passJson.contains("writes")) {
+            for (const JsonValue& usageJson : passJson["writes"].asArray()) {
+                write(pass, resolve(usageJson), ParseAccess(usageJson["access"].asString()));
+            }
+        }
+    }
+
+    compile();
+}
+
+void RenderGraph::setQueueFamilies(uint32_t graphicsFamily, uint32_t computeFamily)
+{
+    queueFamilies_[static_cast<size_t>(RenderGraphQueue::Graphics)] = graphicsFamily;
+    queueFamilies_[static_cast<size_t>(RenderGraphQueue::Compute)] = computeFamily;
+    compiled_ = false;
+}
+
+RenderGraphQueue RenderGraph::getPassQueue(PassId pass) const
+{
+    const bool asyncCompute = queueFamilies_[static_cast<size_t>(RenderGraphQueue::Compute)] !=
+        queueFamilies_[static_cast<size_t>(RenderGraphQueue::Graphics)];
+    return asyncCompute ? passes_[pass].queue : RenderGraphQueue::Graphics;
+}
+
+void RenderGraph::compile()
+{
+    cullPasses();
+    schedulePasses();
+    buildSegments();
+
+    // 1) 빈 상태에서 한 프레임을 흉내 내 프레임이 끝날 때의 상태를 구합니다.
+    std::vector<ResourceState> states(resources_.size());
+    simulate(states, nullptr);
+
+    // 2) 다음 프레임은 그 상태에서 시작합니다. 내용을 유지하지 않는 리소스는 UNDEFINED로 버립니다.
+    for (size_t i = 0; i < resources_.size(); ++i) {
+        const ResourceDesc& desc = resources_[i].desc;
+        ResourceState& state = states[i];
+        if (desc.perFrame) {
+            state = ResourceState{};
+        }
+        else if (desc.hasFinalAccess && desc.finalAccess == RenderGraphAccess::Present) {
+            // 스왑체인 이미지는 acquire 세마포어가 COLOR_ATTACHMENT_OUTPUT 단계에서 기다리므로 그 단계에서 시작합니다.
+            // (세마포어는 이 이미지를 처음 쓰는 세그먼트가 기다립니다)
+            state = ResourceState{};
+            state.writeStages = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+        }
+        else if (!desc.preserveContents) {
+            state.layout = VK_IMAGE_LAYOUT_UNDEFINED;
+        }
+    }
+
+    barrierBatches_.clear();
+    for (Segment& segment : segments_) {
+        segment.waits.clear();
+        segment.releaseBatch = BarrierBatch{};
+    }
+    queueTransferCount_ = 0;
+    simulate(states, &barrierBatches_);
+
+    // 프레임 펜스는 마지막 세그먼트의 제출에 걸리므로, 그 세그먼트가 다른 큐의 이번 프레임 작업을 모두 기다려야
+    // 펜스 대기 뒤에 프레임 인 플라이트 슬롯의 버퍼를 안전하게 다시 쓸 수 있습니다.
+    const uint32_t lastSegment = static_cast<uint32_t>(segments_.size() - 1);
+    for (uint32_t s = lastSegment; s-- > 0;) {
+        if (segments_[s].queue == segments_[lastSegment].queue) {
+            continue;
+        }
+        bool covered = false;
+        for (const SegmentWait& wait : segments_[lastSegment].waits) {
+            covered = covered || (wait.queue == segments_[s].queue && wait.segment != PREVIOUS_FRAME && wait.segment >= s);
+        }
+        if (!covered) {
+            addWait(lastSegment, segments_[s].queue, s, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT);
+        }
+        break;
+    }
+
+    barrierCount_ = 0;
+    barrierBatchCount_ = 0;
+    auto countBatch = [this](const BarrierBatch& batch) {
+        uint32_t count = static_cast<uint32_t>(batch.imageBarriers.size()) + (batch.hasMemoryBarrier ? 1u : 0u);
+        barrierCount_ += count;
+        barrierBatchCount_ += (count > 0) ? 1u : 0u;
+    };
+    for (const BarrierBatch& batch : barrierBatches_) {
+        countBatch(batch);
+    }
+    for (const Segment& segment : segments_) {
+        countBatch(segment.releaseBatch);
+    }
+    compiled_ = true;
+}
+
+void RenderGraph::buildSegments()
+{
+    segments_.clear();
+    passSegments_.clear();
+    for (uint32_t i = 0; i < executionOrder_.size(); ++i) {
+        const RenderGraphQueue queue = getPassQueue(executionOrder_[i]);
+        if (segments_.empty() || segments_.back().queue != queue) {
+            Segment segment{};
+            segment.queue = queue;
+            segment.firstPass = i;
+            segments_.push_back(std::move(segment));
+        }
+        segments_.back().passCount++;
+        passSegments_.push_back(static_cast<uint32_t>(segments_.size() - 1));
+    }
+
+    // 최종 전환(Present)과 프레임 펜스는 그래픽스 큐에서 처리합니다.
+    if (segments_.empty()) {
+        segments_.push_back(Segment{});
+    }
+    if (segments_.back().queue != RenderGraphQueue::Graphics) {
+        throw std::runtime_error("render graph must end on the graphics queue!");
+    }
+}
+
+void RenderGraph::cullPasses()
+{
+    // 읽는 쪽이 없는 리소스부터 거꾸로 따라가며, 쓴 결과를 아무도 읽지 않는 패스를 제거합니다.
+    std::vector<uint32_t> passRefs(passes_.size(), 0);
+    std::vector<uint32_t> resourceRefs(resources_.size(), 0);
+    std::vector<std::vector<PassId>> writers(resources_.size());
+
+    for (PassId p = 0; p < passes_.size(); ++p) {
+        passes_[p].culled = false;
+        for (const ResourceUsage& usage : passes_[p].usages) {
+            if (usage.write) {
+                passRefs[p]++;
+                writers[usage.resource].push_back(p);
+            }
+            else {
+                resourceRefs[usage.resource]++;
+            }
+        }
+    }
+    for (ResourceId r = 0; r < resources_.size(); ++r) {
+        if (resources_[r].desc.output) {
+            resourceRefs[r]++;
+        }
+    }
+
+    std::vector<ResourceId> unreferenced;
+    for (ResourceId r = 0; r < resources_.size(); ++r) {
+        if (resourceRefs[r] == 0) {
+            unreferenced.push_back(r);
+        }
+    }
+    while (!unreferenced.empty()) {
+        ResourceId r = unreferenced.back();
+        unreferenced.pop_back();
+        for (PassId p : writers[r]) {
+            if (passes_[p].culled || passRefs[p] == 0 || --passRefs[p] > 0) {
+                continue;
+            }
+            passes_[p].culled = true;
+            for (const ResourceUsage& usage : passes_[p].usages) {
+                if (!usage.write && --resourceRefs[usage.resource] == 0) {
+                    unreferenced.push_back(usage.resource);
+                }
+            }
+        }
+    }
+
+    culledPassCount_ = 0;
+    for (const Pass& pass : passes_) {
+        culledPassCount_ += pass.culled ? 1u : 0u;
+    }
+}
+
+void RenderGraph::schedulePasses()
+{
+    // 선언 순서대로 리소스 버전을 따라가며 의존성을 만듭니다.
+    std::vector<std::vector<PassId>> dependencies(passes_.size());
+    std::vector<PassId> lastWriter(resources_.size(), ~0u);
+    std::vector<std::vector<PassId>> readersSinceWrite(resources_.size());
+
+    auto addDependency = [&dependencies](PassId pass, PassId dependency) {
+        if (dependency != ~0u && dependency != pass &&
+            std::find(dependencies[pass].begin(), dependencies[pass].end(), dependency) == dependencies[pass].end()) {
+            dependencies[pass].push_back(dependency);
+        }
+    };
+
+    for (PassId p = 0; p < passes_.size(); ++p) {
+        if (passes_[p].culled) {
+            continue;
+        }
+        for (const ResourceUsage& usage : passes_[p].usages) {
+            addDependency(p, lastWriter[usage.resource]);
+            if (usage.write) {
+                for (PassId reader : readersSinceWrite[usage.resource]) {
+                    addDependency(p, reader);
+                }
+            }
+        }
+        for (const ResourceUsage& usage : passes_[p].usages) {
+            if (usage.write) {
+                lastWriter[usage.resource] = p;
+                readersSinceWrite[usage.resource].clear();
+            }
+            else {
+                readersSinceWrite[usage.resource].push_back(p);
+            }
+        }
+    }
+
+    std::vector<uint32_t> remaining(passes_.size(), 0);
+    std::vector<std::vector<PassId>> dependents(passes_.size());
+    std::vector<PassId> ready;
+    for (PassId p = 0; p < passes_.size(); ++p) {
+        if (passes_[p].culled) {
+            continue;
+        }
+        remaining[p] = static_cast<uint32_t>(dependencies[p].size());
+        for (PassId dependency : dependencies[p]) {
+            dependents[dependency].push_back(p);
+        }
+        if (remaining[p] == 0) {
+            ready.push_back(p);
+        }
+    }
+
+    executionOrder_.clear();
+    PassId previous = ~0u;
+    while (!ready.empty()) {
+        // 방금 실행한 패스에 의존하지 않는 패스가 있으면 먼저 꺼냅니다. 없으면 선언 순서가 가장 빠른 패스
+        auto dependsOnPrevious = [&](PassId p) {
+            return std::find(dependencies[p].begin(), dependencies[p].end(), previous) != dependencies[p].end();
+        };
+        auto best = ready.end();
+        for (auto it = ready.begin(); it != ready.end(); ++it) {
+            if (best == ready.end()) {
+                best = it;
+                continue;
+            }
+            bool itIndependent = !dependsOnPrevious(*it);
+            bool bestIndependent = !dependsOnPrevious(*best);
+            if ((itIndependent && !bestIndependent) || (itIndependent == bestIndependent && *it < *best)) {
+                best = it;
+            }
+        }
+
+        PassId pass = *best;
+        ready.erase(best);
+        executionOrder_.push_back(pass);
+        previous = pass;
+
+        for (PassId dependent : dependents[pass]) {
+            if (--remaining[dependent] == 0) {
+                ready.push_back(dependent);
+            }
+        }
+    }
+}
+
+void RenderGraph::simulate(std::vector<ResourceState>& states, std::vector<BarrierBatch>* outBatches)
+{
+    // 첫 번째 흉내(outBatches == nullptr)에서는 세그먼트 대기/release를 기록하지 않습니다.
+    std::vector<bool> touched(resources_.size(), false);
+    auto access = [&](ResourceId resource, const AccessInfo& info, uint32_t segment, BarrierBatch* batch) {
+        ResourceState& state = states[resource];
+        const bool previousFrame = !touched[resource];
+        if (!touched[resource]) {
+            touched[resource] = true;
+            inheritAliasedStates(resource, states);
+        }
+        if (state.segment != ~0u && segments_[state.segment].queue != segments_[segment].queue) {
+            transferQueue(resource, state, info, segment, previousFrame, outBatches ? batch : nullptr);
+        }
+        else {
+            transition(resource, state, info, batch);
+        }
+        state.segment = segment;
+    };
+
+    for (uint32_t i = 0; i < executionOrder_.size(); ++i) {
+        BarrierBatch batch{};
+        for (const ResourceUsage& usage : passes_[executionOrder_[i]].usages) {
+            AccessInfo info = GetAccessInfo(usage.access);
+            info.write = usage.write;
+            access(usage.resource, info, passSegments_[i], &batch);
+        }
+        if (outBatches) {
+            outBatches->push_back(std::move(batch));
+        }
+    }
+
+    BarrierBatch finalBatch{};
+    const uint32_t lastSegment = static_cast<uint32_t>(segments_.size() - 1);
+    for (ResourceId r = 0; r < resources_.size(); ++r) {
+        if (resources_[r].desc.hasFinalAccess) {
+            access(r, GetAccessInfo(resources_[r].desc.finalAccess), lastSegment, &finalBatch);
+        }
+    }
+    if (outBatches) {
+        outBatches->push_back(std::move(finalBatch));
+    }
+}
+
+void RenderGraph::addWait(uint32_t segment, RenderGraphQueue queue, uint32_t waitSegment, VkPipelineStageFlags2 stageMask)
+{
+    // 대기 단계가 없는 접근(Present 전환 등)은 세그먼트 전체를 막습니다.
+    if (stageMask == VK_PIPELINE_STAGE_2_NONE) {
+        stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+    }
+    // 한 큐의 신호 값은 세그먼트 순서대로 커지므로, 큐마다 가장 늦은 세그먼트 하나만 기다리면 됩니다.
+    for (SegmentWait& wait : segments_[segment].waits) {
+        if (wait.queue != queue) {
+            continue;
+        }
+        if (wait.segment == PREVIOUS_FRAME || (waitSegment != PREVIOUS_FRAME && waitSegment > wait.segment)) {
+            wait.segment = waitSegment;
+        }
+        wait.stageMask |= stageMask;
+        return;
+    }
+    segments_[segment].waits.push_back({ queue, waitSegment, stageMask });
+}
+
+void RenderGraph::transferQueue(ResourceId resource, ResourceState& state, const AccessInfo& next, uint32_t segment,
+    bool previousFrame, BarrierBatch* batch)
+{
+    // 다른 큐의 마지막 접근은 세마포어로 기다립니다. 세마포어 신호/대기가 메모리 의존성까지 만들므로,
+    // 대기 단계(next.stageMask)에서는 앞 큐의 쓰기가 이미 보입니다.
+    const Resource& target = resources_[resource];
+    const RenderGraphQueue srcQueue = segments_[state.segment].queue;
+    const RenderGraphQueue dstQueue = segments_[segment].queue;
+    if (batch) {
+        addWait(segment, srcQueue, previousFrame ? PREVIOUS_FRAME : state.segment, next.stageMask);
+    }
+
+    if (target.desc.type == ResourceType::Image && state.layout != VK_IMAGE_LAYOUT_UNDEFINED) {
+        // 지난 프레임의 release는 이미 기록된 세그먼트에 넣을 수 없으므로, 내용을 유지하는 이미지는 프레임 안에서만 큐를 건널 수 있습니다.
+        if (previousFrame) {
+            throw std::runtime_error("render graph image keeps its contents across queues between frames: " + target.desc.name);
+        }
+        // 소유권 이전: 앞 큐의 세그먼트 끝에서 release, 이 패스 앞에서 같은 레이아웃 전환으로 acquire
+        if (batch) {
+            const uint32_t srcFamily = queueFamilies_[static_cast<size_t>(srcQueue)];
+            const uint32_t dstFamily = queueFamilies_[static_cast<size_t>(dstQueue)];
+            segments_[state.segment].releaseBatch.imageBarriers.push_back({ resource,
+                state.writeStages | state.readStages, state.writeAccess, VK_PIPELINE_STAGE_2_NONE, VK_ACCESS_2_NONE,
+                state.layout, next.layout, srcFamily, dstFamily });
+            batch->imageBarriers.push_back({ resource,
+                next.stageMask, VK_ACCESS_2_NONE, next.stageMask, next.accessMask,
+                state.layout, next.layout, srcFamily, dstFamily });
+            queueTransferCount_++;
+        }
+        state.layout = next.layout;
+    }
+
+    // 이제부터는 이 큐의 대기 단계에서 시작한 것으로 봅니다.
+    // 내용을 버리는 이미지는 소유권을 넘기지 않고 UNDEFINED에서 새로 전환합니다.
+    const VkImageLayout layout = state.layout;
+    state = ResourceState{};
+    state.layout = layout;
+    state.writeStages = next.stageMask;
+    if (layout != next.layout && target.desc.type == ResourceType::Image) {
+        transition(resource, state, next, batch);
+        return;
+    }
+    if (next.write) {
+        state.writeAccess = next.accessMask & WRITE_ACCESS_MASK;
+    }
+    else {
+        state.readStages = next.stageMask;
+        state.readAccess = next.accessMask;
+    }
+}
+
+void RenderGraph::inheritAliasedStates(ResourceId resource, std::vector<ResourceState>& states) const
+{
+    const Resource& target = resources_[resource];
+    if (!target.transientPool || !target.transientPool->isBuilt()) {
+        return;
+    }
+
+    // 같은 메모리를 쓰는 이미지의 마지막 접근(이번 프레임에 먼저 쓰였으면 그 접근, 아니면 지난 프레임의 마지막 접근)이
+    // 끝난 뒤에 이 이미지를 UNDEFINED에서 전환해야 합니다. 내용은 버리므로 쓰기 접근만 넘겨받습니다.
+    ResourceState& state = states[resource];
+    for (ResourceId other = 0; other < resources_.size(); ++other) {
+        const Resource& aliased = resources_[other];
+        if (other == resource || aliased.transientPool != target.transientPool ||
+            !target.transientPool->aliases(target.transientImage, aliased.transientImage)) {
+            continue;
+        }
+        state.writeStages |= states[other].writeStages | states[other].readStages;
+        state.writeAccess |= states[other].writeAccess;
+        state.readStages = VK_PIPELINE_STAGE_2_NONE;
+        state.readAccess = VK_ACCESS_2_NONE;
+        state.layout = VK_IMAGE_LAYOUT_UNDEFINED;
+    }
+}
+
+void RenderGraph::transition(ResourceId resource, ResourceState& state, const AccessInfo& next, BarrierBatch* batch) const
+{
+    const bool isImage = resources_[resource].desc.type == ResourceType::Image;
+    const bool layoutChange = isImage && state.layout != next.layout;
+
+    VkPipelineStageFlags2 srcStages = VK_PIPELINE_STAGE_2_NONE;
+    VkAccessFlags2 srcAccess = VK_ACCESS_2_NONE;
+    bool needBarrier = false;
+
+    if (next.write || layoutChange) {
+        // 쓰기(레이아웃 전환 포함)는 앞선 쓰기(WAW)와 앞선 읽기(WAR)가 모두 끝난 뒤여야 합니다.
+        // 읽기는 실행 의존성만 있으면 되므로 접근 마스크는 쓰기만 넣습니다.
+        srcStages = state.writeStages | state.readStages;
+        srcAccess = state.writeAccess;
+        needBarrier = layoutChange || srcStages != VK_PIPELINE_STAGE_2_NONE;
+
+        const VkImageLayout oldLayout = state.layout;
+        if (needBarrier && batch) {
+            if (isImage) {
+                batch->imageBarriers.push_back({ resource, srcStages, srcAccess, next.stageMask, next.accessMask, oldLayout, next.layout });
+            }
+        }
+
+        state.layout = isImage ? next.layout : VK_IMAGE_LAYOUT_UNDEFINED;
+        if (next.write) {
+            state.writeStages = next.stageMask;
+            state.writeAccess = next.accessMask & WRITE_ACCESS_MASK;
+            state.readStages = VK_PIPELINE_STAGE_2_NONE;
+            state.readAccess = VK_ACCESS_2_NONE;
+        }
+        else {
+            // 읽기를 위한 레이아웃 전환: 이 읽기는 이미 가시성을 얻었고, 다른 단계의 읽기는 전환 뒤로 실행 순서만 맞추면 됩니다.
+            state.writeStages = next.stageMask;
+            state.writeAccess = VK_ACCESS_2_NONE;
+            state.readStages = next.stageMask;
+            state.readAccess = next.accessMask;
+        }
+    }
+    else {
+        // 같은 레이아웃에서의 읽기: 마지막 쓰기 이후 아직 가시성을 얻지 못한 단계/접근이 있을 때만 배리어가 필요합니다.
+        bool notVisible = (next.stageMask & ~state.readStages) != 0 || (next.accessMask & ~state.readAccess) != 0;
+        if (state.writeStages != VK_PIPELINE_STAGE_2_NONE && notVisible) {
+            srcStages = state.writeStages;
+            srcAccess = state.writeAccess;
+            needBarrier = true;
+            if (batch && isImage) {
+                batch->imageBarriers.push_back({ resource, srcStages, srcAccess, next.stageMask, next.accessMask, state.layout, state.layout });
+            }
+        }
+        state.readStages |= next.stageMask;
+        state.readAccess |= next.accessMask;
+    }
+
+    if (needBarrier && batch && !isImage) {
+        batch->memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+        batch->memoryBarrier.srcStageMask |= srcStages;
+        batch->memoryBarrier.srcAccessMask |= srcAccess;
+        batch->memoryBarrier.dstStageMask |= next.stageMask;
+        batch->memoryBarrier.dstAccessMask |= next.accessMask;
+        batch->hasMemoryBarrier = true;
+    }
+}
+
+void RenderGraph::setImage(ResourceId resource, VkImage image, VkImageAspectFlags aspectMask)
+{
+    resources_[resource].image = image;
+    resources_[resource].aspectMask = aspectMask;
+}
+
+void RenderGraph::bindTransientImage(ResourceId resource, TransientResourcePool* pool, TransientResourcePool::ImageId image, VkImageAspectFlags aspectMask)
+{
+    Resource& target = resources_[resource];
+    if (target.desc.type != ResourceType::Image || target.desc.preserveContents) {
+        throw std::runtime_error("render graph resource cannot be transient: " + target.desc.name);
+    }
+    target.transientPool = pool;
+    target.transientImage = image;
+    target.aspectMask = aspectMask;
+}
+
+uint32_t RenderGraph::getFirstSegment(ResourceId resource) const
+{
+    for (uint32_t i = 0; i < executionOrder_.size(); ++i) {
+        for (const ResourceUsage& usage : passes_[executionOrder_[i]].usages) {
+            if (usage.resource == resource) {
+                return passSegments_[i];
+            }
+        }
+    }
+    return static_cast<uint32_t>(segments_.size() - 1);
+}
+
+void RenderGraph::declareTransientLifetimes() const
+{
+    if (barrierBatches_.empty()) {
+        throw std::runtime_error("render graph is not compiled!");
+    }
+
+    // 제거된 패스는 실행 순서에 없으므로 실제로 기록되는 접근만 구간에 들어갑니다.
+    for (ResourceId r = 0; r < resources_.size(); ++r) {
+        const Resource& resource = resources_[r];
+        if (!resource.transientPool) {
+            continue;
+        }
+        uint32_t firstPass = ~0u;
+        uint32_t lastPass = 0;
+        bool usedOnCompute = false;
+        for (uint32_t i = 0; i < executionOrder_.size(); ++i) {
+            for (const ResourceUsage& usage : passes_[executionOrder_[i]].usages) {
+                if (usage.resource == r) {
+                    firstPass = std::min(firstPass, i);
+                    lastPass = std::max(lastPass, i);
+                    // 컴퓨트 큐를 켜고 끄는 것과 관계없이 같은 구간이 되도록, 선언된 큐로 판단합니다.
+                    usedOnCompute = usedOnCompute || passes_[executionOrder_[i]].queue == RenderGraphQueue::Compute;
+                }
+            }
+        }
+        if (resource.desc.hasFinalAccess) {
+            lastPass = static_cast<uint32_t>(executionOrder_.size());
+        }
+        // 다른 큐의 세그먼트와 겹쳐 실행될 수 있으므로 다른 이미지와 메모리를 나누지 않습니다.
+        if (firstPass != ~0u && usedOnCompute) {
+            firstPass = 0;
+            lastPass = static_cast<uint32_t>(executionOrder_.size());
+        }
+        if (firstPass != ~0u) {
+            resource.transientPool->addLifetime(resource.transientImage, this, firstPass, lastPass);
+        }
+    }
+}
+
+void RenderGraph::recordBatch(VkCommandBuffer commandBuffer, const BarrierBatch& batch) const
+{
+    if (batch.imageBarriers.empty() && !batch.hasMemoryBarrier) {
+        return;
+    }
+
+    std::vector<VkImageMemoryBarrier2> imageBarriers;
+    imageBarriers.reserve(batch.imageBarriers.size());
+    for (const ImageBarrier& barrier : batch.imageBarriers) {
+        const Resource& resource = resources_[barrier.resource];
+        const VkImage image = resource.transientPool ? resource.transientPool->getImage(resource.transientImage) : resource.image;
+        if (image == VK_NULL_HANDLE) {
+            throw std::runtime_error("render graph image is not set: " + resource.desc.name);
+        }
+
+        VkImageMemoryBarrier2 imageBarrier{};
+        imageBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+        imageBarrier.srcStageMask = barrier.srcStageMask;
+        imageBarrier.srcAccessMask = barrier.srcAccessMask;
+        imageBarrier.dstStageMask = barrier.dstStageMask;
+        imageBarrier.dstAccessMask = barrier.dstAccessMask;
+        imageBarrier.oldLayout = barrier.oldLayout;
+        imageBarrier.newLayout = barrier.newLayout;
+        imageBarrier.srcQueueFamilyIndex = barrier.srcQueueFamily;
+        imageBarrier.dstQueueFamilyIndex = barrier.dstQueueFamily;
+        imageBarrier.image = image;
+        imageBarrier.subresourceRange.aspectMask = resource.aspectMask;
+        imageBarrier.subresourceRange.baseMipLevel = 0;
+        imageBarrier.subresourceRange.levelCount = VK_REMAINING_MIP_LEVELS;
+        imageBarrier.subresourceRange.baseArrayLayer = 0;
+        imageBarrier.subresourceRange.layerCount = VK_REMAINING_ARRAY_LAYERS;
+        imageBarriers.push_back(imageBarrier);
+    }
+
+    VkDependencyInfo dependencyInfo{};
+    dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependencyInfo.memoryBarrierCount = batch.hasMemoryBarrier ? 1 : 0;
+    dependencyInfo.pMemoryBarriers = batch.hasMemoryBarrier ? &batch.memoryBarrier : nullptr;
+    dependencyInfo.imageMemoryBarrierCount = static_cast<uint32_t>(imageBarriers.size());
+    dependencyInfo.pImageMemoryBarriers = imageBarriers.empty() ? nullptr : imageBarriers.data();
+    vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+}
+
+void RenderGraph::executeSegment(VkCommandBuffer commandBuffer, uint32_t segment) const
+{
+    if (!compiled_) {
+        throw std::runtime_error("render graph is not compiled!");
+    }
+
+    const Segment& target = segments_[segment];
+    for (uint32_t i = target.firstPass; i < target.firstPass + target.passCount; ++i) {
+        recordBatch(commandBuffer, barrierBatches_[i]);
+        passes_[executionOrder_[i]].execute(commandBuffer);
+    }
+    if (segment + 1 == segments_.size()) {
+        recordBatch(commandBuffer, barrierBatches_.back());
+    }
+    recordBatch(commandBuffer, target.releaseBatch);
+}
@@ -0,0 +1,236 @@
+#pragma once
+#include <vulkan/vulkan.h>
+#include <vector>
+#include <string>
+#include <functional>
+#include <unordered_map>
+#include <cstdint>
+#include "TransientResourcePool.h"
+
+// 패스가 리소스를 어떻게 쓰는지 (파이프라인 단계, 접근 마스크, 이미지 레이아웃이 여기서 정해집니다)
+enum class RenderGraphAccess : uint8_t {
+    ColorAttachment,        // 컬러 어태치먼트 읽기/쓰기 (LOAD 포함)
+    DepthAttachment,        // 깊이 테스트 + 쓰기
+    DepthAttachmentRead,    // 깊이 테스트만 (EQUAL 셰이딩 패스), 레이아웃은 그대로 둡니다.
+    FragmentSampled,        // 프래그먼트 셰이더 샘플링
+    ComputeSampled,         // 컴퓨트 셰이더 샘플링 (READ_ONLY 레이아웃)
+    ComputeStorageRead,     // 컴퓨트 셰이더 읽기 (GENERAL 레이아웃)
+    ComputeStorageWrite,    // 컴퓨트 셰이더 쓰기 (GENERAL 레이아웃)
+    IndirectRead,           // 간접 드로우 인자 + 버텍스 셰이더의 인스턴스 읽기 (버퍼)
+    Present,                // 프레젠트 (레이아웃 전환만)
+    Count
+};
+
+// 패스를 기록할 큐
+enum class RenderGraphQueue : uint8_t {
+    Graphics,
+    Compute,    // 컴퓨트 전용 큐 (없거나 끄면 그래픽스 큐로 합칩니다)
+    Count
+};
+
+// 패스가 읽고 쓰는 리소스를 선언하면 실행 순서, 쓰지 않는 패스 제거, 배리어를 컴파일 시점에 정하는 렌더 그래프
+//  - 실행 순서: 선언 순서를 기준으로 의존성(RAW/WAR/WAW)을 지키면서, 방금 실행한 패스에 의존하지 않는 패스를
+//    먼저 꺼내 생산자와 소비자 사이를 벌립니다. (배리어 대기가 다른 작업과 겹칠 수 있게)
+//  - 패스 제거: 출력 리소스(스왑체인 등)까지 이어지지 않는 패스는 기록하지 않습니다.
+//  - 배리어: 리소스마다 마지막 쓰기/읽기 단계를 추적해 필요한 것만 만들고, 패스마다 vkCmdPipelineBarrier2 한 번으로 묶습니다.
+//    버퍼는 핸들 없이 논리적으로만 추적하므로 전역 메모리 배리어 하나로 합칩니다. (BDA로 접근하는 버퍼들)
+//  - 같은 그래프를 매 프레임 실행하므로, 프레임 사이의 의존성(지난 프레임의 마지막 접근 -> 이번 프레임 첫 접근)도 첫 배리어에 넣습니다.
+//  - 큐: 실행 순서를 같은 큐의 패스끼리 세그먼트로 나눕니다. 세그먼트 하나가 커맨드 버퍼 하나, 제출 하나입니다.
+//    큐를 건너는 의존성은 타임라인 세마포어 대기로 바꾸고, 이미지는 소유권 이전(release/acquire) 배리어 쌍을 넣습니다.
+//    버퍼는 CONCURRENT로 만들므로(VulkanContext::setBufferSharing) 세마포어만으로 충분합니다.
+// 패스 안에서의 세부 동기화(Hi-Z 밉 사이, 컬링 셰이더 사이)는 패스가 직접 처리합니다.
+class RenderGraph
+{
+public:
+    using ResourceId = uint32_t;
+    using PassId = uint32_t;
+    using ExecuteFunc = std::function<void(VkCommandBuffer)>;
+    static constexpr ResourceId INVALID_RESOURCE = ~0u;
+    // SegmentWait::segment: 그 큐가 지난 프레임까지 마지막으로 신호한 값을 기다립니다.
+    static constexpr uint32_t PREVIOUS_FRAME = ~0u;
+
+    enum class ResourceType {
+        Image,
+        Buffer,
+    };
+
+    struct ResourceDesc {
+        std::string name;
+        ResourceType type = ResourceType::Image;
+        // 프레임 사이에 내용과 레이아웃을 유지합니다. (Hi-Z처럼 지난 프레임 결과를 쓰는 경우)
+        // 아니면 첫 접근에서 UNDEFINED로 전환해 내용을 버립니다.
+        bool preserveContents = false;
+        // 프레임 인 플라이트마다 따로 있는 리소스라 지난 프레임과의 의존성이 없습니다.
+        bool perFrame = false;
+        // 그래프의 결과물입니다. 여기까지 이어지지 않는 패스는 제거됩니다.
+        bool output = false;
+        // 그래프가 끝날 때 전환할 접근 (스왑체인은 Present)
+        bool hasFinalAccess = false;
+        RenderGraphAccess finalAccess = RenderGraphAccess::Present;
+    };
+
+    // 세그먼트를 제출하기 전에 기다릴 다른 큐의 세그먼트 (같은 프레임의 인덱스 또는 PREVIOUS_FRAME)
+    struct SegmentWait {
+        RenderGraphQueue queue;
+        uint32_t segment;
+        VkPipelineStageFlags2 stageMask;
+    };
+
+    RenderGraph() = default;
+
+    void clear();
+
+    ResourceId addResource(const ResourceDesc& desc);
+    ResourceId findResource(const std::string& name) const;
+    PassId addPass(const std::string& name, ExecuteFunc execute, RenderGraphQueue queue = RenderGraphQueue::Graphics);
+    void read(PassId pass, ResourceId resource, RenderGraphAccess access);
+    void write(PassId pass, ResourceId resource, RenderGraphAccess access);
+
+    // JSON 설명으로 리소스와 패스를 만듭니다. 패스의 기록 함수는 이름으로 찾습니다.
+    // {
+    //   "resources": [ { "name": "swapchain", "type": "image", "output": true, "final": "present" }, ... ],
+    //   "passes": [ { "name": "tonemap", "reads": [ { "resource": "sceneColor", "access": "fragmentSampled" } ],
+    //                 "writes": [ { "resource": "swapchain", "access": "colorAttachment" } ] },
+    //               { "name": "cullEarly", "queue": "compute", ... }, ... ]
+    // }
+    void loadFromJson(const std::string& path, const std::unordered_map<std::string, ExecuteFunc>& executors);
+
+    // 컴퓨트 패스를 보낼 큐 패밀리. 두 값이 같으면 모든 패스를 그래픽스 큐 하나에 기록합니다. (기본값)
+    // 바꾼 뒤에는 compile()을 다시 불러야 합니다.
+    void setQueueFamilies(uint32_t graphicsFamily, uint32_t computeFamily);
+
+    // 리소스 선언이 바뀌면 다시 호출해야 합니다.
+    void compile();
+
+    // 이미지 핸들은 프레임마다 바뀔 수 있으므로(스왑체인) 실행 전에 지정합니다.
+    void setImage(ResourceId resource, VkImage image, VkImageAspectFlags aspectMask);
+    // 풀에서 받는 이미지: 핸들은 풀에서 가져오고, 같은 메모리를 쓰는 다른 이미지의 마지막 사용을 첫 배리어에서 기다립니다.
+    // 연결한 뒤 declareTransientLifetimes -> 풀 build() -> compile() 순서로 불러야 합니다.
+    void bindTransientImage(ResourceId resource, TransientResourcePool* pool, TransientResourcePool::ImageId image, VkImageAspectFlags aspectMask);
+    // compile 이후, 실행 순서 기준으로 풀 이미지의 사용 구간을 풀에 알려줍니다.
+    // 여러 큐에서 쓰는 이미지는 큐끼리 겹쳐 실행될 수 있으므로 프레임 전체를 구간으로 잡습니다.
+    void declareTransientLifetimes() const;
+
+    // 세그먼트 순서대로 기록/제출합니다. 마지막 세그먼트는 항상 그래픽스 큐이며 최종 전환(Present)을 포함합니다.
+    uint32_t getSegmentCount() const { return static_cast<uint32_t>(segments_.size()); }
+    RenderGraphQueue getSegmentQueue(uint32_t segment) const { return segments_[segment].queue; }
+    const std::vector<SegmentWait>& getSegmentWaits(uint32_t segment) const { return segments_[segment].waits; }
+    // 리소스를 처음 쓰는 세그먼트 (스왑체인 acquire 세마포어를 기다릴 곳), 쓰지 않으면 마지막 세그먼트
+    uint32_t getFirstSegment(ResourceId resource) const;
+    void executeSegment(VkCommandBuffer commandBuffer, uint32_t segment) const;
+
+    // 통계 (compile 이후)
+    const std::vector<PassId>& getExecutionOrder() const { return executionOrder_; }
+    const std::string& getPassName(PassId pass) const { return passes_[pass].name; }
+    uint32_t getCulledPassCount() const { return culledPassCount_; }
+    uint32_t getBarrierCount() const { return barrierCount_; }
+    uint32_t getBarrierBatchCount() const { return barrierBatchCount_; }
+    uint32_t getQueueTransferCount() const { return queueTransferCount_; }
+
+    static RenderGraphAccess ParseAccess(const std::string& name);
+
+private:
+    struct AccessInfo {
+        VkPipelineStageFlags2 stageMask;
+        VkAccessFlags2 accessMask;
+        VkImageLayout layout;
+        bool write;
+    };
+    static const AccessInfo& GetAccessInfo(RenderGraphAccess access);
+
+    struct ResourceUsage {
+        ResourceId resource;
+        RenderGraphAccess access;
+        bool write;
+    };
+
+    struct Pass {
+        std::string name;
+        ExecuteFunc execute;
+        RenderGraphQueue queue = RenderGraphQueue::Graphics;
+        std::vector<ResourceUsage> usages;
+        bool culled = false;
+    };
+
+    struct Resource {
+        ResourceDesc desc;
+        VkImage image = VK_NULL_HANDLE;
+        VkImageAspectFlags aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        TransientResourcePool* transientPool = nullptr;
+        TransientResourcePool::ImageId transientImage = TransientResourcePool::INVALID_IMAGE;
+    };
+
+    // 리소스의 마지막 접근 상태
+    struct ResourceState {
+        VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+        VkPipelineStageFlags2 writeStages = VK_PIPELINE_STAGE_2_NONE;
+        VkAccessFlags2 writeAccess = VK_ACCESS_2_NONE;
+        // 마지막 쓰기 이후 이미 가시성을 얻은 읽기 단계
+        VkPipelineStageFlags2 readStages = VK_PIPELINE_STAGE_2_NONE;
+        VkAccessFlags2 readAccess = VK_ACCESS_2_NONE;
+        // 마지막으로 접근한 세그먼트 (큐가 바뀌는지 보기 위해)
+        uint32_t segment = ~0u;
+    };
+
+    struct ImageBarrier {
+        ResourceId resource;
+        VkPipelineStageFlags2 srcStageMask;
+        VkAccessFlags2 srcAccessMask;
+        VkPipelineStageFlags2 dstStageMask;
+        VkAccessFlags2 dstAccessMask;
+        VkImageLayout oldLayout;
+        VkImageLayout newLayout;
+        // 소유권 이전일 때만 패밀리 인덱스를 넣습니다.
+        uint32_t srcQueueFamily = VK_QUEUE_FAMILY_IGNORED;
+        uint32_t dstQueueFamily = VK_QUEUE_FAMILY_IGNORED;
+    };
+
+    // 패스 하나 앞에 기록할 배리어 묶음
+    struct BarrierBatch {
+        VkMemoryBarrier2 memoryBarrier{};
+        bool hasMemoryBarrier = false;
+        std::vector<ImageBarrier> imageBarriers;
+    };
+
+    // 같은 큐에서 이어지는 패스 묶음 [firstPass, firstPass + passCount) (실행 순서 인덱스)
+    struct Segment {
+        RenderGraphQueue queue = RenderGraphQueue::Graphics;
+        uint32_t firstPass = 0;
+        uint32_t passCount = 0;
+        std::vector<SegmentWait> waits;
+        // 세그먼트 끝에서 다른 큐로 넘기는 이미지의 release 배리어
+        BarrierBatch releaseBatch;
+    };
+
+    void addUsage(PassId pass, ResourceId resource, RenderGraphAccess access, bool write);
+    void cullPasses();
+    void schedulePasses();
+    void buildSegments();
+    RenderGraphQueue getPassQueue(PassId pass) const;
+    void simulate(std::vector<ResourceState>& states, std::vector<BarrierBatch>* outBatches);
+    void transition(ResourceId resource, ResourceState& state, const AccessInfo& next, BarrierBatch* batch) const;
+    void transferQueue(ResourceId resource, ResourceState& state, const AccessInfo& next, uint32_t segment,
+        bool previousFrame, BarrierBatch* batch);
+    void addWait(uint32_t segment, RenderGraphQueue queue, uint32_t waitSegment, VkPipelineStageFlags2 stageMask);
+    void inheritAliasedStates(ResourceId resource, std::vector<ResourceState>& states) const;
+    void recordBatch(VkCommandBuffer commandBuffer, const BarrierBatch& batch) const;
+
+private:
+    std::vector<Resource> resources_;
+    std::vector<Pass> passes_;
+    std::unordered_map<std::string, ResourceId> resourceNames_;
+
+    std::vector<PassId> executionOrder_;
+    // executionOrder_와 같은 순서, 마지막 하나는 그래프가 끝날 때의 최종 전환
+    std::vector<BarrierBatch> barrierBatches_;
+    std::vector<Segment> segments_;
+    // executionOrder_와 같은 순서, 패스가 속한 세그먼트
+    std::vector<uint32_t> passSegments_;
+    uint32_t queueFamilies_[static_cast<size_t>(RenderGraphQueue::Count)] = {};
+
+    uint32_t culledPassCount_ = 0;
+    uint32_t barrierCount_ = 0;
+    uint32_t barrierBatchCount_ = 0;
+    uint32_t queueTransferCount_ = 0;
+    bool compiled_ = false;
+};
@@ -0,0 +1,85 @@
+#include "RenderQueue.h"
+#include <algorithm>
+#include <cmath>
+
+uint64_t RenderQueue::MakeKey(Pass pass, uint32_t pipeline, uint32_t depthBucket, uint32_t material, uint32_t mesh)
+{
+    depthBucket = std::min(depthBucket, DEPTH_BUCKET_COUNT - 1);
+    if (pass == PASS_TRANSPARENT) {
+        // 반투명은 뒤에서 앞으로 섞어야 합니다.
+        depthBucket = DEPTH_BUCKET_COUNT - 1 - depthBucket;
+    }
+
+    uint64_t key = static_cast<uint64_t>(pass & 0xF);
+    key = (key << PIPELINE_BITS) | (pipeline & ((1u << PIPELINE_BITS) - 1));
+    key = (key << DEPTH_BITS) | depthBucket;
+    key = (key << MATERIAL_BITS) | (material & ((1u << MATERIAL_BITS) - 1));
+    key = (key << MESH_BITS) | (mesh & ((1u << MESH_BITS) - 1));
+    return key;
+}
+
+uint32_t RenderQueue::QuantizeDepth(float viewDistance, float maxDistance)
+{
+    if (!(viewDistance > 0.0f) || !(maxDistance > 0.0f)) {
+        return 0;
+    }
+    float normalized = std::log2(1.0f + viewDistance) / std::log2(1.0f + maxDistance);
+    normalized = std::clamp(normalized, 0.0f, 1.0f);
+    return static_cast<uint32_t>(normalized * static_cast<float>(DEPTH_BUCKET_COUNT - 1));
+}
+
+void RenderQueue::RadixSort(std::vector<Entry>& entries, std::vector<Entry>& scratch)
+{
+    constexpr uint32_t RADIX_BITS = 8;
+    constexpr uint32_t BUCKETS = 1u << RADIX_BITS;
+    constexpr uint32_t PASSES = 64 / RADIX_BITS;
+
+    const size_t count = entries.size();
+    if (count < 2) {
+        return;
+    }
+    scratch.resize(count);
+
+    // 모든 패스의 히스토그램을 한 번의 순회로 만듭니다.
+    uint32_t histograms[PASSES][BUCKETS] = {};
+    for (const Entry& entry : entries) {
+        uint64_t key = entry.key;
+        for (uint32_t pass = 0; pass < PASSES; ++pass) {
+            histograms[pass][(key >> (pass * RADIX_BITS)) & (BUCKETS - 1)]++;
+        }
+    }
+
+    Entry* source = entries.data();
+    Entry* destination = scratch.data();
+    for (uint32_t pass = 0; pass < PASSES; ++pass) {
+        uint32_t* histogram = histograms[pass];
+        const uint32_t shift = pass * RADIX_BITS;
+
+        // 한 버킷에 모두 모여 있으면 이 바이트는 순서를 바꾸지 않습니다.
+        if (histogram[(source[0].key >> shift) & (BUCKETS - 1)] == count) {
+            continue;
+        }
+
+        uint32_t offset = 0;
+        for (uint32_t bucket = 0; bucket < BUCKETS; ++bucket) {
+            uint32_t bucketCount = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += bucketCount;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            const Entry& entry = source[i];
+            destination[histogram[(entry.key >> shift) & (BUCKETS - 1)]++] = entry;
+        }
+        std::swap(source, destination);
+    }
+
+    if (source != entries.data()) {
+        std::copy(source, source + count, entries.data());
+    }
+}
+
+void RenderQueue::reserve(size_t count)
+{
+    entries_.reserve(count);
+    scratch_.reserve(count);
+}
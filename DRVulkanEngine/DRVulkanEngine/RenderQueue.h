@@ -0,0 +1,59 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// 드로우마다 64비트 정렬 키를 만들어 한 번에 정렬하는 렌더 큐
+// 키의 상위 비트일수록 우선순위가 높습니다.
+//  [63..60] pass       4비트  (불투명 -> 스카이박스 -> 반투명)
+//  [59..52] pipeline   8비트
+//  [51..40] depth     12비트  (불투명은 앞->뒤, 반투명은 뒤->앞)
+//  [39..20] material  20비트
+//  [19.. 0] mesh      20비트
+// 이 렌더러는 재질이 bindless(인스턴스 데이터의 재질 인덱스)라 재질이 바뀌어도 바인딩이 없고,
+// 메시마다 정점/인덱스 버퍼가 따로 있어 메시 전환은 어떤 순서로도 줄지 않습니다.
+// 그래서 파이프라인 다음에 깊이를 두어 early-Z를 살리고, 같은 깊이 구간 안에서만 재질/메시로 묶습니다.
+//
+// 정렬은 LSD 기수 정렬(8비트 x 8패스)이며 모든 항목의 바이트가 같은 패스는 건너뜁니다.
+class RenderQueue
+{
+public:
+    enum Pass : uint32_t {
+        PASS_OPAQUE = 0,
+        PASS_SKYBOX = 1,
+        PASS_TRANSPARENT = 2,
+    };
+
+    static constexpr uint32_t PIPELINE_BITS = 8;
+    static constexpr uint32_t DEPTH_BITS = 12;
+    static constexpr uint32_t MATERIAL_BITS = 20;
+    static constexpr uint32_t MESH_BITS = 20;
+    static constexpr uint32_t DEPTH_BUCKET_COUNT = 1u << DEPTH_BITS;
+
+    struct Entry {
+        uint64_t key = 0;
+        uint32_t item = 0;  // 호출자가 정하는 드로우 인덱스
+    };
+
+    // 범위를 넘는 값은 비트 폭에 맞게 잘립니다.
+    static uint64_t MakeKey(Pass pass, uint32_t pipeline, uint32_t depthBucket, uint32_t material, uint32_t mesh);
+    // 카메라로부터의 거리를 [0, maxDistance]에서 로그 분포로 양자화합니다. (가까울수록 촘촘)
+    static uint32_t QuantizeDepth(float viewDistance, float maxDistance);
+
+    // entries를 key 오름차순으로 안정 정렬합니다. scratch는 같은 크기의 임시 버퍼로 재사용됩니다.
+    static void RadixSort(std::vector<Entry>& entries, std::vector<Entry>& scratch);
+
+    void reserve(size_t count);
+    void clear() { entries_.clear(); }
+    void push(uint64_t key, uint32_t item) { entries_.push_back({ key, item }); }
+    void sort() { RadixSort(entries_, scratch_); }
+
+    size_t size() const { return entries_.size(); }
+    bool empty() const { return entries_.empty(); }
+    uint32_t getItem(size_t index) const { return entries_[index].item; }
+    const std::vector<Entry>& getEntries() const { return entries_; }
+
+private:
+    std::vector<Entry> entries_;
+    std::vector<Entry> scratch_;
+};
@@ -0,0 +1,107 @@
+#include "Benchmarks.h"
+#include "RenderQueue.h"
+#include <chrono>
+#include <random>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <limits>
+#include <algorithm>
+
+namespace
+{
+    using Clock = std::chrono::high_resolution_clock;
+
+    constexpr int SORT_ITERATIONS = 20;
+    constexpr uint32_t PIPELINE_COUNT = 8;
+    constexpr uint32_t MATERIAL_COUNT = 1024;
+    constexpr uint32_t MESH_COUNT = 4096;
+    constexpr float MAX_VIEW_DISTANCE = 1000.0f;
+
+    // 여러 번 돌려 가장 빠른 시간을 씁니다. (ms)
+    // 정렬은 입력을 망가뜨리므로 매번 prepare()로 되돌린 뒤 func()만 잽니다.
+    template <typename Prepare, typename Func>
+    double measureBest(Prepare&& prepare, Func&& func, int iterations)
+    {
+        double best = std::numeric_limits<double>::max();
+        for (int i = 0; i < iterations; ++i) {
+            prepare();
+            auto start = Clock::now();
+            func();
+            auto end = Clock::now();
+            best = std::min(best, std::chrono::duration<double, std::milli>(end - start).count());
+        }
+        return best;
+    }
+
+    // 키 순서대로 그렸을 때 패스/파이프라인이 바뀌는 횟수
+    // (재질은 bindless, 메시 버퍼는 배치마다 바인딩하므로 실제 바인딩이 바뀌는 건 이것뿐입니다)
+    size_t countPipelineChanges(const std::vector<RenderQueue::Entry>& entries)
+    {
+        constexpr uint32_t PIPELINE_SHIFT = RenderQueue::DEPTH_BITS + RenderQueue::MATERIAL_BITS + RenderQueue::MESH_BITS;
+        size_t changes = 0;
+        for (size_t i = 1; i < entries.size(); ++i) {
+            if ((entries[i - 1].key >> PIPELINE_SHIFT) != (entries[i].key >> PIPELINE_SHIFT)) {
+                changes++;
+            }
+        }
+        return changes;
+    }
+
+    void runCase(size_t drawCount)
+    {
+        std::mt19937 rng(1234);
+        std::uniform_int_distribution<uint32_t> pipeline(0, PIPELINE_COUNT - 1);
+        std::uniform_int_distribution<uint32_t> material(0, MATERIAL_COUNT - 1);
+        std::uniform_int_distribution<uint32_t> mesh(0, MESH_COUNT - 1);
+        std::uniform_real_distribution<float> distance(0.1f, MAX_VIEW_DISTANCE);
+        std::uniform_int_distribution<uint32_t> passRoll(0, 9);
+
+        std::vector<RenderQueue::Entry> input(drawCount);
+        for (size_t i = 0; i < drawCount; ++i) {
+            // 10%는 반투명
+            RenderQueue::Pass pass = passRoll(rng) == 0 ? RenderQueue::PASS_TRANSPARENT : RenderQueue::PASS_OPAQUE;
+            uint32_t depthBucket = RenderQueue::QuantizeDepth(distance(rng), MAX_VIEW_DISTANCE);
+            input[i].key = RenderQueue::MakeKey(pass, pipeline(rng), depthBucket, material(rng), mesh(rng));
+            input[i].item = static_cast<uint32_t>(i);
+        }
+
+        std::vector<RenderQueue::Entry> entries;
+        std::vector<RenderQueue::Entry> scratch;
+        entries.reserve(drawCount);
+        scratch.reserve(drawCount);
+
+        auto reset = [&] { entries = input; };
+
+        double radixMs = measureBest(reset, [&] { RenderQueue::RadixSort(entries, scratch); }, SORT_ITERATIONS);
+        std::vector<RenderQueue::Entry> radixResult = entries;
+
+        // 이미 정렬된 입력 (카메라가 거의 움직이지 않는 프레임)
+        double radixSortedMs = measureBest([] {}, [&] { RenderQueue::RadixSort(entries, scratch); }, SORT_ITERATIONS);
+
+        auto byKey = [](const RenderQueue::Entry& a, const RenderQueue::Entry& b) { return a.key < b.key; };
+        double stdSortMs = measureBest(reset, [&] { std::stable_sort(entries.begin(), entries.end(), byKey); }, SORT_ITERATIONS);
+
+        bool match = std::equal(entries.begin(), entries.end(), radixResult.begin(),
+            [](const RenderQueue::Entry& a, const RenderQueue::Entry& b) { return a.key == b.key && a.item == b.item; });
+
+        std::cout << std::setw(9) << drawCount
+            << " | radix " << std::setw(8) << radixMs << " ms"
+            << " | radix (sorted) " << std::setw(8) << radixSortedMs << " ms"
+            << " | std::stable_sort " << std::setw(8) << stdSortMs << " ms"
+            << " | pipeline changes " << countPipelineChanges(input) << " -> " << countPipelineChanges(radixResult)
+            << (match ? "" : " | MISMATCH")
+            << std::endl;
+    }
+}
+
+int RunRenderQueueBenchmark()
+{
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Render queue sort benchmark (64-bit keys, best of " << SORT_ITERATIONS << ")" << std::endl;
+
+    for (size_t drawCount : { size_t(10000), size_t(100000), size_t(1000000) }) {
+        runCase(drawCount);
+    }
+    return 0;
+}
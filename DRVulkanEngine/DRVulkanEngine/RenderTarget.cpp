@@ -2,74 +2,102 @@
 #include "Texture.h"
 #include "VulkanContext.h"
 
-void RenderTarget::initialize(VulkanContext* ctx, VkExtent2D extent, VkFormat colorFormat, VkFormat depthFormat)
+void RenderTarget::initialize(TransientResourcePool* transientPool, VkExtent2D extent, VkFormat colorFormat, VkFormat depthFormat)
 {
+    transientPool_ = transientPool;
     extent_ = extent;
     colorFormat_ = colorFormat;
     depthFormat_ = depthFormat;
 
-    VkImageUsageFlags colorUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
-
-    colorTexture_ = std::make_unique<Texture>(ctx, extent.width, extent.height,
-        colorFormat, colorUsage, VK_IMAGE_ASPECT_COLOR_BIT);
-
-    VkImageUsageFlags depthUsage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+    // 톤매핑 패스에서 샘플링합니다.
+    TransientImageDesc colorDesc{};
+    colorDesc.extent = extent;
+    colorDesc.format = colorFormat;
+    colorDesc.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+    colorDesc.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    colorImage_ = transientPool_->declareImage(colorDesc);
+
+    // Hi-Z 피라미드를 만들 때 컴퓨트에서 샘플링합니다. (샘플링 뷰는 깊이 aspect만)
+    TransientImageDesc depthDesc{};
+    depthDesc.extent = extent;
+    depthDesc.format = depthFormat;
+    depthDesc.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+    depthDesc.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+    depthImage_ = transientPool_->declareImage(depthDesc);
+}
 
-    depthTexture_ = std::make_unique<Texture>(ctx, extent.width, extent.height,
-        depthFormat, depthUsage, VK_IMAGE_ASPECT_DEPTH_BIT);
+Texture* RenderTarget::getColorTexture() const
+{
+    return transientPool_ ? transientPool_->getTexture(colorImage_) : nullptr;
 }
 
-void RenderTarget::cleanup()
+Texture* RenderTarget::getDepthTexture() const
 {
-    colorTexture_.reset();
-    depthTexture_.reset();
+    return transientPool_ ? transientPool_->getTexture(depthImage_) : nullptr;
 }
 
 VkImageView RenderTarget::getColorView() const
 {
-    return colorTexture_ ? colorTexture_->getImageView() : VK_NULL_HANDLE;
+    Texture* texture = getColorTexture();
+    return texture ? texture->getImageView() : VK_NULL_HANDLE;
 }
 
 VkImageView RenderTarget::getDepthView() const
 {
-    return depthTexture_ ? depthTexture_->getImageView() : VK_NULL_HANDLE;
+    Texture* texture = getDepthTexture();
+    return texture ? texture->getImageView() : VK_NULL_HANDLE;
 }
 
-VkRenderingAttachmentInfo RenderTarget::getColorAttachmentInfo() const
+VkImageAspectFlags RenderTarget::getDepthAspectMask() const
+{
+    VkImageAspectFlags aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+    if (depthFormat_ == VK_FORMAT_D32_SFLOAT_S8_UINT || depthFormat_ == VK_FORMAT_D24_UNORM_S8_UINT) {
+        aspectMask |= VK_IMAGE_ASPECT_STENCIL_BIT;
+    }
+    return aspectMask;
+}
+
+VkRenderingAttachmentInfo RenderTarget::getColorAttachmentInfo(VkAttachmentLoadOp loadOp) const
 {
     VkRenderingAttachmentInfo colorAttachment{};
     colorAttachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
     colorAttachment.imageView = getColorView();
     // VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL -> VK_IMAGE_LAYOUT_ATTACHMENT_OPTIMAL_KHR
     colorAttachment.imageLayout = VK_IMAGE_LAYOUT_ATTACHMENT_OPTIMAL_KHR;
-    colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+    colorAttachment.loadOp = loadOp;
     colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
     colorAttachment.clearValue.color = { {0.0f, 0.0f, 0.0f, 1.0f} };
 
     return colorAttachment;
 }
 
-VkRenderingAttachmentInfo RenderTarget::getDepthAttachmentInfo() const
+VkRenderingAttachmentInfo RenderTarget::getDepthAttachmentInfo(VkAttachmentLoadOp loadOp) const
 {
     VkRenderingAttachmentInfo depthAttachment{};
     depthAttachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
     depthAttachment.imageView = getDepthView();
     // VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL -> VK_IMAGE_LAYOUT_ATTACHMENT_OPTIMAL_KHR
     depthAttachment.imageLayout = VK_IMAGE_LAYOUT_ATTACHMENT_OPTIMAL_KHR;
-    depthAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-    depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    depthAttachment.loadOp = loadOp;
+    // Hi-Z 생성과 레이트 패스가 얼리 패스의 깊이를 이어서 씁니다.
+    depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
     depthAttachment.clearValue.depthStencil = { 1.0f, 0 };
 
     return depthAttachment;
 }
 
-VkRenderingInfo RenderTarget::getRenderingInfo() const
+VkRenderingInfo RenderTarget::getRenderingInfo(VkAttachmentLoadOp loadOp) const
+{
+    return getRenderingInfo(loadOp, loadOp);
+}
+
+VkRenderingInfo RenderTarget::getRenderingInfo(VkAttachmentLoadOp colorLoadOp, VkAttachmentLoadOp depthLoadOp) const
 {
     static thread_local VkRenderingAttachmentInfo colorAttachment;
     static thread_local VkRenderingAttachmentInfo depthAttachment;
 
-    colorAttachment = getColorAttachmentInfo();
-    depthAttachment = getDepthAttachmentInfo();
+    colorAttachment = getColorAttachmentInfo(colorLoadOp);
+    depthAttachment = getDepthAttachmentInfo(depthLoadOp);
 
     VkRenderingInfo renderingInfo{};
     renderingInfo.sType = VK_STRUCTURE_TYPE_RENDERING_INFO;
@@ -82,4 +110,43 @@ VkRenderingInfo RenderTarget::getRenderingInfo() const
     renderingInfo.pStencilAttachment = nullptr;
 
     return renderingInfo;
+}
+
+VkRenderingInfo RenderTarget::getDepthOnlyRenderingInfo(VkAttachmentLoadOp loadOp) const
+{
+    static thread_local VkRenderingAttachmentInfo depthAttachment;
+
+    depthAttachment = getDepthAttachmentInfo(loadOp);
+
+    VkRenderingInfo renderingInfo{};
+    renderingInfo.sType = VK_STRUCTURE_TYPE_RENDERING_INFO;
+    renderingInfo.renderArea.offset = { 0, 0 };
+    renderingInfo.renderArea.extent = extent_;
+    renderingInfo.layerCount = 1;
+    renderingInfo.colorAttachmentCount = 0;
+    renderingInfo.pColorAttachments = nullptr;
+    renderingInfo.pDepthAttachment = &depthAttachment;
+    renderingInfo.pStencilAttachment = nullptr;
+
+    return renderingInfo;
+}
+
+VkCommandBufferInheritanceRenderingInfo RenderTarget::getInheritanceRenderingInfo() const
+{
+    VkCommandBufferInheritanceRenderingInfo inheritanceInfo{};
+    inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO;
+    inheritanceInfo.colorAttachmentCount = 1;
+    inheritanceInfo.pColorAttachmentFormats = &colorFormat_;
+    inheritanceInfo.depthAttachmentFormat = depthFormat_;
+    inheritanceInfo.stencilAttachmentFormat = VK_FORMAT_UNDEFINED;
+    inheritanceInfo.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+    return inheritanceInfo;
+}
+
+VkCommandBufferInheritanceRenderingInfo RenderTarget::getDepthOnlyInheritanceRenderingInfo() const
+{
+    VkCommandBufferInheritanceRenderingInfo inheritanceInfo = getInheritanceRenderingInfo();
+    inheritanceInfo.colorAttachmentCount = 0;
+    inheritanceInfo.pColorAttachmentFormats = nullptr;
+    return inheritanceInfo;
 }
\ No newline at end of file
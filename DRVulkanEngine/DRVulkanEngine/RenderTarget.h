@@ -1,6 +1,6 @@
 #pragma once
 #include <vulkan/vulkan.h>
-#include <memory>
+#include "TransientResourcePool.h"
 
 class VulkanContext;
 class Texture;
@@ -10,26 +10,40 @@ class RenderTarget
 public:
     RenderTarget() = default;
 
-    // ÷,  ̹ ϰ 
-    void initialize(VulkanContext* ctx, VkExtent2D extent, VkFormat colorFormat, VkFormat depthFormat);
-    void cleanup();
+    // ÷,  ̹ Ǯ մϴ. ̹ Ǯ build() Ŀ   ֽϴ.
+    void initialize(TransientResourcePool* transientPool, VkExtent2D extent, VkFormat colorFormat, VkFormat depthFormat);
 
     // Getter
     VkImageView getColorView() const;
     VkImageView getDepthView() const;
-    Texture* getColorTexture() const { return colorTexture_.get(); }
+    Texture* getColorTexture() const;
+    Texture* getDepthTexture() const;
+    //  ׷ ҽ  Ǯ ̹
+    TransientResourcePool::ImageId getColorImageId() const { return colorImage_; }
+    TransientResourcePool::ImageId getDepthImageId() const { return depthImage_; }
 
     VkExtent2D getExtent() const { return extent_; }
     VkFormat getColorFormat() const { return colorFormat_; }
     VkFormat getDepthFormat() const { return depthFormat_; }
-
-    VkRenderingAttachmentInfo getColorAttachmentInfo() const;
-    VkRenderingAttachmentInfo getDepthAttachmentInfo() const;
-    VkRenderingInfo getRenderingInfo() const;
+    //  ̹ 踮  aspect (ٽ ִ ̸ Բ ȯؾ մϴ)
+    VkImageAspectFlags getDepthAspectMask() const;
+
+    // LOAD:  ӿ  н ׸   ̾ ׸  (Hi-Z Ʈ н)
+    VkRenderingAttachmentInfo getColorAttachmentInfo(VkAttachmentLoadOp loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR) const;
+    VkRenderingAttachmentInfo getDepthAttachmentInfo(VkAttachmentLoadOp loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR) const;
+    VkRenderingInfo getRenderingInfo(VkAttachmentLoadOp loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR) const;
+    //  н  ÷ н: ÷  ̴ н  нϴ.
+    VkRenderingInfo getRenderingInfo(VkAttachmentLoadOp colorLoadOp, VkAttachmentLoadOp depthLoadOp) const;
+    //  н: ÷ ġƮ  ̸ ϴ.
+    VkRenderingInfo getDepthOnlyRenderingInfo(VkAttachmentLoadOp loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR) const;
+    // secondary Ŀǵ ۷  Ÿ꿡 ׸    (pColorAttachmentFormats  Ŵ)
+    VkCommandBufferInheritanceRenderingInfo getInheritanceRenderingInfo() const;
+    VkCommandBufferInheritanceRenderingInfo getDepthOnlyInheritanceRenderingInfo() const;
 
 private:
-    std::unique_ptr<Texture> colorTexture_;
-    std::unique_ptr<Texture> depthTexture_;
+    TransientResourcePool* transientPool_ = nullptr;
+    TransientResourcePool::ImageId colorImage_ = TransientResourcePool::INVALID_IMAGE;
+    TransientResourcePool::ImageId depthImage_ = TransientResourcePool::INVALID_IMAGE;
 
     VkExtent2D extent_;
 
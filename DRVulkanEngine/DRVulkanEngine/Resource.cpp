@@ -2,37 +2,23 @@
 #include "VulkanContext.h"
 #include <stdexcept>
 
-void Resource::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& bufferMemory) {
+void Resource::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, MemoryAllocation& allocation) {
     // 1.   (CreateInfo) 
     VkBufferCreateInfo bufferInfo{};
     bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
     bufferInfo.size = size; //  ũ (Ʈ )
     bufferInfo.usage = usage; //  뵵 (:  ,   )
-    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE; //  ť  ( )
+    // ǻƮ ť    ť  ϴ. (ø  ׷Ƚ ť д  )
+    context->setBufferSharing(bufferInfo);
 
     // 2.  ڵ 
     if (vkCreateBuffer(context->getDevice(), &bufferInfo, nullptr, &buffer) != VK_SUCCESS) {
         throw std::runtime_error("failed to create buffer!");
     }
 
-    // 3. ۿ ʿ ޸ 䱸 
-    VkMemoryRequirements memRequirements;
-    vkGetBufferMemoryRequirements(context->getDevice(), buffer, &memRequirements);
-
-    // 4. ޸ Ҵ (AllocateInfo) 
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size; // ʿ ޸ ũ
-    // 䱸װ Ӽ ϴ  ޸ Ÿ ãϴ.
-    allocInfo.memoryTypeIndex = context->findMemoryType(memRequirements.memoryTypeBits, properties);
-
-    // 5. GPU ޸ Ҵ
-    if (vkAllocateMemory(context->getDevice(), &allocInfo, nullptr, &bufferMemory) != VK_SUCCESS) {
-        throw std::runtime_error("failed to allocate buffer memory!");
-    }
-
-    // 6. Ҵ ޸𸮸 ۿ ε()
-    vkBindBufferMemory(context->getDevice(), buffer, bufferMemory, 0);
+    // 3. ޸ Ҵ⿡  ޾ εմϴ. (BDA Ҵ ÷״ Ҵ Ͽ ̹ پ )
+    //    HOST_VISIBLE̸ allocation.mapped  ε ּҰ ɴϴ.
+    allocation = context->getMemoryAllocator().allocateForBuffer(buffer, properties);
 }
 
 VkCommandBuffer Resource::beginSingleTimeCommands() {
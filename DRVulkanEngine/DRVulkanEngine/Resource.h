@@ -1,15 +1,26 @@
 #pragma once
 #include <vulkan/vulkan.h>
+#include "MemoryAllocator.h"
 class VulkanContext;
 class VulkanSwapChain;
+
+// 업로드 배치가 GPU에서 끝날 때까지 살아 있어야 하는 스테이징 버퍼 (UploadManager가 해제)
+struct StagingBuffer {
+	VkBuffer buffer = VK_NULL_HANDLE;
+	VkDeviceMemory memory = VK_NULL_HANDLE;
+};
+
 class Resource
 {
 public:
 	virtual void populateWriteDescriptor(VkWriteDescriptorSet& writeInfo) const = 0;
+	// UNIFORM_BUFFER_DYNAMIC으로 바인딩되는 리소스는 바인딩할 때마다 현재 오프셋을 넘겨줍니다.
+	virtual bool hasDynamicOffset() const { return false; }
+	virtual uint32_t getDynamicOffset() const { return 0; }
 	bool IsBufferInfosDirty() const { return bBufferInfosDirty_; }
 	void ClearBufferInfosDirty() { bBufferInfosDirty_ = false; }
 protected:
-	void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& bufferMemory);
+	void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, MemoryAllocation& allocation);
 
 	VkCommandBuffer beginSingleTimeCommands();
 	void endSingleTimeCommands(VkCommandBuffer commandBuffer);
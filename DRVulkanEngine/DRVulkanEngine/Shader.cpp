@@ -2,6 +2,7 @@
 #include <fstream>
 #include <stdexcept>
 #include <iostream>
+#include <algorithm>
 #include "VulkanContext.h"
 #include "Vertex.h"
 
@@ -49,6 +50,12 @@ void Shader::initialize(const VulkanContext* inContext, const std::string& inSha
             const auto* pBinding = pSet->bindings[i];
             layoutBindingInfo.bindingInfo.binding = pBinding->binding;
             layoutBindingInfo.bindingInfo.descriptorType = static_cast<VkDescriptorType>(pBinding->descriptor_type);
+            // 프레임 유니폼 링에서 매 프레임 새 위치에 쓰는 UBO는 동적 오프셋으로 바인딩합니다.
+            // (SPIR-V에는 동적 여부가 없으므로 이름으로 정합니다. 리소스 쪽은 FrameUniformAllocator)
+            if (layoutBindingInfo.bindingInfo.descriptorType == VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER &&
+                IsFrameUniform(layoutBindingInfo.resourceName)) {
+                layoutBindingInfo.bindingInfo.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+            }
             layoutBindingInfo.bindingInfo.descriptorCount = pBinding->count;
             layoutBindingInfo.bindingInfo.stageFlags = static_cast<VkShaderStageFlags>(reflectModule.shader_stage);
 
@@ -84,7 +91,21 @@ void Shader::initialize(const VulkanContext* inContext, const std::string& inSha
         auto attributeDescriptions = Vertex::getAttributeDescriptions();
 
         // Shader Ŭ������ ���������� ���� �� ����� �� �ֵ��� ���� ��� ������ �����մϴ�.
-        inputAttributes_.assign(attributeDescriptions.begin(), attributeDescriptions.end());
+        // 포맷과 offset은 Vertex 구조체에서 가져오고, location은 셰이더가 실제로 선언한 입력만 남깁니다.
+        // 깊이 프리패스처럼 위치만 읽는 셰이더는 나머지 어트리뷰트를 fetch하지 않습니다.
+        uint32_t varCount = 0;
+        spvReflectEnumerateInputVariables(&reflectModule, &varCount, nullptr);
+        std::vector<SpvReflectInterfaceVariable*> inputs(varCount);
+        spvReflectEnumerateInputVariables(&reflectModule, &varCount, inputs.data());
+
+        for (const VkVertexInputAttributeDescription& attribute : attributeDescriptions) {
+            bool used = std::any_of(inputs.begin(), inputs.end(), [&](const SpvReflectInterfaceVariable* pVar) {
+                return (pVar->decoration_flags & SPV_REFLECT_DECORATION_BUILT_IN) == 0 && pVar->location == attribute.location;
+            });
+            if (used) {
+                inputAttributes_.push_back(attribute);
+            }
+        }
     }
 
     // --- 6. Push Constant ���� ���� ---
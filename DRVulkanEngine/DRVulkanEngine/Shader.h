@@ -14,6 +14,9 @@ struct LayoutBindingInfo
 class VulkanContext;
 class Shader {
 public:
+    // 프레임 유니폼 링에 두는 UBO 이름 (셰이더 변수 이름 = VulkanApp의 리소스 이름)
+    static bool IsFrameUniform(const std::string& resourceName) { return resourceName == "scene"; }
+
 	void initialize(const VulkanContext* inContext, const std::string& inShaderPath);
     void destroy(VkDevice device);
 private:
@@ -0,0 +1,113 @@
+#include "SoftwareOcclusionCuller.h"
+#include <algorithm>
+
+SoftwareOcclusionCuller::~SoftwareOcclusionCuller()
+{
+    cleanup();
+}
+
+void SoftwareOcclusionCuller::initialize(uint32_t width, uint32_t height, uint32_t workerCount)
+{
+    buffer_.initialize(width, height);
+
+    // 타일 행보다 워커가 많으면 놀게 되므로 제한합니다.
+    workerCount = std::clamp(workerCount, 1u, buffer_.getTileRows());
+    workerCount_ = workerCount;
+    rasterBarrier_ = std::make_unique<std::barrier<>>(static_cast<std::ptrdiff_t>(workerCount_));
+
+    stopRequested_ = false;
+    for (uint32_t i = 0; i < workerCount_; ++i) {
+        workers_.emplace_back(&SoftwareOcclusionCuller::workerLoop, this, i);
+    }
+}
+
+void SoftwareOcclusionCuller::cleanup()
+{
+    if (workers_.empty()) {
+        return;
+    }
+
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopRequested_ = true;
+    }
+    jobCondition_.notify_all();
+    for (std::thread& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    workers_.clear();
+    rasterBarrier_.reset();
+}
+
+void SoftwareOcclusionCuller::kick(const glm::mat4& viewProj, const std::vector<OccluderDesc>& occluders, const std::vector<OccludeeBounds>& occludees)
+{
+    wait();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        viewProj_ = viewProj;
+        occluders_ = occluders;
+        occludees_ = occludees;
+        visibility_.assign(occludees_.size(), 1);
+        pendingWorkers_ = workerCount_;
+        jobId_++;
+    }
+    jobCondition_.notify_all();
+}
+
+const std::vector<uint8_t>& SoftwareOcclusionCuller::wait()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    doneCondition_.wait(lock, [this] { return pendingWorkers_ == 0; });
+    return visibility_;
+}
+
+void SoftwareOcclusionCuller::workerLoop(uint32_t workerIndex)
+{
+    const uint32_t workerCount = workerCount_;
+    const uint32_t tileRows = buffer_.getTileRows();
+    const uint32_t rowBegin = tileRows * workerIndex / workerCount;
+    const uint32_t rowEnd = tileRows * (workerIndex + 1) / workerCount;
+
+    std::vector<glm::vec4> clipScratch;
+    uint64_t lastJobId = 0;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            jobCondition_.wait(lock, [this, lastJobId] { return stopRequested_ || jobId_ != lastJobId; });
+            if (stopRequested_) {
+                return;
+            }
+            lastJobId = jobId_;
+        }
+
+        // 1) 자기 행 구간만 지우고 그립니다. (정점 변환은 워커마다 하지만 가리개는 소수라 비용이 작습니다)
+        buffer_.clearRows(rowBegin, rowEnd);
+        for (const OccluderDesc& occluder : occluders_) {
+            buffer_.renderOccluderRows(occluder.positions, occluder.stride, occluder.vertexCount,
+                occluder.indices, occluder.indexCount, viewProj_ * occluder.world,
+                rowBegin, rowEnd, clipScratch);
+        }
+
+        // 2) 모든 행이 끝나야 검사할 수 있습니다.
+        rasterBarrier_->arrive_and_wait();
+
+        size_t occludeeCount = occludees_.size();
+        size_t begin = occludeeCount * workerIndex / workerCount;
+        size_t end = occludeeCount * (workerIndex + 1) / workerCount;
+        for (size_t i = begin; i < end; ++i) {
+            visibility_[i] = buffer_.testAABB(occludees_[i].boundsMin, occludees_[i].boundsMax, viewProj_) ? 1 : 0;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--pendingWorkers_ == 0) {
+                doneCondition_.notify_all();
+            }
+        }
+    }
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <barrier>
+#include <memory>
+#include <glm/glm.hpp>
+#include "MaskedOcclusionBuffer.h"
+
+// 가리개 메시 하나 (위치 배열은 호출자가 작업이 끝날 때까지 유지해야 합니다)
+struct OccluderDesc {
+    const float* positions = nullptr;
+    uint32_t stride = sizeof(glm::vec3);
+    size_t vertexCount = 0;
+    const uint32_t* indices = nullptr;
+    size_t indexCount = 0;
+    glm::mat4 world = glm::mat4(1.0f);
+};
+
+struct OccludeeBounds {
+    glm::vec3 boundsMin = glm::vec3(0.0f);
+    glm::vec3 boundsMax = glm::vec3(0.0f);
+};
+
+// GPU 컴퓨트 컬링을 쓸 수 없을 때의 CPU 가림 컬링
+//  1) kick()이 가리개/피가림체를 복사하고 워커를 깨우면 렌더 스레드는 바로 돌아가서
+//     이전 프레임 GPU 작업(펜스 대기)과 겹쳐 실행되고
+//  2) 워커마다 타일 행 구간을 나눠 가리개를 래스터라이즈한 뒤 (쓰기 구간이 겹치지 않음)
+//  3) 모두 끝나면 피가림체를 나눠서 검사하고
+//  4) wait()가 피가림체별 가시성(1 = 보임)을 돌려줍니다.
+class SoftwareOcclusionCuller
+{
+public:
+    static constexpr uint32_t DEFAULT_WIDTH = 256;
+    static constexpr uint32_t DEFAULT_HEIGHT = 128;
+
+    SoftwareOcclusionCuller() = default;
+    ~SoftwareOcclusionCuller();
+
+    SoftwareOcclusionCuller(const SoftwareOcclusionCuller&) = delete;
+    SoftwareOcclusionCuller& operator=(const SoftwareOcclusionCuller&) = delete;
+
+    void initialize(uint32_t width = DEFAULT_WIDTH, uint32_t height = DEFAULT_HEIGHT, uint32_t workerCount = 2);
+    void cleanup();
+
+    // 이전 작업이 남아 있으면 끝날 때까지 기다린 뒤 시작합니다.
+    void kick(const glm::mat4& viewProj, const std::vector<OccluderDesc>& occluders, const std::vector<OccludeeBounds>& occludees);
+    const std::vector<uint8_t>& wait();
+
+    bool isInitialized() const { return !workers_.empty(); }
+    const MaskedOcclusionBuffer& getBuffer() const { return buffer_; }
+
+private:
+    void workerLoop(uint32_t workerIndex);
+
+    MaskedOcclusionBuffer buffer_;
+
+    std::vector<std::thread> workers_;
+    uint32_t workerCount_ = 0;
+    std::unique_ptr<std::barrier<>> rasterBarrier_;
+    std::mutex mutex_;
+    std::condition_variable jobCondition_;
+    std::condition_variable doneCondition_;
+    uint64_t jobId_ = 0;
+    uint32_t pendingWorkers_ = 0;
+    bool stopRequested_ = false;
+
+    // 작업 중에는 워커만 읽습니다.
+    glm::mat4 viewProj_ = glm::mat4(1.0f);
+    std::vector<OccluderDesc> occluders_;
+    std::vector<OccludeeBounds> occludees_;
+    std::vector<uint8_t> visibility_;
+};
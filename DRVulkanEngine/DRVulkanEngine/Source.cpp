@@ -1,9 +1,32 @@
 #include "VulkanApp.h"
+#include "Benchmarks.h"
 #include <iostream>
 #include <stdexcept>
+#include <string>
+
+int main(int argc, char** argv) {
+    bool softwareOcclusion = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--bench-culling") {
+            return RunFrustumCullingBenchmark();
+        }
+        if (std::string(argv[i]) == "--bench-render-queue") {
+            return RunRenderQueueBenchmark();
+        }
+        if (std::string(argv[i]) == "--test-occlusion") {
+            return RunOcclusionBufferTest();
+        }
+        if (std::string(argv[i]) == "--bench-bones") {
+            return RunBoneBackendBenchmark();
+        }
+        // 앱 실행 옵션: CPU 컬링 경로로 시작
+        if (std::string(argv[i]) == "--software-occlusion") {
+            softwareOcclusion = true;
+        }
+    }
 
-int main() {
     VulkanApp app;
+    app.setSoftwareOcclusionEnabled(softwareOcclusion);
 
     try {
         app.run();
@@ -13,4 +36,4 @@ int main() {
     }
 
     return EXIT_SUCCESS;
-}
\ No newline at end of file
+}
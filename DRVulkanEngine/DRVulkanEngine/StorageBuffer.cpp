@@ -3,17 +3,18 @@
 #include <stdexcept>
 #include <cstring>
 
-StorageBuffer::StorageBuffer(const VulkanContext* ctx, VkDeviceSize size)
+StorageBuffer::StorageBuffer(const VulkanContext* ctx, VkDeviceSize size, VkBufferUsageFlags additionalUsage)
     : context_(ctx), bufferSize_(size) {
+    context = ctx; // Resource::createBuffer 
 
     // 1.   
     // USAGE STORAGE_BUFFER_BIT SHADER_DEVICE_ADDRESS_BIT ߰մϴ.
     // ̸  Ϲ ũ İ     մϴ.
     createBuffer(bufferSize_,
-        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT,
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT | additionalUsage,
         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
         buffer_,
-        bufferMemory_);
+        allocation_);
 
     // 2. ũ  
     bufferInfo_.buffer = buffer_;
@@ -31,16 +32,21 @@ StorageBuffer::~StorageBuffer() {
     if (buffer_ != VK_NULL_HANDLE) {
         vkDestroyBuffer(context_->getDevice(), buffer_, nullptr);
     }
-    if (bufferMemory_ != VK_NULL_HANDLE) {
-        vkFreeMemory(context_->getDevice(), bufferMemory_, nullptr);
-    }
+    context_->getMemoryAllocator().free(allocation_);
 }
 
 void StorageBuffer::update(const void* data) {
-    void* mappedMemory;
-    vkMapMemory(context_->getDevice(), bufferMemory_, 0, bufferSize_, 0, &mappedMemory);
-    memcpy(mappedMemory, data, static_cast<size_t>(bufferSize_));
-    vkUnmapMemory(context_->getDevice(), bufferMemory_);
+    memcpy(allocation_.mapped, data, static_cast<size_t>(bufferSize_));
+}
+
+void StorageBuffer::update(const void* data, VkDeviceSize size, VkDeviceSize offset) {
+    if (size == 0) {
+        return;
+    }
+    if (offset + size > bufferSize_) {
+        throw std::runtime_error("storage buffer update out of range!");
+    }
+    memcpy(static_cast<char*>(allocation_.mapped) + offset, data, static_cast<size_t>(size));
 }
 
 void StorageBuffer::populateWriteDescriptor(VkWriteDescriptorSet& writeInfo) const {
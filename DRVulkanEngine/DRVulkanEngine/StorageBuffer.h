@@ -7,10 +7,13 @@ class VulkanContext;
 class StorageBuffer : public Resource {
 public:
     // Ϲ SSBO   BDA()  Ȱȭ
-    StorageBuffer(const VulkanContext* context, VkDeviceSize size);
+    // additionalUsage:  ο   ε   ߰ (: VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT)
+    StorageBuffer(const VulkanContext* context, VkDeviceSize size, VkBufferUsageFlags additionalUsage = 0);
     ~StorageBuffer();
 
     void update(const void* data);
+    //  պκи  (   ٲ νϽ  )
+    void update(const void* data, VkDeviceSize size, VkDeviceSize offset = 0);
 
     //  : ̴    ִ 64Ʈ ּ ȯ
     VkDeviceAddress getDeviceAddress() const { return deviceAddress_; }
@@ -20,7 +23,7 @@ public:
 
 private:
     VkBuffer buffer_ = VK_NULL_HANDLE;
-    VkDeviceMemory bufferMemory_ = VK_NULL_HANDLE;
+    MemoryAllocation allocation_;
     VkDeviceSize bufferSize_ = 0;
     VkDeviceAddress deviceAddress_ = 0; // 64Ʈ GPU ּ 
 
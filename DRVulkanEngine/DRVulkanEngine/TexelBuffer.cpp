@@ -5,13 +5,14 @@
 
 TexelBuffer::TexelBuffer(const VulkanContext* ctx, VkDeviceSize size, VkFormat format)
     : context_(ctx), bufferSize_(size), format_(format) {
+    context = ctx; // Resource::createBuffer 
 
     // 1.   (USAGE TEXEL_BUFFER_BIT ϴ)
     createBuffer(bufferSize_,
         VK_BUFFER_USAGE_UNIFORM_TEXEL_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
         buffer_,
-        bufferMemory_);
+        allocation_);
 
     // 2. VkBufferView  (̰ TMU ϵ Ǵ Դϴ)
     VkBufferViewCreateInfo viewInfo{};
@@ -31,7 +32,7 @@ TexelBuffer::~TexelBuffer() {
         vkDestroyBufferView(context_->getDevice(), bufferView_, nullptr);
     }
     vkDestroyBuffer(context_->getDevice(), buffer_, nullptr);
-    vkFreeMemory(context_->getDevice(), bufferMemory_, nullptr);
+    context_->getMemoryAllocator().free(allocation_);
 }
 
 void TexelBuffer::populateWriteDescriptor(VkWriteDescriptorSet& writeInfo) const {
@@ -46,8 +47,5 @@ void TexelBuffer::populateWriteDescriptor(VkWriteDescriptorSet& writeInfo) const
 }
 
 void TexelBuffer::update(const void* data) {
-    void* mappedMemory;
-    vkMapMemory(context_->getDevice(), bufferMemory_, 0, bufferSize_, 0, &mappedMemory);
-    memcpy(mappedMemory, data, static_cast<size_t>(bufferSize_));
-    vkUnmapMemory(context_->getDevice(), bufferMemory_);
+    memcpy(allocation_.mapped, data, static_cast<size_t>(bufferSize_));
 }
\ No newline at end of file
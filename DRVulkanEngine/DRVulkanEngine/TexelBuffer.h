@@ -13,7 +13,7 @@ public:
 
 private:
     VkBuffer buffer_ = VK_NULL_HANDLE;
-    VkDeviceMemory bufferMemory_ = VK_NULL_HANDLE;
+    MemoryAllocation allocation_;
     VkBufferView bufferView_ = VK_NULL_HANDLE; // TMU θ  ٽ ü
     VkDeviceSize bufferSize_ = 0;
     VkFormat format_;
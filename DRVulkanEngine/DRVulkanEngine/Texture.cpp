@@ -1,5 +1,6 @@
 #include "Texture.h"
 #include "VulkanContext.h"
+#include "UploadManager.h"
 #include "GlobalData.h"
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
@@ -146,6 +147,42 @@ Texture::Texture(const VulkanContext* context, const std::string& filepath) {
     initialize(filepath);
 }
 
+Texture::Texture(const VulkanContext* context, const ImageData& image, UploadPriority priority) {
+    this->context = context;
+    initialize(image, priority);
+}
+
+bool Texture::LoadImageData(const std::string& filepath, ImageData& outImage)
+{
+    int texWidth, texHeight, texChannels;
+    stbi_uc* pixels = stbi_load(filepath.c_str(), &texWidth, &texHeight, &texChannels, STBI_rgb_alpha);
+    if (!pixels) {
+        return false;
+    }
+
+    outImage.width = static_cast<uint32_t>(texWidth);
+    outImage.height = static_cast<uint32_t>(texHeight);
+    outImage.pixels.assign(pixels, pixels + static_cast<size_t>(texWidth) * texHeight * 4);
+    stbi_image_free(pixels);
+    return true;
+}
+
+bool Texture::DecodeImageData(const std::vector<unsigned char>& encodedBytes, ImageData& outImage)
+{
+    int texWidth, texHeight, texChannels;
+    stbi_uc* pixels = stbi_load_from_memory(encodedBytes.data(), static_cast<int>(encodedBytes.size()),
+        &texWidth, &texHeight, &texChannels, STBI_rgb_alpha);
+    if (!pixels) {
+        return false;
+    }
+
+    outImage.width = static_cast<uint32_t>(texWidth);
+    outImage.height = static_cast<uint32_t>(texHeight);
+    outImage.pixels.assign(pixels, pixels + static_cast<size_t>(texWidth) * texHeight * 4);
+    stbi_image_free(pixels);
+    return true;
+}
+
 Texture::Texture(const VulkanContext* context, uint32_t width, uint32_t height,
     VkFormat format, VkImageUsageFlags usage, VkImageAspectFlags aspectFlags)
 {
@@ -153,7 +190,7 @@ Texture::Texture(const VulkanContext* context, uint32_t width, uint32_t height,
     this->format_ = format;
 
     createImage(width, height, format, VK_IMAGE_TILING_OPTIMAL, usage,
-        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, texture_, textureMemory_);
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, texture_, textureAllocation_);
 
 
     textureView_ = createImageView(texture_, format, aspectFlags);
@@ -178,41 +215,43 @@ Texture::Texture(const VulkanContext* context, uint32_t width, uint32_t height,
     imageInfo_.sampler = textureSampler_;
 }
 
+Texture::Texture(const VulkanContext* context, VkImage image, VkFormat format, VkImageAspectFlags aspectFlags)
+{
+    this->context = context;
+    this->format_ = format;
+    texture_ = image;
+    ownsImage_ = false;
+
+    // 레이아웃은 이미지를 쓰는 렌더 그래프가 첫 사용에서 UNDEFINED부터 전환합니다.
+    textureView_ = createImageView(texture_, format, aspectFlags);
+    createTextureSampler();
+
+    // VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL -> VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL_KHR
+    imageInfo_.imageLayout = VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL_KHR;
+    imageInfo_.imageView = textureView_;
+    imageInfo_.sampler = textureSampler_;
+}
+
 Texture::~Texture() {
     vkDestroyImageView(context->getDevice(), textureView_, nullptr);
-    vkDestroyImage(context->getDevice(), texture_, nullptr);
-    vkFreeMemory(context->getDevice(), textureMemory_, nullptr);
+    if (ownsImage_) {
+        vkDestroyImage(context->getDevice(), texture_, nullptr);
+        context->getMemoryAllocator().free(textureAllocation_);
+    }
 	vkDestroySampler(context->getDevice(), textureSampler_, nullptr);
 }
 void Texture::initialize(const std::string& filepath) {
-    int texWidth, texHeight, texChannels;
-    // stbi_load �Լ��� �̹��� ������ �ҷ��ɴϴ�.
-    // STBI_rgb_alpha �÷��״� �̹����� ������ RGBA(4ä��) �������� �ε��մϴ�.
-    stbi_uc* pixels = stbi_load(filepath.c_str(), &texWidth, &texHeight, &texChannels, STBI_rgb_alpha);
-    VkDeviceSize imageSize = texWidth * texHeight * 4;
-
-    if (!pixels) {
+    ImageData image;
+    if (!LoadImageData(filepath, image)) {
         throw std::runtime_error("failed to load texture image!");
     }
+    initialize(image);
+}
 
-    VkBuffer stagingBuffer;
-    VkDeviceMemory stagingBufferMemory;
-
-    // CPU���� ���� �����ϰ�(HOST_VISIBLE), ������ ����(TRANSFER_SRC)�� �� ���۸� �����մϴ�.
-    createBuffer(imageSize,
-        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-        stagingBuffer,
-        stagingBufferMemory);
-
-    // Staging Buffer�� �޸𸮸� �����Ͽ� CPU�� �ȼ� �����͸� �����մϴ�.
-    void* data;
-    vkMapMemory(context->getDevice(), stagingBufferMemory, 0, imageSize, 0, &data);
-    memcpy(data, pixels, static_cast<size_t>(imageSize));
-    vkUnmapMemory(context->getDevice(), stagingBufferMemory);
-
-    // ���� �ȼ� �����ʹ� ���� CPU �޸𸮿��� �����ص� �˴ϴ�.
-    stbi_image_free(pixels);
+void Texture::initialize(const ImageData& image, UploadPriority priority) {
+    uint32_t texWidth = image.width;
+    uint32_t texHeight = image.height;
+    VkDeviceSize imageSize = static_cast<VkDeviceSize>(texWidth) * texHeight * 4;
 
     format_ = VK_FORMAT_R8G8B8A8_SRGB;
     currentLayout_ = VK_IMAGE_LAYOUT_UNDEFINED;
@@ -224,24 +263,22 @@ void Texture::initialize(const std::string& filepath) {
         VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, // ���� ��� + ���̴� ���ø���
         VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, // �ְ��� ������ ���� GPU ���� �޸𸮿� ����
         texture_,
-        textureMemory_);
-
-    // (1) UNDEFINED -> TRANSFER_DST_OPTIMAL
-    transitionImageLayout(texture_, VK_FORMAT_R8G8B8A8_SRGB, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-
-    // (2) Staging Buffer���� ���� �̹����� �ȼ� ������ ����
-    copyBufferToImage(stagingBuffer, texture_, static_cast<uint32_t>(texWidth), static_cast<uint32_t>(texHeight));
+        textureAllocation_);
 
-    // (3) TRANSFER_DST_OPTIMAL -> SHADER_READ_ONLY_OPTIMAL 
+    // UNDEFINED -> TRANSFER_DST -> (복사) -> READ_ONLY 를 업로드 매니저가 스테이징 링을 거쳐 배치에 기록합니다.
+    // 스트리밍 우선순위면 프레임 예산에 맞춰 이후 프레임에 기록될 수 있습니다.
+    VkBufferImageCopy region{};
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.mipLevel = 0;
+    region.imageSubresource.baseArrayLayer = 0;
+    region.imageSubresource.layerCount = 1;
+    region.imageExtent = { texWidth, texHeight, 1 };
 
-    // VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL -> VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL_KHR
-    transitionImageLayout(texture_, VK_FORMAT_R8G8B8A8_SRGB, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL_KHR);
-    // VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL -> VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL_KHR
+    VkImageSubresourceRange range{ VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+    uploadTicket_ = context->getUploadManager().uploadImage(texture_, range, { region }, VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL_KHR,
+        image.pixels.data(), imageSize, priority);
     currentLayout_ = VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL_KHR;
 
-    vkDestroyBuffer(context->getDevice(), stagingBuffer, nullptr);
-    vkFreeMemory(context->getDevice(), stagingBufferMemory, nullptr);
-
     textureView_ = createImageView(texture_, VK_FORMAT_R8G8B8A8_SRGB);
 
     createTextureSampler();
@@ -252,7 +289,7 @@ void Texture::initialize(const std::string& filepath) {
 }
 
 
-void Texture::createImage(uint32_t width, uint32_t height, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, VkMemoryPropertyFlags properties, VkImage& image, VkDeviceMemory& imageMemory) {
+void Texture::createImage(uint32_t width, uint32_t height, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, VkMemoryPropertyFlags properties, VkImage& image, MemoryAllocation& imageAllocation) {
 
     VkImageCreateInfo imageInfo{};
     imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
@@ -273,19 +310,7 @@ void Texture::createImage(uint32_t width, uint32_t height, VkFormat format, VkIm
         throw std::runtime_error("failed to create image!");
     }
 
-    VkMemoryRequirements memRequirements;
-    vkGetImageMemoryRequirements(context->getDevice(), image, &memRequirements);
-
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = context->findMemoryType(memRequirements.memoryTypeBits, properties);
-
-    if (vkAllocateMemory(context->getDevice(), &allocInfo, nullptr, &imageMemory) != VK_SUCCESS) {
-        throw std::runtime_error("failed to allocate image memory!");
-    }
-
-    vkBindImageMemory(context->getDevice(), image, imageMemory, 0);
+    imageAllocation = context->getMemoryAllocator().allocateForImage(image, properties);
 }
 
 void Texture::transitionImageLayout(VkImage image, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout) {
@@ -335,34 +360,6 @@ void Texture::transitionImageLayout(VkImage image, VkFormat format, VkImageLayou
     endSingleTimeCommands(commandBuffer);
 }
 
-void Texture::copyBufferToImage(VkBuffer buffer, VkImage image, uint32_t width, uint32_t height) {
-    VkCommandBuffer commandBuffer = beginSingleTimeCommands();
-
-    // 2. ������ ����(Region)�� �����մϴ�.
-    VkBufferImageCopy region{};
-    region.bufferOffset = 0;
-    region.bufferRowLength = 0;
-    region.bufferImageHeight = 0;
-
-    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    region.imageSubresource.mipLevel = 0;
-    region.imageSubresource.baseArrayLayer = 0;
-    region.imageSubresource.layerCount = 1;
-
-    region.imageOffset = { 0, 0, 0 };
-    region.imageExtent = { width, height, 1 };
-
-    vkCmdCopyBufferToImage(
-        commandBuffer,
-        buffer,
-        image,
-        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-        1,
-        &region
-    );
-
-    endSingleTimeCommands(commandBuffer);
-}
 
 
 
@@ -1,12 +1,26 @@
 #pragma once
 #include "Resource.h"
+#include "UploadManager.h"
 #include <string>
+#include <vector>
+
+// 디스크에서 읽어 RGBA8로 디코딩까지 끝난 픽셀 데이터 (Vulkan 객체가 없으므로 워커 스레드에서 생성 가능)
+struct ImageData {
+	uint32_t width = 0;
+	uint32_t height = 0;
+	std::vector<unsigned char> pixels;
+};
+
 class Texture : public Resource
 {
 public:
 	Texture(const class VulkanContext* context, const std::string& filepath);
+	// 복사는 업로드 매니저에 요청만 합니다. (대기 없음, 완료는 업로드 매니저의 요청 번호로 확인)
+	Texture(const class VulkanContext* context, const ImageData& image, UploadPriority priority = UploadPriority::Immediate);
 	Texture(const class VulkanContext* context, uint32_t width, uint32_t height,
 		VkFormat format, VkImageUsageFlags usage, VkImageAspectFlags aspectFlags = VK_IMAGE_ASPECT_COLOR_BIT);
+	// 다른 곳(TransientResourcePool)이 만들고 메모리를 바인딩한 이미지에 뷰와 샘플러만 붙입니다. 이미지와 메모리는 해제하지 않습니다.
+	Texture(const class VulkanContext* context, VkImage image, VkFormat format, VkImageAspectFlags aspectFlags);
 	~Texture();
 
 	// Getter 함수들
@@ -18,23 +32,35 @@ public:
 	void transitionLayout_Cmd(VkCommandBuffer commandBuffer, VkImageLayout newLayout);
 
 	VkImageLayout getImageLayout() const { return imageInfo_.imageLayout; }
+
+	// TextureCache에 등록될 때 붙는 원본 파일의 내용 해시. 캐시를 거치지 않은 텍스처는 0
+	uint64_t getContentHash() const { return contentHash_; }
+	void setContentHash(uint64_t contentHash) { contentHash_ = contentHash; }
+	// 내용 복사를 요청한 업로드 번호. 업로드 매니저를 거치지 않은 텍스처는 INVALID_UPLOAD_TICKET
+	UploadTicket getUploadTicket() const { return uploadTicket_; }
+
+	static bool LoadImageData(const std::string& filepath, ImageData& outImage);
+	static bool DecodeImageData(const std::vector<unsigned char>& encodedBytes, ImageData& outImage);
 private:
 	void initialize(const std::string& filepath);
-	void createImage(uint32_t width, uint32_t height, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, VkMemoryPropertyFlags properties, VkImage& image, VkDeviceMemory& imageMemory);
+	void initialize(const ImageData& image, UploadPriority priority = UploadPriority::Immediate);
+	void createImage(uint32_t width, uint32_t height, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, VkMemoryPropertyFlags properties, VkImage& image, MemoryAllocation& imageAllocation);
 	void transitionImageLayout(VkImage image, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout);
-	void copyBufferToImage(VkBuffer buffer, VkImage image, uint32_t width, uint32_t height);
 
 	VkImageView createImageView(VkImage image, VkFormat format, VkImageAspectFlags aspectFlags = VK_IMAGE_ASPECT_COLOR_BIT);
 	void createTextureSampler();
 private:
 	VkImage texture_;
-	VkDeviceMemory textureMemory_;
+	MemoryAllocation textureAllocation_;
 	VkImageView textureView_;
 	VkSampler textureSampler_;
 
 	mutable VkDescriptorImageInfo imageInfo_;
 
 	VkImageLayout currentLayout_ = VK_IMAGE_LAYOUT_UNDEFINED;
+	bool ownsImage_ = true;
 	VkFormat format_;
+	uint64_t contentHash_ = 0;
+	UploadTicket uploadTicket_ = INVALID_UPLOAD_TICKET;
 };
 
@@ -8,7 +8,28 @@ void TextureArray::addDefaultTexture(Texture* inTex)
 
 int TextureArray::AddTexture(Texture* inTex)
 {
+	// 캐시를 거치지 않은 텍스처(해시 0)는 중복 제거 없이 새 슬롯을 받습니다.
+	const uint64_t contentHash = inTex->getContentHash();
+	if (contentHash != 0) {
+		auto it = textureIndices_.find(contentHash);
+		if (it != textureIndices_.end()) {
+			// 같은 내용이 해제된 뒤 다시 로드됐을 수 있으므로 슬롯을 지금 텍스처로 갱신합니다.
+			const int index = it->second;
+			const VkDescriptorImageInfo imageInfo = inTex->getImageInfo();
+			VkDescriptorImageInfo& slot = imageInfos_[index];
+			if (slot.imageView != imageInfo.imageView || slot.sampler != imageInfo.sampler || slot.imageLayout != imageInfo.imageLayout) {
+				slot = imageInfo;
+				bBufferInfosDirty_ = true;
+			}
+			textures_[index] = inTex;
+			return index;
+		}
+	}
+
 	int retIndex = textures_.size();
+	if (contentHash != 0) {
+		textureIndices_[contentHash] = retIndex;
+	}
 	textures_.push_back(inTex);
 	imageInfos_.push_back(inTex->getImageInfo());
 	bBufferInfosDirty_ = true;
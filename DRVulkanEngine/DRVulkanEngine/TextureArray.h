@@ -3,6 +3,7 @@
 #include "Texture.h"
 #include "Resource.h"
 #include <memory>
+#include <unordered_map>
 // TODO. ҽ ӹް ϴ° ´ ٽ ѹ غ
 // populateWriteDescriptor ޼   ӹ
 class TextureArray : public Resource
@@ -16,6 +17,9 @@ public:
 private:
 	std::vector<Texture*> textures_;
 	std::vector<VkDescriptorImageInfo> imageInfos_;
+	// ̹ ϵ ؽó  ε帮 ε ݴϴ.
+	// Ű TextureCache  ؽԴϴ. ͸ Ű   ؽó ּҸ  ؽó     ޽ϴ.
+	std::unordered_map<uint64_t, int> textureIndices_;
 
 	Texture* defaultTexture_;
 
@@ -0,0 +1,107 @@
+#include "TextureCache.h"
+#include "Texture.h"
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+std::mutex TextureCache::mutex_;
+std::unordered_map<std::string, uint64_t> TextureCache::pathToHash_;
+std::unordered_map<uint64_t, std::weak_ptr<Texture>> TextureCache::textures_;
+
+std::shared_ptr<Texture> TextureCache::Load(const VulkanContext* context, const std::string& path)
+{
+    if (std::shared_ptr<Texture> cached = Find(path)) {
+        return cached;
+    }
+
+    // 경로는 다르지만 내용이 같은 파일(복사된 아틀라스 등)도 하나로 합칩니다.
+    std::vector<unsigned char> bytes;
+    if (!ReadFileBytes(path, bytes)) {
+        throw std::runtime_error("failed to load texture image!");
+    }
+    uint64_t contentHash = HashBytes(bytes.data(), bytes.size());
+    if (std::shared_ptr<Texture> cached = FindByHash(contentHash)) {
+        Insert(path, contentHash, cached);
+        return cached;
+    }
+
+    ImageData image;
+    if (!Texture::DecodeImageData(bytes, image)) {
+        throw std::runtime_error("failed to load texture image!");
+    }
+    auto texture = std::make_shared<Texture>(context, image);
+    Insert(path, contentHash, texture);
+    return texture;
+}
+
+std::shared_ptr<Texture> TextureCache::Find(const std::string& path)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto pathIt = pathToHash_.find(NormalizePath(path));
+    if (pathIt == pathToHash_.end()) {
+        return nullptr;
+    }
+    auto textureIt = textures_.find(pathIt->second);
+    if (textureIt == textures_.end()) {
+        return nullptr;
+    }
+    std::shared_ptr<Texture> texture = textureIt->second.lock();
+    if (!texture) {
+        textures_.erase(textureIt);
+    }
+    return texture;
+}
+
+std::shared_ptr<Texture> TextureCache::FindByHash(uint64_t contentHash)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto textureIt = textures_.find(contentHash);
+    if (textureIt == textures_.end()) {
+        return nullptr;
+    }
+    std::shared_ptr<Texture> texture = textureIt->second.lock();
+    if (!texture) {
+        textures_.erase(textureIt);
+    }
+    return texture;
+}
+
+void TextureCache::Insert(const std::string& path, uint64_t contentHash, const std::shared_ptr<Texture>& texture)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    pathToHash_[NormalizePath(path)] = contentHash;
+    textures_[contentHash] = texture;
+    // 이미 등록된 텍스처를 다른 경로로 다시 넣는 경우에는 건드리지 않습니다. (메인 스레드가 읽는 중일 수 있음)
+    if (texture->getContentHash() != contentHash) {
+        texture->setContentHash(contentHash);
+    }
+}
+
+bool TextureCache::ReadFileBytes(const std::string& path, std::vector<unsigned char>& outBytes)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::streamsize size = file.tellg();
+    file.seekg(0, std::ios::beg);
+    outBytes.resize(static_cast<size_t>(size));
+    return size == 0 || file.read(reinterpret_cast<char*>(outBytes.data()), size).good();
+}
+
+uint64_t TextureCache::HashBytes(const void* data, size_t size)
+{
+    // FNV-1a 64bit
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+std::string TextureCache::NormalizePath(const std::string& path)
+{
+    return std::filesystem::path(path).lexically_normal().generic_string();
+}
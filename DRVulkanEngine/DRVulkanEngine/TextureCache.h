@@ -0,0 +1,35 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+#include <unordered_map>
+
+class Texture;
+class VulkanContext;
+
+// 경로 + 내용 해시 -> weak_ptr<Texture> 캐시
+// 같은 파일(또는 다른 경로에 있는 동일한 내용)을 여러 Model/Material이 참조하면 한 번만 디코딩/업로드합니다.
+// weak_ptr만 들고 있으므로 마지막 참조가 사라지면 텍스처는 정상적으로 해제됩니다.
+// 워커 스레드에서도 조회하므로 내부 상태는 mutex_로 보호합니다.
+class TextureCache
+{
+public:
+    // 동기 로드: 캐시에 살아있는 텍스처가 있으면 그대로 반환하고, 없으면 로드 후 등록합니다.
+    static std::shared_ptr<Texture> Load(const VulkanContext* context, const std::string& path);
+
+    static std::shared_ptr<Texture> Find(const std::string& path);
+    static std::shared_ptr<Texture> FindByHash(uint64_t contentHash);
+    static void Insert(const std::string& path, uint64_t contentHash, const std::shared_ptr<Texture>& texture);
+
+    static bool ReadFileBytes(const std::string& path, std::vector<unsigned char>& outBytes);
+    static uint64_t HashBytes(const void* data, size_t size);
+
+private:
+    static std::string NormalizePath(const std::string& path);
+
+    static std::mutex mutex_;
+    static std::unordered_map<std::string, uint64_t> pathToHash_;
+    static std::unordered_map<uint64_t, std::weak_ptr<Texture>> textures_;
+};
@@ -0,0 +1,344 @@
+#include "TransientResourcePool.h"
+#include "VulkanContext.h"
+#include "Texture.h"
+#include <algorithm>
+#include <stdexcept>
+
+TransientResourcePool::TransientResourcePool() = default;
+
+TransientResourcePool::~TransientResourcePool()
+{
+    cleanup();
+}
+
+void TransientResourcePool::initialize(const VulkanContext* context)
+{
+    context_ = context;
+}
+
+void TransientResourcePool::cleanup()
+{
+    if (!context_) {
+        return;
+    }
+    releasePhysicalImages();
+    images_.clear();
+}
+
+void TransientResourcePool::releasePhysicalImages()
+{
+    VkDevice device = context_->getDevice();
+    for (PhysicalImage& physical : physicalImages_) {
+        // 뷰와 샘플러는 Texture가 정리하고, 이미지와 메모리는 풀이 정리합니다.
+        physical.texture.reset();
+        vkDestroyImage(device, physical.image, nullptr);
+    }
+    for (MemoryBlock& block : blocks_) {
+        vkFreeMemory(device, block.memory, nullptr);
+    }
+    physicalImages_.clear();
+    blocks_.clear();
+    for (DeclaredImage& image : images_) {
+        image.physicalImage = ~0u;
+    }
+    requestedBytes_ = 0;
+    allocatedBytes_ = 0;
+    lazyImageCount_ = 0;
+    built_ = false;
+}
+
+TransientResourcePool::ImageId TransientResourcePool::declareImage(const TransientImageDesc& desc)
+{
+    DeclaredImage image{};
+    image.desc = desc;
+    images_.push_back(image);
+    built_ = false;
+    return static_cast<ImageId>(images_.size() - 1);
+}
+
+void TransientResourcePool::addLifetime(ImageId image, const void* scope, uint32_t firstPass, uint32_t lastPass)
+{
+    images_[image].lifetimes.push_back({ scope, std::min(firstPass, lastPass), std::max(firstPass, lastPass) });
+    built_ = false;
+}
+
+bool TransientResourcePool::CanShare(const std::vector<Lifetime>& a, const std::vector<Lifetime>& b)
+{
+    // 어느 그래프에서도 쓰지 않는 이미지는 언제 쓰일지 모르므로 혼자 둡니다.
+    if (a.empty() || b.empty()) {
+        return false;
+    }
+
+    // 두 이미지를 쓰는 그래프가 정확히 같아야 합니다.
+    auto usesScope = [](const std::vector<Lifetime>& lifetimes, const void* scope) {
+        return std::any_of(lifetimes.begin(), lifetimes.end(), [scope](const Lifetime& lifetime) { return lifetime.scope == scope; });
+    };
+    for (const Lifetime& lifetime : a) {
+        if (!usesScope(b, lifetime.scope)) {
+            return false;
+        }
+    }
+    for (const Lifetime& lifetime : b) {
+        if (!usesScope(a, lifetime.scope)) {
+            return false;
+        }
+    }
+
+    for (const Lifetime& x : a) {
+        for (const Lifetime& y : b) {
+            if (x.scope == y.scope && x.firstPass <= y.lastPass && y.firstPass <= x.lastPass) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool TransientResourcePool::IsAttachmentOnly(VkImageUsageFlags usage)
+{
+    const VkImageUsageFlags attachmentUsage =
+        VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT |
+        VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT |
+        VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT;
+    return (usage & ~attachmentUsage) == 0;
+}
+
+bool TransientResourcePool::findMemoryType(uint32_t typeBits, VkMemoryPropertyFlags properties, uint32_t& outTypeIndex) const
+{
+    VkPhysicalDeviceMemoryProperties memProperties;
+    vkGetPhysicalDeviceMemoryProperties(context_->getPhysicalDevice(), &memProperties);
+
+    for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
+        if ((typeBits & (1u << i)) && (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+            outTypeIndex = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+void TransientResourcePool::build()
+{
+    releasePhysicalImages();
+
+    assignPhysicalImages();
+    createImages();
+    placeInMemoryBlocks();
+    allocateAndBind();
+
+    for (const DeclaredImage& image : images_) {
+        requestedBytes_ += physicalImages_[image.physicalImage].memRequirements.size;
+    }
+    for (const MemoryBlock& block : blocks_) {
+        allocatedBytes_ += block.size;
+    }
+    built_ = true;
+}
+
+void TransientResourcePool::assignPhysicalImages()
+{
+    // (extent, format, usage)가 같은 선언끼리는 사용 구간이 겹치지 않으면 이미지 하나를 돌려 씁니다.
+    for (DeclaredImage& image : images_) {
+        for (uint32_t p = 0; p < physicalImages_.size(); ++p) {
+            PhysicalImage& physical = physicalImages_[p];
+            if (physical.desc == image.desc && CanShare(physical.lifetimes, image.lifetimes)) {
+                physical.lifetimes.insert(physical.lifetimes.end(), image.lifetimes.begin(), image.lifetimes.end());
+                image.physicalImage = p;
+                break;
+            }
+        }
+        if (image.physicalImage == ~0u) {
+            PhysicalImage physical{};
+            physical.desc = image.desc;
+            physical.lifetimes = image.lifetimes;
+            physicalImages_.push_back(std::move(physical));
+            image.physicalImage = static_cast<uint32_t>(physicalImages_.size() - 1);
+        }
+    }
+}
+
+void TransientResourcePool::createImages()
+{
+    VkDevice device = context_->getDevice();
+    for (PhysicalImage& physical : physicalImages_) {
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.extent = { physical.desc.extent.width, physical.desc.extent.height, 1 };
+        imageInfo.mipLevels = 1;
+        imageInfo.arrayLayers = 1;
+        imageInfo.format = physical.desc.format;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        imageInfo.usage = physical.desc.usage;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+
+        // 어태치먼트로만 쓰면 내용이 타일 메모리를 벗어날 일이 없으므로 TRANSIENT로 만들어 봅니다.
+        // LAZILY_ALLOCATED 메모리가 없는 장치(대부분의 데스크톱 GPU)에서는 일반 이미지로 다시 만듭니다.
+        if (IsAttachmentOnly(physical.desc.usage)) {
+            imageInfo.usage |= VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+            if (vkCreateImage(device, &imageInfo, nullptr, &physical.image) != VK_SUCCESS) {
+                throw std::runtime_error("failed to create transient image!");
+            }
+            vkGetImageMemoryRequirements(device, physical.image, &physical.memRequirements);
+
+            uint32_t typeIndex = 0;
+            if (findMemoryType(physical.memRequirements.memoryTypeBits,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT, typeIndex)) {
+                physical.lazy = true;
+                lazyImageCount_++;
+                continue;
+            }
+            vkDestroyImage(device, physical.image, nullptr);
+            physical.image = VK_NULL_HANDLE;
+            imageInfo.usage = physical.desc.usage;
+        }
+
+        if (vkCreateImage(device, &imageInfo, nullptr, &physical.image) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create transient image!");
+        }
+        vkGetImageMemoryRequirements(device, physical.image, &physical.memRequirements);
+    }
+}
+
+void TransientResourcePool::placeInMemoryBlocks()
+{
+    auto overlaps = [](VkDeviceSize offsetA, VkDeviceSize sizeA, VkDeviceSize offsetB, VkDeviceSize sizeB) {
+        return offsetA < offsetB + sizeB && offsetB < offsetA + sizeA;
+    };
+
+    // 큰 이미지부터 놓아 블록 크기가 가장 큰 이미지로 정해지게 합니다.
+    std::vector<uint32_t> order;
+    for (uint32_t p = 0; p < physicalImages_.size(); ++p) {
+        order.push_back(p);
+    }
+    std::stable_sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+        return physicalImages_[a].memRequirements.size > physicalImages_[b].memRequirements.size;
+    });
+
+    for (uint32_t p : order) {
+        PhysicalImage& physical = physicalImages_[p];
+        const VkDeviceSize size = physical.memRequirements.size;
+        const VkDeviceSize alignment = std::max<VkDeviceSize>(physical.memRequirements.alignment, 1);
+
+        if (physical.lazy) {
+            // 지연 할당 메모리는 실제로 잡히는 시점을 드라이버가 정하므로 앨리어싱하지 않고 따로 둡니다.
+            MemoryBlock block{};
+            findMemoryType(physical.memRequirements.memoryTypeBits,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT, block.memoryTypeIndex);
+            block.size = size;
+            block.lazy = true;
+            block.physicalImages.push_back(p);
+            physical.block = static_cast<uint32_t>(blocks_.size());
+            physical.offset = 0;
+            blocks_.push_back(block);
+            continue;
+        }
+
+        const uint32_t typeIndex = context_->findMemoryType(physical.memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+        // 블록마다 0과 이미 놓인 이미지의 끝을 후보로, 바이트가 겹치는 이미지와 수명이 겹치지 않는 가장 앞 위치를 찾습니다.
+        for (uint32_t b = 0; b < blocks_.size() && physical.block == ~0u; ++b) {
+            MemoryBlock& block = blocks_[b];
+            if (block.lazy || block.memoryTypeIndex != typeIndex) {
+                continue;
+            }
+
+            std::vector<VkDeviceSize> candidates = { 0 };
+            for (uint32_t other : block.physicalImages) {
+                const PhysicalImage& placed = physicalImages_[other];
+                VkDeviceSize end = placed.offset + placed.memRequirements.size;
+                candidates.push_back((end + alignment - 1) / alignment * alignment);
+            }
+            std::sort(candidates.begin(), candidates.end());
+
+            for (VkDeviceSize offset : candidates) {
+                if (offset + size > block.size) {
+                    break;
+                }
+                bool fits = true;
+                for (uint32_t other : block.physicalImages) {
+                    const PhysicalImage& placed = physicalImages_[other];
+                    if (overlaps(offset, size, placed.offset, placed.memRequirements.size) &&
+                        !CanShare(placed.lifetimes, physical.lifetimes)) {
+                        fits = false;
+                        break;
+                    }
+                }
+                if (fits) {
+                    physical.block = b;
+                    physical.offset = offset;
+                    block.physicalImages.push_back(p);
+                    break;
+                }
+            }
+        }
+
+        if (physical.block == ~0u) {
+            MemoryBlock block{};
+            block.memoryTypeIndex = typeIndex;
+            block.size = size;
+            block.physicalImages.push_back(p);
+            physical.block = static_cast<uint32_t>(blocks_.size());
+            physical.offset = 0;
+            blocks_.push_back(block);
+        }
+    }
+}
+
+void TransientResourcePool::allocateAndBind()
+{
+    VkDevice device = context_->getDevice();
+    for (MemoryBlock& block : blocks_) {
+        VkMemoryAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocInfo.allocationSize = block.size;
+        allocInfo.memoryTypeIndex = block.memoryTypeIndex;
+
+        if (vkAllocateMemory(device, &allocInfo, nullptr, &block.memory) != VK_SUCCESS) {
+            throw std::runtime_error("failed to allocate transient image memory!");
+        }
+        for (uint32_t p : block.physicalImages) {
+            vkBindImageMemory(device, physicalImages_[p].image, block.memory, physicalImages_[p].offset);
+        }
+    }
+
+    for (PhysicalImage& physical : physicalImages_) {
+        physical.texture = std::make_unique<Texture>(context_, physical.image, physical.desc.format, physical.desc.aspectMask);
+    }
+}
+
+VkImage TransientResourcePool::getImage(ImageId image) const
+{
+    if (!built_) {
+        throw std::runtime_error("transient resource pool is not built!");
+    }
+    return physicalImages_[images_[image].physicalImage].image;
+}
+
+Texture* TransientResourcePool::getTexture(ImageId image) const
+{
+    if (!built_) {
+        throw std::runtime_error("transient resource pool is not built!");
+    }
+    return physicalImages_[images_[image].physicalImage].texture.get();
+}
+
+bool TransientResourcePool::aliases(ImageId a, ImageId b) const
+{
+    if (!built_ || a == b) {
+        return false;
+    }
+    const uint32_t pa = images_[a].physicalImage;
+    const uint32_t pb = images_[b].physicalImage;
+    if (pa == pb) {
+        return true;
+    }
+    const PhysicalImage& x = physicalImages_[pa];
+    const PhysicalImage& y = physicalImages_[pb];
+    if (x.block != y.block || blocks_[x.block].lazy) {
+        return false;
+    }
+    return x.offset < y.offset + y.memRequirements.size && y.offset < x.offset + x.memRequirements.size;
+}
@@ -0,0 +1,120 @@
+#pragma once
+#include <vulkan/vulkan.h>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+class VulkanContext;
+class Texture;
+
+// 프레임 안에서만 쓰는 어태치먼트의 생성 정보. 세 값이 같으면 같은 이미지를 돌려 쓸 수 있습니다.
+struct TransientImageDesc {
+    VkExtent2D extent{};
+    VkFormat format = VK_FORMAT_UNDEFINED;
+    VkImageUsageFlags usage = 0;
+    VkImageAspectFlags aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+
+    bool operator==(const TransientImageDesc& other) const {
+        return extent.width == other.extent.width && extent.height == other.extent.height &&
+            format == other.format && usage == other.usage && aspectMask == other.aspectMask;
+    }
+};
+
+// 렌더 그래프의 중간 어태치먼트를 모아서 만드는 풀
+//  - 이미지는 declareImage로 선언만 하고, 렌더 그래프가 실행 순서 기준의 사용 구간을 알려준 뒤 build()에서 한꺼번에 만듭니다.
+//  - (extent, format, usage)가 같고 사용 구간이 겹치지 않는 선언은 이미지 하나를 같이 씁니다.
+//  - 다른 이미지끼리도 사용 구간이 겹치지 않으면 같은 VkDeviceMemory 범위에 바인딩합니다. (메모리 앨리어싱)
+//    앨리어싱된 이미지의 첫 사용은 앞 이미지의 마지막 사용을 기다려야 하며, 이 배리어는 렌더 그래프가 넣습니다.
+//  - 어태치먼트로만 쓰는 이미지(샘플링/스토리지 없음)는 LAZILY_ALLOCATED 메모리가 있으면 그쪽에 둡니다.
+//    타일 기반 GPU에서는 실제 메모리가 거의 잡히지 않습니다.
+// 여러 그래프(scope)가 같은 풀을 쓰면, 두 이미지를 모두 쓰는 그래프에서만 앨리어싱을 허용합니다.
+// 한쪽 그래프에만 나오는 이미지끼리는 그 그래프가 다른 쪽의 마지막 사용을 모르므로 겹쳐 두지 않습니다.
+class TransientResourcePool
+{
+public:
+    using ImageId = uint32_t;
+    static constexpr ImageId INVALID_IMAGE = ~0u;
+
+    TransientResourcePool();
+    ~TransientResourcePool();
+
+    TransientResourcePool(const TransientResourcePool&) = delete;
+    TransientResourcePool& operator=(const TransientResourcePool&) = delete;
+
+    void initialize(const VulkanContext* context);
+    void cleanup();
+
+    ImageId declareImage(const TransientImageDesc& desc);
+    // [firstPass, lastPass] 구간에서 이미지를 씁니다. (scope 안의 실행 순서 인덱스, 양 끝 포함)
+    void addLifetime(ImageId image, const void* scope, uint32_t firstPass, uint32_t lastPass);
+
+    // 선언과 사용 구간을 바탕으로 이미지, 메모리, 뷰를 만듭니다. 다시 호출하면 전부 새로 만듭니다.
+    void build();
+    bool isBuilt() const { return built_; }
+
+    VkImage getImage(ImageId image) const;
+    Texture* getTexture(ImageId image) const;
+    const TransientImageDesc& getDesc(ImageId image) const { return images_[image].desc; }
+    // 두 선언이 같은 메모리를 쓰는지 (같은 이미지를 돌려 쓰는 경우 포함)
+    bool aliases(ImageId a, ImageId b) const;
+
+    // 통계 (build 이후): 선언마다 따로 만들었을 때의 크기와 실제로 잡은 크기
+    VkDeviceSize getRequestedBytes() const { return requestedBytes_; }
+    VkDeviceSize getAllocatedBytes() const { return allocatedBytes_; }
+    uint32_t getPhysicalImageCount() const { return static_cast<uint32_t>(physicalImages_.size()); }
+    uint32_t getLazyImageCount() const { return lazyImageCount_; }
+
+private:
+    struct Lifetime {
+        const void* scope;
+        uint32_t firstPass;
+        uint32_t lastPass;
+    };
+
+    struct DeclaredImage {
+        TransientImageDesc desc;
+        std::vector<Lifetime> lifetimes;
+        uint32_t physicalImage = ~0u;
+    };
+
+    struct PhysicalImage {
+        TransientImageDesc desc;
+        std::vector<Lifetime> lifetimes;    // 이 이미지를 같이 쓰는 선언들의 구간을 모두 모은 것
+        VkImage image = VK_NULL_HANDLE;
+        VkMemoryRequirements memRequirements{};
+        bool lazy = false;
+        uint32_t block = ~0u;
+        VkDeviceSize offset = 0;
+        std::unique_ptr<Texture> texture;
+    };
+
+    struct MemoryBlock {
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        uint32_t memoryTypeIndex = 0;
+        VkDeviceSize size = 0;
+        bool lazy = false;
+        std::vector<uint32_t> physicalImages;
+    };
+
+    static bool CanShare(const std::vector<Lifetime>& a, const std::vector<Lifetime>& b);
+    static bool IsAttachmentOnly(VkImageUsageFlags usage);
+
+    void releasePhysicalImages();
+    void assignPhysicalImages();
+    void createImages();
+    void placeInMemoryBlocks();
+    void allocateAndBind();
+    bool findMemoryType(uint32_t typeBits, VkMemoryPropertyFlags properties, uint32_t& outTypeIndex) const;
+
+private:
+    const VulkanContext* context_ = nullptr;
+
+    std::vector<DeclaredImage> images_;
+    std::vector<PhysicalImage> physicalImages_;
+    std::vector<MemoryBlock> blocks_;
+
+    VkDeviceSize requestedBytes_ = 0;
+    VkDeviceSize allocatedBytes_ = 0;
+    uint32_t lazyImageCount_ = 0;
+    bool built_ = false;
+};
@@ -15,7 +15,7 @@ UniformBuffer::UniformBuffer(const VulkanContext* ctx, VkDeviceSize size) {
         VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
         buffer_,
-        bufferMemory_);
+        allocation_);
 
     bufferInfo_.buffer = buffer_;
     bufferInfo_.offset = 0;
@@ -27,22 +27,13 @@ UniformBuffer::~UniformBuffer() {
     if (buffer_ != VK_NULL_HANDLE) {
         vkDestroyBuffer(context->getDevice(), buffer_, nullptr);
     }
-    if (bufferMemory_ != VK_NULL_HANDLE) {
-        vkFreeMemory(context->getDevice(), bufferMemory_, nullptr);
-    }
+    context->getMemoryAllocator().free(allocation_);
 }
 
 void UniformBuffer::update(const void* data) {
-    // 4. GPU ޸𸮸 CPU   ͷ մϴ.
-    void* mappedMemory;
-    vkMapMemory(context->getDevice(), bufferMemory_, 0, bufferSize_, 0, &mappedMemory);
-
-    // 5. CPU ͸ ε GPU ޸ Ϳ մϴ.
-    memcpy(mappedMemory, data, static_cast<size_t>(bufferSize_));
-
-    // 6. ޸  մϴ.
+    // 4. ҴⰡ    ּҿ CPU ͸ ٷ մϴ.
     // (HOST_COHERENT Ӽ п vkFlushMappedMemoryRanges ȣ ʿ䰡 ϴ.)
-    vkUnmapMemory(context->getDevice(), bufferMemory_);
+    memcpy(allocation_.mapped, data, static_cast<size_t>(bufferSize_));
 }
 
 void UniformBuffer::populateWriteDescriptor(VkWriteDescriptorSet& writeInfo) const
@@ -17,7 +17,7 @@ public:
 private:
     uint32_t binding_;
     VkBuffer buffer_ = VK_NULL_HANDLE;
-    VkDeviceMemory bufferMemory_ = VK_NULL_HANDLE;
+    MemoryAllocation allocation_;
     VkDeviceSize bufferSize_ = 0;
 
     VkDescriptorBufferInfo bufferInfo_;
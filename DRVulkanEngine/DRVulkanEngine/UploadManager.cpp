@@ -0,0 +1,636 @@
+#include "UploadManager.h"
+#include "VulkanContext.h"
+#include <stdexcept>
+#include <chrono>
+#include <cstring>
+#include <algorithm>
+
+namespace {
+    // 링 구간 시작 정렬. RGBA32F 텍셀 크기(16)면 이미지 복사의 bufferOffset 제약을 모두 만족합니다.
+    constexpr VkDeviceSize STAGING_ALIGNMENT = 16;
+
+    VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment)
+    {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+}
+
+UploadManager::~UploadManager()
+{
+    cleanup();
+}
+
+void UploadManager::initialize(const VulkanContext* context, VkDeviceSize stagingRingSize, VkDeviceSize frameBudget)
+{
+    if (stagingRingSize == 0) {
+        throw std::runtime_error("failed to create staging ring: size must be greater than zero!");
+    }
+
+    context_ = context;
+    transferFamily_ = context_->getTransferQueueFamily();
+    graphicsFamily_ = context_->getGraphicsQueueFamily();
+    separateFamilies_ = transferFamily_ != graphicsFamily_;
+    transferQueue_ = context_->getTransferQueue();
+    graphicsQueue_ = context_->getGraphicsQueue();
+
+    // 배치 커맨드 버퍼는 한 번 제출하고 해제하므로 TRANSIENT 풀을 씁니다.
+    VkCommandPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+    poolInfo.queueFamilyIndex = transferFamily_;
+    if (vkCreateCommandPool(context_->getDevice(), &poolInfo, nullptr, &transferCommandPool_) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create upload command pool!");
+    }
+
+    VkSemaphoreTypeCreateInfo timelineInfo{};
+    timelineInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+    timelineInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+    timelineInfo.initialValue = 0;
+
+    VkSemaphoreCreateInfo semaphoreInfo{};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+    semaphoreInfo.pNext = &timelineInfo;
+    if (vkCreateSemaphore(context_->getDevice(), &semaphoreInfo, nullptr, &transferTimeline_) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create upload timeline semaphore!");
+    }
+
+    if (separateFamilies_) {
+        poolInfo.queueFamilyIndex = graphicsFamily_;
+        if (vkCreateCommandPool(context_->getDevice(), &poolInfo, nullptr, &acquireCommandPool_) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create upload acquire command pool!");
+        }
+        if (vkCreateSemaphore(context_->getDevice(), &semaphoreInfo, nullptr, &acquireTimeline_) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create upload timeline semaphore!");
+        }
+    }
+
+    // 링은 한 번 매핑해 두고 종료할 때까지 풀지 않습니다.
+    void* mapped = nullptr;
+    ring_ = createStagingBuffer(stagingRingSize, &mapped);
+    ringMapped_ = static_cast<unsigned char*>(mapped);
+    ringSize_ = stagingRingSize;
+    ringHead_ = 0;
+    ringTail_ = 0;
+    frameBudget_ = frameBudget;
+
+    lastSubmittedValue_ = 0;
+    submittedBatchCount_ = 0;
+    ownershipTransferCount_ = 0;
+}
+
+void UploadManager::cleanup()
+{
+    if (context_ == nullptr) {
+        return;
+    }
+
+    // 아직 스테이징되지 않은 스트리밍 요청은 대상 리소스가 이미 해제됐을 수 있으므로 버립니다.
+    for (auto& queue : pendingRequests_) {
+        queue.clear();
+    }
+
+    // 종료 시에만 남은 배치를 기다립니다.
+    flush();
+    if (lastSubmittedValue_ > 0) {
+        waitValue(lastSubmittedValue_);
+    }
+    for (Batch& batch : submittedBatches_) {
+        releaseBatch(batch);
+    }
+    submittedBatches_.clear();
+    ringAllocations_.clear();
+    ticketValues_.clear();
+    firstTicket_ = nextTicket_;
+
+    VkDevice device = context_->getDevice();
+    if (ring_.buffer != VK_NULL_HANDLE) {
+        vkUnmapMemory(device, ring_.memory);
+        vkDestroyBuffer(device, ring_.buffer, nullptr);
+        vkFreeMemory(device, ring_.memory, nullptr);
+        ring_ = StagingBuffer{};
+        ringMapped_ = nullptr;
+    }
+    if (transferTimeline_ != VK_NULL_HANDLE) {
+        vkDestroySemaphore(device, transferTimeline_, nullptr);
+        transferTimeline_ = VK_NULL_HANDLE;
+    }
+    if (acquireTimeline_ != VK_NULL_HANDLE) {
+        vkDestroySemaphore(device, acquireTimeline_, nullptr);
+        acquireTimeline_ = VK_NULL_HANDLE;
+    }
+    if (transferCommandPool_ != VK_NULL_HANDLE) {
+        vkDestroyCommandPool(device, transferCommandPool_, nullptr);
+        transferCommandPool_ = VK_NULL_HANDLE;
+    }
+    if (acquireCommandPool_ != VK_NULL_HANDLE) {
+        vkDestroyCommandPool(device, acquireCommandPool_, nullptr);
+        acquireCommandPool_ = VK_NULL_HANDLE;
+    }
+    context_ = nullptr;
+}
+
+UploadTicket UploadManager::uploadBuffer(VkBuffer buffer, VkDeviceSize offset, const void* data, VkDeviceSize size, UploadPriority priority)
+{
+    UploadRequest request;
+    request.size = size;
+    request.record = [buffer, offset, size](VkCommandBuffer commandBuffer, VkBuffer stagingBuffer, VkDeviceSize stagingOffset) {
+        VkBufferCopy region{};
+        region.srcOffset = stagingOffset;
+        region.dstOffset = offset;
+        region.size = size;
+        vkCmdCopyBuffer(commandBuffer, stagingBuffer, buffer, 1, &region);
+    };
+    return submitRequest(std::move(request), data, priority);
+}
+
+UploadTicket UploadManager::uploadImage(VkImage image, const VkImageSubresourceRange& range, const std::vector<VkBufferImageCopy>& regions,
+    VkImageLayout finalLayout, const void* data, VkDeviceSize size, UploadPriority priority)
+{
+    UploadRequest request;
+    request.size = size;
+    request.record = [this, image, range, regions, finalLayout](VkCommandBuffer commandBuffer, VkBuffer stagingBuffer, VkDeviceSize stagingOffset) {
+        recordImageCopy(commandBuffer, image, range, regions, stagingBuffer, stagingOffset, finalLayout);
+    };
+    return submitRequest(std::move(request), data, priority);
+}
+
+UploadTicket UploadManager::submitRequest(UploadRequest&& request, const void* data, UploadPriority priority)
+{
+    if (request.size == 0) {
+        return INVALID_UPLOAD_TICKET;
+    }
+
+    request.ticket = nextTicket_++;
+    ticketValues_.push_back(0);
+
+    if (priority == UploadPriority::Immediate) {
+        // 바로 그릴 리소스이므로 예산과 상관없이 기록하고, 링이 가득 찼으면 기다립니다.
+        stageRequest(request, data, true);
+        return request.ticket;
+    }
+
+    const UploadTicket ticket = request.ticket;
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    request.data.assign(bytes, bytes + request.size);
+    pendingRequests_[static_cast<size_t>(priority)].push_back(std::move(request));
+    return ticket;
+}
+
+bool UploadManager::stageRequest(UploadRequest& request, const void* data, bool allowStall)
+{
+    VkBuffer stagingBuffer = ring_.buffer;
+    VkDeviceSize stagingOffset = 0;
+
+    if (request.size > ringSize_) {
+        // 링보다 큰 업로드만 전용 스테이징 버퍼를 만들고, 배치가 끝나면 해제합니다.
+        void* mapped = nullptr;
+        StagingBuffer staging = createStagingBuffer(request.size, &mapped);
+        memcpy(mapped, data, static_cast<size_t>(request.size));
+        vkUnmapMemory(context_->getDevice(), staging.memory);
+
+        getCommandBuffer();
+        openBatch_.stagingBuffers.push_back(staging);
+        stagingBuffer = staging.buffer;
+        ++oversizeUploadCount_;
+    }
+    else {
+        if (!allocateRing(request.size, stagingOffset)) {
+            if (!allowStall) {
+                return false;
+            }
+            waitForRingSpace(request.size, stagingOffset);
+        }
+        memcpy(ringMapped_ + stagingOffset, data, static_cast<size_t>(request.size));
+    }
+
+    request.record(getCommandBuffer(), stagingBuffer, stagingOffset);
+    ticketValues_[request.ticket - firstTicket_] = openBatch_.value;
+
+    frameBytes_ += request.size;
+    totalBytes_ += request.size;
+    return true;
+}
+
+bool UploadManager::stageNextPending(bool allowStall)
+{
+    for (size_t priority = static_cast<size_t>(UploadPriority::High); priority < static_cast<size_t>(UploadPriority::Count); ++priority) {
+        std::deque<UploadRequest>& queue = pendingRequests_[priority];
+        if (queue.empty()) {
+            continue;
+        }
+
+        // 우선순위 순서를 지키기 위해 앞 요청이 막히면 낮은 우선순위도 이번 프레임에는 넘어가지 않습니다.
+        // 예산보다 큰 요청이 영원히 밀리지 않도록 프레임의 첫 요청은 예산과 상관없이 진행합니다.
+        UploadRequest& request = queue.front();
+        if (!allowStall && frameBytes_ > 0 && frameBytes_ + request.size > frameBudget_) {
+            return false;
+        }
+        if (!stageRequest(request, request.data.data(), allowStall)) {
+            return false;
+        }
+        queue.pop_front();
+        return true;
+    }
+    return false;
+}
+
+bool UploadManager::allocateRing(VkDeviceSize size, VkDeviceSize& outOffset)
+{
+    // 구간에는 열린 배치의 타임라인 값을 기록하므로 배치를 먼저 엽니다.
+    getCommandBuffer();
+
+    if (ringAllocations_.empty()) {
+        ringHead_ = 0;
+        ringTail_ = 0;
+    }
+
+    VkDeviceSize begin = alignUp(ringHead_, STAGING_ALIGNMENT);
+    if (ringAllocations_.empty() || ringHead_ > ringTail_) {
+        // 빈 공간: [head, 끝)과 [0, tail). 끝에 들어가지 않으면 앞으로 감습니다.
+        if (begin + size > ringSize_) {
+            if (size > ringTail_) {
+                return false;
+            }
+            begin = 0;
+        }
+    }
+    else if (begin + size > ringTail_) {
+        // 빈 공간: [head, tail). head == tail이면 가득 찬 상태입니다.
+        return false;
+    }
+
+    ringAllocations_.push_back(RingAllocation{ begin, begin + size, openBatch_.value });
+    ringHead_ = begin + size;
+    outOffset = begin;
+    return true;
+}
+
+void UploadManager::waitForRingSpace(VkDeviceSize size, VkDeviceSize& outOffset)
+{
+    // 가장 오래된 구간을 읽는 배치가 끝날 때까지 CPU가 기다립니다.
+    // 빈 링에는 size <= ringSize_인 요청이 항상 들어가므로 구간이 남아 있는 동안만 돕니다.
+    const auto stallStart = std::chrono::high_resolution_clock::now();
+    while (!allocateRing(size, outOffset)) {
+        const uint64_t value = ringAllocations_.front().value;
+        if (value > lastSubmittedValue_) {
+            // 열린 배치가 잡고 있는 공간이면 먼저 제출해야 끝납니다.
+            flush();
+        }
+        waitValue(value);
+        retire();
+    }
+    const auto stallEnd = std::chrono::high_resolution_clock::now();
+    stallMilliseconds_ += std::chrono::duration<double, std::milli>(stallEnd - stallStart).count();
+    ++stallCount_;
+}
+
+StagingBuffer UploadManager::createStagingBuffer(VkDeviceSize size, void** outMapped)
+{
+    VkDevice device = context_->getDevice();
+    StagingBuffer staging;
+
+    // 전송 큐에서만 읽으므로 EXCLUSIVE로 둡니다.
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = size;
+    bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    if (vkCreateBuffer(device, &bufferInfo, nullptr, &staging.buffer) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create staging buffer!");
+    }
+
+    VkMemoryRequirements memRequirements;
+    vkGetBufferMemoryRequirements(device, staging.buffer, &memRequirements);
+
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = memRequirements.size;
+    allocInfo.memoryTypeIndex = context_->findMemoryType(memRequirements.memoryTypeBits,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    if (vkAllocateMemory(device, &allocInfo, nullptr, &staging.memory) != VK_SUCCESS) {
+        throw std::runtime_error("failed to allocate staging buffer memory!");
+    }
+    vkBindBufferMemory(device, staging.buffer, staging.memory, 0);
+
+    if (vkMapMemory(device, staging.memory, 0, size, 0, outMapped) != VK_SUCCESS) {
+        throw std::runtime_error("failed to map staging buffer memory!");
+    }
+    return staging;
+}
+
+VkCommandBuffer UploadManager::getCommandBuffer()
+{
+    if (batchOpen_) {
+        return openBatch_.transferCommandBuffer;
+    }
+
+    openBatch_ = Batch{};
+    openBatch_.value = lastSubmittedValue_ + 1;
+    openBatch_.transferCommandBuffer = allocateCommandBuffer(transferCommandPool_);
+
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    vkBeginCommandBuffer(openBatch_.transferCommandBuffer, &beginInfo);
+
+    batchOpen_ = true;
+    return openBatch_.transferCommandBuffer;
+}
+
+void UploadManager::recordImageCopy(VkCommandBuffer commandBuffer, VkImage image, const VkImageSubresourceRange& range,
+    const std::vector<VkBufferImageCopy>& regions, VkBuffer stagingBuffer, VkDeviceSize stagingOffset, VkImageLayout finalLayout)
+{
+    VkImageMemoryBarrier2 barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+    barrier.srcStageMask = VK_PIPELINE_STAGE_2_NONE;
+    barrier.srcAccessMask = VK_ACCESS_2_NONE;
+    barrier.dstStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+    barrier.dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = image;
+    barrier.subresourceRange = range;
+
+    VkDependencyInfo dependencyInfo{};
+    dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+    dependencyInfo.imageMemoryBarrierCount = 1;
+    dependencyInfo.pImageMemoryBarriers = &barrier;
+    vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+
+    // regions의 bufferOffset은 요청 데이터 기준이므로 스테이징 구간 시작만큼 옮깁니다.
+    std::vector<VkBufferImageCopy> copies = regions;
+    for (VkBufferImageCopy& copy : copies) {
+        copy.bufferOffset += stagingOffset;
+    }
+    vkCmdCopyBufferToImage(commandBuffer, stagingBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+        static_cast<uint32_t>(copies.size()), copies.data());
+
+    barrier.srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+    barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.newLayout = finalLayout;
+
+    if (separateFamilies_) {
+        // 릴리즈: 전송 큐는 그래픽스 스테이지를 모르므로 dst는 비워 두고, 같은 전환을 그래픽스 큐의 획득에서 반복합니다.
+        barrier.dstStageMask = VK_PIPELINE_STAGE_2_NONE;
+        barrier.dstAccessMask = VK_ACCESS_2_NONE;
+        barrier.srcQueueFamilyIndex = transferFamily_;
+        barrier.dstQueueFamilyIndex = graphicsFamily_;
+
+        VkImageMemoryBarrier2 acquire = barrier;
+        acquire.srcStageMask = VK_PIPELINE_STAGE_2_NONE;
+        acquire.srcAccessMask = VK_ACCESS_2_NONE;
+        acquire.dstStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+        acquire.dstAccessMask = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT;
+        pendingAcquires_.push_back(acquire);
+        ++ownershipTransferCount_;
+    }
+    else {
+        // 같은 큐이므로 이후 제출의 셰이더 읽기와 바로 배리어를 겁니다.
+        barrier.dstStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+        barrier.dstAccessMask = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT;
+    }
+
+    vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+}
+
+void UploadManager::flushFrame()
+{
+    // 대기 중인 스트리밍 요청을 우선순위 순서대로, 이번 프레임 예산이 남는 동안만 스테이징합니다.
+    // 링에 자리가 없으면 기다리지 않고 다음 프레임으로 넘깁니다.
+    while (stageNextPending(false)) {
+    }
+    flush();
+
+    lastFrameBytes_ = frameBytes_;
+    peakFrameBytes_ = std::max(peakFrameBytes_, frameBytes_);
+    frameBytes_ = 0;
+}
+
+uint64_t UploadManager::flush()
+{
+    if (!batchOpen_) {
+        return lastSubmittedValue_;
+    }
+
+    if (!separateFamilies_) {
+        // 같은 큐: 버퍼 복사 결과를 이후 제출의 모든 읽기에 보이게 합니다.
+        // (패밀리가 다르면 그래픽스 큐가 기다리는 세마포어가 같은 역할을 합니다)
+        VkMemoryBarrier2 memoryBarrier{};
+        memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+        memoryBarrier.srcStageMask = VK_PIPELINE_STAGE_2_COPY_BIT;
+        memoryBarrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+        memoryBarrier.dstStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+        memoryBarrier.dstAccessMask = VK_ACCESS_2_MEMORY_READ_BIT;
+
+        VkDependencyInfo dependencyInfo{};
+        dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+        dependencyInfo.memoryBarrierCount = 1;
+        dependencyInfo.pMemoryBarriers = &memoryBarrier;
+        vkCmdPipelineBarrier2(openBatch_.transferCommandBuffer, &dependencyInfo);
+    }
+
+    if (vkEndCommandBuffer(openBatch_.transferCommandBuffer) != VK_SUCCESS) {
+        throw std::runtime_error("failed to record upload command buffer!");
+    }
+
+    VkCommandBufferSubmitInfo commandBufferInfo{};
+    commandBufferInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
+    commandBufferInfo.commandBuffer = openBatch_.transferCommandBuffer;
+
+    VkSemaphoreSubmitInfo signalInfo{};
+    signalInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+    signalInfo.semaphore = transferTimeline_;
+    signalInfo.value = openBatch_.value;
+    signalInfo.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+
+    VkSubmitInfo2 submitInfo{};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
+    submitInfo.commandBufferInfoCount = 1;
+    submitInfo.pCommandBufferInfos = &commandBufferInfo;
+    submitInfo.signalSemaphoreInfoCount = 1;
+    submitInfo.pSignalSemaphoreInfos = &signalInfo;
+    if (vkQueueSubmit2(transferQueue_, 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS) {
+        throw std::runtime_error("failed to submit upload batch!");
+    }
+
+    if (separateFamilies_) {
+        // 획득할 이미지가 없어도 제출해서 acquireTimeline_이 배치마다 같은 값에 도달하게 합니다.
+        VkCommandBufferSubmitInfo acquireCommandBufferInfo{};
+        acquireCommandBufferInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
+        if (!pendingAcquires_.empty()) {
+            openBatch_.acquireCommandBuffer = allocateCommandBuffer(acquireCommandPool_);
+
+            VkCommandBufferBeginInfo beginInfo{};
+            beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+            vkBeginCommandBuffer(openBatch_.acquireCommandBuffer, &beginInfo);
+
+            VkDependencyInfo dependencyInfo{};
+            dependencyInfo.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+            dependencyInfo.imageMemoryBarrierCount = static_cast<uint32_t>(pendingAcquires_.size());
+            dependencyInfo.pImageMemoryBarriers = pendingAcquires_.data();
+            vkCmdPipelineBarrier2(openBatch_.acquireCommandBuffer, &dependencyInfo);
+
+            if (vkEndCommandBuffer(openBatch_.acquireCommandBuffer) != VK_SUCCESS) {
+                throw std::runtime_error("failed to record upload acquire command buffer!");
+            }
+            acquireCommandBufferInfo.commandBuffer = openBatch_.acquireCommandBuffer;
+        }
+
+        VkSemaphoreSubmitInfo waitInfo{};
+        waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+        waitInfo.semaphore = transferTimeline_;
+        waitInfo.value = openBatch_.value;
+        waitInfo.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+
+        VkSemaphoreSubmitInfo acquireSignalInfo = signalInfo;
+        acquireSignalInfo.semaphore = acquireTimeline_;
+
+        VkSubmitInfo2 acquireSubmitInfo{};
+        acquireSubmitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
+        acquireSubmitInfo.waitSemaphoreInfoCount = 1;
+        acquireSubmitInfo.pWaitSemaphoreInfos = &waitInfo;
+        acquireSubmitInfo.commandBufferInfoCount = pendingAcquires_.empty() ? 0 : 1;
+        acquireSubmitInfo.pCommandBufferInfos = pendingAcquires_.empty() ? nullptr : &acquireCommandBufferInfo;
+        acquireSubmitInfo.signalSemaphoreInfoCount = 1;
+        acquireSubmitInfo.pSignalSemaphoreInfos = &acquireSignalInfo;
+        if (vkQueueSubmit2(graphicsQueue_, 1, &acquireSubmitInfo, VK_NULL_HANDLE) != VK_SUCCESS) {
+            throw std::runtime_error("failed to submit upload acquire batch!");
+        }
+        pendingAcquires_.clear();
+    }
+
+    lastSubmittedValue_ = openBatch_.value;
+    submittedBatches_.push_back(std::move(openBatch_));
+    openBatch_ = Batch{};
+    batchOpen_ = false;
+    ++submittedBatchCount_;
+    return lastSubmittedValue_;
+}
+
+bool UploadManager::isComplete(UploadTicket ticket) const
+{
+    // INVALID_UPLOAD_TICKET이거나 이미 회수된 번호
+    if (ticket < firstTicket_) {
+        return true;
+    }
+    const uint64_t value = ticketValues_[ticket - firstTicket_];
+    return value != 0 && value <= getCompletedValue();
+}
+
+void UploadManager::wait(UploadTicket ticket)
+{
+    while (ticket >= firstTicket_ && ticketValues_[ticket - firstTicket_] == 0) {
+        if (!stageNextPending(true)) {
+            break;
+        }
+    }
+    if (ticket < firstTicket_) {
+        return;
+    }
+
+    const uint64_t value = ticketValues_[ticket - firstTicket_];
+    if (value > lastSubmittedValue_) {
+        flush();
+    }
+    waitValue(value);
+}
+
+void UploadManager::waitValue(uint64_t value) const
+{
+    VkSemaphore semaphore = separateFamilies_ ? acquireTimeline_ : transferTimeline_;
+    VkSemaphoreWaitInfo waitInfo{};
+    waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+    waitInfo.semaphoreCount = 1;
+    waitInfo.pSemaphores = &semaphore;
+    waitInfo.pValues = &value;
+    vkWaitSemaphores(context_->getDevice(), &waitInfo, UINT64_MAX);
+}
+
+void UploadManager::retire()
+{
+    if (submittedBatches_.empty()) {
+        return;
+    }
+
+    // 배치는 제출 순서대로 끝나므로 앞에서부터 확인합니다.
+    const uint64_t completedValue = getCompletedValue();
+    while (!submittedBatches_.empty() && submittedBatches_.front().value <= completedValue) {
+        releaseBatch(submittedBatches_.front());
+        submittedBatches_.pop_front();
+    }
+
+    // 링 구간도 할당 순서대로 끝나므로 tail을 앞으로 당깁니다.
+    while (!ringAllocations_.empty() && ringAllocations_.front().value <= completedValue) {
+        ringAllocations_.pop_front();
+    }
+    if (ringAllocations_.empty()) {
+        ringHead_ = 0;
+        ringTail_ = 0;
+    }
+    else {
+        ringTail_ = ringAllocations_.front().begin;
+    }
+
+    // 대기 중인 요청(0)을 만나면 멈춥니다. 그 뒤의 번호는 스테이징될 때까지 남겨 둡니다.
+    while (!ticketValues_.empty() && ticketValues_.front() != 0 && ticketValues_.front() <= completedValue) {
+        ticketValues_.pop_front();
+        ++firstTicket_;
+    }
+}
+
+VkDeviceSize UploadManager::getPendingBytes() const
+{
+    VkDeviceSize bytes = 0;
+    for (const auto& queue : pendingRequests_) {
+        for (const UploadRequest& request : queue) {
+            bytes += request.size;
+        }
+    }
+    return bytes;
+}
+
+VkCommandBuffer UploadManager::allocateCommandBuffer(VkCommandPool pool)
+{
+    VkCommandBufferAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocInfo.commandPool = pool;
+    allocInfo.commandBufferCount = 1;
+
+    VkCommandBuffer commandBuffer;
+    if (vkAllocateCommandBuffers(context_->getDevice(), &allocInfo, &commandBuffer) != VK_SUCCESS) {
+        throw std::runtime_error("failed to allocate upload command buffer!");
+    }
+    return commandBuffer;
+}
+
+void UploadManager::releaseBatch(Batch& batch)
+{
+    VkDevice device = context_->getDevice();
+    for (const StagingBuffer& staging : batch.stagingBuffers) {
+        vkDestroyBuffer(device, staging.buffer, nullptr);
+        vkFreeMemory(device, staging.memory, nullptr);
+    }
+    batch.stagingBuffers.clear();
+
+    if (batch.transferCommandBuffer != VK_NULL_HANDLE) {
+        vkFreeCommandBuffers(device, transferCommandPool_, 1, &batch.transferCommandBuffer);
+        batch.transferCommandBuffer = VK_NULL_HANDLE;
+    }
+    if (batch.acquireCommandBuffer != VK_NULL_HANDLE) {
+        vkFreeCommandBuffers(device, acquireCommandPool_, 1, &batch.acquireCommandBuffer);
+        batch.acquireCommandBuffer = VK_NULL_HANDLE;
+    }
+}
+
+uint64_t UploadManager::getCompletedValue() const
+{
+    // 패밀리가 다르면 그래픽스 큐의 획득까지 끝나야 이미지를 쓸 수 있습니다.
+    uint64_t value = 0;
+    vkGetSemaphoreCounterValue(context_->getDevice(), separateFamilies_ ? acquireTimeline_ : transferTimeline_, &value);
+    return value;
+}
@@ -0,0 +1,170 @@
+#pragma once
+#include <vulkan/vulkan.h>
+#include <vector>
+#include <deque>
+#include <functional>
+#include <cstdint>
+#include "Resource.h"
+
+class VulkanContext;
+
+// Immediate는 호출 즉시 스테이징하고 이번 프레임 제출에 들어갑니다. (바로 그릴 리소스)
+// 나머지는 큐에 쌓였다가 flushFrame()에서 우선순위 순서대로, 프레임 예산 안에서만 스테이징됩니다. (스트리밍)
+enum class UploadPriority : uint32_t
+{
+    Immediate,
+    High,
+    Normal,
+    Low,
+    Count
+};
+
+// 업로드 요청마다 하나씩 발급되는 번호. isComplete/wait로 완료를 확인합니다.
+using UploadTicket = uint64_t;
+constexpr UploadTicket INVALID_UPLOAD_TICKET = 0;
+
+// 텍스처/버퍼 업로드를 전송 큐에 모아서 제출합니다.
+//  - 스테이징은 영구 매핑된 링 버퍼 하나에서 잘라 씁니다. 구간마다 배치의 타임라인 값을 기록해 두고,
+//    타임라인이 그 값을 지나면 회수합니다. 링보다 큰 업로드만 전용 스테이징 버퍼를 만듭니다.
+//  - 복사는 열린 배치의 커맨드 버퍼 하나에 계속 기록되고, flushFrame() 한 번에 제출됩니다. (프레임마다 한 번)
+//  - 전송 전용 패밀리가 있으면 이미지는 EXCLUSIVE이므로 전송 큐에서 릴리즈, 그래픽스 큐에서 획득 배리어로 소유권을 넘깁니다.
+//    획득 배리어는 배치를 기다리는 그래픽스 제출 하나에 모아서 기록하므로 이후 프레임 제출보다 먼저 실행됩니다.
+//  - 버퍼는 setBufferSharing이 전송 패밀리까지 CONCURRENT로 만들므로 소유권 이전이 필요 없습니다.
+//  - 전송 전용 패밀리가 없으면 그래픽스 큐에 같은 방식으로 제출하고 릴리즈/획득 대신 일반 배리어를 씁니다.
+// 렌더 스레드에서만 사용합니다.
+class UploadManager
+{
+public:
+    static constexpr VkDeviceSize DEFAULT_STAGING_RING_SIZE = 64ull * 1024 * 1024;
+    static constexpr VkDeviceSize DEFAULT_FRAME_BUDGET = 8ull * 1024 * 1024;
+
+    UploadManager() = default;
+    ~UploadManager();
+
+    UploadManager(const UploadManager&) = delete;
+    UploadManager& operator=(const UploadManager&) = delete;
+
+    void initialize(const VulkanContext* context, VkDeviceSize stagingRingSize = DEFAULT_STAGING_RING_SIZE, VkDeviceSize frameBudget = DEFAULT_FRAME_BUDGET);
+    void cleanup();
+
+    // data는 호출 중에만 유효하면 됩니다. (스트리밍 요청은 사본을 보관합니다)
+    UploadTicket uploadBuffer(VkBuffer buffer, VkDeviceSize offset, const void* data, VkDeviceSize size, UploadPriority priority = UploadPriority::Immediate);
+    // regions의 bufferOffset은 data 기준입니다. 복사 전 UNDEFINED -> TRANSFER_DST, 복사 후 finalLayout으로 전환하고
+    // 그래픽스 큐로 소유권을 넘깁니다. 전송 전용 큐는 minImageTransferGranularity 제약이 있으므로 밉 레벨 전체를 복사해야 합니다.
+    UploadTicket uploadImage(VkImage image, const VkImageSubresourceRange& range, const std::vector<VkBufferImageCopy>& regions,
+        VkImageLayout finalLayout, const void* data, VkDeviceSize size, UploadPriority priority = UploadPriority::Immediate);
+
+    // 프레임마다 한 번: 예산 안에서 대기 중인 스트리밍 요청을 스테이징하고 열린 배치를 제출합니다.
+    void flushFrame();
+    // 끝난 배치의 커맨드 버퍼와 스테이징 구간을 회수합니다. 프레임마다 호출합니다.
+    void retire();
+
+    bool isComplete(UploadTicket ticket) const;
+    // 아직 스테이징되지 않은 요청이면 예산을 무시하고 그 요청까지 기록한 뒤 제출해서 기다립니다.
+    void wait(UploadTicket ticket);
+
+    void setFrameBudget(VkDeviceSize frameBudget) { frameBudget_ = frameBudget; }
+    VkDeviceSize getFrameBudget() const { return frameBudget_; }
+
+    // 통계
+    VkDeviceSize getLastFrameBytes() const { return lastFrameBytes_; }
+    VkDeviceSize getPeakFrameBytes() const { return peakFrameBytes_; }
+    VkDeviceSize getTotalBytes() const { return totalBytes_; }
+    VkDeviceSize getPendingBytes() const;
+    // 링에 자리가 없어 CPU가 이전 배치를 기다린 횟수와 시간
+    uint64_t getStallCount() const { return stallCount_; }
+    double getStallMilliseconds() const { return stallMilliseconds_; }
+    uint64_t getOversizeUploadCount() const { return oversizeUploadCount_; }
+    uint64_t getSubmittedBatchCount() const { return submittedBatchCount_; }
+    uint64_t getOwnershipTransferCount() const { return ownershipTransferCount_; }
+
+private:
+    // 스테이징 버퍼와 그 안의 오프셋을 받아 복사를 기록합니다.
+    using RecordFunction = std::function<void(VkCommandBuffer commandBuffer, VkBuffer stagingBuffer, VkDeviceSize stagingOffset)>;
+
+    struct UploadRequest {
+        UploadTicket ticket = INVALID_UPLOAD_TICKET;
+        VkDeviceSize size = 0;
+        std::vector<unsigned char> data;    // 스트리밍 요청만 보관합니다.
+        RecordFunction record;
+    };
+
+    struct Batch {
+        uint64_t value = 0;
+        VkCommandBuffer transferCommandBuffer = VK_NULL_HANDLE;
+        VkCommandBuffer acquireCommandBuffer = VK_NULL_HANDLE;
+        std::vector<StagingBuffer> stagingBuffers;
+    };
+
+    // 링에서 잘라 쓴 구간 [begin, end)와, 그 구간을 읽는 배치의 타임라인 값
+    struct RingAllocation {
+        VkDeviceSize begin = 0;
+        VkDeviceSize end = 0;
+        uint64_t value = 0;
+    };
+
+    UploadTicket submitRequest(UploadRequest&& request, const void* data, UploadPriority priority);
+    bool stageRequest(UploadRequest& request, const void* data, bool allowStall);
+    bool stageNextPending(bool allowStall);
+    bool allocateRing(VkDeviceSize size, VkDeviceSize& outOffset);
+    void waitForRingSpace(VkDeviceSize size, VkDeviceSize& outOffset);
+    StagingBuffer createStagingBuffer(VkDeviceSize size, void** outMapped);
+
+    VkCommandBuffer getCommandBuffer();
+    void recordImageCopy(VkCommandBuffer commandBuffer, VkImage image, const VkImageSubresourceRange& range,
+        const std::vector<VkBufferImageCopy>& regions, VkBuffer stagingBuffer, VkDeviceSize stagingOffset, VkImageLayout finalLayout);
+    uint64_t flush();
+    void waitValue(uint64_t value) const;
+    uint64_t getCompletedValue() const;
+
+    VkCommandBuffer allocateCommandBuffer(VkCommandPool pool);
+    void releaseBatch(Batch& batch);
+
+private:
+    const VulkanContext* context_ = nullptr;
+    bool separateFamilies_ = false;
+    uint32_t transferFamily_ = 0;
+    uint32_t graphicsFamily_ = 0;
+    VkQueue transferQueue_ = VK_NULL_HANDLE;
+    VkQueue graphicsQueue_ = VK_NULL_HANDLE;
+    VkCommandPool transferCommandPool_ = VK_NULL_HANDLE;
+    VkCommandPool acquireCommandPool_ = VK_NULL_HANDLE;
+
+    // 전송 큐 제출이 신호하고, 패밀리가 다르면 그래픽스 획득 제출이 같은 값을 acquireTimeline_에 신호합니다.
+    // (한 세마포어를 두 큐가 번갈아 신호하면 값이 줄어드는 순서로 실행될 수 있어 둘로 나눕니다)
+    VkSemaphore transferTimeline_ = VK_NULL_HANDLE;
+    VkSemaphore acquireTimeline_ = VK_NULL_HANDLE;
+    uint64_t lastSubmittedValue_ = 0;
+
+    bool batchOpen_ = false;
+    Batch openBatch_;
+    std::vector<VkImageMemoryBarrier2> pendingAcquires_;
+    std::deque<Batch> submittedBatches_;
+
+    // 스테이징 링 (HOST_VISIBLE | HOST_COHERENT, 영구 매핑)
+    StagingBuffer ring_;
+    unsigned char* ringMapped_ = nullptr;
+    VkDeviceSize ringSize_ = 0;
+    VkDeviceSize ringHead_ = 0;     // 다음에 잘라 줄 위치
+    VkDeviceSize ringTail_ = 0;     // 아직 GPU가 읽을 수 있는 가장 오래된 구간의 시작
+    std::deque<RingAllocation> ringAllocations_;
+
+    // 우선순위별 대기 중인 스트리밍 요청 (Immediate 칸은 쓰지 않음)
+    std::deque<UploadRequest> pendingRequests_[static_cast<size_t>(UploadPriority::Count)];
+    VkDeviceSize frameBudget_ = DEFAULT_FRAME_BUDGET;
+    VkDeviceSize frameBytes_ = 0;
+
+    // 요청 번호 -> 기록된 배치의 타임라인 값 (0이면 아직 대기 중). 앞쪽은 끝나는 대로 잘라냅니다.
+    std::deque<uint64_t> ticketValues_;
+    UploadTicket firstTicket_ = 1;
+    UploadTicket nextTicket_ = 1;
+
+    VkDeviceSize lastFrameBytes_ = 0;
+    VkDeviceSize peakFrameBytes_ = 0;
+    VkDeviceSize totalBytes_ = 0;
+    uint64_t stallCount_ = 0;
+    double stallMilliseconds_ = 0.0;
+    uint64_t oversizeUploadCount_ = 0;
+    uint64_t submittedBatchCount_ = 0;
+    uint64_t ownershipTransferCount_ = 0;
+};
@@ -15,6 +15,9 @@
 #include "CubemapTexture.h"
 #include "GlobalData.h"
 #include "VulkanUtils.h"
+#include "TextureCache.h"
+#include "UploadManager.h"
+#include "MemoryAllocator.h"
 
 VulkanApp::VulkanApp()
     :camera_(std::make_unique<Camera>())
@@ -38,6 +41,13 @@ void VulkanApp::run() {
 
 }
 
+void VulkanApp::enableBoneBackendBenchmark(const BoneBackendBenchmark::Settings& settings)
+{
+    boneBenchmark_ = std::make_unique<BoneBackendBenchmark>(settings);
+    // 깊이 프리패스 구간을 재므로 켜 둡니다.
+    depthPrepassEnabled_ = true;
+}
+
 void VulkanApp::initWindow() {
     glfwInit();
     glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
@@ -52,24 +62,50 @@ void VulkanApp::initVulkan() {
 
     //createDescriptorSetLayout();
     swapChain_.initialize(&context_, window);
+    transientPool_.initialize(&context_);
     sceneRenderTarget_.initialize(
-        &context_,
+        &transientPool_,
         swapChain_.getSwapChainExtent(),
         VK_FORMAT_R16G16B16A16_SFLOAT,
         swapChain_.getDepthFormat()
     );
+    // 그래프의 사용 구간이 정해져야 풀 이미지를 만들 수 있으므로, 씬 타깃을 쓰는 다른 초기화보다 먼저 합니다.
+    buildRenderGraphs();
 	shaderManager_.initialize(&context_);
 
+    // 모델이 로드되면서 오브젝트 ID를 받으므로 에셋보다 먼저 만듭니다.
+    gpuScene_.initialize(&context_, MAX_FRAMES_IN_FLIGHT);
+    materialTable_.initialize(&context_, MAX_FRAMES_IN_FLIGHT);
+    bonePalettePool_.initialize(&context_, MAX_FRAMES_IN_FLIGHT);
     loadAssets();
+    asyncModelLoader_.initialize(&context_);
+    instanceBatcher_.initialize(&context_, &gpuScene_, MAX_FRAMES_IN_FLIGHT);
+    commandRecorder_.initialize(&context_, MAX_FRAMES_IN_FLIGHT);
+    commandBufferCache_.initialize(&context_, MAX_FRAMES_IN_FLIGHT, context_.getGraphicsQueueFamily());
+    computeCommandBufferCache_.initialize(&context_, MAX_FRAMES_IN_FLIGHT, context_.getComputeQueueFamily());
+    gpuTimer_.initialize(&context_, MAX_FRAMES_IN_FLIGHT, GPU_SCOPE_COUNT);
     descriptorPool_.initialize(&context_);
 	// Pipeline �ʱ�ȭ
 	PipelineConfig pipelineConfig{};
 	pipelineConfig.pipelineName = "default";
 	pipelineConfig.vertexShaderPath = "shaders/shader.vert.spv";
 	pipelineConfig.fragmentShaderPath = "shaders/shader.frag.spv";
+    pipelineConfig.depthOnlyVertexShaderPath = "shaders/depth_prepass.vert.spv";
+    // 본 팔레트 읽기 경로 (BONE_BACKEND), 세 변형 모두 같은 값으로 특수화합니다.
+    // 장치 기능/제한으로 쓸 수 없으면 파이프라인을 만들기 전에 여기서 한 번 바꿉니다. (대기나 재특수화 없음)
+    if (!bonePalettePool_.isBackendSupported(boneBackend_)) {
+        std::cout << "Bone Backend: " << GetBoneBackendName(boneBackend_) << " is not supported on this device, using "
+                  << GetBoneBackendName(BoneBackend::Storage) << std::endl;
+        boneBackend_ = BoneBackend::Storage;
+    }
+    pipelineConfig.vertexSpecializationConstants = { static_cast<uint32_t>(boneBackend_) };
     pipelineConfig.colorAttachmentFormat = sceneRenderTarget_.getColorFormat(); // ��: R16G16B16A16_SFLOAT
     pipelineConfig.depthAttachmentFormat = sceneRenderTarget_.getDepthFormat();
 	defaultPipeline_.initialize(&context_, &swapChain_, &descriptorPool_, &shaderManager_, pipelineConfig);
+    depthPrepassPipeline_.initialize(&context_, &swapChain_, &descriptorPool_, &shaderManager_, VulkanPipeline::MakeDepthOnlyConfig(pipelineConfig));
+    defaultEqualPipeline_.initialize(&context_, &swapChain_, &descriptorPool_, &shaderManager_, VulkanPipeline::MakeDepthEqualConfig(pipelineConfig));
+    pipelineConfig.depthOnlyVertexShaderPath.clear();
+    pipelineConfig.vertexSpecializationConstants.clear();
 
 
     pipelineConfig.pipelineName = "skybox";
@@ -94,6 +130,13 @@ void VulkanApp::initVulkan() {
 
     tonemappingPipeline_.initialize(&context_, &swapChain_, &descriptorPool_, &shaderManager_, tonemappingConfig);
 
+    // GPU 컬링 (인스턴스 데이터는 BDA, LATE 단계의 Hi-Z만 디스크립터로 바인딩)
+    sceneScatterPipeline_.initialize(&context_, &descriptorPool_, &shaderManager_, "shaders/scene_scatter.comp.spv");
+    cullPipeline_.initialize(&context_, &descriptorPool_, &shaderManager_, "shaders/cull.comp.spv");
+    clusterCullPipeline_.initialize(&context_, &descriptorPool_, &shaderManager_, "shaders/cluster_cull.comp.spv");
+    hizDownsamplePipeline_.initialize(&context_, &descriptorPool_, &shaderManager_, "shaders/hiz_downsample.comp.spv");
+    hizPyramid_ = std::make_unique<HiZPyramid>(&context_, &descriptorPool_, hizDownsamplePipeline_, sceneRenderTarget_);
+
 
     std::unordered_map<std::string, std::vector<std::string>> pipelineDescriptorSetsMap;
     std::string pipelineName = "default";
@@ -105,11 +148,14 @@ void VulkanApp::initVulkan() {
     pipelineDescriptorSetsMap[pipelineName] = descriptorSetNames;
 
 	resources_["materialTextures"] = &textureArray_;
-	resources_["materialData"] = &materialUbArray_;
-	resources_["ubo"] = &modelUbArray_;
-	resources_["boneData"] = &boneUbArray_;
+	resources_["materialData"] = &materialTable_;
+	// 같은 팔레트 버퍼의 세 가지 뷰, 특수화된 경로 하나만 실제로 읽습니다.
+	resources_["bonePaletteWindows"] = bonePalettePool_.getWindowView();
+	resources_["bonePalette"] = &bonePalettePool_;
+	resources_["bonePaletteTexels"] = bonePalettePool_.getTexelView();
 	resources_["skyboxSampler"] = envCubemapTexture_.get();
 	resources_["hdrSceneTexture"] = sceneRenderTarget_.getColorTexture();
+	resources_["hizPyramid"] = hizPyramid_.get();
 
 	// Default Pipeline Descriptor Set ����
     {
@@ -128,11 +174,37 @@ void VulkanApp::initVulkan() {
             }
 
             DescriptorSet descriptorSet{};
-            descriptorSet.initialize(&context_, &descriptorPool_, descriptorPool_.layoutCache_.getLayout(layoutBindings), requiredResources);
+            descriptorSet.initialize(&context_, &descriptorPool_, descriptorPool_.layoutCache_.getLayout(layoutBindings), requiredResources, MAX_FRAMES_IN_FLIGHT);
             commonDescriptorSet_.push_back(std::move(descriptorSet));
 			descriptorSets.push_back(commonDescriptorSet_.back());
 		}
         defaultPipeline_.setDescriptorSets(descriptorSets);
+        // 같은 셰이더로 만든 변형이라 레이아웃이 같으므로 디스크립터 셋을 함께 씁니다.
+        defaultEqualPipeline_.setDescriptorSets(descriptorSets);
+    }
+
+    // Depth Prepass Pipeline Descriptor Set 생성 (버텍스 셰이더가 쓰는 바인딩만)
+    {
+        std::vector<DescriptorSet> descriptorSets;
+
+        const std::map<uint32_t, std::map<uint32_t, LayoutBindingInfo>>& bindingMap = depthPrepassPipeline_.GetDescriptorSetLayoutBindingMap();
+        for (const auto& [setIndex, bindings] : bindingMap) {
+            std::vector< VkDescriptorSetLayoutBinding> layoutBindings;
+            std::vector<Resource*> requiredResources;
+            for (const auto& [bindingIndex, layoutBinding] : bindings) {
+                layoutBindings.push_back(layoutBinding.bindingInfo);
+                if (resources_.find(layoutBinding.resourceName) != resources_.end())
+                {
+                    requiredResources.push_back(resources_[layoutBinding.resourceName]);
+                }
+            }
+
+            DescriptorSet descriptorSet{};
+            descriptorSet.initialize(&context_, &descriptorPool_, descriptorPool_.layoutCache_.getLayout(layoutBindings), requiredResources, MAX_FRAMES_IN_FLIGHT);
+            commonDescriptorSet_.push_back(std::move(descriptorSet));
+            descriptorSets.push_back(commonDescriptorSet_.back());
+        }
+        depthPrepassPipeline_.setDescriptorSets(descriptorSets);
     }
 
     // Skybox Pipeline Descriptor Set ����
@@ -152,7 +224,7 @@ void VulkanApp::initVulkan() {
             }
 
             DescriptorSet descriptorSet{};
-            descriptorSet.initialize(&context_, &descriptorPool_, descriptorPool_.layoutCache_.getLayout(layoutBindings), requiredResources);
+            descriptorSet.initialize(&context_, &descriptorPool_, descriptorPool_.layoutCache_.getLayout(layoutBindings), requiredResources, MAX_FRAMES_IN_FLIGHT);
             commonDescriptorSet_.push_back(std::move(descriptorSet));
             descriptorSets.push_back(commonDescriptorSet_.back());
         }
@@ -176,33 +248,68 @@ void VulkanApp::initVulkan() {
             }
 
             DescriptorSet descriptorSet{};
-            descriptorSet.initialize(&context_, &descriptorPool_, descriptorPool_.layoutCache_.getLayout(layoutBindings), requiredResources);
+            descriptorSet.initialize(&context_, &descriptorPool_, descriptorPool_.layoutCache_.getLayout(layoutBindings), requiredResources, MAX_FRAMES_IN_FLIGHT);
             commonDescriptorSet_.push_back(std::move(descriptorSet));
             descriptorSets.push_back(commonDescriptorSet_.back());
         }
         tonemappingPipeline_.setDescriptorSets(descriptorSets);
     }
 
+    // Cull Pipeline Descriptor Set 생성
+    {
+        std::vector<DescriptorSet> descriptorSets;
+
+        const std::map<uint32_t, std::map<uint32_t, LayoutBindingInfo>>& bindingMap = cullPipeline_.GetDescriptorSetLayoutBindingMap();
+        for (const auto& [setIndex, bindings] : bindingMap) {
+            std::vector< VkDescriptorSetLayoutBinding> layoutBindings;
+            std::vector<Resource*> requiredResources;
+            for (const auto& [bindingIndex, layoutBinding] : bindings) {
+                layoutBindings.push_back(layoutBinding.bindingInfo);
+                if (resources_.find(layoutBinding.resourceName) != resources_.end())
+                {
+                    requiredResources.push_back(resources_[layoutBinding.resourceName]);
+                }
+            }
+
+            DescriptorSet descriptorSet{};
+            descriptorSet.initialize(&context_, &descriptorPool_, descriptorPool_.layoutCache_.getLayout(layoutBindings), requiredResources, MAX_FRAMES_IN_FLIGHT);
+            commonDescriptorSet_.push_back(std::move(descriptorSet));
+            descriptorSets.push_back(commonDescriptorSet_.back());
+        }
+        cullPipeline_.setDescriptorSets(descriptorSets);
+    }
+
     createCommandBuffers();
     createSyncObjects();
 }
 
 
 void VulkanApp::createCommandBuffers() {
-    commandBuffers.resize(MAX_FRAMES_IN_FLIGHT);
-
-    VkCommandBufferAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    allocInfo.commandPool = context_.getCommandPool();
-    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    allocInfo.commandBufferCount = (uint32_t) commandBuffers.size();
+    // 세그먼트 수는 렌더 그래프와 비동기 컴퓨트 설정에 따라 달라지므로 버퍼는 getFrameCommandBuffer에서 할당합니다.
+    for (auto& queueCommandBuffers : commandBuffers) {
+        queueCommandBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+    }
+}
 
-    if (vkAllocateCommandBuffers(context_.getDevice(), &allocInfo, commandBuffers.data()) != VK_SUCCESS) {
-        throw std::runtime_error("failed to allocate command buffers!");
+VkCommandBuffer VulkanApp::getFrameCommandBuffer(RenderGraphQueue queue, uint32_t segment) {
+    std::vector<VkCommandBuffer>& frameCommandBuffers = commandBuffers[static_cast<size_t>(queue)][currentFrame];
+    while (frameCommandBuffers.size() <= segment) {
+        VkCommandBufferAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.commandPool = (queue == RenderGraphQueue::Compute) ? context_.getComputeCommandPool() : context_.getCommandPool();
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocInfo.commandBufferCount = 1;
+
+        VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+        if (vkAllocateCommandBuffers(context_.getDevice(), &allocInfo, &commandBuffer) != VK_SUCCESS) {
+            throw std::runtime_error("failed to allocate command buffers!");
+        }
+        frameCommandBuffers.push_back(commandBuffer);
     }
+    return frameCommandBuffers[segment];
 }
 
-void VulkanApp::recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex) {
+void VulkanApp::recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t segment, uint32_t imageIndex, bool useSecondaryCommandBuffers) {
     VkCommandBufferBeginInfo beginInfo{};
     beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
 
@@ -210,72 +317,139 @@ void VulkanApp::recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imag
         throw std::runtime_error("failed to begin recording command buffer!");
     }
 
-    VkImageMemoryBarrier imageBarrier{};
-    imageBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-    imageBarrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    // VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL -> VK_IMAGE_LAYOUT_ATTACHMENT_OPTIMAL_KHR
-    imageBarrier.newLayout = VK_IMAGE_LAYOUT_ATTACHMENT_OPTIMAL_KHR;
-    imageBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    imageBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    imageBarrier.image = swapChain_.getSwapChainImages()[imageIndex];
-    imageBarrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    imageBarrier.subresourceRange.baseMipLevel = 0;
-    imageBarrier.subresourceRange.levelCount = 1;
-    imageBarrier.subresourceRange.baseArrayLayer = 0;
-    imageBarrier.subresourceRange.layerCount = 1;
-    imageBarrier.srcAccessMask = 0;
-    imageBarrier.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-
-    vkCmdPipelineBarrier(commandBuffer,
-                         VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
-                         VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-                         0, 0, nullptr, 0, nullptr, 1, &imageBarrier);
-    {
-        // VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL -> VK_IMAGE_LAYOUT_ATTACHMENT_OPTIMAL_KHR
-        sceneRenderTarget_.getColorTexture()->transitionLayout_Cmd(
-            commandBuffer,
-            VK_IMAGE_LAYOUT_ATTACHMENT_OPTIMAL_KHR);
+    // 패스 기록 함수들이 참조하는 이번 프레임의 값
+    frameImageIndex_ = imageIndex;
+    recordWithSecondaries_ = useSecondaryCommandBuffers;
 
-        auto renderingInfo = sceneRenderTarget_.getRenderingInfo();
-        //auto renderingInfo = swapChain_.getRenderingInfo(imageIndex);
-        vkCmdBeginRendering(commandBuffer, &renderingInfo);
+    // 패스 순서와 패스 사이의 레이아웃 전환/배리어는 렌더 그래프가 컴파일 시점에 정해 둡니다.
+    RenderGraph& renderGraph = depthPrepassEnabled_ ? depthPrepassRenderGraph_ : renderGraph_;
+    renderGraph.setImage(renderGraph.findResource("swapchain"), swapChain_.getSwapChainImages()[imageIndex], VK_IMAGE_ASPECT_COLOR_BIT);
+    renderGraph.setImage(renderGraph.findResource("hizPyramid"), hizPyramid_->getImage(), VK_IMAGE_ASPECT_COLOR_BIT);
+    renderGraph.executeSegment(commandBuffer, segment);
 
-        defaultPipeline_.bindPipeline(commandBuffer);
+    if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
+        throw std::runtime_error("failed to record command buffer!");
+    }
+}
 
-        for (Model& model : models_)
-        {
-            PushConstantData pushData{};
-            model.getPushConstantData(pushData);
-
-            vkCmdPushConstants(
-                commandBuffer,
-                defaultPipeline_.getPipelineLayout(),
-                VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-                0,
-                sizeof(PushConstantData),
-                &pushData
-            );
-            model.draw(commandBuffer);
-        }
+void VulkanApp::recordSceneDraws(VkCommandBuffer commandBuffer, const VkCommandBufferInheritanceRenderingInfo& inheritance,
+    uint32_t itemCount, const ParallelCommandRecorder::RecordFunc& recordFunc)
+{
+    // 씬 패스의 드로우는 워커 스레드가 secondary 커맨드 버퍼에 나눠 기록합니다.
+    // secondary는 상태를 물려받지 않으므로 워커마다 파이프라인과 푸시 상수를 다시 바인딩합니다.
+    // 캐시할 커맨드 버퍼는 secondary가 프레임마다 리셋되므로 primary에 직접 기록합니다.
+    if (recordWithSecondaries_) {
+        commandRecorder_.recordAndExecute(commandBuffer, inheritance, itemCount, recordFunc);
+    }
+    else {
+        CommandEncoder encoder(commandBuffer);
+        recordFunc(encoder, 0, itemCount);
+    }
+}
 
+void VulkanApp::buildRenderGraphs()
+{
+    auto scenePhase = [this](VulkanPipeline& pipeline, InstanceBatcher::CullPhase phase) {
+        return ParallelCommandRecorder::RecordFunc(
+            [this, &pipeline, phase](CommandEncoder& encoder, uint32_t batchBegin, uint32_t batchEnd) {
+                pipeline.bindPipeline(encoder, static_cast<uint32_t>(currentFrame));
+                instanceBatcher_.drawRange(encoder, pipeline.getPipelineLayout(), phase, batchBegin, batchEnd);
+            });
+    };
+    // secondary로 기록하는 렌더링 안에서는 primary에 직접 드로우할 수 없으므로 스카이박스도 같은 경로로 기록합니다.
+    auto recordSkybox = [this](VkCommandBuffer commandBuffer) {
+        recordSceneDraws(commandBuffer, sceneRenderTarget_.getInheritanceRenderingInfo(), 1,
+            [this](CommandEncoder& encoder, uint32_t, uint32_t) {
+                skyboxPipeline_.bindPipeline(encoder, static_cast<uint32_t>(currentFrame));
+                skyboxModel_->draw(encoder.getCommandBuffer());
+            });
+    };
+    auto sceneRenderingFlags = [this]() -> VkRenderingFlags {
+        return recordWithSecondaries_ ? VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT : 0;
+    };
 
-        skyboxPipeline_.bindPipeline(commandBuffer);
-        skyboxModel_->draw(commandBuffer);
+    // 패스 이름 -> 기록 함수. 어떤 패스를 어떤 순서로 쓸지는 rendergraphs/*.json이 정합니다.
+    std::unordered_map<std::string, RenderGraph::ExecuteFunc> executors;
+
+    // 컬링과 드로우 인자 생성은 렌더링 패스 시작 전에 GPU에서 처리합니다.
+    // EARLY: 지난 프레임에 보였던 인스턴스만 그려 깊이를 채우고, LATE: 그 깊이로 만든 Hi-Z로 전체를 다시 검사합니다.
+    // 그 전에 이번 프레임에 바뀐 오브젝트 레코드를 GPU 씬에 흩뿌립니다.
+    executors["sceneUpload"] = [this](VkCommandBuffer commandBuffer) {
+        gpuScene_.recordScatter(commandBuffer, sceneScatterPipeline_);
+    };
+    executors["cullEarly"] = [this](VkCommandBuffer commandBuffer) {
+        instanceBatcher_.cull(commandBuffer, cullPipeline_, InstanceBatcher::CULL_PHASE_EARLY);
+        instanceBatcher_.cullClusters(commandBuffer, clusterCullPipeline_, InstanceBatcher::CULL_PHASE_EARLY);
+    };
+    executors["cullLate"] = [this](VkCommandBuffer commandBuffer) {
+        instanceBatcher_.cull(commandBuffer, cullPipeline_, InstanceBatcher::CULL_PHASE_LATE);
+        instanceBatcher_.cullClusters(commandBuffer, clusterCullPipeline_, InstanceBatcher::CULL_PHASE_LATE);
+    };
+    executors["hizBuild"] = [this](VkCommandBuffer commandBuffer) {
+        hizPyramid_->build(commandBuffer, hizDownsamplePipeline_);
+    };
 
+    // 모델마다가 아니라 고유 메시마다 간접 드로우 한 번씩 기록합니다.
+    executors["sceneEarly"] = [this, scenePhase, sceneRenderingFlags](VkCommandBuffer commandBuffer) {
+        auto renderingInfo = sceneRenderTarget_.getRenderingInfo();
+        renderingInfo.flags = sceneRenderingFlags();
+        vkCmdBeginRendering(commandBuffer, &renderingInfo);
+        recordSceneDraws(commandBuffer, sceneRenderTarget_.getInheritanceRenderingInfo(), instanceBatcher_.getDrawCount(),
+            scenePhase(defaultPipeline_, InstanceBatcher::CULL_PHASE_EARLY));
         vkCmdEndRendering(commandBuffer);
-    }
-    // VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL -> VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL_KHR
-    sceneRenderTarget_.getColorTexture()->transitionLayout_Cmd(
-        commandBuffer,
-        VK_IMAGE_LAYOUT_READ_ONLY_OPTIMAL_KHR);
+    };
+    // 새로 보이게 된 인스턴스를 얼리 패스 결과 위에 이어 그립니다.
+    executors["sceneLate"] = [this, scenePhase, recordSkybox, sceneRenderingFlags](VkCommandBuffer commandBuffer) {
+        auto renderingInfo = sceneRenderTarget_.getRenderingInfo(VK_ATTACHMENT_LOAD_OP_LOAD);
+        renderingInfo.flags = sceneRenderingFlags();
+        vkCmdBeginRendering(commandBuffer, &renderingInfo);
+        recordSceneDraws(commandBuffer, sceneRenderTarget_.getInheritanceRenderingInfo(), instanceBatcher_.getDrawCount(),
+            scenePhase(defaultPipeline_, InstanceBatcher::CULL_PHASE_LATE));
+        recordSkybox(commandBuffer);
+        vkCmdEndRendering(commandBuffer);
+    };
 
-    {
-        auto renderingInfo = swapChain_.getRenderingInfo(imageIndex);
-        renderingInfo.pDepthAttachment = nullptr;
+    // 깊이 프리패스: 얼리/레이트 패스는 깊이만 쓰고, 셰이딩은 마지막 컬러 패스에서
+    // 깊이가 같은(EQUAL) 픽셀에 대해서만 한 번씩 합니다. 오버드로우가 많은 장면에서 프래그먼트 비용이 줄어듭니다.
+    // 프래그먼트 셰이더가 없으므로 두 패스의 GPU 시간을 버텍스 단계 비용으로 봅니다. (본 백엔드 비교)
+    executors["depthEarly"] = [this, scenePhase, sceneRenderingFlags](VkCommandBuffer commandBuffer) {
+        gpuTimer_.beginScope(commandBuffer, static_cast<uint32_t>(currentFrame), GPU_SCOPE_DEPTH_EARLY);
+        auto renderingInfo = sceneRenderTarget_.getDepthOnlyRenderingInfo();
+        renderingInfo.flags = sceneRenderingFlags();
+        vkCmdBeginRendering(commandBuffer, &renderingInfo);
+        recordSceneDraws(commandBuffer, sceneRenderTarget_.getDepthOnlyInheritanceRenderingInfo(), instanceBatcher_.getDrawCount(),
+            scenePhase(depthPrepassPipeline_, InstanceBatcher::CULL_PHASE_EARLY));
+        vkCmdEndRendering(commandBuffer);
+        gpuTimer_.endScope(commandBuffer, static_cast<uint32_t>(currentFrame), GPU_SCOPE_DEPTH_EARLY);
+    };
+    executors["depthLate"] = [this, scenePhase, sceneRenderingFlags](VkCommandBuffer commandBuffer) {
+        gpuTimer_.beginScope(commandBuffer, static_cast<uint32_t>(currentFrame), GPU_SCOPE_DEPTH_LATE);
+        auto renderingInfo = sceneRenderTarget_.getDepthOnlyRenderingInfo(VK_ATTACHMENT_LOAD_OP_LOAD);
+        renderingInfo.flags = sceneRenderingFlags();
+        vkCmdBeginRendering(commandBuffer, &renderingInfo);
+        recordSceneDraws(commandBuffer, sceneRenderTarget_.getDepthOnlyInheritanceRenderingInfo(), instanceBatcher_.getDrawCount(),
+            scenePhase(depthPrepassPipeline_, InstanceBatcher::CULL_PHASE_LATE));
+        vkCmdEndRendering(commandBuffer);
+        gpuTimer_.endScope(commandBuffer, static_cast<uint32_t>(currentFrame), GPU_SCOPE_DEPTH_LATE);
+    };
+    // 완성된 깊이를 읽기만 하면서 얼리/레이트 인스턴스를 모두 셰이딩합니다.
+    executors["shade"] = [this, scenePhase, recordSkybox, sceneRenderingFlags](VkCommandBuffer commandBuffer) {
+        auto renderingInfo = sceneRenderTarget_.getRenderingInfo(VK_ATTACHMENT_LOAD_OP_CLEAR, VK_ATTACHMENT_LOAD_OP_LOAD);
+        renderingInfo.flags = sceneRenderingFlags();
+        vkCmdBeginRendering(commandBuffer, &renderingInfo);
+        const VkCommandBufferInheritanceRenderingInfo inheritance = sceneRenderTarget_.getInheritanceRenderingInfo();
+        recordSceneDraws(commandBuffer, inheritance, instanceBatcher_.getDrawCount(), scenePhase(defaultEqualPipeline_, InstanceBatcher::CULL_PHASE_EARLY));
+        recordSceneDraws(commandBuffer, inheritance, instanceBatcher_.getDrawCount(), scenePhase(defaultEqualPipeline_, InstanceBatcher::CULL_PHASE_LATE));
+        recordSkybox(commandBuffer);
+        vkCmdEndRendering(commandBuffer);
+    };
+
+    executors["tonemap"] = [this](VkCommandBuffer commandBuffer) {
+        auto renderingInfo = swapChain_.getRenderingInfo(frameImageIndex_);
 
         vkCmdBeginRendering(commandBuffer, &renderingInfo);
 
-        tonemappingPipeline_.bindPipeline(commandBuffer);
+        tonemappingPipeline_.bindPipeline(commandBuffer, static_cast<uint32_t>(currentFrame));
 
         //struct PushConstants { float exposure; } pushConstants;
         vkCmdPushConstants(commandBuffer, tonemappingPipeline_.getPipelineLayout(),
@@ -284,21 +458,45 @@ void VulkanApp::recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imag
         vkCmdDraw(commandBuffer, 3, 1, 0, 0);
 
         vkCmdEndRendering(commandBuffer);
-    }
+    };
 
-    // VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL -> VK_IMAGE_LAYOUT_ATTACHMENT_OPTIMAL_KHR
-    imageBarrier.oldLayout = VK_IMAGE_LAYOUT_ATTACHMENT_OPTIMAL_KHR;
-    imageBarrier.newLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-    imageBarrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-    imageBarrier.dstAccessMask = 0;
+    renderGraph_.loadFromJson("rendergraphs/forward.json", executors);
+    depthPrepassRenderGraph_.loadFromJson("rendergraphs/forward_prepass.json", executors);
+
+    // 씬 컬러/깊이는 풀에서 받습니다. 두 그래프의 사용 구간을 모두 알려준 뒤 이미지를 만들고,
+    // 어떤 이미지끼리 메모리를 겹쳐 쓰는지 정해지면 그 배리어를 넣어 다시 컴파일합니다.
+    for (RenderGraph* renderGraph : { &renderGraph_, &depthPrepassRenderGraph_ }) {
+        renderGraph->bindTransientImage(renderGraph->findResource("sceneColor"), &transientPool_,
+            sceneRenderTarget_.getColorImageId(), VK_IMAGE_ASPECT_COLOR_BIT);
+        renderGraph->bindTransientImage(renderGraph->findResource("sceneDepth"), &transientPool_,
+            sceneRenderTarget_.getDepthImageId(), sceneRenderTarget_.getDepthAspectMask());
+        renderGraph->declareTransientLifetimes();
+    }
+    transientPool_.build();
+    applyAsyncCompute();
 
-    vkCmdPipelineBarrier(commandBuffer,
-                         VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-                         VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
-                         0, 0, nullptr, 0, nullptr, 1, &imageBarrier);
+    std::cout << "Transient attachments: " << transientPool_.getPhysicalImageCount() << " images ("
+        << transientPool_.getLazyImageCount() << " lazily allocated), "
+        << transientPool_.getRequestedBytes() / (1024 * 1024) << " MB requested, "
+        << transientPool_.getAllocatedBytes() / (1024 * 1024) << " MB allocated" << std::endl;
+}
 
-    if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
-        throw std::runtime_error("failed to record command buffer!");
+void VulkanApp::applyAsyncCompute()
+{
+    // 컴퓨트 패밀리를 그래픽스와 같게 주면 그래프가 모든 패스를 그래픽스 큐 하나에 기록합니다.
+    const uint32_t graphicsFamily = context_.getGraphicsQueueFamily();
+    const uint32_t computeFamily = asyncComputeEnabled_ ? context_.getComputeQueueFamily() : graphicsFamily;
+    for (RenderGraph* renderGraph : { &renderGraph_, &depthPrepassRenderGraph_ }) {
+        renderGraph->setQueueFamilies(graphicsFamily, computeFamily);
+        renderGraph->compile();
+
+        std::cout << "Render graph:";
+        for (RenderGraph::PassId pass : renderGraph->getExecutionOrder()) {
+            std::cout << " " << renderGraph->getPassName(pass);
+        }
+        std::cout << " (culled " << renderGraph->getCulledPassCount() << ", " << renderGraph->getBarrierCount()
+            << " barriers in " << renderGraph->getBarrierBatchCount() << " batches, " << renderGraph->getSegmentCount()
+            << " queue segments, " << renderGraph->getQueueTransferCount() << " ownership transfers)" << std::endl;
     }
 }
 
@@ -328,6 +526,17 @@ void VulkanApp::createSyncObjects() {
             throw std::runtime_error("failed to create synchronization objects for a frame!");
         }
     }
+
+    VkSemaphoreTypeCreateInfo timelineInfo{};
+    timelineInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+    timelineInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+    timelineInfo.initialValue = 0;
+    semaphoreInfo.pNext = &timelineInfo;
+    for (VkSemaphore& timeline : queueTimelines_) {
+        if (vkCreateSemaphore(context_.getDevice(), &semaphoreInfo, nullptr, &timeline) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create timeline semaphore!");
+        }
+    }
 }
 
 void VulkanApp::mainLoop() {
@@ -338,6 +547,11 @@ void VulkanApp::mainLoop() {
     std::cout << "2: Reinhard Tonemap" << std::endl;
     std::cout << "3: Reinhard Extended Tonemap" << std::endl;
     std::cout << "4: Simple Exposure Tonemap" << std::endl;
+    std::cout << "P: Print Command Encoder Stats" << std::endl;
+    std::cout << "C: Toggle Command Buffer Cache" << std::endl;
+    std::cout << "Z: Toggle Depth Prepass" << std::endl;
+    std::cout << "X: Toggle Async Compute" << std::endl;
+    std::cout << "B: Cycle Bone Backend" << std::endl;
     std::cout << "===================" << std::endl;
 
     while (!glfwWindowShouldClose(window)) {
@@ -381,6 +595,9 @@ void VulkanApp::cleanup() {
     {
         vkDestroySemaphore(context_.getDevice(), renderFinishedSemaphores[i], nullptr);
     }
+    for (VkSemaphore timeline : queueTimelines_) {
+        vkDestroySemaphore(context_.getDevice(), timeline, nullptr);
+    }
 
     glfwDestroyWindow(window);
     glfwTerminate();
@@ -395,7 +612,7 @@ void VulkanApp::update()
 	static float totalTime = 0.0f;
 	float checkTime[2] = { 0.0f, 0.0f };
 	totalTime += dt;
-    if (count > 0 && totalTime >= checkTime[2-count])
+    if (!boneBenchmark_ && count > 0 && totalTime >= checkTime[2-count])
     {
         count--;
         ModelConfig modelConfig{};
@@ -404,22 +621,69 @@ void VulkanApp::update()
         modelConfig.modelFilename = "mouseModel.fbx";
         //modelConfig.animationFilenames.push_back("Hip Hop Dancing_cleaned.fbx");
         modelConfig.animationFilenames.push_back("mouseModelAnim.fbx");
-        models_.push_back(Model(&context_, modelConfig));
-        models_.back().prepareBindless(modelUbArray_, materialUbArray_, boneUbArray_, textureArray_);
+        asyncModelLoader_.requestModel(modelConfig);
     }
-    for(auto& descriptorSet : commonDescriptorSet_)
+
+    // 업로드까지 끝난 모델만 씬에 추가합니다. (파일 I/O는 워커 스레드에서 처리)
+    asyncModelLoader_.update();
+    ModelHandle readyHandle = INVALID_MODEL_HANDLE;
+    std::unique_ptr<Model> readyModel;
+    while (asyncModelLoader_.popReadyModel(readyHandle, readyModel))
     {
-        descriptorSet.updateIfDirty();
-	}
+        models_.push_back(std::move(*readyModel));
+        models_.back().prepareBindless(materialTable_, bonePalettePool_, textureArray_);
+        models_.back().registerObjects(gpuScene_);
+        instanceListDirty_ = true;
+    }
     for(Model& model : models_)
     {
-        model.update(dt);
+        model.update(dt, bonePalettePool_);
 	}
+    // 새 재질을 올리고, 테이블을 키웠으면 아래에서 디스크립터가 새 버퍼를 가리키도록 갱신됩니다.
+    materialTable_.flush(static_cast<uint32_t>(currentFrame));
+    // 모델들이 바꾼 팔레트를 이 슬롯에 한 번에 복사합니다. 풀이 커졌으면 팔레트 뷰 디스크립터도 아래에서 갱신됩니다.
+    bonePalettePool_.flush(static_cast<uint32_t>(currentFrame));
+    if (!bonePalettePool_.isBackendSupported(boneBackend_)) {
+        // 풀이 커져 UBO 창 수나 텍셀 수 제한을 넘었으면 항상 쓸 수 있는 SSBO로 바꿉니다.
+        // setBoneBackend가 장치 유휴를 기다린 뒤 파이프라인을 바꾸므로 비행 중인 프레임과 겹치지 않고,
+        // 아래 디스크립터 갱신과 이번 프레임 기록보다 먼저 끝납니다.
+        if (!boneBackendFallbackReported_) {
+            std::cout << "Bone Backend: " << GetBoneBackendName(boneBackend_) << " cannot cover "
+                      << bonePalettePool_.getStats().capacity << " matrices per slot, falling back to "
+                      << GetBoneBackendName(BoneBackend::Storage) << std::endl;
+            boneBackendFallbackReported_ = true;
+        }
+        setBoneBackend(BoneBackend::Storage);
+    }
+    for(auto& descriptorSet : commonDescriptorSet_)
+    {
+        // 위에서 이 슬롯의 펜스를 기다렸으므로 이 슬롯의 사본만 다시 씁니다. 다른 슬롯은 아직 GPU가 읽고 있을 수 있습니다.
+        // 바인딩된 셋을 갱신하면 그 셋으로 기록한 커맨드 버퍼는 무효가 됩니다.
+        if (descriptorSet.updateIfDirty(static_cast<uint32_t>(currentFrame))) {
+            sceneVersion_++;
+        }
+	}
+    // 같은 리소스를 여러 셋이 공유하므로 모든 셋을 본 뒤에 지웁니다.
+    for (auto& [name, resource] : resources_) {
+        resource->ClearBufferInfosDirty();
+    }
 }
 
 void VulkanApp::drawFrame() {
+    if (softwareOcclusionEnabled_) {
+        // 펜스 대기(이전 프레임 GPU 작업) 동안 워커 스레드가 가림 컬링을 진행합니다.
+        kickSoftwareOcclusion();
+    }
     vkWaitForFences(context_.getDevice(), 1, &inFlightFences[currentFrame], VK_TRUE, UINT64_MAX);
-
+    // 끝난 업로드 배치의 스테이징 버퍼를 회수합니다. (모델 로더는 update()에서 같은 타임라인을 폴링합니다)
+    context_.getUploadManager().retire();
+    // 이 슬롯의 유니폼 구간도 GPU 사용이 끝났으므로 처음부터 다시 씁니다.
+    frameUniforms_.beginFrame(static_cast<uint32_t>(currentFrame));
+    // 이 슬롯의 지난 제출에서 잰 구간 시간
+    const bool hasGpuTimes = gpuTimer_.resolve(static_cast<uint32_t>(currentFrame), gpuScopeTimes_);
+    if (boneBenchmark_) {
+        updateBoneBackendBenchmark(hasGpuTimes);
+    }
 
     update();
     uint32_t imageIndex;
@@ -427,38 +691,57 @@ void VulkanApp::drawFrame() {
 
     if (result == VK_ERROR_OUT_OF_DATE_KHR) {
         swapChain_.recreate();
+        sceneVersion_++;
         return;
     } else if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
         throw std::runtime_error("failed to acquire swap chain image!");
     }
 
     vkResetFences(context_.getDevice(), 1, &inFlightFences[currentFrame]);
+    // 이 프레임 슬롯의 secondary는 펜스 대기로 GPU 사용이 끝났으므로 풀을 통째로 리셋합니다.
+    commandRecorder_.beginFrame(static_cast<uint32_t>(currentFrame));
 
-    vkResetCommandBuffer(commandBuffers[currentFrame], 0);
-    recordCommandBuffer(commandBuffers[currentFrame], imageIndex);
+    // 인스턴스 배치를 먼저 만들어야 커맨드 버퍼에 기록할 수 있습니다.
     updateUniformBuffer(currentFrame);
+    if (instanceBatcher_.getRecordVersion() != lastBatchRecordVersion_) {
+        lastBatchRecordVersion_ = instanceBatcher_.getRecordVersion();
+        sceneVersion_++;
+    }
+    if (gpuScene_.getRecordVersion() != lastSceneRecordVersion_) {
+        lastSceneRecordVersion_ = gpuScene_.getRecordVersion();
+        sceneVersion_++;
+    }
 
+    // 렌더 그래프의 큐 세그먼트마다 커맨드 버퍼 하나씩 기록합니다.
+    // 캐시 모드에서는 카메라만 움직이는 프레임에 기록 없이 이전 커맨드 버퍼를 다시 제출합니다.
+    const RenderGraph& renderGraph = depthPrepassEnabled_ ? depthPrepassRenderGraph_ : renderGraph_;
+    std::vector<VkCommandBuffer> segmentCommandBuffers(renderGraph.getSegmentCount());
+    uint32_t queueSegmentCounts[static_cast<size_t>(RenderGraphQueue::Count)] = {};
+    for (uint32_t segment = 0; segment < renderGraph.getSegmentCount(); ++segment) {
+        const RenderGraphQueue queue = renderGraph.getSegmentQueue(segment);
+        const uint32_t queueSegment = queueSegmentCounts[static_cast<size_t>(queue)]++;
+        VkCommandBuffer& commandBuffer = segmentCommandBuffers[segment];
+        if (commandBufferCacheEnabled_) {
+            CommandBufferCache& cache = (queue == RenderGraphQueue::Compute) ? computeCommandBufferCache_ : commandBufferCache_;
+            bool needsRecording = false;
+            commandBuffer = cache.acquire(static_cast<uint32_t>(currentFrame), imageIndex, queueSegment, sceneVersion_, needsRecording);
+            if (needsRecording) {
+                recordCommandBuffer(commandBuffer, segment, imageIndex, false);
+            }
+        }
+        else {
+            commandBuffer = getFrameCommandBuffer(queue, queueSegment);
+            vkResetCommandBuffer(commandBuffer, 0);
+            recordCommandBuffer(commandBuffer, segment, imageIndex, true);
+        }
+    }
 
-    VkSubmitInfo submitInfo{};
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-
-    VkSemaphore waitSemaphores[] = {imageAvailableSemaphores[currentFrame]};
-    VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
-    submitInfo.waitSemaphoreCount = 1;
-    submitInfo.pWaitSemaphores = waitSemaphores;
-    submitInfo.pWaitDstStageMask = waitStages;
-
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &commandBuffers[currentFrame];
+    // 대기 중인 스트리밍 업로드를 프레임 예산만큼 스테이징하고, 이번 프레임까지 기록된 업로드를 전송 큐에 한 번에 제출합니다.
+    // 그래픽스 큐의 소유권 획득이 프레임 제출보다 먼저 들어가므로 새 텍스처를 이번 프레임부터 샘플링할 수 있습니다.
+    context_.getUploadManager().flushFrame();
+    submitRenderGraph(renderGraph, segmentCommandBuffers, imageIndex);
 
     VkSemaphore signalSemaphores[] = {renderFinishedSemaphores[imageIndex]};
-    submitInfo.signalSemaphoreCount = 1;
-    submitInfo.pSignalSemaphores = signalSemaphores;
-
-    if (vkQueueSubmit(context_.getGraphicsQueue(), 1, &submitInfo, inFlightFences[currentFrame]) != VK_SUCCESS) {
-        throw std::runtime_error("failed to submit draw command buffer!");
-    }
-
     VkPresentInfoKHR presentInfo{};
     presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
 
@@ -475,6 +758,7 @@ void VulkanApp::drawFrame() {
 
     if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR) {
         swapChain_.recreate();
+        sceneVersion_++;
     } else if (result != VK_SUCCESS) {
         throw std::runtime_error("failed to present swap chain image!");
     }
@@ -482,13 +766,156 @@ void VulkanApp::drawFrame() {
     currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
 }
 
-void VulkanApp::updateUniformBuffer(uint32_t currentImage) {
-    glm::mat4 viewMatrix = camera_->getViewMatrix();
-    glm::mat4 projMatrix = camera_->getProjectionMatrix(swapChain_.getSwapChainExtent().width / (float)swapChain_.getSwapChainExtent().height,
+void VulkanApp::submitRenderGraph(const RenderGraph& renderGraph, const std::vector<VkCommandBuffer>& segmentCommandBuffers, uint32_t imageIndex)
+{
+    // 세그먼트 i는 자기 큐의 타임라인을 (프레임 시작 값 + 그 큐에서 몇 번째 세그먼트인지 + 1)로 올립니다.
+    // 다른 큐의 세그먼트를 기다릴 때는 그 값을, 지난 프레임을 기다릴 때는 프레임 시작 값을 기다립니다.
+    // 컴퓨트 세그먼트는 그래픽스의 지난 프레임 꼬리를 기다리지 않으므로 다음 프레임 컬링이 이번 프레임 셰이딩과 겹칩니다.
+    const uint32_t segmentCount = renderGraph.getSegmentCount();
+    uint64_t frameBase[static_cast<size_t>(RenderGraphQueue::Count)];
+    std::vector<uint64_t> signalValues(segmentCount);
+    for (size_t queue = 0; queue < static_cast<size_t>(RenderGraphQueue::Count); ++queue) {
+        frameBase[queue] = queueTimelineValues_[queue];
+    }
+    for (uint32_t segment = 0; segment < segmentCount; ++segment) {
+        const size_t queue = static_cast<size_t>(renderGraph.getSegmentQueue(segment));
+        signalValues[segment] = ++queueTimelineValues_[queue];
+    }
+
+    const uint32_t swapchainSegment = renderGraph.getFirstSegment(renderGraph.findResource("swapchain"));
+    for (uint32_t segment = 0; segment < segmentCount; ++segment) {
+        const RenderGraphQueue queue = renderGraph.getSegmentQueue(segment);
+        const bool lastSegment = segment + 1 == segmentCount;
+
+        std::vector<VkSemaphoreSubmitInfo> waitInfos;
+        for (const RenderGraph::SegmentWait& wait : renderGraph.getSegmentWaits(segment)) {
+            VkSemaphoreSubmitInfo waitInfo{};
+            waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+            waitInfo.semaphore = queueTimelines_[static_cast<size_t>(wait.queue)];
+            waitInfo.value = (wait.segment == RenderGraph::PREVIOUS_FRAME) ? frameBase[static_cast<size_t>(wait.queue)] : signalValues[wait.segment];
+            waitInfo.stageMask = wait.stageMask;
+            waitInfos.push_back(waitInfo);
+        }
+        if (segment == swapchainSegment) {
+            VkSemaphoreSubmitInfo waitInfo{};
+            waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+            waitInfo.semaphore = imageAvailableSemaphores[currentFrame];
+            waitInfo.stageMask = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+            waitInfos.push_back(waitInfo);
+        }
+
+        VkSemaphoreSubmitInfo signalInfos[2]{};
+        signalInfos[0].sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+        signalInfos[0].semaphore = queueTimelines_[static_cast<size_t>(queue)];
+        signalInfos[0].value = signalValues[segment];
+        signalInfos[0].stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+        signalInfos[1].sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+        signalInfos[1].semaphore = renderFinishedSemaphores[imageIndex];
+        signalInfos[1].stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+
+        VkCommandBufferSubmitInfo commandBufferInfo{};
+        commandBufferInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
+        commandBufferInfo.commandBuffer = segmentCommandBuffers[segment];
+
+        VkSubmitInfo2 submitInfo{};
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
+        submitInfo.waitSemaphoreInfoCount = static_cast<uint32_t>(waitInfos.size());
+        submitInfo.pWaitSemaphoreInfos = waitInfos.empty() ? nullptr : waitInfos.data();
+        submitInfo.commandBufferInfoCount = 1;
+        submitInfo.pCommandBufferInfos = &commandBufferInfo;
+        // 마지막 세그먼트(그래픽스)가 프레젠트 세마포어와 프레임 펜스를 신호합니다.
+        submitInfo.signalSemaphoreInfoCount = lastSegment ? 2 : 1;
+        submitInfo.pSignalSemaphoreInfos = signalInfos;
+
+        VkQueue submitQueue = (queue == RenderGraphQueue::Compute) ? context_.getComputeQueue() : context_.getGraphicsQueue();
+        if (vkQueueSubmit2(submitQueue, 1, &submitInfo, lastSegment ? inFlightFences[currentFrame] : VK_NULL_HANDLE) != VK_SUCCESS) {
+            throw std::runtime_error("failed to submit draw command buffer!");
+        }
+    }
+}
+
+glm::mat4 VulkanApp::computeProjectionMatrix() const
+{
+    return camera_->getProjectionMatrix(swapChain_.getSwapChainExtent().width / (float)swapChain_.getSwapChainExtent().height,
         0.1f, 100.0f);
+}
 
+void VulkanApp::updateModelTransforms()
+{
     const float spacing = 2.0f;
     const glm::vec3 scaleFactors(0.02f);
+
+    if (boneBenchmark_) {
+        // 카메라(원점, -Z 방향) 앞쪽 멀리 격자로 세워 모든 인스턴스가 화면에 들어오게 합니다.
+        const uint32_t gridSize = boneBenchmark_->getSettings().gridSize;
+        for (uint32_t i = 0; i < models_.size(); ++i) {
+            const float column = static_cast<float>(i % gridSize) - static_cast<float>(gridSize - 1) / 2.0f;
+            const float row = static_cast<float>(i / gridSize);
+            glm::mat4 translationMatrix = glm::translate(glm::mat4(1.0f),
+                glm::vec3(column * spacing, 0.0f, -(static_cast<float>(gridSize) + row) * spacing));
+            models_[i].setWorldMatrix(translationMatrix * glm::scale(glm::mat4(1.0f), scaleFactors));
+        }
+        return;
+    }
+
+    for (int i = 0; i < models_.size(); ++i) {
+        float xPosition = (static_cast<float>(i) - (static_cast<float>(models_.size() - 1) / 2.0f)) * spacing;
+        glm::mat4 translationMatrix = glm::translate(glm::mat4(1.0f), glm::vec3(xPosition, 0.0f, 0.0f));
+        glm::mat4 scalingMatrix = glm::scale(glm::mat4(1.0f), scaleFactors);
+        glm::mat4 worldMatrix = translationMatrix * scalingMatrix;
+        models_[i].setWorldMatrix(worldMatrix);
+    }
+}
+
+void VulkanApp::setSoftwareOcclusionEnabled(bool enabled)
+{
+    // 워커 스레드는 처음 켤 때 만듭니다.
+    if (enabled && !softwareOcclusion_.isInitialized()) {
+        softwareOcclusion_.initialize();
+    }
+    softwareOcclusionEnabled_ = enabled;
+    // CPU 경로는 매 프레임 목록을 다시 만들고, GPU 전용 경로로 돌아오면 모든 모델로 한 번 다시 만듭니다.
+    instanceListDirty_ = true;
+}
+
+void VulkanApp::kickSoftwareOcclusion()
+{
+    updateModelTransforms();
+
+    occluders_.clear();
+    occludees_.resize(models_.size());
+    for (size_t i = 0; i < models_.size(); ++i) {
+        const Model& model = models_[i];
+        // 메시가 없으면 0 크기 박스로 두고, 그릴 것도 없으므로 결과는 무시됩니다.
+        model.getWorldBounds(occludees_[i].boundsMin, occludees_[i].boundsMax);
+
+        if (!model.isOccluder() || !model.getAsset()) {
+            continue;
+        }
+        // 정점 배열은 공유 에셋이 가지고 있으므로 작업 중에도 유효합니다.
+        for (const Mesh& mesh : model.getAsset()->meshes) {
+            const std::vector<Vertex>& vertices = mesh.getVertices();
+            const std::vector<uint32_t>& indices = mesh.getIndices();
+            if (vertices.empty() || indices.empty()) {
+                continue;
+            }
+            OccluderDesc occluder{};
+            occluder.positions = &vertices[0].pos.x;
+            occluder.stride = sizeof(Vertex);
+            occluder.vertexCount = vertices.size();
+            occluder.indices = indices.data();
+            occluder.indexCount = indices.size();
+            occluder.world = model.getWorldMatrix();
+            occluders_.push_back(occluder);
+        }
+    }
+
+    softwareOcclusion_.kick(computeProjectionMatrix() * camera_->getViewMatrix(), occluders_, occludees_);
+}
+
+void VulkanApp::updateUniformBuffer(uint32_t currentImage) {
+    glm::mat4 viewMatrix = camera_->getViewMatrix();
+    glm::mat4 projMatrix = computeProjectionMatrix();
     
     UniformBufferScene uboScene;
     uboScene.proj = projMatrix;
@@ -502,15 +929,61 @@ void VulkanApp::updateUniformBuffer(uint32_t currentImage) {
     uboScene.maxWhite = hdrMaxWhite;
     uboScene.tonemapOperator = tonemapMode;
     
-    sceneUB_->update(&uboScene);
-
-    for (int i = 0; i < models_.size(); ++i) {
-        float xPosition = (static_cast<float>(i) - (static_cast<float>(models_.size() - 1) / 2.0f)) * spacing;
-        glm::mat4 translationMatrix = glm::translate(glm::mat4(1.0f), glm::vec3(xPosition, 0.0f, 0.0f));
-        glm::mat4 scalingMatrix = glm::scale(glm::mat4(1.0f), scaleFactors);
-        glm::mat4 worldMatrix = translationMatrix * scalingMatrix;
-        models_[i].updateUniformBuffer(worldMatrix, viewMatrix, projMatrix);
+    const FrameUniformAllocation sceneAllocation = frameUniforms_.write(&uboScene, sizeof(uboScene));
+    frameUniforms_.setDynamicOffset(sceneAllocation.offset);
+    if (sceneUniformOffsets_[currentFrame] != frameUniforms_.getDynamicOffset()) {
+        sceneUniformOffsets_[currentFrame] = frameUniforms_.getDynamicOffset();
+        sceneVersion_++;
+    }
+    viewProjMatrix_ = projMatrix * viewMatrix;
+
+    if (softwareOcclusionEnabled_) {
+        // CPU 컬링 경로: 가림 결과가 프레임마다 달라지므로 인스턴스 목록을 매 프레임 다시 만듭니다.
+        updateModelTransforms();
+
+        // 이번 프레임 초에 시작한 결과 (그 뒤에 추가된 모델은 결과가 없으므로 그립니다)
+        const std::vector<uint8_t>& occlusionVisibility = softwareOcclusion_.wait();
+
+        // 프러스텀 컬링, 박스 인덱스는 모델 인덱스와 같습니다. (모델은 추가만 되므로 새 모델만 addBox)
+        for (size_t i = 0; i < models_.size(); ++i) {
+            // 메시가 없는 모델은 원점의 0 크기 박스로 두고, 그릴 것이 없으므로 결과는 상관없습니다.
+            glm::vec3 boundsMin(0.0f);
+            glm::vec3 boundsMax(0.0f);
+            models_[i].getWorldBounds(boundsMin, boundsMax);
+            if (i < frustumCuller_.size()) {
+                frustumCuller_.setBox(static_cast<uint32_t>(i), boundsMin, boundsMax);
+            }
+            else {
+                frustumCuller_.addBox(boundsMin, boundsMax);
+            }
+        }
+        frustumCuller_.cull(Frustum::FromViewProj(viewProjMatrix_), visibleModels_);
+        // 계층 경로가 박스를 클러스터 순서로 재배치해 결과 순서가 섞이므로 배치 순서와 컬링 입력 목록이 프레임마다 유지되도록 정렬합니다.
+        std::sort(visibleModels_.begin(), visibleModels_.end());
+
+        instanceBatcher_.begin();
+        for (uint32_t i : visibleModels_) {
+            if (i < occlusionVisibility.size() && !occlusionVisibility[i]) {
+                continue;
+            }
+            instanceBatcher_.addModel(models_[i]);
+        }
     }
+    else if (instanceListDirty_) {
+        // 프러스텀/Hi-Z 컬링은 cull.comp가 GpuScene의 레코드로 모두 하므로 CPU는 모델을 순회하지 않습니다.
+        // 모델 변환은 모델 수와 배치 방식으로만 정해지므로 모델이 추가된 프레임에만 다시 계산해 목록을 만듭니다.
+        updateModelTransforms();
+        instanceBatcher_.begin();
+        for (const Model& model : models_) {
+            instanceBatcher_.addModel(model);
+        }
+        instanceListDirty_ = false;
+    }
+    // addModel()이 갱신한 레코드 중 바뀐 것만 이 슬롯의 업로드 버퍼로 보냅니다. (필요하면 레코드 버퍼를 키움)
+    gpuScene_.flush(currentImage);
+    // 팔레트는 update()에서 이 슬롯에 복사했습니다.
+    instanceBatcher_.build(currentImage, viewProjMatrix_, camera_->getPosition(), swapChain_.getSwapChainExtent(),
+        hizPyramid_->getExtent(), hizPyramid_->getMipCount(), bonePalettePool_.getFrameAddress(), bonePalettePool_.getFrameBaseIndex());
 }
 
 void VulkanApp::loadAssets() {
@@ -521,16 +994,24 @@ void VulkanApp::loadAssets() {
     //modelConfig.animationFilenames.push_back("Hip Hop Dancing_cleaned.fbx");
     modelConfig.animationFilenames.push_back("mouseModelAnim.fbx");
 	models_.push_back(Model(&context_, modelConfig));
+    if (boneBenchmark_) {
+        // 본 백엔드 벤치마크 씬: 같은 에셋을 공유하는 스키닝 인스턴스 격자 (에셋은 위에서 한 번만 로드됨)
+        const uint32_t gridSize = boneBenchmark_->getSettings().gridSize;
+        for (uint32_t i = 1; i < gridSize * gridSize; ++i) {
+            models_.push_back(Model(&context_, modelConfig));
+        }
+    }
 
     for(Model& model : models_)
     {
-        model.prepareBindless(modelUbArray_, materialUbArray_, boneUbArray_, textureArray_);
+        model.prepareBindless(materialTable_, bonePalettePool_, textureArray_);
+        model.registerObjects(gpuScene_);
 	}
 	
-    sceneUB_ = std::make_unique<class UniformBuffer>(&context_, sizeof(UniformBufferScene));
-    resources_["scene"]= sceneUB_.get();
+    frameUniforms_.initialize(&context_, MAX_FRAMES_IN_FLIGHT, sizeof(UniformBufferScene));
+    resources_["scene"]= &frameUniforms_;
 
-    defaultTexture_ = std::make_unique<Texture>(&context_, "../assets/images/minion.jpg");
+    defaultTexture_ = TextureCache::Load(&context_, "../assets/images/minion.jpg");
     textureArray_.addDefaultTexture(defaultTexture_.get());
 
     // HDR ȯ��� �ε� - �� ū �ػ󵵷� ����
@@ -590,11 +1071,13 @@ void VulkanApp::handleHDRInput() {
     if (glfwGetKey(window, GLFW_KEY_Q) == GLFW_PRESS) {
         hdrExposure -= 0.02f;
         if (hdrExposure < 0.1f) hdrExposure = 0.1f;
+        sceneVersion_++; // 톤매핑 푸시 상수
         std::cout << "HDR Exposure: " << hdrExposure << std::endl;
     }
     if (glfwGetKey(window, GLFW_KEY_E) == GLFW_PRESS) {
         hdrExposure += 0.02f;
         if (hdrExposure > 5.0f) hdrExposure = 5.0f;
+        sceneVersion_++;
         std::cout << "HDR Exposure: " << hdrExposure << std::endl;
     }
 
@@ -638,4 +1121,182 @@ void VulkanApp::handleHDRInput() {
         std::cout << "Tonemap Mode: Simple Exposure" << std::endl;
     }
     if (glfwGetKey(window, GLFW_KEY_4) == GLFW_RELEASE) key4Pressed = false;
+
+    // 직전 프레임의 씬/스카이박스 기록에서 실제로 보낸 호출과 중복이라 건너뛴 호출
+    static bool keyPPressed = false;
+    if (glfwGetKey(window, GLFW_KEY_P) == GLFW_PRESS && !keyPPressed) {
+        keyPPressed = true;
+        const CommandEncoder::Stats stats = commandRecorder_.getFrameStats();
+        std::cout << "Command Encoder: issued " << stats.getIssuedCount()
+                  << ", skipped " << stats.getSkippedCount() << std::endl;
+        std::cout << "  pipeline " << stats.pipelineBinds << "/" << stats.pipelineBindsSkipped
+                  << ", descriptor sets " << stats.descriptorSetBinds << "/" << stats.descriptorSetBindsSkipped
+                  << ", vertex buffers " << stats.vertexBufferBinds << "/" << stats.vertexBufferBindsSkipped
+                  << ", index buffers " << stats.indexBufferBinds << "/" << stats.indexBufferBindsSkipped
+                  << ", push constants " << stats.pushConstants << "/" << stats.pushConstantsSkipped
+                  << ", draws " << stats.draws << std::endl;
+        std::cout << "Command Buffer Cache: hits " << commandBufferCache_.getHitCount() + computeCommandBufferCache_.getHitCount()
+                  << ", re-records " << commandBufferCache_.getMissCount() + computeCommandBufferCache_.getMissCount() << std::endl;
+        std::cout << "Instance Batcher: " << instanceBatcher_.getInstanceCount() << "/" << InstanceBatcher::MAX_INSTANCES << " instances"
+                  << ", " << instanceBatcher_.getDrawCount() << "/" << InstanceBatcher::MAX_BATCHES << " batches"
+                  << ", dropped " << instanceBatcher_.getDroppedInstanceCount() + instanceBatcher_.getDroppedBatchInstanceCount() << std::endl;
+        const UploadManager& uploadManager = context_.getUploadManager();
+        std::cout << "Uploads: last frame " << uploadManager.getLastFrameBytes() / 1024 << " KB"
+                  << ", peak " << uploadManager.getPeakFrameBytes() / 1024 << " KB"
+                  << " (budget " << uploadManager.getFrameBudget() / 1024 << " KB)"
+                  << ", pending " << uploadManager.getPendingBytes() / 1024 << " KB"
+                  << ", stalls " << uploadManager.getStallCount() << " (" << uploadManager.getStallMilliseconds() << " ms)"
+                  << ", oversize " << uploadManager.getOversizeUploadCount()
+                  << ", batches " << uploadManager.getSubmittedBatchCount()
+                  << ", ownership transfers " << uploadManager.getOwnershipTransferCount() << std::endl;
+        const MemoryAllocator::Stats memoryStats = context_.getMemoryAllocator().getStats();
+        std::cout << "Device Memory: allocations " << memoryStats.deviceMemoryCount << "/" << memoryStats.maxDeviceMemoryCount
+                  << " (blocks " << memoryStats.blockCount << ", dedicated " << memoryStats.dedicatedCount << ")"
+                  << ", slab pages " << memoryStats.slabPageCount
+                  << ", resources " << memoryStats.allocationCount << " (total " << memoryStats.totalAllocationCount << ")"
+                  << ", used " << memoryStats.usedBytes / (1024 * 1024) << "/" << memoryStats.reservedBytes / (1024 * 1024) << " MB" << std::endl;
+        const GpuScene::Stats& sceneStats = gpuScene_.getStats();
+        std::cout << "GPU Scene: objects " << sceneStats.objectCount << "/" << sceneStats.capacity
+                  << ", uploads last frame " << sceneStats.lastUploadCount << " (peak " << sceneStats.peakUploadCount
+                  << ", total " << sceneStats.totalUploadCount << ")"
+                  << ", grows " << sceneStats.growCount << std::endl;
+        const MaterialTable::Stats& materialStats = materialTable_.getStats();
+        std::cout << "Materials: " << materialStats.materialCount << "/" << materialStats.capacity
+                  << ", registered " << materialStats.registerCount << " (dedup hits " << materialStats.dedupHits << ")"
+                  << ", grows " << materialStats.growCount << std::endl;
+        std::cout << "Frame Uniforms: last frame " << frameUniforms_.getLastFrameBytes() / 1024 << " KB"
+                  << ", peak " << frameUniforms_.getPeakFrameBytes() / 1024 << " KB"
+                  << " (per slot " << frameUniforms_.getFrameSize() / 1024 << " KB)" << std::endl;
+        const BonePalettePool::Stats& paletteStats = bonePalettePool_.getStats();
+        std::cout << "Bone Palettes: " << paletteStats.paletteCount << " palettes, "
+                  << paletteStats.matrixCount << "/" << paletteStats.capacity << " matrices"
+                  << ", upload last frame " << paletteStats.lastUploadBytes / 1024 << " KB"
+                  << " (peak " << paletteStats.peakUploadBytes / 1024 << " KB)"
+                  << ", grows " << paletteStats.growCount << std::endl;
+        std::cout << "Bone Backend: " << GetBoneBackendName(boneBackend_);
+        if (gpuScopeTimes_.size() == GPU_SCOPE_COUNT && gpuScopeTimes_[GPU_SCOPE_DEPTH_EARLY] >= 0.0) {
+            std::cout << ", depth prepass GPU " << gpuScopeTimes_[GPU_SCOPE_DEPTH_EARLY] << " + "
+                      << std::max(gpuScopeTimes_[GPU_SCOPE_DEPTH_LATE], 0.0) << " ms";
+        }
+        std::cout << std::endl;
+    }
+    if (glfwGetKey(window, GLFW_KEY_P) == GLFW_RELEASE) keyPPressed = false;
+
+    static bool keyCPressed = false;
+    if (glfwGetKey(window, GLFW_KEY_C) == GLFW_PRESS && !keyCPressed) {
+        keyCPressed = true;
+        commandBufferCacheEnabled_ = !commandBufferCacheEnabled_;
+        commandBufferCache_.invalidate();
+        computeCommandBufferCache_.invalidate();
+        std::cout << "Command Buffer Cache: " << (commandBufferCacheEnabled_ ? "ON" : "OFF") << std::endl;
+    }
+    if (glfwGetKey(window, GLFW_KEY_C) == GLFW_RELEASE) keyCPressed = false;
+
+    static bool keyZPressed = false;
+    if (glfwGetKey(window, GLFW_KEY_Z) == GLFW_PRESS && !keyZPressed) {
+        keyZPressed = true;
+        depthPrepassEnabled_ = !depthPrepassEnabled_;
+        sceneVersion_++; // 패스 구성이 바뀝니다.
+        std::cout << "Depth Prepass: " << (depthPrepassEnabled_ ? "ON" : "OFF") << std::endl;
+    }
+    if (glfwGetKey(window, GLFW_KEY_Z) == GLFW_RELEASE) keyZPressed = false;
+
+    static bool keyXPressed = false;
+    if (glfwGetKey(window, GLFW_KEY_X) == GLFW_PRESS && !keyXPressed) {
+        keyXPressed = true;
+        if (context_.hasDedicatedComputeQueue()) {
+            asyncComputeEnabled_ = !asyncComputeEnabled_;
+            applyAsyncCompute();
+            sceneVersion_++; // 세그먼트 구성과 배리어가 바뀝니다.
+            std::cout << "Async Compute: " << (asyncComputeEnabled_ ? "ON" : "OFF") << std::endl;
+        }
+        else {
+            std::cout << "Async Compute: no dedicated compute queue" << std::endl;
+        }
+    }
+    if (glfwGetKey(window, GLFW_KEY_X) == GLFW_RELEASE) keyXPressed = false;
+
+    // 토글은 drawFrame() 밖에서 하므로 kick()과 wait()가 같은 프레임 안에서 짝이 맞습니다.
+    static bool keyOPressed = false;
+    if (glfwGetKey(window, GLFW_KEY_O) == GLFW_PRESS && !keyOPressed) {
+        keyOPressed = true;
+        setSoftwareOcclusionEnabled(!softwareOcclusionEnabled_);
+        std::cout << "Software Occlusion: " << (softwareOcclusionEnabled_ ? "ON (CPU culling)" : "OFF (GPU culling)") << std::endl;
+    }
+    if (glfwGetKey(window, GLFW_KEY_O) == GLFW_RELEASE) keyOPressed = false;
+
+    static bool keyBPressed = false;
+    if (glfwGetKey(window, GLFW_KEY_B) == GLFW_PRESS && !keyBPressed) {
+        keyBPressed = true;
+        // 다음 백엔드부터 이 장치에서 쓸 수 있는 것을 찾습니다.
+        BoneBackend next = boneBackend_;
+        for (uint32_t i = 0; i < static_cast<uint32_t>(BoneBackend::Count); ++i) {
+            next = static_cast<BoneBackend>((static_cast<uint32_t>(next) + 1) % static_cast<uint32_t>(BoneBackend::Count));
+            if (setBoneBackend(next)) {
+                break;
+            }
+            std::cout << "Bone Backend: " << GetBoneBackendName(next) << " is not supported, skipping" << std::endl;
+        }
+        std::cout << "Bone Backend: " << GetBoneBackendName(boneBackend_) << std::endl;
+    }
+    if (glfwGetKey(window, GLFW_KEY_B) == GLFW_RELEASE) keyBPressed = false;
+}
+
+bool VulkanApp::setBoneBackend(BoneBackend backend)
+{
+    if (!bonePalettePool_.isBackendSupported(backend)) {
+        return false;
+    }
+    if (backend == boneBackend_) {
+        return true;
+    }
+    // 이전 파이프라인으로 기록한 커맨드 버퍼가 GPU에서 모두 끝나야 파이프라인을 다시 만들 수 있습니다.
+    vkDeviceWaitIdle(context_.getDevice());
+    const std::vector<uint32_t> constants = { static_cast<uint32_t>(backend) };
+    defaultPipeline_.setVertexSpecialization(constants);
+    defaultEqualPipeline_.setVertexSpecialization(constants);
+    depthPrepassPipeline_.setVertexSpecialization(constants);
+    boneBackend_ = backend;
+    sceneVersion_++; // 파이프라인 핸들이 바뀝니다.
+    return true;
+}
+
+void VulkanApp::updateBoneBackendBenchmark(bool hasGpuTimes)
+{
+    if (boneBenchmark_->isFinished()) {
+        return;
+    }
+    if (!gpuTimer_.isSupported()) {
+        std::cout << "Bone backend benchmark: GPU timestamps are not supported on this device" << std::endl;
+        glfwSetWindowShouldClose(window, GLFW_TRUE);
+        boneBenchmark_.reset();
+        instanceListDirty_ = true; // 격자 배치가 끝납니다.
+        return;
+    }
+
+    // 얼리 + 레이트 = 이번 프레임의 모든 인스턴스를 한 번씩 깊이로 그린 시간
+    if (hasGpuTimes) {
+        double milliseconds = 0.0;
+        for (double scopeTime : gpuScopeTimes_) {
+            milliseconds += std::max(scopeTime, 0.0);
+        }
+        boneBenchmark_->addFrame(milliseconds);
+    }
+
+    // 측정할 백엔드로 바꾸고, 이 장치에서 쓸 수 없으면 건너뜁니다.
+    while (!boneBenchmark_->isFinished() && boneBenchmark_->getCurrentBackend() != boneBackend_) {
+        const BoneBackend backend = boneBenchmark_->getCurrentBackend();
+        if (setBoneBackend(backend)) {
+            std::cout << "Bone backend benchmark: measuring " << GetBoneBackendName(backend) << std::endl;
+            break;
+        }
+        boneBenchmark_->skipCurrentBackend("not supported on this device");
+    }
+
+    if (boneBenchmark_->isFinished()) {
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(context_.getPhysicalDevice(), &properties);
+        boneBenchmark_->printResults(properties.deviceName, static_cast<uint32_t>(models_.size()));
+        glfwSetWindowShouldClose(window, GLFW_TRUE);
+    }
 }
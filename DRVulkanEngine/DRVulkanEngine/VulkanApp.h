@@ -10,6 +10,7 @@
 #include "VulkanContext.h"
 #include "VulkanSwapChain.h"
 #include "VulkanPipeline.h"
+#include "ComputePipeline.h"
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <memory>
@@ -19,8 +20,22 @@
 #include "DescriptorSet.h"
 #include "DescriptorPool.h"
 #include "UniformBuffer.h"
-#include "UniformBufferArray.h"
 #include "RenderTarget.h"
+#include "AsyncModelLoader.h"
+#include "InstanceBatcher.h"
+#include "FrameUniformAllocator.h"
+#include "GpuScene.h"
+#include "MaterialTable.h"
+#include "BonePalettePool.h"
+#include "BoneBackendBenchmark.h"
+#include "GpuTimer.h"
+#include "HiZPyramid.h"
+#include "SoftwareOcclusionCuller.h"
+#include "FrustumCuller.h"
+#include "ParallelCommandRecorder.h"
+#include "CommandBufferCache.h"
+#include "RenderGraph.h"
+#include "TransientResourcePool.h"
 const uint32_t WIDTH = 800;
 const uint32_t HEIGHT = 600;
 class Camera;
@@ -43,13 +58,26 @@ public:
     VulkanApp();
     ~VulkanApp();
     void run();
+    // run() 전에 부르면 스키닝 인스턴스 격자를 띄워 본 백엔드마다 깊이 프리패스 GPU 시간을 재고, 결과를 출력한 뒤 창을 닫습니다.
+    void enableBoneBackendBenchmark(const BoneBackendBenchmark::Settings& settings);
+    // GPU 컴퓨트 컬링을 쓸 수 없는 환경용 CPU 컬링 (프러스텀 + 소프트웨어 가림, ModelConfig::isOccluder인 모델이 가리개)
+    // 켜면 CPU가 매 프레임 모든 모델을 검사해 살아남은 것만 인스턴스 목록에 넣습니다. --software-occlusion 또는 O 키
+    void setSoftwareOcclusionEnabled(bool enabled);
 
 private:
     void initWindow();
     void initVulkan();
 
     void createCommandBuffers();
-    void recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex);
+    // useSecondaryCommandBuffers가 false면 씬 드로우도 primary에 직접 기록합니다. (캐시해서 다시 제출할 커맨드 버퍼)
+    void recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t segment, uint32_t imageIndex, bool useSecondaryCommandBuffers);
+    VkCommandBuffer getFrameCommandBuffer(RenderGraphQueue queue, uint32_t segment);
+    void submitRenderGraph(const RenderGraph& renderGraph, const std::vector<VkCommandBuffer>& segmentCommandBuffers, uint32_t imageIndex);
+    void applyAsyncCompute();
+    void recordSceneDraws(VkCommandBuffer commandBuffer, const VkCommandBufferInheritanceRenderingInfo& inheritance,
+        uint32_t itemCount, const ParallelCommandRecorder::RecordFunc& recordFunc);
+    // rendergraphs/*.json을 읽어 패스 이름마다 기록 함수를 연결합니다.
+    void buildRenderGraphs();
     void createSyncObjects();
     void mainLoop();
     void cleanup();
@@ -57,6 +85,12 @@ private:
     void drawFrame();
 
     void updateUniformBuffer(uint32_t currentImage);
+    void updateModelTransforms();
+    glm::mat4 computeProjectionMatrix() const;
+    void kickSoftwareOcclusion();
+    // 세 씬 파이프라인을 그 백엔드로 다시 특수화합니다. 이 장치/버퍼 크기에서 쓸 수 없으면 false
+    bool setBoneBackend(BoneBackend backend);
+    void updateBoneBackendBenchmark(bool hasGpuTimes);
     void handleHDRInput(); // HDR ���� Ű���� �Է� ó��
 
     void loadAssets();
@@ -69,15 +103,28 @@ private:
     VulkanContext context_;
     VulkanSwapChain swapChain_;
     VulkanPipeline defaultPipeline_;
+    // 깊이 프리패스 (Z 키로 전환): 깊이 전용 변형으로 깊이를 먼저 채우고 메인 패스는 EQUAL로 셰이딩만 합니다.
+    VulkanPipeline depthPrepassPipeline_;
+    VulkanPipeline defaultEqualPipeline_;
 	VulkanPipeline skyboxPipeline_;
 	VulkanPipeline tonemappingPipeline_;
+    ComputePipeline sceneScatterPipeline_;
+    ComputePipeline cullPipeline_;
+    ComputePipeline clusterCullPipeline_;
+    ComputePipeline hizDownsamplePipeline_;
 
 
+    // 씬 컬러/깊이 같은 프레임 중간 어태치먼트 (렌더 그래프의 사용 구간으로 메모리를 겹쳐 씁니다)
+    TransientResourcePool transientPool_;
     RenderTarget sceneRenderTarget_;
 
     ShaderManager shaderManager_;
 
-    std::vector<VkCommandBuffer> commandBuffers;
+    // 캐시를 쓰지 않을 때의 커맨드 버퍼 [queue][frame][세그먼트], 큐 패밀리의 풀에서 필요할 때 할당합니다.
+    std::vector<std::vector<VkCommandBuffer>> commandBuffers[static_cast<size_t>(RenderGraphQueue::Count)];
+    // 큐마다 타임라인 세마포어 하나. 세그먼트를 제출할 때마다 그 큐의 값이 1씩 오릅니다.
+    VkSemaphore queueTimelines_[static_cast<size_t>(RenderGraphQueue::Count)] = {};
+    uint64_t queueTimelineValues_[static_cast<size_t>(RenderGraphQueue::Count)] = {};
     std::vector<VkSemaphore> imageAvailableSemaphores;
     std::vector<VkSemaphore> renderFinishedSemaphores;
     std::vector<VkFence> inFlightFences;
@@ -92,15 +139,64 @@ private:
 
     std::vector<Model> models_;
 	std::unique_ptr<Model> skyboxModel_;
+    AsyncModelLoader asyncModelLoader_;
+    // 모델 x 메시 오브젝트 레코드 테이블 (바뀐 레코드만 업로드해 컴퓨트로 흩뿌림)
+    GpuScene gpuScene_;
+    InstanceBatcher instanceBatcher_;
+    ParallelCommandRecorder commandRecorder_;
+    // 씬이 바뀌지 않는 동안 기록한 커맨드 버퍼를 그대로 다시 제출합니다. (C 키로 전환)
+    CommandBufferCache commandBufferCache_;
+    CommandBufferCache computeCommandBufferCache_;
+    bool commandBufferCacheEnabled_ = false;
+    bool depthPrepassEnabled_ = false;
+    // 컬링/Hi-Z 패스를 컴퓨트 전용 큐에 보내 그래픽스 작업과 겹칩니다. (X 키로 전환, 전용 큐가 없으면 무시)
+    bool asyncComputeEnabled_ = true;
+    // 프리패스를 끄고 켤 때마다 다시 컴파일하지 않도록 두 그래프를 미리 만들어 둡니다.
+    RenderGraph renderGraph_;
+    RenderGraph depthPrepassRenderGraph_;
+    // 패스 기록 함수가 참조하는 현재 기록 중인 프레임의 값
+    uint32_t frameImageIndex_ = 0;
+    bool recordWithSecondaries_ = false;
+    // 기록되는 커맨드가 달라지는 변경마다 올립니다. (디스크립터 셋 갱신, 스왑체인 재생성, 푸시 상수 값, 배치 구성)
+    uint64_t sceneVersion_ = 0;
+    uint64_t lastBatchRecordVersion_ = 0;
+    uint64_t lastSceneRecordVersion_ = 0;
+    std::unique_ptr<HiZPyramid> hizPyramid_;
+    SoftwareOcclusionCuller softwareOcclusion_;
+    bool softwareOcclusionEnabled_ = false;
+    std::vector<OccluderDesc> occluders_;
+    std::vector<OccludeeBounds> occludees_;
+    FrustumCuller frustumCuller_;
+    std::vector<uint32_t> visibleModels_;
+    // 모델이 추가되거나 배치 방식이 바뀌면 켭니다. 켜진 프레임에만 변환과 인스턴스 목록을 다시 만듭니다.
+    bool instanceListDirty_ = true;
+    glm::mat4 viewProjMatrix_ = glm::mat4(1.0f);
 
     std::map<std::string, Resource*> resources_;
     std::unique_ptr<class CubemapTexture> envCubemapTexture_;
-    std::unique_ptr<class UniformBuffer> sceneUB_;
+    // 씬 UBO처럼 프레임마다 새로 쓰는 유니폼 데이터의 영구 매핑 링 (동적 오프셋)
+    FrameUniformAllocator frameUniforms_;
+    // 캐시된 커맨드 버퍼는 바인딩할 때의 동적 오프셋을 담고 있으므로 슬롯별로 기억해 바뀌면 sceneVersion_을 올립니다.
+    std::array<uint32_t, MAX_FRAMES_IN_FLIGHT> sceneUniformOffsets_{};
     TextureArray textureArray_;
-    UniformBufferArray materialUbArray_;
-    UniformBufferArray modelUbArray_;
-    UniformBufferArray boneUbArray_;
-    std::unique_ptr<Texture> defaultTexture_;
+    // 모든 재질 레코드를 담는 스토리지 버퍼 하나 (같은 레코드는 ID 하나를 공유)
+    MaterialTable materialTable_;
+    // 모든 스키닝 인스턴스의 본 팔레트 (인스턴스마다 본 수만큼의 고정 구간, 프레임마다 한 번 복사)
+    BonePalettePool bonePalettePool_;
+    // 버텍스 셰이더가 팔레트를 읽는 경로 (B 키로 전환), 기본값은 디스크립터가 필요 없는 BDA
+    BoneBackend boneBackend_ = BoneBackend::DeviceAddress;
+    // 풀이 커져 백엔드를 SSBO로 되돌렸다는 안내는 한 번만 출력합니다.
+    bool boneBackendFallbackReported_ = false;
+    // 깊이 프리패스 얼리/레이트 구간의 GPU 시간 (버텍스 단계 비용)
+    enum GpuTimerScope : uint32_t {
+        GPU_SCOPE_DEPTH_EARLY = 0,
+        GPU_SCOPE_DEPTH_LATE,
+        GPU_SCOPE_COUNT
+    };
+    GpuTimer gpuTimer_;
+    std::vector<double> gpuScopeTimes_;
+    std::unique_ptr<BoneBackendBenchmark> boneBenchmark_;
+    std::shared_ptr<Texture> defaultTexture_;
 
     // ī�޶� ����
     float lastFrame;
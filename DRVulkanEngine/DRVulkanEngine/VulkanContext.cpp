@@ -1,5 +1,7 @@
 #include "VulkanContext.h"
 #include "GlobalData.h"
+#include "UploadManager.h"
+#include "MemoryAllocator.h"
 #include <GLFW/glfw3.h>
 #include <stdexcept>
 #include <vector>
@@ -34,8 +36,16 @@ VulkanContext::VulkanContext(VulkanContext&& other) noexcept
     , device(other.device)
     , graphicsQueue(other.graphicsQueue)
     , presentQueue(other.presentQueue)
+    , computeQueue(other.computeQueue)
+    , transferQueue(other.transferQueue)
     , surface(other.surface)
     , commandPool_(other.commandPool_)
+    , computeCommandPool_(other.computeCommandPool_)
+    , queueFamilyIndices_(other.queueFamilyIndices_)
+    , sharedQueueFamilies_{ other.sharedQueueFamilies_[0], other.sharedQueueFamilies_[1], other.sharedQueueFamilies_[2] }
+    , sharedQueueFamilyCount_(other.sharedQueueFamilyCount_)
+    , memoryAllocator_(std::move(other.memoryAllocator_))
+    , uploadManager_(std::move(other.uploadManager_))
     , debugMessenger(other.debugMessenger) {
     
     // �̵��� ��ü�� �ڵ���� ��ȿȭ
@@ -44,8 +54,11 @@ VulkanContext::VulkanContext(VulkanContext&& other) noexcept
     other.device = VK_NULL_HANDLE;
     other.graphicsQueue = VK_NULL_HANDLE;
     other.presentQueue = VK_NULL_HANDLE;
+    other.computeQueue = VK_NULL_HANDLE;
+    other.transferQueue = VK_NULL_HANDLE;
     other.surface = VK_NULL_HANDLE;
     other.commandPool_ = VK_NULL_HANDLE;
+    other.computeCommandPool_ = VK_NULL_HANDLE;
     other.debugMessenger = VK_NULL_HANDLE;
 }
 
@@ -58,8 +71,18 @@ VulkanContext& VulkanContext::operator=(VulkanContext&& other) noexcept {
         device = other.device;
         graphicsQueue = other.graphicsQueue;
         presentQueue = other.presentQueue;
+        computeQueue = other.computeQueue;
+        transferQueue = other.transferQueue;
         surface = other.surface;
         commandPool_ = other.commandPool_;
+        computeCommandPool_ = other.computeCommandPool_;
+        queueFamilyIndices_ = other.queueFamilyIndices_;
+        sharedQueueFamilies_[0] = other.sharedQueueFamilies_[0];
+        sharedQueueFamilies_[1] = other.sharedQueueFamilies_[1];
+        sharedQueueFamilies_[2] = other.sharedQueueFamilies_[2];
+        sharedQueueFamilyCount_ = other.sharedQueueFamilyCount_;
+        memoryAllocator_ = std::move(other.memoryAllocator_);
+        uploadManager_ = std::move(other.uploadManager_);
         debugMessenger = other.debugMessenger;
         
         other.instance = VK_NULL_HANDLE;
@@ -67,8 +90,11 @@ VulkanContext& VulkanContext::operator=(VulkanContext&& other) noexcept {
         other.device = VK_NULL_HANDLE;
         other.graphicsQueue = VK_NULL_HANDLE;
         other.presentQueue = VK_NULL_HANDLE;
+        other.computeQueue = VK_NULL_HANDLE;
+        other.transferQueue = VK_NULL_HANDLE;
         other.surface = VK_NULL_HANDLE;
         other.commandPool_ = VK_NULL_HANDLE;
+        other.computeCommandPool_ = VK_NULL_HANDLE;
         other.debugMessenger = VK_NULL_HANDLE;
     }
     return *this;
@@ -81,6 +107,12 @@ void VulkanContext::initialize(GLFWwindow* window)
     pickPhysicalDevice();
     createLogicalDevice();
     createCommandPool();
+
+    memoryAllocator_ = std::make_unique<MemoryAllocator>();
+    memoryAllocator_->initialize(this);
+
+    uploadManager_ = std::make_unique<UploadManager>();
+    uploadManager_->initialize(this);
 }
 
 bool VulkanContext::checkValidationLayerSupport() {
@@ -262,11 +294,24 @@ void VulkanContext::pickPhysicalDevice() {
 
 void VulkanContext::createLogicalDevice() {
     QueueFamilyIndices indices = findQueueFamilies(physicalDevice);
+    queueFamilyIndices_ = indices;
+    sharedQueueFamilyCount_ = 0;
+    for (uint32_t family : { indices.graphicsFamily.value(), indices.computeFamily.value(), indices.transferFamily.value() }) {
+        bool duplicated = false;
+        for (uint32_t i = 0; i < sharedQueueFamilyCount_; ++i) {
+            duplicated |= sharedQueueFamilies_[i] == family;
+        }
+        if (!duplicated) {
+            sharedQueueFamilies_[sharedQueueFamilyCount_++] = family;
+        }
+    }
 
     std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
     std::set<uint32_t> uniqueQueueFamilies = {
         indices.graphicsFamily.value(),
-        indices.presentFamily.value()
+        indices.presentFamily.value(),
+        indices.computeFamily.value(),
+        indices.transferFamily.value()
     };
 
     float queuePriority = 1.0f;
@@ -319,9 +364,24 @@ void VulkanContext::createLogicalDevice() {
     vulkan12Features.pNext = &vulkan13Features;
     vulkan12Features.descriptorBindingPartiallyBound = VK_TRUE;
     vulkan12Features.runtimeDescriptorArray = VK_TRUE;
-#if USE_BDA_BUFFER
+    // 인스턴스/컬링 버퍼는 본 버퍼 방식과 관계없이 BDA로 접근합니다.
     vulkan12Features.bufferDeviceAddress = VK_TRUE;
-#endif
+    // GPU 컬링 결과로 드로우 개수를 정하는 vkCmdDrawIndexedIndirectCount용
+    vulkan12Features.drawIndirectCount = VK_TRUE;
+    // 그래픽스/컴퓨트 큐 사이의 프레임 안 의존성을 값 하나로 표현합니다.
+    vulkan12Features.timelineSemaphore = VK_TRUE;
+
+    // 선택 기능은 지원 여부를 먼저 물어보고 켭니다.
+    VkPhysicalDeviceVulkan12Features supportedVulkan12Features{};
+    supportedVulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    VkPhysicalDeviceFeatures2 supportedFeatures2{};
+    supportedFeatures2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    supportedFeatures2.pNext = &supportedVulkan12Features;
+    vkGetPhysicalDeviceFeatures2(physicalDevice, &supportedFeatures2);
+    uniformBufferArrayNonUniformIndexing_ = supportedVulkan12Features.shaderUniformBufferArrayNonUniformIndexing == VK_TRUE;
+    hostQueryReset_ = supportedVulkan12Features.hostQueryReset == VK_TRUE;
+    vulkan12Features.shaderUniformBufferArrayNonUniformIndexing = uniformBufferArrayNonUniformIndexing_ ? VK_TRUE : VK_FALSE;
+    vulkan12Features.hostQueryReset = hostQueryReset_ ? VK_TRUE : VK_FALSE;
 
     VkPhysicalDeviceFeatures2 deviceFeatures2{};
     deviceFeatures2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
@@ -336,6 +396,8 @@ void VulkanContext::createLogicalDevice() {
     if (supportedFeatures.shaderInt64) {
         deviceFeatures2.features.shaderInt64 = VK_TRUE;
     }
+    // 간접 드로우 인자의 firstInstance가 배치의 인스턴스 버퍼 시작이 됩니다. (isDeviceSuitable에서 필수로 확인)
+    deviceFeatures2.features.drawIndirectFirstInstance = VK_TRUE;
 
     VkDeviceCreateInfo createInfo{};
     createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
@@ -364,6 +426,14 @@ void VulkanContext::createLogicalDevice() {
 
     vkGetDeviceQueue(device, indices.graphicsFamily.value(), 0, &graphicsQueue);
     vkGetDeviceQueue(device, indices.presentFamily.value(), 0, &presentQueue);
+    vkGetDeviceQueue(device, indices.computeFamily.value(), 0, &computeQueue);
+    vkGetDeviceQueue(device, indices.transferFamily.value(), 0, &transferQueue);
+    if (hasDedicatedComputeQueue()) {
+        std::cout << "Async compute queue family: " << indices.computeFamily.value() << std::endl;
+    }
+    if (hasDedicatedTransferQueue()) {
+        std::cout << "Transfer queue family: " << indices.transferFamily.value() << std::endl;
+    }
 
     std::cout << "Logical device created successfully!" << std::endl;
 }
@@ -380,6 +450,11 @@ void VulkanContext::createCommandPool() {
         throw std::runtime_error("failed to create command pool!");
     }
 
+    poolInfo.queueFamilyIndex = queueFamilyIndices.computeFamily.value();
+    if (vkCreateCommandPool(device, &poolInfo, nullptr, &computeCommandPool_) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create compute command pool!");
+    }
+
     std::cout << "Command pool created successfully!" << std::endl;
 }
 
@@ -423,10 +498,26 @@ void VulkanContext::cleanup() {
         debugMessenger = VK_NULL_HANDLE;
     }
 
+    // 남은 업로드를 기다린 뒤 스테이징 버퍼와 풀을 디바이스보다 먼저 해제합니다.
+    if (uploadManager_) {
+        uploadManager_->cleanup();
+        uploadManager_.reset();
+    }
+
+    // 리소스는 모두 먼저 해제되어 있어야 합니다. 남은 블록은 여기서 한꺼번에 돌려줍니다.
+    if (memoryAllocator_) {
+        memoryAllocator_->cleanup();
+        memoryAllocator_.reset();
+    }
+
     if (commandPool_ != VK_NULL_HANDLE && device != VK_NULL_HANDLE) {
         vkDestroyCommandPool(device, commandPool_, nullptr);
         commandPool_ = VK_NULL_HANDLE;
     }
+    if (computeCommandPool_ != VK_NULL_HANDLE && device != VK_NULL_HANDLE) {
+        vkDestroyCommandPool(device, computeCommandPool_, nullptr);
+        computeCommandPool_ = VK_NULL_HANDLE;
+    }
 
     if (device != VK_NULL_HANDLE) {
         vkDestroyDevice(device, nullptr);
@@ -473,9 +564,45 @@ QueueFamilyIndices VulkanContext::findQueueFamilies(VkPhysicalDevice device) con
         i++;
     }
 
+    // 그래픽스 비트가 없는 컴퓨트 패밀리는 보통 별도의 하드웨어 큐라 그래픽스 작업과 겹쳐 실행됩니다.
+    for (uint32_t family = 0; family < queueFamilyCount; ++family) {
+        const VkQueueFlags flags = queueFamilies[family].queueFlags;
+        if ((flags & VK_QUEUE_COMPUTE_BIT) && !(flags & VK_QUEUE_GRAPHICS_BIT)) {
+            indices.computeFamily = family;
+            break;
+        }
+    }
+    if (!indices.computeFamily.has_value()) {
+        indices.computeFamily = indices.graphicsFamily;
+    }
+
+    // 전송 전용 패밀리는 DMA 엔진이라 그래픽스/컴퓨트와 겹쳐서 복사합니다.
+    for (uint32_t family = 0; family < queueFamilyCount; ++family) {
+        const VkQueueFlags flags = queueFamilies[family].queueFlags;
+        if ((flags & VK_QUEUE_TRANSFER_BIT) && !(flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT))) {
+            indices.transferFamily = family;
+            break;
+        }
+    }
+    if (!indices.transferFamily.has_value()) {
+        indices.transferFamily = indices.graphicsFamily;
+    }
+
     return indices;
 }
 
+void VulkanContext::setBufferSharing(VkBufferCreateInfo& bufferInfo) const
+{
+    if (sharedQueueFamilyCount_ > 1) {
+        bufferInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+        bufferInfo.queueFamilyIndexCount = sharedQueueFamilyCount_;
+        bufferInfo.pQueueFamilyIndices = sharedQueueFamilies_;
+    }
+    else {
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    }
+}
+
 const uint32_t VulkanContext::findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) const {
     VkPhysicalDeviceMemoryProperties memProperties;
     vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memProperties);
@@ -504,8 +631,10 @@ bool VulkanContext::isDeviceSuitable(VkPhysicalDevice device) {
     vkGetPhysicalDeviceFeatures2(device, &deviceFeatures2);
 
     bool dynamicRenderingSupported = dynamicRenderingFeatures.dynamicRendering;
+    // GPU 컬링이 채운 간접 드로우는 firstInstance로 배치/인스턴스 슬롯을 넘기므로, 없으면 0으로 읽혀 다른 인스턴스를 그립니다.
+    bool drawIndirectFirstInstanceSupported = deviceFeatures2.features.drawIndirectFirstInstance;
 
-    return indices.isComplete() && extensionsSupported && dynamicRenderingSupported;
+    return indices.isComplete() && extensionsSupported && dynamicRenderingSupported && drawIndirectFirstInstanceSupported;
 }
 
 bool VulkanContext::checkDeviceExtensionSupport(VkPhysicalDevice device) {
@@ -4,13 +4,20 @@
 #include <vector>
 #include <optional>
 #include <string>
+#include <memory>
 
 // GLFW ���� ����
 struct GLFWwindow;
+class UploadManager;
+class MemoryAllocator;
 
 struct QueueFamilyIndices {
     std::optional<uint32_t> graphicsFamily;
     std::optional<uint32_t> presentFamily;
+    // 그래픽스가 없는 컴퓨트 전용 패밀리 (없으면 그래픽스 패밀리와 같습니다)
+    std::optional<uint32_t> computeFamily;
+    // 그래픽스/컴퓨트가 없는 전송 전용 패밀리 (DMA 엔진, 없으면 그래픽스 패밀리와 같습니다)
+    std::optional<uint32_t> transferFamily;
 
     bool isComplete() {
         return graphicsFamily.has_value() && presentFamily.has_value();
@@ -24,8 +31,20 @@ private:
     VkDevice device = VK_NULL_HANDLE;
     VkQueue graphicsQueue = VK_NULL_HANDLE;
     VkQueue presentQueue = VK_NULL_HANDLE;
+    VkQueue computeQueue = VK_NULL_HANDLE;
+    VkQueue transferQueue = VK_NULL_HANDLE;
     VkSurfaceKHR surface = VK_NULL_HANDLE;
     VkCommandPool commandPool_ = VK_NULL_HANDLE;
+    VkCommandPool computeCommandPool_ = VK_NULL_HANDLE;
+    QueueFamilyIndices queueFamilyIndices_;
+    // 컴퓨트/전송 큐가 따로 있으면 버퍼를 그 패밀리들이 같이 쓰도록(CONCURRENT) 만듭니다.
+    uint32_t sharedQueueFamilies_[3] = {};
+    uint32_t sharedQueueFamilyCount_ = 1;
+    std::unique_ptr<MemoryAllocator> memoryAllocator_;
+    std::unique_ptr<UploadManager> uploadManager_;
+    // 디바이스가 지원할 때만 켜는 선택 기능
+    bool uniformBufferArrayNonUniformIndexing_ = false;
+    bool hostQueryReset_ = false;
     
     VkDebugUtilsMessengerEXT debugMessenger = VK_NULL_HANDLE;
     
@@ -68,12 +87,32 @@ public:
     VkDevice getDevice() const { return device; }
     VkQueue getGraphicsQueue() const { return graphicsQueue; }
     VkQueue getPresentQueue() const { return presentQueue; }
+    VkQueue getComputeQueue() const { return computeQueue; }
+    VkQueue getTransferQueue() const { return transferQueue; }
+    uint32_t getGraphicsQueueFamily() const { return queueFamilyIndices_.graphicsFamily.value(); }
+    uint32_t getComputeQueueFamily() const { return queueFamilyIndices_.computeFamily.value(); }
+    uint32_t getTransferQueueFamily() const { return queueFamilyIndices_.transferFamily.value(); }
+    // 컴퓨트 전용 패밀리가 있어 그래픽스와 겹쳐 실행할 수 있는지
+    bool hasDedicatedComputeQueue() const { return getComputeQueueFamily() != getGraphicsQueueFamily(); }
+    bool hasDedicatedTransferQueue() const { return getTransferQueueFamily() != getGraphicsQueueFamily(); }
     VkSurfaceKHR getSurface() const { return surface; }
     VkCommandPool getCommandPool() const { return commandPool_; }
+    VkCommandPool getComputeCommandPool() const { return computeCommandPool_; }
+    // 텍스처/버퍼 업로드는 여기에 기록해 전송 큐로 모아서 제출합니다. (Resource는 const 컨텍스트만 가지고 있음)
+    UploadManager& getUploadManager() const { return *uploadManager_; }
+    // 리소스의 디바이스 메모리는 모두 여기서 잘라 받습니다. (maxMemoryAllocationCount 제한 회피)
+    MemoryAllocator& getMemoryAllocator() const { return *memoryAllocator_; }
+    // UBO 배열을 인스턴스마다 다른 인덱스로 읽을 수 있는지 (본 팔레트 UBO 창 백엔드)
+    bool supportsUniformBufferArrayNonUniformIndexing() const { return uniformBufferArrayNonUniformIndexing_; }
+    // 호스트에서 쿼리 풀을 리셋할 수 있는지 (GPU 타이머)
+    bool supportsHostQueryReset() const { return hostQueryReset_; }
 
     // ��ƿ��Ƽ �޼����
     QueueFamilyIndices findQueueFamilies(VkPhysicalDevice device) const;
     const uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) const;
+    // 그래픽스/컴퓨트/전송 큐가 소유권 이전 없이 같이 쓰도록 버퍼 공유 모드를 채웁니다.
+    // 이미지는 압축 등의 이유로 EXCLUSIVE로 두고 렌더 그래프와 업로드 매니저가 소유권을 넘깁니다.
+    void setBufferSharing(VkBufferCreateInfo& bufferInfo) const;
 
 private:
     bool isDeviceSuitable(VkPhysicalDevice device);
@@ -10,6 +10,8 @@
 #include "DescriptorPool.h"
 #include "DescriptorSet.h"
 #include "GlobalData.h"
+#include "CommandEncoder.h"
+#include "Resource.h"
 // Vertex ����ü ���� (VulkanApp.cpp���� �̵�)
 
 
@@ -59,9 +61,43 @@ void VulkanPipeline::initialize(const VulkanContext* vulkanContext,
     config_ = config;
     descriptorPool_ = descriptorPool;
 
-    Shader* vertexShader = shaderMgr_->getShader(config_.vertexShaderPath);
-    Shader* fragmentShader = shaderMgr_->getShader(config_.fragmentShaderPath);
-    createGraphicsPipeline({ vertexShader, fragmentShader });
+    createGraphicsPipeline(collectShaders());
+}
+
+std::vector<Shader*> VulkanPipeline::collectShaders() const
+{
+    // 버텍스 셰이더가 항상 첫 번째여야 합니다. (특수화 상수, 버텍스 입력)
+    std::vector<Shader*> shaders = { shaderMgr_->getShader(config_.vertexShaderPath) };
+    if (!config_.depthOnly) {
+        shaders.push_back(shaderMgr_->getShader(config_.fragmentShaderPath));
+    }
+    return shaders;
+}
+
+PipelineConfig VulkanPipeline::MakeDepthOnlyConfig(const PipelineConfig& config)
+{
+    PipelineConfig depthConfig = config;
+    depthConfig.pipelineName = config.pipelineName + "_depth";
+    if (!config.depthOnlyVertexShaderPath.empty()) {
+        depthConfig.vertexShaderPath = config.depthOnlyVertexShaderPath;
+    }
+    depthConfig.fragmentShaderPath.clear();
+    depthConfig.depthOnly = true;
+    depthConfig.depthTestEnable = true;
+    depthConfig.depthWriteEnable = true;
+    depthConfig.blendEnable = false;
+    depthConfig.colorAttachmentFormat = VK_FORMAT_UNDEFINED;
+    return depthConfig;
+}
+
+PipelineConfig VulkanPipeline::MakeDepthEqualConfig(const PipelineConfig& config)
+{
+    PipelineConfig equalConfig = config;
+    equalConfig.pipelineName = config.pipelineName + "_equal";
+    equalConfig.depthCompareOp = VK_COMPARE_OP_EQUAL;
+    equalConfig.depthTestEnable = true;
+    equalConfig.depthWriteEnable = false;
+    return equalConfig;
 }
 
 void VulkanPipeline::createGraphicsPipeline(const std::vector<Shader*> shaders){
@@ -71,35 +107,27 @@ void VulkanPipeline::createGraphicsPipeline(const std::vector<Shader*> shaders){
     for (const Shader* shader : shaders) {
         shaderStages.push_back(shader->stageInfo_);
     }
-////////////////////////////////////
-    // TODO. �ӽ� �׽�Ʈ�� �ڵ�
-    struct SpecializationData {
-        VkBool32 useBDA; // 0 (false) �Ǵ� 1 (true)
-    };
-
-    SpecializationData specData;
-    specData.useBDA = USE_BDA_BUFFER? VK_TRUE : VK_FALSE; // �Ǵ� VK_FALSE�� ����
-
-    // 2. ���̴��� � ����� �������� ����
-    VkSpecializationMapEntry entry{};
-    entry.constantID = 0;        // GLSL�� constant_id = 0�� ��ġ
-    entry.offset = 0;            // specData ����ü ���� ������
-    entry.size = sizeof(VkBool32);
-
-    // 3. ����ȶ������̼� ���� ����
-    VkSpecializationInfo specInfo{};
-    specInfo.mapEntryCount = 1;
-    specInfo.pMapEntries = &entry;
-    specInfo.dataSize = sizeof(SpecializationData);
-    specInfo.pData = &specData;
-
-    shaderStages[0].pSpecializationInfo = &specInfo;
-////////////////////////////////////
+
+    // 버텍스 스테이지는 항상 첫 번째입니다.
+    std::vector<VkSpecializationMapEntry> specializationEntries(config_.vertexSpecializationConstants.size());
+    for (uint32_t i = 0; i < specializationEntries.size(); ++i) {
+        specializationEntries[i].constantID = i;
+        specializationEntries[i].offset = sizeof(uint32_t) * i;
+        specializationEntries[i].size = sizeof(uint32_t);
+    }
+    VkSpecializationInfo specializationInfo{};
+    if (!specializationEntries.empty()) {
+        specializationInfo.mapEntryCount = static_cast<uint32_t>(specializationEntries.size());
+        specializationInfo.pMapEntries = specializationEntries.data();
+        specializationInfo.dataSize = sizeof(uint32_t) * config_.vertexSpecializationConstants.size();
+        specializationInfo.pData = config_.vertexSpecializationConstants.data();
+        shaderStages[0].pSpecializationInfo = &specializationInfo;
+    }
 
     VkPipelineVertexInputStateCreateInfo vertexInputInfo{}; // �ٱ��� ����
     if (config_.useVertexInput) {
         // ���� ����: 3D �𵨿� ������������ ���� �Է��� �����մϴ�.
-        vertexInputInfo = createVertexInputState();
+        vertexInputInfo = createVertexInputState(shaders[0]);
     }
     else {
         // �� ���ο� ������������ �� ���� �Է� ���¸� �����մϴ�.
@@ -125,8 +153,8 @@ void VulkanPipeline::createGraphicsPipeline(const std::vector<Shader*> shaders){
     // Depth Stencil State �߰�
     VkPipelineDepthStencilStateCreateInfo depthStencilInfo{};
     depthStencilInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
-    depthStencilInfo.depthTestEnable = VK_TRUE;
-    depthStencilInfo.depthWriteEnable = VK_TRUE;
+    depthStencilInfo.depthTestEnable = config_.depthTestEnable ? VK_TRUE : VK_FALSE;
+    depthStencilInfo.depthWriteEnable = config_.depthWriteEnable ? VK_TRUE : VK_FALSE;
     depthStencilInfo.depthCompareOp = config_.depthCompareOp;
     depthStencilInfo.depthBoundsTestEnable = VK_FALSE;
     depthStencilInfo.stencilTestEnable = VK_FALSE;
@@ -235,13 +263,16 @@ void VulkanPipeline::recreate() {
         pipelineLayout_ = VK_NULL_HANDLE;
     }
 
-    Shader* vertexShader = shaderMgr_->getShader(config_.vertexShaderPath);
-    Shader* fragmentShader = shaderMgr_->getShader(config_.fragmentShaderPath);
-    createGraphicsPipeline({ vertexShader , fragmentShader });
+    createGraphicsPipeline(collectShaders());
 
     std::cout << "Pipeline recreated successfully!" << std::endl;
 }
 
+void VulkanPipeline::setVertexSpecialization(const std::vector<uint32_t>& constants) {
+    config_.vertexSpecializationConstants = constants;
+    recreate();
+}
+
 void VulkanPipeline::cleanup() {
     if (!context_ || !context_->getDevice()) {
         return;
@@ -260,38 +291,87 @@ void VulkanPipeline::cleanup() {
 void VulkanPipeline::setDescriptorSets(const std::vector<DescriptorSet>& inDescriptorSet)
 {
     descriptorSets_ = inDescriptorSet;
+
+    // 바인딩할 때마다 핸들 배열을 만들지 않도록 프레임별로 미리 모아둡니다.
+    frameDescriptorSetHandles_.clear();
+    dynamicResources_.clear();
+    if (!descriptorSets_.empty()) {
+        frameDescriptorSetHandles_.resize(descriptorSets_.front().getFrameCount());
+    }
+    for (const DescriptorSet& ds : descriptorSets_)
+    {
+        for (uint32_t frameIndex = 0; frameIndex < frameDescriptorSetHandles_.size(); ++frameIndex)
+        {
+            frameDescriptorSetHandles_[frameIndex].push_back(ds.getHandle(frameIndex));
+        }
+        for (const Resource* resource : ds.getResources())
+        {
+            if (resource->hasDynamicOffset())
+            {
+                dynamicResources_.push_back(resource);
+            }
+        }
+    }
+    if (dynamicResources_.size() > CommandEncoder::MAX_DYNAMIC_OFFSETS) {
+        throw std::runtime_error("too many dynamic descriptors!");
+    }
 }
-void VulkanPipeline::bindPipeline(VkCommandBuffer commandBuffer)
+void VulkanPipeline::bindPipeline(VkCommandBuffer commandBuffer, uint32_t frameIndex)
 {
 	vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsPipeline);
 
-    std::vector< VkDescriptorSet> descriptorSets;
-    for (const DescriptorSet& ds : descriptorSets_)
-    {
-        descriptorSets.push_back(ds.getHandle());
+    if (frameDescriptorSetHandles_.empty()) {
+        return;
     }
+    const std::vector<VkDescriptorSet>& descriptorSetHandles = frameDescriptorSetHandles_[frameIndex];
+    uint32_t dynamicOffsets[CommandEncoder::MAX_DYNAMIC_OFFSETS];
+    const uint32_t dynamicOffsetCount = collectDynamicOffsets(dynamicOffsets);
     vkCmdBindDescriptorSets(
         commandBuffer,                      // ���� ��� ���� Ŀ�ǵ� ����
         VK_PIPELINE_BIND_POINT_GRAPHICS,    // �׷��Ƚ� ���������ο� ���ε�
         pipelineLayout_,                     // ���������� ���� �� ����� ���̾ƿ�
         0,                                  // ���ε��� ù ��° descriptor set ��ȣ (set = 0)
-        descriptorSets.size(),                                  // ���ε��� descriptor set�� ����
-        descriptorSets.data(),                     // ���ε��� descriptor set �ڵ��� �迭 ������
-        0,                                  // ���� ������ ���� (������ 0)
-        nullptr                             // ���� ������ �迭 ������ (������ nullptr)
+        static_cast<uint32_t>(descriptorSetHandles.size()),                             // ���ε��� descriptor set�� ����
+        descriptorSetHandles.data(),                      // ���ε��� descriptor set �ڵ��� �迭 ������
+        dynamicOffsetCount,                 // ���� ������ ���� (������ 0)
+        dynamicOffsets                      // ���� ������ �迭 ������ (������ nullptr)
     );
 }
 
-VkPipelineVertexInputStateCreateInfo VulkanPipeline::createVertexInputState() {
+void VulkanPipeline::bindPipeline(CommandEncoder& encoder, uint32_t frameIndex)
+{
+    encoder.bindPipeline(VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsPipeline);
+    if (frameDescriptorSetHandles_.empty()) {
+        return;
+    }
+    const std::vector<VkDescriptorSet>& descriptorSetHandles = frameDescriptorSetHandles_[frameIndex];
+    // 워커 스레드가 동시에 바인딩하므로 오프셋은 멤버가 아닌 지역 배열에 모읍니다.
+    uint32_t dynamicOffsets[CommandEncoder::MAX_DYNAMIC_OFFSETS];
+    const uint32_t dynamicOffsetCount = collectDynamicOffsets(dynamicOffsets);
+    encoder.bindDescriptorSets(VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout_, 0,
+        static_cast<uint32_t>(descriptorSetHandles.size()), descriptorSetHandles.data(), dynamicOffsetCount, dynamicOffsets);
+}
+
+uint32_t VulkanPipeline::collectDynamicOffsets(uint32_t* outOffsets) const
+{
+    uint32_t count = 0;
+    for (const Resource* resource : dynamicResources_) {
+        outOffsets[count++] = resource->getDynamicOffset();
+    }
+    return count;
+}
+
+VkPipelineVertexInputStateCreateInfo VulkanPipeline::createVertexInputState(const Shader* vertexShader) {
     static auto bindingDescription = Vertex::getBindingDescription();
-    static auto attributeDescriptions = Vertex::getAttributeDescriptions();
+    // 셰이더가 선언한 입력만 넣습니다. 깊이 전용 변형은 위치(와 스키닝 입력)만 읽습니다.
+    vertexInputAttributes_ = vertexShader->inputAttributes_;
 
     VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
     vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
     vertexInputInfo.vertexBindingDescriptionCount = 1;
     vertexInputInfo.pVertexBindingDescriptions = &bindingDescription;
-    vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
-    vertexInputInfo.pVertexAttributeDescriptions = attributeDescriptions.data();
+    vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(vertexInputAttributes_.size());
+    vertexInputInfo.pVertexAttributeDescriptions = vertexInputAttributes_.empty() ? nullptr : vertexInputAttributes_.data();
 
     return vertexInputInfo;
 }
@@ -364,7 +444,7 @@ VkPipelineColorBlendStateCreateInfo VulkanPipeline::createColorBlendState(VkPipe
     colorBlending.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
     colorBlending.logicOpEnable = VK_FALSE;
     colorBlending.logicOp = VK_LOGIC_OP_COPY;
-    colorBlending.attachmentCount = 1;
+    colorBlending.attachmentCount = config_.depthOnly ? 0 : 1;
     colorBlending.pAttachments = &colorBlendAttachment;
     colorBlending.blendConstants[0] = 0.0f;
     colorBlending.blendConstants[1] = 0.0f;
@@ -377,8 +457,8 @@ VkPipelineColorBlendStateCreateInfo VulkanPipeline::createColorBlendState(VkPipe
 VkPipelineRenderingCreateInfo VulkanPipeline::createDynamicRenderingInfo( ) {
     VkPipelineRenderingCreateInfo pipelineRenderingCreateInfo{};
     pipelineRenderingCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO;
-    pipelineRenderingCreateInfo.colorAttachmentCount = 1;
-    pipelineRenderingCreateInfo.pColorAttachmentFormats = &config_.colorAttachmentFormat;
+    pipelineRenderingCreateInfo.colorAttachmentCount = config_.depthOnly ? 0 : 1;
+    pipelineRenderingCreateInfo.pColorAttachmentFormats = config_.depthOnly ? nullptr : &config_.colorAttachmentFormat;
     
     // Depth Buffer ���� ����
     pipelineRenderingCreateInfo.depthAttachmentFormat = config_.depthAttachmentFormat;
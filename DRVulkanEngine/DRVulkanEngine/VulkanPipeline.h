@@ -15,6 +15,8 @@ class ShaderManager;
 class Shader;
 class DescriptorPool;
 class DescriptorSet;
+class CommandEncoder;
+class Resource;
 
 class VulkanPipeline {
 public:
@@ -36,11 +38,17 @@ public:
         const PipelineConfig& config);
 
     void cleanup();
-	void bindPipeline(VkCommandBuffer commandBuffer);
+	// frameIndex ũ  纻 εմϴ.
+	void bindPipeline(VkCommandBuffer commandBuffer, uint32_t frameIndex);
+    // ̹  /ũ  εǾ  ǳʶݴϴ.
+    void bindPipeline(CommandEncoder& encoder, uint32_t frameIndex);
 
 
     // Pipeline  (SwapChain  )
     void recreate();
+    // ؽ ̴ Ưȭ  ٲ  ٽ ϴ. (̾ƿ Ƿ ũ  ״)
+    //    Ŀǵ ۰ GPU   ҷ մϴ.
+    void setVertexSpecialization(const std::vector<uint32_t>& constants);
 
     // Getter ޼
     VkPipeline getGraphicsPipeline() const { return graphicsPipeline; }
@@ -49,7 +57,15 @@ public:
 
     bool isValid() const { return graphicsPipeline != VK_NULL_HANDLE; }
     void setDescriptorSets(const std::vector<DescriptorSet>& inDescriptorSet);
+
+    //  н : ؽ  ̸ ϴ.
+    // ũ ° ؽ Է  ؽ ̴ ÷  ϴ.
+    static PipelineConfig MakeDepthOnlyConfig(const PipelineConfig& config);
+    // н ä ̿  ȼ ̵ϴ  н  (EQUAL,   )
+    static PipelineConfig MakeDepthEqualConfig(const PipelineConfig& config);
 private:
+    std::vector<Shader*> collectShaders() const;
+    uint32_t collectDynamicOffsets(uint32_t* outOffsets) const;
     void createGraphicsPipeline(const std::vector<Shader*> shaders);
     void createPipelineLayout(const std::vector<Shader*> shaders);
 private:
@@ -59,7 +75,7 @@ private:
     
     // Pipeline     ޼
     
-    VkPipelineVertexInputStateCreateInfo createVertexInputState();
+    VkPipelineVertexInputStateCreateInfo createVertexInputState(const Shader* vertexShader);
     VkPipelineInputAssemblyStateCreateInfo createInputAssemblyState();
     VkPipelineViewportStateCreateInfo createViewportState(VkViewport& viewport, VkRect2D& scissor);
     VkPipelineRasterizationStateCreateInfo createRasterizationState();
@@ -80,4 +96,9 @@ private:
     std::map<uint32_t, std::map<uint32_t, LayoutBindingInfo>> descriptorSetLayoutBindingMap_;
 
     std::vector<DescriptorSet> descriptorSets_;
+    //  ->   ڵ
+    std::vector<std::vector<VkDescriptorSet>> frameDescriptorSetHandles_;
+    // UNIFORM_BUFFER_DYNAMIC ε ҽ (, ε ). ε     ѱϴ.
+    std::vector<const Resource*> dynamicResources_;
+    std::vector<VkVertexInputAttributeDescription> vertexInputAttributes_;
 };
\ No newline at end of file
@@ -15,9 +15,6 @@ VulkanSwapChain::VulkanSwapChain(VulkanSwapChain&& other) noexcept
     , swapChainImageFormat(other.swapChainImageFormat)
     , swapChainExtent(other.swapChainExtent)
     , swapChainImageViews(std::move(other.swapChainImageViews))
-    , depthImage(other.depthImage)
-    , depthImageMemory(other.depthImageMemory)
-    , depthImageView(other.depthImageView)
     , depthFormat(other.depthFormat)
     , context(other.context)
     , window(other.window) {
@@ -26,9 +23,6 @@ VulkanSwapChain::VulkanSwapChain(VulkanSwapChain&& other) noexcept
     other.swapChain = VK_NULL_HANDLE;
     other.swapChainImageFormat = VK_FORMAT_UNDEFINED;
     other.swapChainExtent = {0, 0};
-    other.depthImage = VK_NULL_HANDLE;
-    other.depthImageMemory = VK_NULL_HANDLE;
-    other.depthImageView = VK_NULL_HANDLE;
     other.depthFormat = VK_FORMAT_UNDEFINED;
     other.context = nullptr;
     other.window = nullptr;
@@ -43,9 +37,6 @@ VulkanSwapChain& VulkanSwapChain::operator=(VulkanSwapChain&& other) noexcept {
         swapChainImageFormat = other.swapChainImageFormat;
         swapChainExtent = other.swapChainExtent;
         swapChainImageViews = std::move(other.swapChainImageViews);
-        depthImage = other.depthImage;
-        depthImageMemory = other.depthImageMemory;
-        depthImageView = other.depthImageView;
         depthFormat = other.depthFormat;
         context = other.context;
         window = other.window;
@@ -53,9 +44,6 @@ VulkanSwapChain& VulkanSwapChain::operator=(VulkanSwapChain&& other) noexcept {
         other.swapChain = VK_NULL_HANDLE;
         other.swapChainImageFormat = VK_FORMAT_UNDEFINED;
         other.swapChainExtent = {0, 0};
-        other.depthImage = VK_NULL_HANDLE;
-        other.depthImageMemory = VK_NULL_HANDLE;
-        other.depthImageView = VK_NULL_HANDLE;
         other.depthFormat = VK_FORMAT_UNDEFINED;
         other.context = nullptr;
         other.window = nullptr;
@@ -69,9 +57,10 @@ void VulkanSwapChain::initialize(const VulkanContext* vulkanContext, GLFWwindow*
     
     createSwapChain();
     createImageViews();
-    createDepthResources(); // Depth Buffer ���� �߰�
+    // 씬 깊이 버퍼는 RenderTarget이 만들고, 여기서는 지원되는 포맷만 골라 둡니다.
+    depthFormat = findDepthFormat();
     
-    std::cout << "SwapChain initialized with Dynamic Rendering and Depth Buffer support!" << std::endl;
+    std::cout << "SwapChain initialized with Dynamic Rendering!" << std::endl;
 }
 
 void VulkanSwapChain::createSwapChain() {
@@ -134,33 +123,7 @@ void VulkanSwapChain::createImageViews() {
     }
 }
 
-void VulkanSwapChain::createDepthResources() {
-    depthFormat = findDepthFormat();
-
-    createImage(swapChainExtent.width, swapChainExtent.height, depthFormat, VK_IMAGE_TILING_OPTIMAL,
-                VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-                depthImage, depthImageMemory);
-
-    depthImageView = createImageView(depthImage, depthFormat, VK_IMAGE_ASPECT_DEPTH_BIT);
-
-    std::cout << "Depth resources created successfully!" << std::endl;
-}
-
 void VulkanSwapChain::recreate() {
-    // ���� Depth Buffer ����
-    if (depthImageView != VK_NULL_HANDLE) {
-        vkDestroyImageView(context->getDevice(), depthImageView, nullptr);
-        depthImageView = VK_NULL_HANDLE;
-    }
-    if (depthImage != VK_NULL_HANDLE) {
-        vkDestroyImage(context->getDevice(), depthImage, nullptr);
-        depthImage = VK_NULL_HANDLE;
-    }
-    if (depthImageMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(context->getDevice(), depthImageMemory, nullptr);
-        depthImageMemory = VK_NULL_HANDLE;
-    }
-
     // ���� SwapChain ����
     for (auto imageView : swapChainImageViews) {
         vkDestroyImageView(context->getDevice(), imageView, nullptr);
@@ -172,12 +135,11 @@ void VulkanSwapChain::recreate() {
         swapChain = VK_NULL_HANDLE;
     }
 
-    // ���ο� SwapChain�� Depth Buffer ����
+    // 새 SwapChain 생성
     createSwapChain();
     createImageViews();
-    createDepthResources();
 
-    std::cout << "SwapChain recreated with Dynamic Rendering and Depth Buffer!" << std::endl;
+    std::cout << "SwapChain recreated with Dynamic Rendering!" << std::endl;
 }
 
 void VulkanSwapChain::cleanup() {
@@ -185,20 +147,6 @@ void VulkanSwapChain::cleanup() {
         return;
     }
 
-    // Depth Buffer ����
-    if (depthImageView != VK_NULL_HANDLE) {
-        vkDestroyImageView(context->getDevice(), depthImageView, nullptr);
-        depthImageView = VK_NULL_HANDLE;
-    }
-    if (depthImage != VK_NULL_HANDLE) {
-        vkDestroyImage(context->getDevice(), depthImage, nullptr);
-        depthImage = VK_NULL_HANDLE;
-    }
-    if (depthImageMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(context->getDevice(), depthImageMemory, nullptr);
-        depthImageMemory = VK_NULL_HANDLE;
-    }
-
     // Color Image Views ����
     for (auto imageView : swapChainImageViews) {
         vkDestroyImageView(context->getDevice(), imageView, nullptr);
@@ -229,25 +177,11 @@ VkRenderingAttachmentInfo VulkanSwapChain::getColorAttachmentInfo(uint32_t image
     return colorAttachment;
 }
 
-VkRenderingAttachmentInfo VulkanSwapChain::getDepthAttachmentInfo() const {
-    VkRenderingAttachmentInfo depthAttachment{};
-    depthAttachment.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
-    depthAttachment.imageView = depthImageView;
-    // VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL -> VK_IMAGE_LAYOUT_ATTACHMENT_OPTIMAL_KHR
-    depthAttachment.imageLayout = VK_IMAGE_LAYOUT_ATTACHMENT_OPTIMAL_KHR;
-    depthAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-    depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-    depthAttachment.clearValue.depthStencil = {1.0f, 0};
-    return depthAttachment;
-}
-
 VkRenderingInfo VulkanSwapChain::getRenderingInfo(uint32_t imageIndex) const {
     // thread_local static���� ������ ���� ����
     static thread_local VkRenderingAttachmentInfo colorAttachment;
-    static thread_local VkRenderingAttachmentInfo depthAttachment;
     
     colorAttachment = getColorAttachmentInfo(imageIndex);
-    depthAttachment = getDepthAttachmentInfo();
     
     VkRenderingInfo renderingInfo{};
     renderingInfo.sType = VK_STRUCTURE_TYPE_RENDERING_INFO;
@@ -256,7 +190,7 @@ VkRenderingInfo VulkanSwapChain::getRenderingInfo(uint32_t imageIndex) const {
     renderingInfo.layerCount = 1;
     renderingInfo.colorAttachmentCount = 1;
     renderingInfo.pColorAttachments = &colorAttachment;
-    renderingInfo.pDepthAttachment = &depthAttachment; // Depth Attachment �߰�
+    renderingInfo.pDepthAttachment = nullptr;
     renderingInfo.pStencilAttachment = nullptr;
     
     return renderingInfo;
@@ -289,43 +223,6 @@ bool VulkanSwapChain::hasStencilComponent(VkFormat format) {
     return format == VK_FORMAT_D32_SFLOAT_S8_UINT || format == VK_FORMAT_D24_UNORM_S8_UINT;
 }
 
-void VulkanSwapChain::createImage(uint32_t width, uint32_t height, VkFormat format, VkImageTiling tiling, 
-                                  VkImageUsageFlags usage, VkMemoryPropertyFlags properties, 
-                                  VkImage& image, VkDeviceMemory& imageMemory) {
-    VkImageCreateInfo imageInfo{};
-    imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-    imageInfo.imageType = VK_IMAGE_TYPE_2D;
-    imageInfo.extent.width = width;
-    imageInfo.extent.height = height;
-    imageInfo.extent.depth = 1;
-    imageInfo.mipLevels = 1;
-    imageInfo.arrayLayers = 1;
-    imageInfo.format = format;
-    imageInfo.tiling = tiling;
-    imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    imageInfo.usage = usage;
-    imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
-    imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-
-    if (vkCreateImage(context->getDevice(), &imageInfo, nullptr, &image) != VK_SUCCESS) {
-        throw std::runtime_error("failed to create image!");
-    }
-
-    VkMemoryRequirements memRequirements;
-    vkGetImageMemoryRequirements(context->getDevice(), image, &memRequirements);
-
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = context->findMemoryType(memRequirements.memoryTypeBits, properties);
-
-    if (vkAllocateMemory(context->getDevice(), &allocInfo, nullptr, &imageMemory) != VK_SUCCESS) {
-        throw std::runtime_error("failed to allocate image memory!");
-    }
-
-    vkBindImageMemory(context->getDevice(), image, imageMemory, 0);
-}
-
 VkImageView VulkanSwapChain::createImageView(VkImage image, VkFormat format, VkImageAspectFlags aspectFlags) {
     VkImageViewCreateInfo viewInfo{};
     viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
@@ -21,12 +21,8 @@ private:
     VkFormat swapChainImageFormat;
     VkExtent2D swapChainExtent;
     std::vector<VkImageView> swapChainImageViews;
-    
-    // Depth Buffer   ߰
-    VkImage depthImage = VK_NULL_HANDLE;
-    VkDeviceMemory depthImageMemory = VK_NULL_HANDLE;
-    VkImageView depthImageView = VK_NULL_HANDLE;
-    VkFormat depthFormat;
+    //   Ÿ    (̹ RenderTarget ϴ)
+    VkFormat depthFormat = VK_FORMAT_UNDEFINED;
 
     const VulkanContext* context;
     GLFWwindow* window;
@@ -47,7 +43,6 @@ public:
     void initialize(const VulkanContext* vulkanContext, GLFWwindow* glfwWindow);
     void createSwapChain();
     void createImageViews();
-    void createDepthResources(); // Depth Buffer  ޼ ߰
     void cleanup();
     
     // SwapChain  ( ũ  )
@@ -60,7 +55,6 @@ public:
     const std::vector<VkImageView>& getSwapChainImageViews() const { return swapChainImageViews; }
     
     // Depth Buffer Getter ޼ ߰
-    VkImageView getDepthImageView() const { return depthImageView; }
     VkFormat getDepthFormat() const { return depthFormat; }
     
     // ƿƼ ޼
@@ -69,7 +63,6 @@ public:
 
     // Dynamic Rendering   ޼
     VkRenderingAttachmentInfo getColorAttachmentInfo(uint32_t imageIndex) const;
-    VkRenderingAttachmentInfo getDepthAttachmentInfo() const; // Depth Attachment  ߰
     VkRenderingInfo getRenderingInfo(uint32_t imageIndex) const;
 
 private:
@@ -83,6 +76,5 @@ private:
     VkFormat findDepthFormat();
     VkFormat findSupportedFormat(const std::vector<VkFormat>& candidates, VkImageTiling tiling, VkFormatFeatureFlags features);
     bool hasStencilComponent(VkFormat format);
-    void createImage(uint32_t width, uint32_t height, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, VkMemoryPropertyFlags properties, VkImage& image, VkDeviceMemory& imageMemory);
     VkImageView createImageView(VkImage image, VkFormat format, VkImageAspectFlags aspectFlags);
 };
\ No newline at end of file
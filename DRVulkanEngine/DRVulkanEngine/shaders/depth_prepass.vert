@@ -0,0 +1,111 @@
+#version 450
+#extension GL_ARB_gpu_shader_int64 : enable
+#extension GL_EXT_buffer_reference : enable
+#extension GL_EXT_nonuniform_qualifier : enable
+
+
+// 깊이만 쓰므로 위치와 스키닝 입력만 선언합니다.
+// 파이프라인은 리플렉션으로 이 location들만 버텍스 입력에 넣습니다.
+layout(location = 0) in vec3 inPosition;
+layout(location = 5) in ivec4 inBoneIDs;
+layout(location = 6) in vec4 inWeights;
+
+// 메인 패스(shader.vert)와 같은 식으로 계산해야 EQUAL 깊이 테스트가 통과합니다.
+invariant gl_Position;
+
+// shader.vert와 같아야 합니다.
+struct InstanceData {
+    mat4 world;
+    uint64_t boneAddress;
+    int paletteIndex;
+    int materialIndex;
+};
+
+layout(buffer_reference, std430) readonly restrict buffer InstancePtr {
+    InstanceData instances[];
+};
+
+layout(set = 0, binding = 0) uniform SceneUBO {
+    mat4 proj;
+    mat4 view;
+    vec3 lightPos;
+    vec3 viewPos;
+} scene;
+
+layout(push_constant) uniform PushConstants {
+    uint64_t instanceAddress;
+    int padding0;
+    int padding1;
+} pc;
+
+// 본 행렬을 읽는 경로 (BoneBackend, 파이프라인을 만들 때 특수화)
+// 네 경로 모두 같은 팔레트 풀(BonePalettePool)을 가리키고, 쓰지 않는 경로는 특수화 뒤 제거됩니다.
+layout(constant_id = 0) const uint BONE_BACKEND = 2;
+const uint BONE_BACKEND_UNIFORM_ARRAY = 0;
+const uint BONE_BACKEND_STORAGE = 1;
+const uint BONE_BACKEND_DEVICE_ADDRESS = 2;
+const uint BONE_BACKEND_TEXEL_BUFFER = 3;
+
+#define MAX_BONE_WINDOWS 128        // BonePalettePool::MAX_UNIFORM_WINDOWS
+#define BONE_WINDOW_MATRICES 256    // BonePalettePool::WINDOW_MATRICES (16KB)
+
+// 팔레트는 창 경계에 걸치지 않으므로 인스턴스 하나는 창 하나만 읽습니다.
+// 창 인덱스가 인스턴스마다 달라 shaderUniformBufferArrayNonUniformIndexing 기능이 필요합니다.
+layout(std140, set = 0, binding = 1) uniform BonePaletteWindow {
+    mat4 matrices[BONE_WINDOW_MATRICES];
+} bonePaletteWindows[MAX_BONE_WINDOWS];
+
+layout(std430, set = 0, binding = 2) readonly buffer BonePaletteStorage {
+    mat4 matrices[];
+} bonePalette;
+
+// RGBA32F, 행렬 하나가 열 4개 텍셀
+layout(set = 0, binding = 3) uniform samplerBuffer bonePaletteTexels;
+
+// 이 인스턴스 구간의 주소 (InstanceData::boneAddress)
+layout(buffer_reference, std430) readonly restrict buffer BonePtr {
+    mat4 finalBoneMatrix[];
+};
+
+mat4 loadBoneMatrix(InstanceData instance, int boneId) {
+    if (BONE_BACKEND == BONE_BACKEND_UNIFORM_ARRAY) {
+        uint index = uint(instance.paletteIndex + boneId);
+        return bonePaletteWindows[nonuniformEXT(index / BONE_WINDOW_MATRICES)].matrices[index % BONE_WINDOW_MATRICES];
+    }
+    if (BONE_BACKEND == BONE_BACKEND_STORAGE) {
+        return bonePalette.matrices[instance.paletteIndex + boneId];
+    }
+    if (BONE_BACKEND == BONE_BACKEND_TEXEL_BUFFER) {
+        int texel = (instance.paletteIndex + boneId) * 4;
+        return mat4(texelFetch(bonePaletteTexels, texel),
+                    texelFetch(bonePaletteTexels, texel + 1),
+                    texelFetch(bonePaletteTexels, texel + 2),
+                    texelFetch(bonePaletteTexels, texel + 3));
+    }
+    return BonePtr(instance.boneAddress).finalBoneMatrix[boneId];
+}
+
+void main() {
+    InstanceData instance = InstancePtr(pc.instanceAddress).instances[gl_InstanceIndex];
+    mat4 currentModelMatrix = instance.world;
+
+    mat4 totalBoneTransform = mat4(1.0f);
+    // 애니메이션이 없는 모델은 팔레트 주소가 0입니다. (팔레트 인덱스는 -1)
+    if (inWeights.x > 0.0 && instance.boneAddress != 0) {
+        
+        totalBoneTransform = mat4(0.0f);
+        
+        for(int i = 0; i < 4; i++) {
+            if(inBoneIDs[i] < 0 || inWeights[i] == 0.0) {
+                continue;
+            }
+            
+            mat4 boneMatrix = loadBoneMatrix(instance, inBoneIDs[i]);
+            totalBoneTransform += boneMatrix * inWeights[i];
+        }
+    }
+    
+    vec4 animatedPos = totalBoneTransform * vec4(inPosition, 1.0);
+    vec4 worldPos = currentModelMatrix * animatedPos;
+    gl_Position = scene.proj * scene.view * worldPos;
+}
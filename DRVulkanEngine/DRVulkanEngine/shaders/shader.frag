@@ -2,49 +2,46 @@
 #extension GL_ARB_gpu_shader_int64 : enable
 #extension GL_EXT_buffer_reference : enable
 
-#define MAX_MATERIALS 128
 #define MAX_TEXTURES_PER_MATERIAL 128
 
 layout(location = 0) in vec3 fragWorldPos;
 layout(location = 1) in vec3 fragNormal;
 layout(location = 2) in vec2 fragTexCoord;
 layout(location = 3) in mat3 fragTBN;
+layout(location = 6) flat in int fragMaterialIndex;
 
 layout(location = 0) out vec4 outColor;
 
-// --- PushConstant ---
-layout(push_constant) uniform PushConstants {
-    uint64_t boneAddress;
-    int modelUBIndex;
-    int materialIndex;
-    int boneUbIndex;
-    int padding;
-} pc;
 // --- DescriptorSet ---
-layout(set = 0, binding = 1) uniform SceneUBO {
+layout(set = 0, binding = 0) uniform SceneUBO {
     mat4 proj;
     mat4 view;
     vec3 lightPos;
     vec3 viewPos;
 } scene;
 
-struct MaterialUBO {
+// MaterialTable의 MaterialData와 일치해야 합니다. (32바이트)
+struct MaterialData {
     int diffuseTexIndex;
     int normalTexIndex;
     int specularTexIndex;
     int ambientTexIndex;
     int emissiveTexIndex;
+    int padding0;
+    int padding1;
+    int padding2;
 };
 
-layout(std140, set = 1, binding = 0) uniform MaterialCollection {
-    MaterialUBO materials;
-} materialData[MAX_MATERIALS];
+// 모든 재질이 버퍼 하나에 있으므로 재질 수 제한이 없습니다. (인스턴스의 재질 ID로 인덱싱)
+layout(std430, set = 1, binding = 0) readonly buffer MaterialTable {
+    MaterialData materials[];
+} materialData;
 
 layout(set = 2, binding = 0) uniform sampler2D materialTextures[MAX_TEXTURES_PER_MATERIAL];
 
 
 void main() {
-    MaterialUBO currentMaterial = materialData[pc.materialIndex].materials;
+    MaterialData currentMaterial = materialData.materials[fragMaterialIndex];
 
     vec3 normal = normalize(fragNormal);
     if (currentMaterial.normalTexIndex > -1) {